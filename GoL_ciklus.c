@@ -0,0 +1,58 @@
+/**
+ * @file GoL_ciklus.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A ciklusfelismerés megvalósítása.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_ciklus.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+void ciklus_init(Ciklus_figyelo *f){
+    f->kov = 0;
+    f->db = 0;
+    f->periodus = 0;
+    f->kezdet = 0;
+}
+
+int ciklus_frissit(Ciklus_figyelo *f, Tabla *t){
+    if(f->periodus == 0){
+        // A legrégebbi előfordulás kell, hogy a ciklus kezdete pontos legyen
+        int elso = (f->db < CIKLUS_ELOZMENY) ? 0 : f->kov;
+        for(int i = 0; i < f->db; i++){
+            int index = (elso + i) % CIKLUS_ELOZMENY;
+            if(f->hashek[index] == t->hash){
+                f->kezdet = f->generaciok[index];
+                f->periodus = t->generacio - f->kezdet;
+                break;
+            }
+        }
+    }
+
+    f->hashek[f->kov] = t->hash;
+    f->generaciok[f->kov] = t->generacio;
+    f->kov = (f->kov + 1) % CIKLUS_ELOZMENY;
+    if(f->db < CIKLUS_ELOZMENY)
+        f->db++;
+
+    return f->periodus != 0 && f->kezdet + f->periodus == t->generacio;
+}
+
+long long ciklus_ugras(Ciklus_figyelo *f, Tabla *t, long long cel){
+    if(f->periodus == 0 || cel <= t->generacio)
+        return 0;
+    long long ugras = (cel - t->generacio) / f->periodus * f->periodus;
+    t->generacio += ugras;
+    return ugras;
+}
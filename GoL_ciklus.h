@@ -0,0 +1,64 @@
+/**
+ * @file GoL_ciklus.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Stabilizálódás és ismétlődés (csendélet, oszcillátor) felismerése a tábla hash-e alapján.
+ * Az utolsó CIKLUS_ELOZMENY generáció hash-ét tárolja; ha egy hash újra előfordul, a tábla ciklusba került.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_CIKLUS_H
+#define GOL_CIKLUS_H
+
+#include <stdint.h>
+#include "GoL_logics.h"
+
+/** Ennyi generáció hash-ét tárolja, ennél hosszabb periódust nem ismer fel */
+#define CIKLUS_ELOZMENY 1024
+
+/**
+ * @brief A ciklusfigyelő állapota.
+ * @param hashek Az utolsó generációk hash-ei (gyűrűs puffer)
+ * @param generaciok A hashekhez tartozó generációszámok
+ * @param kov A következő beírandó elem indexe
+ * @param db Az érvényes elemek száma
+ * @param periodus A felismert ciklus periódusa, 0 ha még nincs
+ * @param kezdet Az a generáció, ahonnan a ciklus kezdődik
+ */
+typedef struct Ciklus_figyelo{
+    uint64_t hashek[CIKLUS_ELOZMENY];
+    long long generaciok[CIKLUS_ELOZMENY];
+    int kov, db;
+    long long periodus, kezdet;
+}Ciklus_figyelo;
+
+/**
+ * @brief Üres állapotba hozza a figyelőt.
+ * Akkor is hívandó, ha a táblát a felhasználó megváltoztatta (flip, betöltés).
+ * @param f
+ */
+void ciklus_init(Ciklus_figyelo *f);
+
+/**
+ * @brief Felveszi a tábla jelenlegi hash-ét, és megnézi, előfordult -e már.
+ * Minden uj_generacio után hívandó. O(CIKLUS_ELOZMENY), a tábla méretétől független.
+ * @param f
+ * @param t
+ * @return 1 ha most ismert fel először ciklust (ekkor a periodus és a kezdet ki van töltve), különben 0
+ */
+int ciklus_frissit(Ciklus_figyelo *f, Tabla *t);
+
+/**
+ * @brief Ha a tábla ciklusban van, a generációszámlálót a célhoz legközelebbi, de azt meg nem haladó,
+ * a jelenlegivel azonos állapotú generációra állítja, léptetés nélkül.
+ * @param f
+ * @param t
+ * @param cel A generáció, ameddig futtatni kellene
+ * @return az átugrott generációk száma
+ */
+long long ciklus_ugras(Ciklus_figyelo *f, Tabla *t, long long cel);
+
+#endif
@@ -0,0 +1,1503 @@
+/**
+ * @file GoL_ellenorzes.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A szimuláció helyességét ellenőrző önteszt megvalósítása.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_ellenorzes.h"
+#include "GoL_statisztika.h"
+#include "GoL_idoblokk.h"
+#include "GoL_lut.h"
+#include "GoL_motor.h"
+#include "GoL_elosztott.h"
+#include "GoL_tortenet.h"
+#include "GoL_felvetel.h"
+#include "GoL_ltl.h"
+#include "GoL_kernel.h"
+#include "GoL_leves.h"
+#include "GoL_ciklus.h"
+#include "GoL_nepszamlalas.h"
+#include "GoL_kozos.h"
+#include "GoL_szerver.h"
+#include "GoL_novekvo.h"
+#include "GoL_lemez.h"
+#include "GoL_ritka.h"
+#include "GoL_memoria.h"
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/** Ennyi véletlen táblán veti össze a motorokat */
+#define KERESZT_TABLAK 24
+/** Ennyi generáción át veti össze a motorokat táblánként */
+#define KERESZT_GENERACIOK 120
+
+/**
+ * @brief Egy ismert kezdőállás és a referencia motorral kapott eredménye.
+ * @param nev
+ * @param minta Sorok '\n'-nel elválasztva, 'O' az élő cella. Ha NULL, véletlen "leves" a mag alapján.
+ * @param sz A játéktér szélessége (szegély nélkül)
+ * @param m A játéktér magassága (szegély nélkül)
+ * @param sor A minta bal felső sarkának sora
+ * @param oszlop A minta bal felső sarkának oszlopa
+ * @param mag A véletlen leves magja
+ * @param generaciok Ennyi generációt lép
+ * @param nepesseg Az elvárt népesség a végén
+ * @param hash Az elvárt tabla_hash a végén
+ */
+typedef struct Arany_allas{
+    const char *nev;
+    const char *minta;
+    int sz, m;
+    int sor, oszlop;
+    uint64_t mag;
+    int generaciok;
+    int nepesseg;
+    uint64_t hash;
+}Arany_allas;
+
+/**
+ * @brief Egy összevetendő motor.
+ * @param nev
+ * @param lepes Az uj_generacio-val azonos módon viselkedő függvény, ami esetleg egyszerre több generációt lép
+ * @param generaciok Egy hívás hány generációt lép (ennyi uj_generacio-val kell összevetni)
+ */
+typedef struct Motor_leiras{
+    const char *nev;
+    Lepes_fuggveny lepes;
+    int generaciok;
+}Motor_leiras;
+
+static const Arany_allas arany_allasok[] = {
+    {"blinker",        "OOO",                                  16, 16,  7,  6, 0,  101,    3, 0x3506e3a290ca82d8ULL},
+    {"glider",         ".O.\n..O\nOOO",                        32, 32,  2,  2, 0,   60,    5, 0xadc4ca57e2b545f3ULL},
+    {"r-pentomino",    ".OO\nOO.\n.O.",                        64, 64, 30, 30, 0,  500,  130, 0x7e59b9e96cfa2f43ULL},
+    {"acorn",          ".O.....\n...O...\nOO..OOO",           100, 80, 38, 45, 0, 1000,   48, 0xccabd6f4f06c7fdaULL},
+    {"diehard",        "......O.\nOO......\n.O...OOO",         40, 40, 18, 16, 0,  130,    0, 0x0000000000000000ULL},
+    {"gosper gun",     "........................O...........\n"
+                       "......................O.O...........\n"
+                       "............OO......OO............OO\n"
+                       "...........O...O....OO............OO\n"
+                       "OO........O.....O...OO..............\n"
+                       "OO........O...O.OO....O.O...........\n"
+                       "..........O.....O.......O...........\n"
+                       "...........O...O....................\n"
+                       "............OO......................", 60, 40,  2,  2, 0,  300,   56, 0x35dd784b0d258a0fULL},
+    {"leves 50x50",    NULL,                                   50, 50,  0,  0, 2021, 200,  159, 0xb6e43f81399d77fcULL},
+    {"leves 97x31",    NULL,                                   97, 31,  0,  0,   42, 350,  118, 0xecdb7c5ddc8a83bdULL},
+};
+
+/**
+ * @brief Az idoblokk_lepes kis csempékkel, hogy a véletlen táblákon is sok csempe és csempehatár legyen.
+ */
+static OszlopSor_Lista_Elem* idoblokk_4(Tabla *t);
+static OszlopSor_Lista_Elem* idoblokk_9(Tabla *t);
+
+/** Az alternatív motorok, amiket a referencia uj_generacio-val kell összevetni */
+static const Motor_leiras motorok[] = {
+    {"referencia", uj_generacio, 1},
+    {"lut", lut_generacio, 1},
+    {"ltl", ltl_generacio, 1},
+    {"kernel", kernel_generacio, 1},
+    {"idoblokk k=4", idoblokk_4, 4},
+    {"idoblokk k=9", idoblokk_9, 9},
+};
+
+/**
+ * @brief Egyszerű, determinisztikus véletlenszám generátor (xorshift64*).
+ * @param allapot nem lehet 0
+ * @return a következő véletlen szám
+ */
+static uint64_t veletlen(uint64_t *allapot);
+
+/**
+ * @brief Feltölti a táblát véletlen cellákkal.
+ * @param t inicializált tábla
+ * @param mag
+ * @param suruseg az élő cellák aránya százalékban
+ */
+static void veletlen_leves(Tabla *t, uint64_t mag, int suruseg);
+
+/**
+ * @brief Létrehozza az arany állás kezdőállapotát.
+ * @param t inicializálatlan tábla
+ * @param allas
+ */
+static void allas_felallit(Tabla *t, const Arany_allas *allas);
+
+/**
+ * @brief Lefuttatja az állást és visszaadja a népességet és a hash-t.
+ * @param allas
+ * @param nepesseg
+ * @param hash
+ */
+static void allas_futtat(const Arany_allas *allas, int *nepesseg, uint64_t *hash);
+
+/**
+ * @brief Megnézi, hogy a változáslista pontosan azokat a cellákat tartalmazza -e, amik az elozo és az uj között különböznek.
+ * @param elozo
+ * @param uj
+ * @param fej
+ * @return 1 ha egyezik
+ */
+static int valtozaslista_helyes(Tabla *elozo, Tabla *uj, OszlopSor_Lista_Elem *fej);
+
+/**
+ * @brief Egy véletlen táblán a növekményes statisztikát generációnként összeveti a teljes táblából számolttal.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int statisztika_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy generációt lép tetszőleges szabállyal, a lehető legegyszerűbben (a szabályfüggetlen motorok ellenőrzéséhez).
+ * @param t
+ * @param sz
+ */
+static void naiv_lepes(Tabla *t, const Szabaly *sz);
+
+/**
+ * @brief Néhány nem Conway-féle szabállyal összeveti a táblázatos motort a naiv_lepes-sel.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int szabalyok_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy generációt lép Larger than Life / Generations szabállyal, cellánként a teljes szomszédságot végigszámolva.
+ * @param t
+ * @param sz
+ */
+static void naiv_ltl_lepes(Tabla *t, const Ltl_szabaly *sz);
+
+/**
+ * @brief Néhány Generations és Larger than Life szabállyal összeveti az ltl motort a naiv_ltl_lepes-sel,
+ * és ellenőrzi a szabályok beolvasását és kiírását.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int ltl_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy generációt lép B/S szabállyal tetszőleges szomszédsággal és peremmel, a szomszédok eltolásainak listájából.
+ * @param t
+ * @param sz
+ * @param szomszedsag
+ * @param perem
+ */
+static void naiv_topologia_lepes(Tabla *t, const Szabaly *sz, Szomszedsag szomszedsag, Perem perem);
+
+/**
+ * @brief Minden szomszédsággal és peremmel, néhány szabállyal összeveti a kernel motort a naiv_topologia_lepes-sel.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int kernel_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy kis leveskeresést több szálon lefuttat, és minden leves eredményét összeveti az önálló táblán,
+ * az uj_generacio-val és a Ciklus_figyelo-val kapottal.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int leves_ellenoriz(FILE *ki);
+
+/**
+ * @brief Kiteszi a katalógus-alakú mintát ('o'/'.' cellák, '/' sorhatár) a táblára, a négyzet egyik szimmetriájával transzformálva.
+ * @param t
+ * @param minta
+ * @param sor A transzformált minta bal felső sarkának sora
+ * @param oszlop A transzformált minta bal felső sarkának oszlopa
+ * @param transzformacio 0-7: a 4 tükrözés/forgatás, majd ugyanezek a főátlóra tükrözve
+ */
+static void minta_kitesz(Tabla *t, const char *minta, int sor, int oszlop, int transzformacio);
+
+/**
+ * @brief A katalógus minden objektumát minden fázisában és mind a 8 helyzetében egy objektumként kell felismernie;
+ * egy több objektumos táblán a darabszámoknak, egy kis leveskeresésben a szálankénti összegnek kell egyeznie.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int nepszamlalas_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy véletlen tábla generációit osztott memóriás gyűrűben teszi közzé, és egy külön leképezésen át visszaolvassa
+ * őket; ellenőrzi, hogy a felülírt, illetve az olvasás közben felülírt keretet az olvasó észreveszi (csak POSIX).
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int kozos_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy külön folyamatban elindítja a vezérlő szervert egy véletlen táblával, és tesztkliensekkel vezérli: a kliens
+ * tükrözött táblájának minden generációban egyeznie kell a szerverével és a helyben futtatottal, a lemaradó kliensnek
+ * pedig kulcsképkockát kell kapnia. Egy hosszú lep parancs közben a többi kliensnek is válaszolnia kell, és a saves
+ * mappán kívülre mutató mentésneveket el kell utasítania (csak POSIX).
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int szerver_ellenoriz(FILE *ki);
+
+/**
+ * @brief A tesztkliens futtatása a szkripttel; a szerver indulásáig újrapróbálja a kapcsolódást.
+ * @return mint a kliens_futtat
+ */
+static int kliens_szkript(const char *cim, const char *szkript, Kliens_eredmeny *e);
+
+/**
+ * @brief Egy véletlen táblát több munkás folyamatra osztva futtat, és összeveti a referenciával (csak POSIX).
+ * @param ki
+ * @return 1 ha egyezett
+ */
+static int elosztott_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy véletlen tábla történetében véletlen generációkra ugrik, és összeveti az előre futtatva kapott hash-ekkel;
+ * ellenőrzi a kézi módosítás utáni elvágást és a memóriakeret betartását is.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int tortenet_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy véletlen tábla néhány generációját nyers formátumban, nagyítva rögzíti, és pixelenként összeveti a táblával.
+ * @param ki
+ * @return 1 ha egyezett
+ */
+static int felvetel_ellenoriz(FILE *ki);
+
+/**
+ * @brief Ellenőrzi a tábla méretkorlátait: a memóriabecslés 32 bit fölött sem csordul túl, a túl nagy vagy érvénytelen
+ * méretet a tabla_meret_ellenoriz, az init_tabla és a tabla_betolt is elutasítja, foglalás nélkül.
+ * @param ki
+ * @return 1 ha minden rendben
+ */
+static int meret_ellenoriz(FILE *ki);
+
+/**
+ * @brief Egy növekvő táblán futó siklót egy elég nagy, rögzített táblán futóval vet össze (a hash a globális
+ * koordinátákban egyezik), egy a teljes táblát kitöltő, tehát már az első lépésben a szegélyhez érő levest egy körben
+ * kipárnázott rögzített táblán futóval, és ellenőrzi, hogy egy kis minta körül a nagy növekvő tábla összezsugorodik.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int novekvo_ellenoriz(FILE *ki);
+
+/**
+ * @brief Minden motorral összeveti a lemezen tárolt, sávonként léptetett táblát a memóriában, egyben léptetettel
+ * (cellánként, hash-re és a változások számára); a tábla magassága nem többszöröse a sávnak, így van csonka sáv is.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int lemez_ellenoriz(FILE *ki);
+
+/**
+ * @brief Több szabállyal összeveti a ritka tábla lépését a naiv lépéssel (hash, népesség, és időnként cellánként) egy
+ * csonka csempékből álló táblán, amin leves, csendéletek és a csempéken át haladó sikló is van; közben minden csempeformának
+ * elő kell fordulnia. Ellenőrzi a sűrű táblából, a mentésből és a mentésbe alakítást is.
+ * @param ki
+ * @return 1 ha minden egyezett
+ */
+static int ritka_ellenoriz(FILE *ki);
+
+/**
+ * @brief Véletlen táblákon cellánként összeveti a motort a referenciával.
+ * @param ki
+ * @param motor
+ * @return 1 ha minden egyezett
+ */
+static int motor_osszevet(FILE *ki, const Motor_leiras *motor);
+
+OszlopSor_Lista_Elem* idoblokk_4(Tabla *t){
+    return idoblokk_lepes(t, 4, 16);
+}
+
+OszlopSor_Lista_Elem* idoblokk_9(Tabla *t){
+    return idoblokk_lepes(t, 9, 7);
+}
+
+uint64_t veletlen(uint64_t *allapot){
+    uint64_t x = *allapot;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *allapot = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+void veletlen_leves(Tabla *t, uint64_t mag, int suruseg){
+    uint64_t allapot = mag ? mag : 1;
+    for(int sor=1; sor<t->m-1; sor++)
+        for(int oszlop=1; oszlop<t->sz-1; oszlop++)
+            CELLA(t, sor, oszlop) = (int)(veletlen(&allapot) % 100) < suruseg;
+    t->hash = tabla_hash(t);
+}
+
+void allas_felallit(Tabla *t, const Arany_allas *allas){
+    init_tabla(t, allas->sz, allas->m);
+    if(allas->minta == NULL){
+        veletlen_leves(t, allas->mag, 37);
+        return;
+    }
+    int sor = allas->sor, oszlop = allas->oszlop;
+    for(const char *c = allas->minta; *c != '\0'; c++){
+        if(*c == '\n'){
+            sor++;
+            oszlop = allas->oszlop;
+            continue;
+        }
+        if(*c == 'O')
+            CELLA(t, sor, oszlop) = 1;
+        oszlop++;
+    }
+    t->hash = tabla_hash(t);
+}
+
+void allas_futtat(const Arany_allas *allas, int *nepesseg, uint64_t *hash){
+    Tabla t;
+    allas_felallit(&t, allas);
+    for(int i = 0; i < allas->generaciok; i++)
+        valtozasok_felszabadit(uj_generacio(&t));
+    *nepesseg = tabla_nepesseg(&t);
+    *hash = tabla_hash(&t);
+    destroy_tabla(&t);
+}
+
+int valtozaslista_helyes(Tabla *elozo, Tabla *uj, OszlopSor_Lista_Elem *fej){
+    int kulonbozo = 0, listaban = 0;
+    for(int sor=0; sor<uj->m; sor++)
+        for(int oszlop=0; oszlop<uj->sz; oszlop++)
+            kulonbozo += CELLA(elozo, sor, oszlop) != CELLA(uj, sor, oszlop);
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next){
+        if(CELLA(elozo, iter->sor, iter->oszlop) == CELLA(uj, iter->sor, iter->oszlop))
+            return 0;
+        listaban++;
+    }
+    return kulonbozo == listaban;
+}
+
+int motor_osszevet(FILE *ki, const Motor_leiras *motor){
+    uint64_t allapot = 0x5EED5EED5EEDULL;
+    for(int tabla = 0; tabla < KERESZT_TABLAK; tabla++){
+        int sz = 8 + (int)(veletlen(&allapot) % 90);
+        int m = 8 + (int)(veletlen(&allapot) % 90);
+        int suruseg = 10 + (int)(veletlen(&allapot) % 60);
+        Tabla ref, alt, elozo;
+        init_tabla(&ref, sz, m);
+        veletlen_leves(&ref, veletlen(&allapot), suruseg);
+        tabla_masol(&alt, &ref);
+
+        for(int gen = motor->generaciok; gen <= KERESZT_GENERACIOK; gen += motor->generaciok){
+            tabla_masol(&elozo, &alt);
+            for(int i = 0; i < motor->generaciok; i++)
+                valtozasok_felszabadit(uj_generacio(&ref));
+            OszlopSor_Lista_Elem *fej = motor->lepes(&alt);
+            const char *hiba = NULL;
+            if(!valtozaslista_helyes(&elozo, &alt, fej))
+                hiba = "hibas valtozaslista";
+            else if(alt.hash != tabla_hash(&alt))
+                hiba = "a frissitett hash nem egyezik a tabla hash-evel";
+            else if(alt.generacio != ref.generacio)
+                hiba = "hibas generacio szamlalo";
+            valtozasok_felszabadit(fej);
+            destroy_tabla(&elozo);
+            if(hiba != NULL){
+                fprintf(ki, "HIBA  %s: %s (%dx%d tabla, %d. generacio)\n", motor->nev, hiba, sz, m, gen);
+                destroy_tabla(&ref);
+                destroy_tabla(&alt);
+                return 0;
+            }
+            for(int sor=0; sor<ref.m; sor++){
+                for(int oszlop=0; oszlop<ref.sz; oszlop++){
+                    if(CELLA(&ref, sor, oszlop) != CELLA(&alt, sor, oszlop)){
+                        fprintf(ki, "HIBA  %s: elteres a (%d, %d) cellaban (%dx%d tabla, %d. generacio)\n", motor->nev, sor, oszlop, sz, m, gen);
+                        destroy_tabla(&ref);
+                        destroy_tabla(&alt);
+                        return 0;
+                    }
+                }
+            }
+        }
+        destroy_tabla(&ref);
+        destroy_tabla(&alt);
+    }
+    fprintf(ki, "OK    %s: %d veletlen tabla, %d generacio, cellankent egyezik\n", motor->nev, KERESZT_TABLAK, KERESZT_GENERACIOK);
+    return 1;
+}
+
+void naiv_lepes(Tabla *t, const Szabaly *sz){
+    Tabla regi;
+    tabla_masol(&regi, t);
+    for(int sor=1; sor<t->m-1; sor++){
+        for(int oszlop=1; oszlop<t->sz-1; oszlop++){
+            int szomszedok = 0;
+            for(int di = -1; di <= 1; di++)
+                for(int dj = -1; dj <= 1; dj++)
+                    if(di || dj)
+                        szomszedok += CELLA(&regi, sor+di, oszlop+dj);
+            uint16_t maszk = CELLA(&regi, sor, oszlop) ? sz->tuleles : sz->szuletes;
+            CELLA(t, sor, oszlop) = (maszk >> szomszedok) & 1;
+        }
+    }
+    destroy_tabla(&regi);
+}
+
+int szabalyok_ellenoriz(FILE *ki){
+    static const char *szabalyok[] = {"B36/S23", "B2/S", "B3678/S34678", "B1357/S1357", "B0/S8"};
+    uint64_t allapot = 0xB5B5B5B5ULL;
+    int jo = 1;
+    for(size_t i = 0; i < sizeof(szabalyok)/sizeof(szabalyok[0]) && jo; i++){
+        Szabaly sz;
+        szabaly_beolvas(szabalyok[i], &sz);
+        lut_szabaly(&sz);
+        Tabla naiv, t;
+        init_tabla(&naiv, 17 + (int)(veletlen(&allapot) % 60), 17 + (int)(veletlen(&allapot) % 60));
+        veletlen_leves(&naiv, veletlen(&allapot), 35);
+        tabla_masol(&t, &naiv);
+        for(int gen = 1; gen <= 40 && jo; gen++){
+            naiv_lepes(&naiv, &sz);
+            valtozasok_felszabadit(lut_generacio(&t));
+            if(t.hash != tabla_hash(&naiv) || memcmp(t.g, naiv.g, (size_t)t.m * t.lepes) != 0){
+                fprintf(ki, "HIBA  lut %s: elteres a %d. generacioban\n", szabalyok[i], gen);
+                jo = 0;
+            }
+        }
+        destroy_tabla(&naiv);
+        destroy_tabla(&t);
+    }
+    lut_szabaly(motor_aktiv_szabaly());
+    if(jo)
+        fprintf(ki, "OK    lut: %d nem Conway-fele szabaly, egyezik a naiv lepessel\n", (int)(sizeof(szabalyok)/sizeof(szabalyok[0])));
+    return jo;
+}
+
+void naiv_ltl_lepes(Tabla *t, const Ltl_szabaly *sz){
+    Tabla regi;
+    tabla_masol(&regi, t);
+    int r = sz->sugar;
+    for(int sor = 1; sor < t->m - 1; sor++){
+        for(int oszlop = 1; oszlop < t->sz - 1; oszlop++){
+            int n = 0;
+            for(int di = -r; di <= r; di++){
+                for(int dj = -r; dj <= r; dj++){
+                    int i = sor + di, j = oszlop + dj;
+                    if((sz->neumann && abs(di) + abs(dj) > r) || (!sz->kozep && di == 0 && dj == 0))
+                        continue;
+                    if(i >= 0 && i < t->m && j >= 0 && j < t->sz)
+                        n += CELLA(&regi, i, j) == 1;
+                }
+            }
+            Cella c = CELLA(&regi, sor, oszlop);
+            if(c == 0)
+                c = (sz->szuletes[n >> 6] >> (n & 63)) & 1;
+            else if(c == 1)
+                c = ((sz->tuleles[n >> 6] >> (n & 63)) & 1) ? 1 : (sz->allapotok > 2 ? 2 : 0);
+            else
+                c = c + 1 < sz->allapotok ? c + 1 : 0;
+            CELLA(t, sor, oszlop) = c;
+        }
+    }
+    destroy_tabla(&regi);
+}
+
+int ltl_ellenoriz(FILE *ki){
+    static const char *szabalyok[] = {"B2/S/C3", "B2/S345/C4", "R5,C2,M1,S34..58,B34..45,NM", "R3,C4,M0,S5..12,B7..9,NN",
+                                      "R10,C3,M1,S120..210,B95..150,NM", "R7,C2,M0,S20..40,B22..31,NN"};
+    static const char *hibasak[] = {"B2/S/C1", "B9/S", "R11,C2,M0,S1..2,B1..2,NM", "R2,C2,M0,S1..2,B1..2,NX", "R2,C2,M0,S1..2,B1..2"};
+    uint64_t allapot = 0x17171717ULL;
+    int jo = 1;
+    for(size_t i = 0; i < sizeof(szabalyok)/sizeof(szabalyok[0]) && jo; i++){
+        Ltl_szabaly sz, ujra;
+        char szoveg[LTL_SZABALY_HOSSZ];
+        if(!ltl_szabaly_beolvas(szabalyok[i], &sz)){
+            fprintf(ki, "HIBA  ltl: nem olvashato be: %s\n", szabalyok[i]);
+            jo = 0;
+            break;
+        }
+        ltl_szabaly_kiir(&sz, szoveg);
+        if(strcmp(szoveg, szabalyok[i]) != 0 || !ltl_szabaly_beolvas(szoveg, &ujra) || memcmp(&sz, &ujra, sizeof(sz)) != 0){
+            fprintf(ki, "HIBA  ltl: %s kiirva %s\n", szabalyok[i], szoveg);
+            jo = 0;
+            break;
+        }
+        ltl_szabaly(&sz);
+        Tabla naiv, t;
+        init_tabla(&naiv, 30 + (int)(veletlen(&allapot) % 50), 30 + (int)(veletlen(&allapot) % 50));
+        veletlen_leves(&naiv, veletlen(&allapot), 45);
+        tabla_masol(&t, &naiv);
+        for(int gen = 1; gen <= 30 && jo; gen++){
+            Tabla elozo;
+            tabla_masol(&elozo, &t);
+            naiv_ltl_lepes(&naiv, &sz);
+            OszlopSor_Lista_Elem *fej = ltl_generacio(&t);
+            if(t.hash != tabla_hash(&naiv) || memcmp(t.g, naiv.g, (size_t)t.m * t.lepes) != 0 || !valtozaslista_helyes(&elozo, &t, fej)){
+                fprintf(ki, "HIBA  ltl %s: elteres a %d. generacioban\n", szabalyok[i], gen);
+                jo = 0;
+            }
+            valtozasok_felszabadit(fej);
+            destroy_tabla(&elozo);
+        }
+        destroy_tabla(&naiv);
+        destroy_tabla(&t);
+    }
+    for(size_t i = 0; i < sizeof(hibasak)/sizeof(hibasak[0]) && jo; i++){
+        Ltl_szabaly sz;
+        if(ltl_szabaly_beolvas(hibasak[i], &sz)){
+            fprintf(ki, "HIBA  ltl: hibas szabaly elfogadva: %s\n", hibasak[i]);
+            jo = 0;
+        }
+    }
+    // Visszaáll a motor szabályára (az ltl a motorok összevetésében a Conway-féllel fut)
+    Ltl_szabaly eredeti;
+    ltl_szabaly_bs(motor_aktiv_szabaly(), &eredeti);
+    ltl_szabaly(motor_aktiv_ltl() != NULL ? motor_aktiv_ltl() : &eredeti);
+    if(jo)
+        fprintf(ki, "OK    ltl: %d Generations / Larger than Life szabaly, egyezik a naiv lepessel\n", (int)(sizeof(szabalyok)/sizeof(szabalyok[0])));
+    return jo;
+}
+
+void naiv_topologia_lepes(Tabla *t, const Szabaly *sz, Szomszedsag szomszedsag, Perem perem){
+    static const int eltolasok[3][8][2] = {
+        {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}},
+        {{-1, 0}, {0, -1}, {0, 1}, {1, 0}},
+        {{-1, -1}, {-1, 0}, {0, -1}, {0, 1}, {1, 0}, {1, 1}},
+    };
+    static const int db[3] = {8, 4, 6};
+    Tabla regi;
+    tabla_masol(&regi, t);
+    int m = t->m - 2, szel = t->sz - 2;
+    for(int sor = 1; sor <= m; sor++){
+        for(int oszlop = 1; oszlop <= szel; oszlop++){
+            int szomszedok = 0;
+            for(int i = 0; i < db[szomszedsag]; i++){
+                int s = sor + eltolasok[szomszedsag][i][0], o = oszlop + eltolasok[szomszedsag][i][1];
+                if(perem == p_torusz){
+                    s = (s - 1 + m) % m + 1;
+                    o = (o - 1 + szel) % szel + 1;
+                }
+                szomszedok += CELLA(&regi, s, o);
+            }
+            uint16_t maszk = CELLA(&regi, sor, oszlop) ? sz->tuleles : sz->szuletes;
+            CELLA(t, sor, oszlop) = (maszk >> szomszedok) & 1;
+        }
+    }
+    destroy_tabla(&regi);
+}
+
+int kernel_ellenoriz(FILE *ki){
+    static const char *szabalyok[] = {"B3/S23", "B2/S34", "B1/S012"};
+    uint64_t allapot = 0xC0FFEEULL;
+    int jo = 1, esetek = 0;
+    for(int szomszedsag = sz_moore; szomszedsag <= sz_hatszog && jo; szomszedsag++){
+        for(int perem = p_halott; perem <= p_torusz && jo; perem++){
+            for(size_t i = 0; i < sizeof(szabalyok)/sizeof(szabalyok[0]) && jo; i++){
+                Szabaly sz;
+                szabaly_beolvas(szabalyok[i], &sz);
+                kernel_szabaly(&sz);
+                kernel_beallit((Szomszedsag)szomszedsag, (Perem)perem);
+                Tabla naiv, t;
+                init_tabla(&naiv, 1 + (int)(veletlen(&allapot) % 50), 1 + (int)(veletlen(&allapot) % 50));
+                veletlen_leves(&naiv, veletlen(&allapot), 30);
+                tabla_masol(&t, &naiv);
+                for(int gen = 1; gen <= 40 && jo; gen++){
+                    Tabla elozo;
+                    tabla_masol(&elozo, &t);
+                    naiv_topologia_lepes(&naiv, &sz, (Szomszedsag)szomszedsag, (Perem)perem);
+                    OszlopSor_Lista_Elem *fej = kernel_generacio(&t);
+                    // A szegély (a kov-é is) a tórusz után is halott marad
+                    int szegely_halott = 1;
+                    for(int sor = 0; sor < t.m; sor++)
+                        szegely_halott &= !CELLA(&t, sor, 0) && !CELLA(&t, sor, t.sz - 1) && !t.kov[(size_t)sor * t.lepes] &&
+                                          !t.kov[(size_t)sor * t.lepes + t.sz - 1];
+                    if(t.hash != tabla_hash(&naiv) || memcmp(t.g, naiv.g, (size_t)t.m * t.lepes) != 0 ||
+                       !valtozaslista_helyes(&elozo, &t, fej) || !szegely_halott){
+                        fprintf(ki, "HIBA  kernel %s%s %s: elteres a %d. generacioban\n", szomszedsag_nev((Szomszedsag)szomszedsag),
+                                perem == p_torusz ? " torusz" : "", szabalyok[i], gen);
+                        jo = 0;
+                    }
+                    valtozasok_felszabadit(fej);
+                    destroy_tabla(&elozo);
+                }
+                destroy_tabla(&naiv);
+                destroy_tabla(&t);
+                esetek++;
+            }
+        }
+    }
+    kernel_beallit(sz_moore, p_halott);
+    kernel_szabaly(motor_aktiv_szabaly());
+    if(jo)
+        fprintf(ki, "OK    kernel: %d szomszedsag/perem/szabaly eset, egyezik a naiv lepessel\n", esetek);
+    return jo;
+}
+
+int leves_ellenoriz(FILE *ki){
+    Leves_beallitas b = {40, 48, 12, 40, 7, 3, 5, 1500, 0};
+    Szabaly conway = SZABALY_CONWAY;
+    Leves_eredmeny *eredmenyek = malloc(b.db * sizeof(Leves_eredmeny));
+    Leves_osszesites ossz;
+    int jo = leves_kereses(&b, &conway, eredmenyek, NULL, &ossz) && ossz.db == b.db;
+    for(long long i = 0; i < b.db && jo; i++){
+        Tabla t;
+        Ciklus_figyelo cf;
+        if(!leves_tabla(&t, &b, i)){
+            fprintf(ki, "HIBA  leves: elfogyott a memoria a %lld. leves tablajahoz\n", i);
+            jo = 0;
+            break;
+        }
+        ciklus_init(&cf);
+        ciklus_frissit(&cf, &t);
+        while(cf.periodus == 0 && t.generacio < b.max_generacio){
+            valtozasok_felszabadit(uj_generacio(&t));
+            ciklus_frissit(&cf, &t);
+        }
+        const Leves_eredmeny *e = &eredmenyek[i];
+        if(e->sorszam != i || e->periodus != cf.periodus || e->kezdet != (cf.periodus ? cf.kezdet : t.generacio) ||
+           e->nepesseg != tabla_nepesseg(&t) || e->hash != t.hash){
+            fprintf(ki, "HIBA  leves: a %lld. leves eredmenye elter (periodus %d/%lld, kezdet %d/%lld)\n", i, e->periodus, cf.periodus,
+                    e->kezdet, cf.kezdet);
+            jo = 0;
+        }
+        destroy_tabla(&t);
+    }
+    free(eredmenyek);
+    if(jo)
+        fprintf(ki, "OK    leves: %lld leves 3 szalon, egyezik az onallo tablan futtatottal\n", b.db);
+    return jo;
+}
+
+void minta_kitesz(Tabla *t, const char *minta, int sor, int oszlop, int transzformacio){
+    int w = 0, h = 1, x = 0;
+    for(const char *c = minta; *c; c++){
+        if(*c == '/'){
+            h++;
+            x = 0;
+        }
+        else if(++x > w){
+            w = x;
+        }
+    }
+    x = 0;
+    int y = 0;
+    for(const char *c = minta; *c; c++){
+        if(*c == '/'){
+            y++;
+            x = 0;
+            continue;
+        }
+        int tx = (transzformacio & 1) ? w - 1 - x : x;
+        int ty = (transzformacio & 2) ? h - 1 - y : y;
+        if(transzformacio & 4){
+            int csere = tx;
+            tx = ty;
+            ty = csere;
+        }
+        CELLA(t, sor + ty, oszlop + tx) = *c == 'o';
+        x++;
+    }
+}
+
+int nepszamlalas_ellenoriz(FILE *ki){
+    int db, jo = 1, esetek = 0;
+    const Katalogus_elem *katalogus = nepszamlalas_katalogus(&db);
+    Nepszamlalo sz;
+    if(!nepszamlalo_init(&sz)){
+        fprintf(ki, "HIBA  nepszamlalas: elfogyott a memoria a katalogus felepitesekor\n");
+        nepszamlalo_torol(&sz);
+        return 0;
+    }
+    for(int k = 0; k < db && jo; k++){
+        for(int tr = 0; tr < 8 && jo; tr++){
+            // Akkora margóval, hogy az űrhajó se érje el a szegélyt egy periódus alatt
+            Tabla t;
+            init_tabla(&t, 13 + 2 * (katalogus[k].periodus + 2), 13 + 2 * (katalogus[k].periodus + 2));
+            memset(t.g, 0, (size_t)t.m * t.lepes);
+            memset(t.kov, 0, (size_t)t.m * t.lepes);
+            minta_kitesz(&t, katalogus[k].minta, katalogus[k].periodus + 3, katalogus[k].periodus + 3, tr);
+            t.hash = tabla_hash(&t);
+            for(int fazis = 0; fazis < katalogus[k].periodus && jo; fazis++){
+                Nepszamlalas n;
+                nepszamlalas_init(&n);
+                nepszamlalas_tabla(&sz, &t, &n);
+                esetek++;
+                if(n.objektumok != 1 || n.db[k] != 1){
+                    fprintf(ki, "HIBA  nepszamlalas: %s (%d. helyzet, %d. fazis) %lld objektum, %lld ismeretlen\n", katalogus[k].nev,
+                            tr, fazis, n.objektumok, n.ismeretlen);
+                    jo = 0;
+                }
+                valtozasok_felszabadit(uj_generacio(&t));
+            }
+            destroy_tabla(&t);
+        }
+    }
+
+    // Több objektum egy táblán, néhány generáció múlva is (a pentadekatlon két fázisa szétesik, azt is egyben kell látnia)
+    if(jo){
+        static const struct{ const char *nev; int sor, oszlop, tr; } elrendezes[] = {
+            {"blokk", 3, 3, 0}, {"blokk", 3, 60, 0}, {"siklo", 40, 40, 5}, {"villogo", 10, 20, 4}, {"pulzar", 20, 5, 0},
+            {"hajo", 70, 70, 3}, {"pentadekatlon", 60, 10, 4}, {"nehez urhajo", 5, 35, 1}, {"jelzofeny", 45, 70, 2},
+        };
+        int ne = (int)(sizeof(elrendezes) / sizeof(elrendezes[0]));
+        long long elvart[NEPSZAMLALAS_KATALOGUS_MAX] = {0};
+        Tabla t;
+        init_tabla(&t, 90, 90);
+        memset(t.g, 0, (size_t)t.m * t.lepes);
+        memset(t.kov, 0, (size_t)t.m * t.lepes);
+        for(int i = 0; i < ne; i++){
+            for(int k = 0; k < db; k++){
+                if(strcmp(katalogus[k].nev, elrendezes[i].nev) == 0){
+                    minta_kitesz(&t, katalogus[k].minta, elrendezes[i].sor, elrendezes[i].oszlop, elrendezes[i].tr);
+                    elvart[k]++;
+                }
+            }
+        }
+        // Egy ismeretlen alakzat (R-pentomino) is, ami a léptetés alatt sem ér el senkit
+        minta_kitesz(&t, ".oo/oo./.o.", 78, 50, 0);
+        t.hash = tabla_hash(&t);
+        for(int gen = 0; gen < 6 && jo; gen++){
+            Nepszamlalas n;
+            nepszamlalas_init(&n);
+            nepszamlalas_tabla(&sz, &t, &n);
+            esetek++;
+            jo = n.objektumok == ne + 1 && n.ismeretlen == 1;
+            for(int k = 0; k < db; k++)
+                jo = jo && n.db[k] == elvart[k];
+            if(!jo)
+                fprintf(ki, "HIBA  nepszamlalas: a %d. generacioban %lld objektum (%d az elvart), %lld ismeretlen\n", gen,
+                        n.objektumok, ne + 1, n.ismeretlen);
+            valtozasok_felszabadit(uj_generacio(&t));
+        }
+        destroy_tabla(&t);
+    }
+
+    // A leveskeresés szálankénti népszámlálásának összege egyezik az önálló táblákon számolttal
+    if(jo){
+        Leves_beallitas b = {40, 48, 12, 40, 11, 3, 5, 1500, 1};
+        Szabaly conway = SZABALY_CONWAY;
+        Leves_eredmeny *eredmenyek = malloc(b.db * sizeof(Leves_eredmeny));
+        Leves_osszesites ossz;
+        Nepszamlalas osszeg;
+        nepszamlalas_init(&osszeg);
+        jo = leves_kereses(&b, &conway, eredmenyek, NULL, &ossz);
+        for(long long i = 0; i < b.db && jo; i++){
+            Tabla t;
+            if(!leves_tabla(&t, &b, i)){
+                jo = 0;
+                break;
+            }
+            while(t.generacio < eredmenyek[i].kezdet)
+                valtozasok_felszabadit(uj_generacio(&t));
+            nepszamlalas_tabla(&sz, &t, &osszeg);
+            destroy_tabla(&t);
+        }
+        jo = jo && memcmp(&osszeg, &ossz.nepszamlalas, sizeof(osszeg)) == 0 && osszeg.objektumok > 0;
+        if(!jo)
+            fprintf(ki, "HIBA  nepszamlalas: a leveskereses nepszamlalasa elter (%lld/%lld objektum)\n", ossz.nepszamlalas.objektumok,
+                    osszeg.objektumok);
+        free(eredmenyek);
+    }
+    nepszamlalo_torol(&sz);
+    if(jo)
+        fprintf(ki, "OK    nepszamlalas: %d objektum minden fazisa es helyzete, %d eset, leveskereses 3 szalon\n", db, esetek);
+    return jo;
+}
+
+int kozos_ellenoriz(FILE *ki){
+#ifdef _WIN32
+    fprintf(ki, "KIHAGYVA kozos: csak POSIX rendszeren\n");
+    return 1;
+#else
+    char nev[64];
+    sprintf(nev, "/gol_ellenorzes_%d", (int)getpid());
+    const int rekeszek = 4, generaciok = 30;
+    Tabla t, olvasott;
+    init_tabla(&t, 83, 61);
+    veletlen_leves(&t, 1234, 35);
+    init_tabla(&olvasott, 83, 61);
+    memset(olvasott.g, 0, (size_t)olvasott.m * olvasott.lepes);
+    memset(olvasott.kov, 0, (size_t)olvasott.m * olvasott.lepes);
+    Kozos_gyuru iro, olvaso;
+    if(!kozos_indit(&iro, nev, &t, rekeszek)){
+        fprintf(ki, "HIBA  kozos: nem hozhato letre az osztott memoria\n");
+        destroy_tabla(&t);
+        destroy_tabla(&olvasott);
+        return 0;
+    }
+    int jo = kozos_csatlakozik(&olvaso, nev) && olvaso.fejlec->sz == 83 && olvaso.fejlec->m == 61;
+    for(int gen = 0; gen <= generaciok && jo; gen++){
+        if(gen > 0)
+            valtozasok_felszabadit(uj_generacio(&t));
+        kozos_kozzetesz(&iro, &t);
+        Kozos_keret k;
+        jo = kozos_olvas(&olvaso, gen + 1, &olvasott, &k) && k.generacio == t.generacio && k.hash == t.hash &&
+             k.nepesseg == (uint64_t)tabla_nepesseg(&t) && olvaso.fejlec->kozzetett == (uint32_t)gen + 1;
+        for(int i = 0; i < t.m * t.lepes && jo; i++)
+            jo = olvasott.g[i] == (t.g[i] == 1);
+        if(!jo)
+            fprintf(ki, "HIBA  kozos: a %d. generacio kerete elter\n", gen);
+    }
+    if(jo){
+        // A gyűrűben csak az utolsó rekeszek darab keret van meg
+        Kozos_keret k;
+        uint32_t utolso = generaciok + 1;
+        jo = !kozos_olvas(&olvaso, utolso - rekeszek, &olvasott, &k) && kozos_olvas(&olvaso, utolso - rekeszek + 1, &olvasott, &k) &&
+             !kozos_olvas(&olvaso, utolso + 1, &olvasott, &k);
+        // Az olvasás közben felülírt keret érvénytelen
+        uint32_t szamlalo;
+        const Kozos_keret *kk = kozos_olvasas_kezd(&olvaso, utolso, &szamlalo);
+        jo = jo && kk != NULL && kk->sorszam == utolso;
+        for(int i = 0; i < rekeszek && jo; i++)
+            kozos_kozzetesz(&iro, &t);
+        jo = jo && !kozos_olvasas_vege(kk, szamlalo);
+        if(!jo)
+            fprintf(ki, "HIBA  kozos: a felulirt keretet nem vette eszre az olvaso\n");
+    }
+    kozos_leallit(&iro);
+    jo = jo && olvaso.fejlec->lezarva;
+    kozos_lecsatlakozik(&olvaso);
+    destroy_tabla(&t);
+    destroy_tabla(&olvasott);
+    if(jo)
+        fprintf(ki, "OK    kozos: %d generacio, %d rekeszes gyuru, felulirt keretek eszlelve\n", generaciok + 1, rekeszek);
+    return jo;
+#endif
+}
+
+int kliens_szkript(const char *cim, const char *szkript, Kliens_eredmeny *e){
+#ifdef _WIN32
+    (void)cim; (void)szkript; (void)e;
+    return 0;
+#else
+    FILE *be = tmpfile();
+    if(be == NULL)
+        return 0;
+    fputs(szkript, be);
+    int sikeres = 0;
+    for(int i = 0; i < 300 && !sikeres; i++){
+        rewind(be);
+        sikeres = kliens_futtat(cim, be, NULL, e);
+        if(!sikeres && e->szerver_generacio == 0 && e->kulcsok == 0)
+            SDL_Delay(10);
+        else
+            break;
+    }
+    fclose(be);
+    return sikeres;
+#endif
+}
+
+int szerver_ellenoriz(FILE *ki){
+#ifdef _WIN32
+    fprintf(ki, "KIHAGYVA szerver: csak POSIX rendszeren\n");
+    return 1;
+#else
+    char fajlnev[] = "/tmp/gol_ellenorzes_XXXXXX";
+    int fd = mkstemp(fajlnev);
+    if(fd < 0){
+        fprintf(ki, "HIBA  szerver: nem hozhato letre ideiglenes fajl\n");
+        return 0;
+    }
+    close(fd);
+    char cim[64];
+    sprintf(cim, "unix:/tmp/gol_szerver_%d.sock", (int)getpid());
+    Tabla t;
+    init_tabla(&t, 256, 256);
+    veletlen_leves(&t, 4242, 35);
+    int jo = tabla_ment(fajlnev, &t);
+    pid_t pid = jo ? fork() : -1;
+    if(pid == 0)
+        _exit(szerver_futtat(cim, fajlnev) ? 0 : 1);
+    Kliens_eredmeny e1, e2, e3, e4;
+    memset(&e1, 0, sizeof(e1));
+    memset(&e2, 0, sizeof(e2));
+    memset(&e4, 0, sizeof(e4));
+    jo = jo && pid > 0 &&
+         kliens_szkript(cim, "feliratkozas\nlep 40\nszabaly B36/S23\nlep 25\nsebesseg 3000\nindit\nvarj 120\nmegallit\nallapot\n", &e1);
+    // A lemaradó kliens: amíg alszik, a szerver teljes sebességgel fut
+    jo = jo && kliens_szkript(cim, "feliratkozas\nszabaly B3/S23\nsebesseg 0\nindit\nalszik 500\nmegallit\n", &e2);
+    // Egy másik folyamat szinte végtelen lep parancsa közben is válaszol, és nem enged a saves mappán kívülre
+    pid_t lepo = jo ? fork() : -1;
+    if(lepo == 0){
+        Kliens_eredmeny e;
+        kliens_szkript(cim, "lep 1000000000\n", &e);
+        _exit(0);
+    }
+    SDL_Delay(200);
+    jo = jo && lepo > 0 &&
+         kliens_szkript(cim, "allapot\nbetolt ../gol_ellenorzes\nment /tmp/gol_ellenorzes\nment a\\b\nbetolt \n", &e4);
+    int lepett = jo && e4.szerver_generacio > e2.szerver_generacio && e4.elutasitott == 4;
+    if(pid > 0){
+        kliens_szkript(cim, "leallit\n", &e3);
+        int statusz;
+        jo = jo && waitpid(pid, &statusz, 0) == pid && WIFEXITED(statusz) && WEXITSTATUS(statusz) == 0;
+    }
+    if(lepo > 0)
+        waitpid(lepo, NULL, 0);
+    remove(fajlnev);
+    if(jo){
+        // Helyben ugyanazok a lépések
+        Szabaly conway = SZABALY_CONWAY, b36;
+        szabaly_beolvas("B36/S23", &b36);
+        for(int i = 0; i < 40; i++)
+            valtozasok_felszabadit(motor_lepes(&t));
+        motor_szabaly(&b36);
+        while(t.generacio < e1.szerver_generacio)
+            valtozasok_felszabadit(motor_lepes(&t));
+        motor_szabaly(&conway);
+        uint64_t hash1 = t.hash;
+        while(t.generacio < e2.szerver_generacio)
+            valtozasok_felszabadit(motor_lepes(&t));
+        jo = e1.hibak == 0 && e1.kulcsok >= 1 && e1.generacio == e1.szerver_generacio &&
+             e1.hash == e1.szerver_hash && e1.hash == hash1 && e1.elutasitott == 0;
+        if(!jo)
+            fprintf(ki, "HIBA  szerver: az elso kliens tukre elter (%lld/%lld generacio, %lld hiba)\n", e1.generacio,
+                    e1.szerver_generacio, e1.hibak);
+        jo = jo && e2.hibak == 0 && e2.kulcsok >= 2 && e2.generacio == e2.szerver_generacio && e2.hash == e2.szerver_hash &&
+             e2.hash == t.hash;
+        if(!jo)
+            fprintf(ki, "HIBA  szerver: a lemarado kliens tukre elter (%lld/%lld generacio, %lld kulcskepkocka, %lld hiba)\n",
+                    e2.generacio, e2.szerver_generacio, e2.kulcsok, e2.hibak);
+        if(jo && !lepett)
+            fprintf(ki, "HIBA  szerver: a lep kozben nem valaszolt (%lld. generacio), vagy %lld mentesnevet utasitott el a 4-bol\n",
+                    e4.szerver_generacio, e4.elutasitott);
+        jo = jo && lepett;
+    }
+    else{
+        fprintf(ki, "HIBA  szerver: nem sikerult a szerverrel beszelni\n");
+    }
+    destroy_tabla(&t);
+    if(jo)
+        fprintf(ki, "OK    szerver: %lld + %lld valtozas, a lemarado kliens %lld kulcskepkockat kapott, a tukrok egyeztek; "
+                "lep kozben is valaszolt, a mentesnevek korlatozva\n", e1.deltak, e2.deltak, e2.kulcsok);
+    return jo;
+#endif
+}
+
+int elosztott_ellenoriz(FILE *ki){
+#ifdef _WIN32
+    fprintf(ki, "KIHAGYVA elosztott: csak POSIX rendszeren\n");
+    return 1;
+#else
+    char fajlnev[] = "/tmp/gol_ellenorzes_XXXXXX";
+    int fd = mkstemp(fajlnev);
+    if(fd < 0){
+        fprintf(ki, "HIBA  elosztott: nem hozhato letre ideiglenes fajl\n");
+        return 0;
+    }
+    close(fd);
+    Tabla t;
+    init_tabla(&t, 83, 61);
+    veletlen_leves(&t, 99, 33);
+    int jo = tabla_ment(fajlnev, &t);
+    long long szuletes = 0, halalozas = 0;
+    for(int gen = 0; gen < 90; gen++){
+        OszlopSor_Lista_Elem *fej = uj_generacio(&t);
+        for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next){
+            if(CELLA(&t, iter->sor, iter->oszlop)) szuletes++;
+            else halalozas++;
+        }
+        valtozasok_felszabadit(fej);
+    }
+    Elosztott_eredmeny e;
+    jo = jo && elosztott_futtat(fajlnev, 90, 5, NULL, &e);
+    remove(fajlnev);
+    jo = jo && e.generacio == t.generacio && e.hash == t.hash && e.nepesseg == tabla_nepesseg(&t) &&
+         e.ossz_szuletes == szuletes && e.ossz_halalozas == halalozas;
+    destroy_tabla(&t);
+    if(jo)
+        fprintf(ki, "OK    elosztott: 5 munkas, 90 generacio, egyezik a referenciaval\n");
+    else
+        fprintf(ki, "HIBA  elosztott: elter a referenciatol\n");
+    return jo;
+#endif
+}
+
+int tortenet_ellenoriz(FILE *ki){
+    enum {GENERACIOK = 200};
+    uint64_t hashek[GENERACIOK + 1];
+    uint64_t allapot = 0x7047ULL;
+    Tabla t;
+    init_tabla(&t, 70, 50);
+    veletlen_leves(&t, 36, 35);
+    Tortenet tr;
+    tortenet_init(&tr, &t, 16, (size_t)1 << 24);
+    hashek[0] = t.hash;
+    for(int gen = 1; gen <= GENERACIOK; gen++){
+        OszlopSor_Lista_Elem *fej = uj_generacio(&t);
+        tortenet_rogzit(&tr, &t, fej);
+        valtozasok_felszabadit(fej);
+        hashek[gen] = t.hash;
+    }
+    int jo = tortenet_elso(&tr) == 0 && tortenet_utolso(&tr) == GENERACIOK, siker;
+    for(int i = 0; i < 100 && jo; i++){
+        long long cel = (long long)(veletlen(&allapot) % (GENERACIOK + 1));
+        valtozasok_felszabadit(tortenet_ugras(&tr, &t, cel, &siker));
+        jo = siker && t.generacio == cel && t.hash == hashek[cel] && t.hash == tabla_hash(&t);
+    }
+
+    // Visszalépés, kézi módosítás, majd új ág: a régi ág a módosítás előtti generációig marad meg
+    valtozasok_felszabadit(tortenet_ugras(&tr, &t, 50, &siker));
+    flip(&t, 10, 10);
+    tortenet_csonkit(&tr, &t);
+    uint64_t ag[11];
+    ag[0] = t.hash;
+    for(int gen = 1; gen <= 10; gen++){
+        OszlopSor_Lista_Elem *fej = uj_generacio(&t);
+        tortenet_rogzit(&tr, &t, fej);
+        valtozasok_felszabadit(fej);
+        ag[gen] = t.hash;
+    }
+    jo = jo && tortenet_utolso(&tr) == 60;
+    valtozasok_felszabadit(tortenet_ugras(&tr, &t, 49, &siker));
+    jo = jo && siker && t.hash == hashek[49] && t.hash == tabla_hash(&t);
+    valtozasok_felszabadit(tortenet_ugras(&tr, &t, 55, &siker));
+    jo = jo && siker && t.hash == ag[5] && t.hash == tabla_hash(&t);
+    tortenet_torol(&tr);
+
+    // Kis kerettel a legrégebbi szakaszok törlődnek, oda már nem lehet ugrani
+    tortenet_init(&tr, &t, 16, 16384);
+    for(int gen = 0; gen < 100; gen++){
+        OszlopSor_Lista_Elem *fej = uj_generacio(&t);
+        tortenet_rogzit(&tr, &t, fej);
+        valtozasok_felszabadit(fej);
+    }
+    uint64_t vegso = t.hash;
+    valtozasok_felszabadit(tortenet_ugras(&tr, &t, 55, &siker));
+    jo = jo && !siker && t.hash == vegso && tortenet_elso(&tr) > 55 && tr.db > 1 && tr.hasznalt <= 16384;
+    tortenet_torol(&tr);
+
+    // Ha már a kulcskép sem fér a keretbe, a történet kikapcsolva jön létre, és a tábla attól még léptethető
+    tortenet_init(&tr, &t, 16, tortenet_memoria_becsles(t.sz - 2, t.m - 2) - 1);
+    jo = jo && !tortenet_aktiv(&tr) && tortenet_elso(&tr) == -1 && tortenet_utolso(&tr) == -1;
+    OszlopSor_Lista_Elem *fej = uj_generacio(&t);
+    tortenet_rogzit(&tr, &t, fej);
+    valtozasok_felszabadit(fej);
+    tortenet_csonkit(&tr, &t);
+    valtozasok_felszabadit(tortenet_ugras(&tr, &t, t.generacio - 1, &siker));
+    jo = jo && !siker && !tortenet_aktiv(&tr) && tr.hasznalt == 0;
+    tortenet_torol(&tr);
+    destroy_tabla(&t);
+    if(jo)
+        fprintf(ki, "OK    tortenet: %d generacio, ugrasok, elvagas es memoriakeret rendben\n", GENERACIOK);
+    else
+        fprintf(ki, "HIBA  tortenet: elteres ugras utan\n");
+    return jo;
+}
+
+int meret_ellenoriz(FILE *ki){
+    const char *fajlnev = "./gol_meret_ellenorzes.txt";
+    char uzenet[256] = "";
+    size_t nagy = tabla_memoria_becsles(100000, 100000, tar_suru, NULL);
+    // Két puffer, soronként 64-re kerekítve: a 10^10 cellás tábla becslése nem csordulhat túl 32 biten
+    int jo = nagy == 2 * ((size_t)100002 * memoria_kerekit(100002) + 2 * MEMORIA_IGAZITAS);
+    jo = jo && tabla_memoria_becsles(0, 5, tar_suru, NULL) == 0 && tabla_memoria_becsles(5, -1, tar_suru, NULL) == 0 &&
+         tabla_memoria_becsles((long long)TABLA_MAX_OLDAL + 1, 1, tar_suru, NULL) == 0;
+    jo = jo && tabla_meret_ellenoriz(100, 100, tar_suru, 0, uzenet, sizeof(uzenet));
+    jo = jo && !tabla_meret_ellenoriz(TABLA_MAX_OLDAL, TABLA_MAX_OLDAL, tar_suru, 0, uzenet, sizeof(uzenet)) && uzenet[0] != '\0';
+    // A kísérő szerkezetek is a keretbe számítanak
+    size_t fizikai = memoria_fizikai();
+    jo = jo && (fizikai == 0 || !tabla_meret_ellenoriz(100, 100, tar_suru, fizikai, uzenet, sizeof(uzenet)));
+    // A népszámlálás indexei int-ek: a 2^31 cellánál nagyobb rács nem számlálható
+    jo = jo && nepszamlalas_memoria_becsles(100, 100) == (size_t)102 * memoria_kerekit(102) * sizeof(int) &&
+         nepszamlalas_memoria_becsles(50000, 50000) == 0;
+
+    Tabla t;
+    jo = jo && !init_tabla(&t, 0, 10) && t.g == NULL && !init_tabla(&t, TABLA_MAX_OLDAL + 1, 10) && t.g == NULL;
+
+    // Az int-be nem férő méretű mentés olvasás előtt elutasítódik
+    FILE *fp = fopen(fajlnev, "wt");
+    if(fp != NULL){
+        fprintf(fp, "0.1\n3000000002 5\n");
+        fclose(fp);
+        jo = jo && !tabla_betolt(fajlnev, &t);
+        remove(fajlnev);
+    }
+    else
+        jo = 0;
+
+    if(jo)
+        fprintf(ki, "OK    meret: 100000x100000 becslese %llu MB, a tul nagy tablak elutasitva\n", (unsigned long long)(nagy >> 20));
+    else
+        fprintf(ki, "HIBA  meret: a meretkorlatok nem mukodnek\n");
+    return jo;
+}
+
+int novekvo_ellenoriz(FILE *ki){
+    enum {GENERACIOK = 800, ZSUGORITAS_GENERACIOK = 300, NAGY = 400, LEVES = 24, PARNA = 150, LEVES_GENERACIOK = 250};
+    // A 3. transzformáció a délkelet felé haladó siklót északnyugat felé fordítja
+    const char *siklo = ".o./..o/ooo";
+    Tabla n, r;
+    Novekvo nv;
+    init_tabla(&n, 20, 20);
+    memset(n.g, 0, (size_t)n.lepes * n.m * sizeof(Cella));
+    minta_kitesz(&n, siklo, 10, 10, 3);
+    n.hash = tabla_hash(&n);
+    init_tabla(&r, 320, 320);
+    memset(r.g, 0, (size_t)r.lepes * r.m * sizeof(Cella));
+    r.eltolas_sor = r.eltolas_oszlop = -250;
+    minta_kitesz(&r, siklo, 260, 260, 3);
+    r.hash = tabla_hash(&r);
+
+    int jo = n.hash == r.hash;
+    novekvo_init(&nv, &n);
+    for(int g = 0; g < GENERACIOK; g++){
+        valtozasok_felszabadit(motor_lepes(&n));
+        valtozasok_felszabadit(motor_lepes(&r));
+        novekvo_igazit(&nv, &n);
+        if(n.hash != r.hash)
+            jo = 0;
+    }
+    jo = jo && tabla_nepesseg(&n) == 5 && nv.novelesek > 0 && n.eltolas_sor < 0 && n.eltolas_oszlop < 0;
+    long long novelesek = nv.novelesek;
+    int szel = n.sz - 2, mag = n.m - 2;
+    destroy_tabla(&n);
+    destroy_tabla(&r);
+
+    // A szegélyig érő leves: a tábla már az első lépés előtt nő, különben a szegély menti születések elvesznének
+    init_tabla(&n, LEVES, LEVES);
+    veletlen_leves(&n, 4711, 45);
+    init_tabla(&r, LEVES + 2 * PARNA, LEVES + 2 * PARNA);
+    memset(r.g, 0, (size_t)r.lepes * r.m * sizeof(Cella));
+    r.eltolas_sor = r.eltolas_oszlop = -PARNA;
+    for(int sor = 1; sor <= LEVES; sor++)
+        for(int oszlop = 1; oszlop <= LEVES; oszlop++)
+            CELLA(&r, sor + PARNA, oszlop + PARNA) = CELLA(&n, sor, oszlop);
+    r.hash = tabla_hash(&r);
+    novekvo_init(&nv, &n);
+    jo = jo && n.hash == r.hash && novekvo_nov(&nv, &n);
+    for(int g = 0; g < LEVES_GENERACIOK && jo; g++){
+        valtozasok_felszabadit(motor_lepes(&n));
+        valtozasok_felszabadit(motor_lepes(&r));
+        novekvo_igazit(&nv, &n);
+        jo = n.hash == r.hash && tabla_nepesseg(&n) == tabla_nepesseg(&r);
+    }
+    destroy_tabla(&n);
+    destroy_tabla(&r);
+
+    // Egy villogó egy nagy tábla közepén: a növekvő tábla zsugorodjon, és egyezzen a rögzített táblával
+    init_tabla(&n, NAGY, NAGY);
+    memset(n.g, 0, (size_t)n.lepes * n.m * sizeof(Cella));
+    minta_kitesz(&n, "ooo", NAGY / 2, NAGY / 2, 0);
+    n.hash = tabla_hash(&n);
+    tabla_masol(&r, &n);
+    novekvo_init(&nv, &n);
+    for(int g = 0; g < ZSUGORITAS_GENERACIOK; g++){
+        valtozasok_felszabadit(motor_lepes(&n));
+        valtozasok_felszabadit(motor_lepes(&r));
+        novekvo_igazit(&nv, &n);
+    }
+    jo = jo && nv.zsugoritasok > 0 && n.sz - 2 < NAGY && n.m - 2 < NAGY && n.hash == r.hash && tabla_nepesseg(&n) == 3;
+    int zsugoritott = n.sz - 2;
+    destroy_tabla(&n);
+    destroy_tabla(&r);
+
+    if(jo)
+        fprintf(ki, "OK    novekvo: siklo %d generacio, %lld noveles, %dx%d tabla; szegelyig ero leves %d generacio; zsugoritas %d-rol %d-ra\n",
+                GENERACIOK, novelesek, szel, mag, LEVES_GENERACIOK, NAGY, zsugoritott);
+    else
+        fprintf(ki, "HIBA  novekvo: a novekvo tabla elter a rogzitettol\n");
+    return jo;
+}
+
+int lemez_ellenoriz(FILE *ki){
+    enum {GENERACIOK = 40, SZELESSEG = 300, MAGASSAG = 3 * LEMEZ_SAV + 100};
+#ifdef _WIN32
+    // Windowson nincs fájlra leképezett tábla
+    fprintf(ki, "OK    lemez: ezen a rendszeren nem erheto el\n");
+    return 1;
+#endif
+    const char *eredeti = motor_aktiv()->nev;
+    int jo = memoria_fajl_konyvtar("."), db, motorral = 0;
+    const Motor *lista = motor_lista(&db);
+    for(int i = 0; i < db && jo; i++){
+        if(!motor_valaszt(lista[i].nev))
+            continue;
+        Tabla l, s;
+        tabla_tarolas_beallit(tar_lemez);
+        jo = init_tabla(&l, SZELESSEG, MAGASSAG);
+        tabla_tarolas_beallit(tar_suru);
+        if(!jo)
+            break;
+        veletlen_leves(&l, 77 + i, 35);
+        tabla_masol(&s, &l);
+        for(int g = 0; g < GENERACIOK && jo; g++){
+            OszlopSor_Lista_Elem *lf = lemez_lepes(&l), *sf = motor_lepes(&s);
+            long long ldb = 0, sdb = 0;
+            // A csere után a kov az előző generáció: a listában csak valóban megváltozott cella lehet
+            for(OszlopSor_Lista_Elem *iter = lf; iter != NULL; iter = iter->next, ldb++)
+                if(iter->sor < 1 || iter->sor > l.m - 2 ||
+                   l.g[(size_t)iter->sor * l.lepes + iter->oszlop] == l.kov[(size_t)iter->sor * l.lepes + iter->oszlop])
+                    jo = 0;
+            for(OszlopSor_Lista_Elem *iter = sf; iter != NULL; iter = iter->next)
+                sdb++;
+            jo = jo && ldb == sdb && l.hash == s.hash && l.generacio == s.generacio &&
+                 memcmp(l.g, s.g, (size_t)l.lepes * l.m * sizeof(Cella)) == 0;
+            valtozasok_felszabadit(lf);
+            valtozasok_felszabadit(sf);
+        }
+        jo = jo && l.hash == tabla_hash(&l);
+        destroy_tabla(&l);
+        destroy_tabla(&s);
+        motorral++;
+    }
+    tabla_tarolas_beallit(tar_suru);
+    motor_valaszt(eredeti);
+
+    if(jo)
+        fprintf(ki, "OK    lemez: %d motor, %dx%d tabla %d savban, %d generacio egyezett\n", motorral, SZELESSEG, MAGASSAG,
+                (MAGASSAG + LEMEZ_SAV - 1) / LEMEZ_SAV, GENERACIOK);
+    else
+        fprintf(ki, "HIBA  lemez: a savonkenti lepes elter\n");
+    return jo;
+}
+
+int ritka_ellenoriz(FILE *ki){
+    enum {GENERACIOK = 150, SZELESSEG = 3 * RITKA_CSEMPE + 8, MAGASSAG = 2 * RITKA_CSEMPE + 22};
+    static const char *szabalyok[] = {"B3/S23", "B36/S23", "B2/S", "B3/S012345678"};
+    const char *fajlnev = "./gol_ritka_ellenorzes.txt";
+    int jo = 1, minden_forma = 1;
+    long long atalakitasok = 0;
+    for(size_t i = 0; i < sizeof(szabalyok)/sizeof(szabalyok[0]) && jo; i++){
+        Szabaly sz;
+        szabaly_beolvas(szabalyok[i], &sz);
+        Tabla naiv, t;
+        Ritka_tabla r;
+        init_tabla(&naiv, SZELESSEG, MAGASSAG);
+        memset(naiv.g, 0, (size_t)naiv.lepes * naiv.m * sizeof(Cella));
+        // Leves a bal oldalon, csendéletek és egy délkelet felé haladó sikló a jobb oldalon
+        uint64_t allapot = 0x5EED5EEDULL + i;
+        for(int sor = 1; sor < naiv.m - 1; sor++)
+            for(int oszlop = 1; oszlop <= SZELESSEG / 3; oszlop++)
+                CELLA(&naiv, sor, oszlop) = (int)(veletlen(&allapot) % 100) < 40;
+        minta_kitesz(&naiv, "oo/oo", 10, 150, 0);
+        minta_kitesz(&naiv, "oo/oo", 100, 190, 0);
+        minta_kitesz(&naiv, ".o./..o/ooo", 5, 120, 0);
+        naiv.hash = tabla_hash(&naiv);
+        jo = ritka_tablabol(&r, &naiv) && r.hash == naiv.hash && r.nepesseg == tabla_nepesseg(&naiv);
+        long long formak[3] = {0, 0, 0};
+        for(int gen = 1; gen <= GENERACIOK && jo; gen++){
+            naiv_lepes(&naiv, &sz);
+            long long valtozas = ritka_lepes(&r, &sz);
+            jo = r.hash == tabla_hash(&naiv) && r.nepesseg == tabla_nepesseg(&naiv) && valtozas == r.szuletes + r.halalozas;
+            for(int k = 0; k < 3; k++)
+                if(r.tipusok[k] > 0)
+                    formak[k]++;
+            if(jo && (gen % 25 == 0 || gen == GENERACIOK)){
+                jo = ritka_tablaba(&r, &t) && memcmp(t.g, naiv.g, (size_t)t.m * t.lepes) == 0 && t.hash == r.hash;
+                destroy_tabla(&t);
+            }
+            if(!jo)
+                fprintf(ki, "HIBA  ritka %s: elteres a %d. generacioban\n", szabalyok[i], gen);
+        }
+        minden_forma = minden_forma && formak[ct_ures] && formak[ct_lista] && formak[ct_suru];
+        atalakitasok += r.atalakitasok;
+
+        // Mentés a ritka táblából, vissza sűrűbe és ritkába
+        if(jo && i == 0){
+            Ritka_tabla visszatoltott;
+            jo = ritka_ment(fajlnev, &r) && tabla_betolt(fajlnev, &t);
+            jo = jo && memcmp(t.g, naiv.g, (size_t)t.m * t.lepes) == 0 && t.hash == r.hash;
+            destroy_tabla(&t);
+            jo = jo && ritka_betolt(fajlnev, &visszatoltott);
+            if(jo){
+                jo = visszatoltott.hash == r.hash && visszatoltott.nepesseg == r.nepesseg &&
+                     visszatoltott.tipusok[ct_suru] == r.tipusok[ct_suru] && visszatoltott.tipusok[ct_lista] == r.tipusok[ct_lista];
+                ritka_torol(&visszatoltott);
+            }
+            remove(fajlnev);
+            if(!jo)
+                fprintf(ki, "HIBA  ritka: a mentes es a betoltes elter\n");
+        }
+        ritka_torol(&r);
+        destroy_tabla(&naiv);
+    }
+    Szabaly b0;
+    szabaly_beolvas("B0/S8", &b0);
+    jo = jo && !ritka_szabaly_jo(&b0);
+    if(jo && !minden_forma){
+        fprintf(ki, "HIBA  ritka: nem fordult elo minden csempeforma\n");
+        jo = 0;
+    }
+    if(jo)
+        fprintf(ki, "OK    ritka: %d szabaly, %dx%d tabla, %d generacio, %lld formavaltas; mentes es betoltes rendben\n",
+                (int)(sizeof(szabalyok)/sizeof(szabalyok[0])), SZELESSEG, MAGASSAG, GENERACIOK, atalakitasok);
+    return jo;
+}
+
+int felvetel_ellenoriz(FILE *ki){
+    enum {KEPEK = 20, NAGYITAS = 3};
+    const char *fajlnev = "./gol_felvetel_ellenorzes.rgb";
+    Tabla t;
+    init_tabla(&t, 45, 31);
+    veletlen_leves(&t, 12, 40);
+    Tabla *allapotok = malloc(KEPEK * sizeof(Tabla));
+    Felvetel f;
+    int jo = felvetel_indit(&f, f_nyers, fajlnev, &t, NAGYITAS, 1), masolt = 0;
+    for(int i = 0; i < KEPEK && jo; i++){
+        tabla_masol(&allapotok[masolt++], &t);
+        felvetel_kepkocka(&f, &t);
+        valtozasok_felszabadit(uj_generacio(&t));
+    }
+    jo = jo && felvetel_leallit(&f) && f.rogzitett == KEPEK && f.eldobott == 0;
+
+    int szel = (t.sz - 2) * NAGYITAS, mag = (t.m - 2) * NAGYITAS;
+    FILE *fp = jo ? fopen(fajlnev, "rb") : NULL;
+    unsigned char pixel[3];
+    for(int i = 0; i < KEPEK && fp != NULL && jo; i++){
+        for(int y = 0; y < mag && jo; y++){
+            for(int x = 0; x < szel && jo; x++){
+                int elo = CELLA(&allapotok[i], 1 + y / NAGYITAS, 1 + x / NAGYITAS);
+                jo = fread(pixel, 1, 3, fp) == 3 && (pixel[0] == 155) == elo;
+            }
+        }
+    }
+    jo = jo && fp != NULL && fgetc(fp) == EOF;
+    if(fp != NULL)
+        fclose(fp);
+    remove(fajlnev);
+    for(int i = 0; i < masolt; i++)
+        destroy_tabla(&allapotok[i]);
+    free(allapotok);
+    destroy_tabla(&t);
+    if(jo)
+        fprintf(ki, "OK    felvetel: %d kepkocka, %dx nagyitva, egyezik a tablaval\n", KEPEK, NAGYITAS);
+    else
+        fprintf(ki, "HIBA  felvetel: a rogzitett kepkockak elternek a tablatol\n");
+    return jo;
+}
+
+int statisztika_ellenoriz(FILE *ki){
+    Tabla t;
+    init_tabla(&t, 60, 45);
+    veletlen_leves(&t, 7, 30);
+    Statisztika s;
+    statisztika_init(&s, &t, 16);
+    int jo = 1;
+    for(int gen = 1; gen <= 300 && jo; gen++){
+        Tabla elozo;
+        tabla_masol(&elozo, &t);
+        OszlopSor_Lista_Elem *fej = uj_generacio(&t);
+        statisztika_frissit(&s, &t, fej);
+        valtozasok_felszabadit(fej);
+
+        int szuletes = 0, halalozas = 0, min_sor = t.m, min_oszlop = t.sz, max_sor = -1, max_oszlop = -1;
+        for(int sor=1; sor<t.m-1; sor++){
+            for(int oszlop=1; oszlop<t.sz-1; oszlop++){
+                szuletes += !CELLA(&elozo, sor, oszlop) && CELLA(&t, sor, oszlop);
+                halalozas += CELLA(&elozo, sor, oszlop) && !CELLA(&t, sor, oszlop);
+                if(CELLA(&t, sor, oszlop)){
+                    if(sor < min_sor) min_sor = sor;
+                    if(sor > max_sor) max_sor = sor;
+                    if(oszlop < min_oszlop) min_oszlop = oszlop;
+                    if(oszlop > max_oszlop) max_oszlop = oszlop;
+                }
+            }
+        }
+        destroy_tabla(&elozo);
+        const Gen_adat *j = &s.jelen;
+        if(j->nepesseg != tabla_nepesseg(&t) || j->szuletes != szuletes || j->halalozas != halalozas ||
+           j->min_sor != min_sor || j->max_sor != max_sor || j->min_oszlop != min_oszlop || j->max_oszlop != max_oszlop){
+            fprintf(ki, "HIBA  statisztika: elteres a %d. generacioban\n", gen);
+            jo = 0;
+        }
+    }
+    // Kézi flip: egy haldokló (Generations) cella törlése nem halálozás, a 0 -> 1 -> 0 oda-vissza változtat
+    int sor = 1, oszlop = 1;
+    while(CELLA(&t, sor, oszlop) != 0)
+        oszlop++;
+    long long nepesseg = s.jelen.nepesseg;
+    CELLA(&t, sor, oszlop) = 2;
+    Cella allapotok[3] = {2, 0, 1};
+    long long vart[3] = {nepesseg, nepesseg + 1, nepesseg};
+    for(int i = 0; i < 3 && jo; i++){
+        flip(&t, sor, oszlop);
+        statisztika_flip(&s, &t, sor, oszlop, allapotok[i]);
+        if(s.jelen.nepesseg != vart[i] || s.jelen.nepesseg != tabla_nepesseg(&t)){
+            fprintf(ki, "HIBA  statisztika: a %d. kezi flip utan a nepesseg %lld, vart %lld\n", i + 1, s.jelen.nepesseg, vart[i]);
+            jo = 0;
+        }
+    }
+    if(jo)
+        fprintf(ki, "OK    statisztika: 300 generacio, egyezik a teljes tablabol szamolttal\n");
+    statisztika_torol(&s);
+    destroy_tabla(&t);
+    return jo;
+}
+
+int ellenorzes_futtat(FILE *ki){
+    int hibak = 0;
+    for(size_t i = 0; i < sizeof(arany_allasok)/sizeof(arany_allasok[0]); i++){
+        const Arany_allas *allas = &arany_allasok[i];
+        int nepesseg;
+        uint64_t hash;
+        allas_futtat(allas, &nepesseg, &hash);
+        if(nepesseg == allas->nepesseg && hash == allas->hash){
+            fprintf(ki, "OK    %s (%d generacio): nepesseg %d, hash %016llx\n", allas->nev, allas->generaciok, nepesseg, (unsigned long long)hash);
+        }
+        else{
+            fprintf(ki, "HIBA  %s (%d generacio): nepesseg %d (elvart %d), hash %016llx (elvart %016llx)\n", allas->nev, allas->generaciok,
+                    nepesseg, allas->nepesseg, (unsigned long long)hash, (unsigned long long)allas->hash);
+            hibak++;
+        }
+    }
+    for(size_t i = 0; i < sizeof(motorok)/sizeof(motorok[0]); i++){
+        if(!motor_osszevet(ki, &motorok[i]))
+            hibak++;
+    }
+    if(!szabalyok_ellenoriz(ki))
+        hibak++;
+    if(!ltl_ellenoriz(ki))
+        hibak++;
+    if(!kernel_ellenoriz(ki))
+        hibak++;
+    if(!leves_ellenoriz(ki))
+        hibak++;
+    if(!nepszamlalas_ellenoriz(ki))
+        hibak++;
+    if(!kozos_ellenoriz(ki))
+        hibak++;
+    if(!szerver_ellenoriz(ki))
+        hibak++;
+    if(!statisztika_ellenoriz(ki))
+        hibak++;
+    if(!elosztott_ellenoriz(ki))
+        hibak++;
+    if(!tortenet_ellenoriz(ki))
+        hibak++;
+    if(!felvetel_ellenoriz(ki))
+        hibak++;
+    if(!novekvo_ellenoriz(ki))
+        hibak++;
+    if(!meret_ellenoriz(ki))
+        hibak++;
+    if(!lemez_ellenoriz(ki))
+        hibak++;
+    if(!ritka_ellenoriz(ki))
+        hibak++;
+    fprintf(ki, "%s: %d hiba\n", hibak ? "SIKERTELEN" : "SIKERES", hibak);
+    return hibak;
+}
+
+void ellenorzes_arany_general(FILE *ki){
+    for(size_t i = 0; i < sizeof(arany_allasok)/sizeof(arany_allasok[0]); i++){
+        int nepesseg;
+        uint64_t hash;
+        allas_futtat(&arany_allasok[i], &nepesseg, &hash);
+        fprintf(ki, "%-16s %5d generacio: nepesseg %5d, hash 0x%016llxULL\n", arany_allasok[i].nev, arany_allasok[i].generaciok, nepesseg, (unsigned long long)hash);
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * @file GoL_ellenorzes.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A szimuláció helyességét ellenőrző önteszt.
+ * Ismert mintákat futtat adott számú generáción át, és a népességet és a tábla hash-ét eltárolt ("arany") értékekkel veti össze.
+ * Az alternatív motorokat véletlen táblákon cellánként összeveti a referencia uj_generacio-val.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_ELLENORZES_H
+#define GOL_ELLENORZES_H
+
+#include <stdio.h>
+
+/**
+ * @brief Lefuttatja az összes ellenőrzést, az eredményt a ki fájlba írja.
+ * @param ki pl. stdout
+ * @return a sikertelen ellenőrzések száma (0 ha minden rendben)
+ */
+int ellenorzes_futtat(FILE *ki);
+
+/**
+ * @brief Kiírja a mintákhoz tartozó arany értékeket a jelenlegi referencia motorral számolva.
+ * Új minta felvételekor használandó, az eredmény a táblázatba másolható.
+ * @param ki
+ */
+void ellenorzes_arany_general(FILE *ki);
+
+#endif
@@ -0,0 +1,560 @@
+/**
+ * @file GoL_elosztott.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Az elosztott szimuláció megvalósítása (fork + Unix socketek).
+ * @version 0.1
+ * @date 2021-12-01
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_motor.h"
+#include "GoL_elosztott.h"
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#endif
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+#ifdef _WIN32
+
+int elosztott_futtat(const char *fajlnev, long long n, int munkasok, const char *mentes, Elosztott_eredmeny *e){
+    (void)fajlnev; (void)n; (void)munkasok; (void)mentes; (void)e;
+    fprintf(stderr, "Az elosztott futtatas csak POSIX rendszeren erheto el\n");
+    return 0;
+}
+
+#else
+
+/** A belső sorokat ennyiesével számolja, közöttük ránéz a halo cseréjére */
+#define ATFEDES_SOROK 64
+
+/**
+ * @brief Egy munkás folyamat állapota.
+ * @param t A munkás sávja; a 0. és az utolsó sora a szomszédoktól kapott halo
+ * @param eltolas A sáv helyi sorindexéhez ennyit adva kapjuk a teljes tábla sorindexét
+ * @param koord A koordinátorral közös socket
+ * @param fel A felső szomszéddal közös socket, -1 ha a sáv a tábla tetején van
+ * @param le Az alsó szomszéddal közös socket, -1 ha a sáv a tábla alján van
+ * @param szuletes Az összes születés a sávban
+ * @param halalozas Az összes halálozás a sávban
+ * @param csomag Egy bitekbe csomagolt sor mérete bájtban
+ * @param ki_fel A küldendő felső sor (csomagolva)
+ * @param ki_le A küldendő alsó sor
+ * @param be_fel A felső szomszédtól kapott sor
+ * @param be_le Az alsó szomszédtól kapott sor
+ */
+typedef struct Munkas{
+    Tabla t;
+    int eltolas;
+    int koord, fel, le;
+    long long szuletes, halalozas;
+    size_t csomag;
+    uint8_t *ki_fel, *ki_le, *be_fel, *be_le;
+}Munkas;
+
+/**
+ * @brief Egy szomszéddal folyó, nem blokkoló sorcsere állapota.
+ * @param fd -1 ha nincs szomszéd
+ * @param ki
+ * @param be
+ * @param kiirt Ennyi bájt ment már el
+ * @param beolvasott Ennyi bájt érkezett már meg
+ */
+typedef struct Csere{
+    int fd;
+    const uint8_t *ki;
+    uint8_t *be;
+    size_t kiirt, beolvasott;
+}Csere;
+
+/**
+ * @brief A koordinátor parancsa egy munkásnak.
+ * @param tipus 'L' n generáció léptetés, 'M' a sáv elküldése mentéshez, 'Q' kilépés
+ * @param n
+ */
+typedef struct Parancs{
+    char tipus;
+    long long n;
+}Parancs;
+
+/**
+ * @brief Pontosan meret bájtot ír a socketbe (blokkolva).
+ * @return 1 ha sikeres
+ */
+static int teljes_ir(int fd, const void *adat, size_t meret);
+
+/**
+ * @brief Pontosan meret bájtot olvas a socketből (blokkolva).
+ * @return 1 ha sikeres, 0 ha a kapcsolat megszakadt
+ */
+static int teljes_olvas(int fd, void *adat, size_t meret);
+
+/**
+ * @brief Beolvassa a mentés fejlécét.
+ * @param fp
+ * @param szel
+ * @param mag
+ * @return 1 ha érvényes
+ */
+static int fejlec_olvas(FILE *fp, int *szel, int *mag);
+
+/**
+ * @brief A munkás betölti a mentésből a teljes tábla [sor_tol, sor_ig) sorait, és lefoglalja a halo cseréjének puffereit.
+ * @return 1 ha sikeres; 0 ha a mentés hibás, vagy elfogyott a memória (a munkás ezt 'H'-val jelenti a koordinátornak)
+ */
+static int sav_betolt(Munkas *m, const char *fajlnev, int sor_tol, int sor_ig);
+
+/**
+ * @brief Egy sort bitekbe csomagol (8 cella egy bájt).
+ */
+static void sor_csomagol(const Cella *sor, int sz, uint8_t *ki);
+
+/**
+ * @brief A sor_csomagol párja.
+ */
+static void sor_kicsomagol(const uint8_t *be, int sz, Cella *sor);
+
+/**
+ * @brief A sáv [sor_tol, sor_ig) sorait lépteti a t.kov-ba, közben frissíti a hash-t és a számlálókat.
+ */
+static void sorok_lepes(Munkas *m, int sor_tol, int sor_ig);
+
+/**
+ * @brief Továbbviszi a két szomszéddal folyó sorcserét.
+ * @param cs A felső és az alsó szomszéd cseréje
+ * @param meret A sor mérete bájtban
+ * @param varakozas poll időkorlát ms-ban: 0 ha csak ránéz, -1 ha vár, amíg valami haladni tud
+ * @return 1 ha mindkét csere kész, 0 ha még nem, -1 ha hiba történt
+ */
+static int csere_halad(Csere cs[2], size_t meret, int varakozas);
+
+/**
+ * @brief Egy generációt lép a sávval: a halo cseréje közben kiszámolja a belső sorokat, utána a két szélsőt.
+ * @return 1 ha sikeres
+ */
+static int generacio_lep(Munkas *m);
+
+/**
+ * @brief A munkás jelentése a koordinátornak a sáv jelenlegi állapotáról.
+ */
+static void jelentes_keszit(Munkas *m, Elosztott_eredmeny *e);
+
+/**
+ * @brief A munkás folyamat: betölti a sávját, majd a koordinátor parancsait hajtja végre.
+ * @return a folyamat kilépési kódja
+ */
+static int munkas_fo(Munkas *m, const char *fajlnev, int sor_tol, int sor_ig);
+
+/**
+ * @brief A mentés egy sorát írja ki (tabla_ment formátumban).
+ */
+static void sor_kiir(FILE *fp, const Cella *sor, int sz);
+
+int teljes_ir(int fd, const void *adat, size_t meret){
+    const char *p = adat;
+    while(meret > 0){
+        ssize_t n = send(fd, p, meret, MSG_NOSIGNAL);
+        if(n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)){
+            struct pollfd pfd = {fd, POLLOUT, 0};
+            poll(&pfd, 1, -1);
+            continue;
+        }
+        if(n <= 0)
+            return 0;
+        p += n;
+        meret -= n;
+    }
+    return 1;
+}
+
+int teljes_olvas(int fd, void *adat, size_t meret){
+    char *p = adat;
+    while(meret > 0){
+        ssize_t n = recv(fd, p, meret, 0);
+        if(n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)){
+            struct pollfd pfd = {fd, POLLIN, 0};
+            poll(&pfd, 1, -1);
+            continue;
+        }
+        if(n <= 0)
+            return 0;
+        p += n;
+        meret -= n;
+    }
+    return 1;
+}
+
+int fejlec_olvas(FILE *fp, int *szel, int *mag){
+    char v[4];
+    if(fscanf(fp, "%3[^\n]", v) != 1 || strcmp(v, "0.1"))
+        return 0;
+    return fscanf(fp, " %d%d", szel, mag) == 2 && *szel >= 3 && *mag >= 3;
+}
+
+int sav_betolt(Munkas *m, const char *fajlnev, int sor_tol, int sor_ig){
+    FILE *fp = fopen(fajlnev, "rt");
+    if(fp == NULL)
+        return 0;
+    int szel, mag;
+    if(!fejlec_olvas(fp, &szel, &mag)){
+        fclose(fp);
+        return 0;
+    }
+    if(!init_tabla(&m->t, szel-2, sor_ig - sor_tol)){
+        fclose(fp);
+        return 0;
+    }
+    m->eltolas = sor_tol - 1;
+    // A sávon kívüli sorokat is végig kell olvasni, de nem tárolja őket
+    for(int sor = 0; sor < sor_ig; sor++){
+        for(int oszlop = 0; oszlop < szel; oszlop++){
+            int c;
+            if(fscanf(fp, "%d", &c) != 1 || (c != 0 && c != 1)){
+                fclose(fp);
+                destroy_tabla(&m->t);
+                return 0;
+            }
+            if(sor >= sor_tol && oszlop > 0 && oszlop < szel-1 && c){
+                CELLA(&m->t, sor - m->eltolas, oszlop) = 1;
+                m->t.hash ^= cella_kulcs(sor, oszlop);
+            }
+        }
+    }
+    fclose(fp);
+    m->csomag = (size_t)(szel + 7) / 8;
+    m->ki_fel = malloc(4 * m->csomag);
+    if(m->ki_fel == NULL){
+        destroy_tabla(&m->t);
+        return 0;
+    }
+    m->ki_le = m->ki_fel + m->csomag;
+    m->be_fel = m->ki_le + m->csomag;
+    m->be_le = m->be_fel + m->csomag;
+    return 1;
+}
+
+void sor_csomagol(const Cella *sor, int sz, uint8_t *ki){
+    memset(ki, 0, (size_t)(sz + 7) / 8);
+    for(int oszlop = 0; oszlop < sz; oszlop++)
+        ki[oszlop >> 3] |= sor[oszlop] << (oszlop & 7);
+}
+
+void sor_kicsomagol(const uint8_t *be, int sz, Cella *sor){
+    for(int oszlop = 0; oszlop < sz; oszlop++)
+        sor[oszlop] = (be[oszlop >> 3] >> (oszlop & 7)) & 1;
+}
+
+void sorok_lepes(Munkas *m, int sor_tol, int sor_ig){
+    Tabla *t = &m->t;
+    const Szabaly *sz = motor_aktiv_szabaly();
+    const uint16_t maszk[2] = {sz->szuletes, sz->tuleles};
+    for(int sor = sor_tol; sor < sor_ig; sor++){
+        const Cella *fent = t->g + (size_t)(sor-1) * t->lepes;
+        const Cella *kozep = fent + t->lepes;
+        const Cella *lent = kozep + t->lepes;
+        Cella *uj = t->kov + (size_t)sor * t->lepes;
+        for(int oszlop = 1; oszlop < t->sz-1; oszlop++){
+            int szomszedok = fent[oszlop-1] + fent[oszlop] + fent[oszlop+1] + kozep[oszlop-1] + kozep[oszlop+1] +
+                             lent[oszlop-1] + lent[oszlop] + lent[oszlop+1];
+            uj[oszlop] = (maszk[kozep[oszlop]] >> szomszedok) & 1;
+            if(uj[oszlop] != kozep[oszlop]){
+                t->hash ^= cella_kulcs(sor + m->eltolas, oszlop);
+                if(uj[oszlop]) m->szuletes++;
+                else m->halalozas++;
+            }
+        }
+    }
+}
+
+int csere_halad(Csere cs[2], size_t meret, int varakozas){
+    struct pollfd pfd[2];
+    int melyik[2];
+    int db = 0;
+    for(int i = 0; i < 2; i++){
+        if(cs[i].fd < 0)
+            continue;
+        short esemenyek = 0;
+        if(cs[i].kiirt < meret) esemenyek |= POLLOUT;
+        if(cs[i].beolvasott < meret) esemenyek |= POLLIN;
+        if(esemenyek){
+            pfd[db].fd = cs[i].fd;
+            pfd[db].events = esemenyek;
+            pfd[db].revents = 0;
+            melyik[db++] = i;
+        }
+    }
+    if(db == 0)
+        return 1;
+    if(poll(pfd, db, varakozas) < 0)
+        return errno == EINTR ? 0 : -1;
+    for(int j = 0; j < db; j++){
+        Csere *c = &cs[melyik[j]];
+        if(pfd[j].revents & POLLOUT){
+            ssize_t n = send(c->fd, c->ki + c->kiirt, meret - c->kiirt, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if(n > 0) c->kiirt += n;
+            else if(n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return -1;
+        }
+        if(pfd[j].revents & POLLIN){
+            ssize_t n = recv(c->fd, c->be + c->beolvasott, meret - c->beolvasott, MSG_DONTWAIT);
+            if(n > 0) c->beolvasott += n;
+            else if(n == 0) return -1;
+            else if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return -1;
+        }
+        else if(pfd[j].revents & (POLLERR | POLLHUP | POLLNVAL)){
+            return -1;
+        }
+    }
+    for(int i = 0; i < 2; i++)
+        if(cs[i].fd >= 0 && (cs[i].kiirt < meret || cs[i].beolvasott < meret))
+            return 0;
+    return 1;
+}
+
+int generacio_lep(Munkas *m){
+    Tabla *t = &m->t;
+    int h = t->m - 2;
+    sor_csomagol(&CELLA(t, 1, 0), t->sz, m->ki_fel);
+    sor_csomagol(&CELLA(t, h, 0), t->sz, m->ki_le);
+    Csere cs[2] = {{m->fel, m->ki_fel, m->be_fel, 0, 0}, {m->le, m->ki_le, m->be_le, 0, 0}};
+
+    // A halo csak a két szélső sorhoz kell; a többi sor számolása alatt a csere a háttérben halad
+    int kesz = csere_halad(cs, m->csomag, 0);
+    for(int sor = 2; sor < h; sor += ATFEDES_SOROK){
+        sorok_lepes(m, sor, (sor + ATFEDES_SOROK < h) ? sor + ATFEDES_SOROK : h);
+        if(kesz == 0)
+            kesz = csere_halad(cs, m->csomag, 0);
+    }
+    while(kesz == 0)
+        kesz = csere_halad(cs, m->csomag, -1);
+    if(kesz < 0)
+        return 0;
+    if(m->fel >= 0)
+        sor_kicsomagol(m->be_fel, t->sz, &CELLA(t, 0, 0));
+    if(m->le >= 0)
+        sor_kicsomagol(m->be_le, t->sz, &CELLA(t, h+1, 0));
+    sorok_lepes(m, 1, 2);
+    if(h > 1)
+        sorok_lepes(m, h, h+1);
+
+    Cella *csere = t->g;
+    t->g = t->kov;
+    t->kov = csere;
+    t->generacio++;
+    return 1;
+}
+
+void jelentes_keszit(Munkas *m, Elosztott_eredmeny *e){
+    Tabla *t = &m->t;
+    e->generacio = t->generacio;
+    e->nepesseg = 0;
+    e->ossz_szuletes = m->szuletes;
+    e->ossz_halalozas = m->halalozas;
+    e->min_sor = INT32_MAX;
+    e->min_oszlop = INT32_MAX;
+    e->max_sor = -1;
+    e->max_oszlop = -1;
+    e->hash = t->hash;
+    for(int sor = 1; sor < t->m-1; sor++){
+        for(int oszlop = 1; oszlop < t->sz-1; oszlop++){
+            if(CELLA(t, sor, oszlop)){
+                e->nepesseg++;
+                if(sor + m->eltolas < e->min_sor) e->min_sor = sor + m->eltolas;
+                if(sor + m->eltolas > e->max_sor) e->max_sor = sor + m->eltolas;
+                if(oszlop < e->min_oszlop) e->min_oszlop = oszlop;
+                if(oszlop > e->max_oszlop) e->max_oszlop = oszlop;
+            }
+        }
+    }
+}
+
+int munkas_fo(Munkas *m, const char *fajlnev, int sor_tol, int sor_ig){
+    char allapot = sav_betolt(m, fajlnev, sor_tol, sor_ig) ? 'K' : 'H';
+    if(!teljes_ir(m->koord, &allapot, 1) || allapot == 'H')
+        return 1;
+    if(m->fel >= 0) fcntl(m->fel, F_SETFL, fcntl(m->fel, F_GETFL) | O_NONBLOCK);
+    if(m->le >= 0) fcntl(m->le, F_SETFL, fcntl(m->le, F_GETFL) | O_NONBLOCK);
+
+    int hiba = 0;
+    Parancs p;
+    while(!hiba && teljes_olvas(m->koord, &p, sizeof(p)) && p.tipus != 'Q'){
+        if(p.tipus == 'L'){
+            for(long long i = 0; i < p.n && !hiba; i++)
+                hiba = !generacio_lep(m);
+            Elosztott_eredmeny e;
+            jelentes_keszit(m, &e);
+            if(hiba)
+                e.generacio = -1;
+            hiba |= !teljes_ir(m->koord, &e, sizeof(e));
+        }
+        else if(p.tipus == 'M'){
+            for(int sor = 1; sor < m->t.m-1 && !hiba; sor++)
+                hiba = !teljes_ir(m->koord, &CELLA(&m->t, sor, 0), m->t.sz);
+        }
+    }
+    free(m->ki_fel);
+    destroy_tabla(&m->t);
+    return hiba;
+}
+
+void sor_kiir(FILE *fp, const Cella *sor, int sz){
+    for(int oszlop = 0; oszlop < sz; oszlop++){
+        fputc('0' + sor[oszlop], fp);
+        if(oszlop != sz-1)
+            fputc(' ', fp);
+    }
+    fputc('\n', fp);
+}
+
+int elosztott_futtat(const char *fajlnev, long long n, int munkasok, const char *mentes, Elosztott_eredmeny *e){
+    FILE *fp = fopen(fajlnev, "rt");
+    if(fp == NULL)
+        return 0;
+    int szel, mag;
+    int ervenyes = fejlec_olvas(fp, &szel, &mag);
+    fclose(fp);
+    if(!ervenyes || munkasok < 1 || munkasok > ELOSZTOTT_MAX_MUNKAS)
+        return 0;
+    if(munkasok > mag-2)
+        munkasok = mag-2;
+
+    // koord[w][0] a koordinátoré, koord[w][1] a munkásé; szomszed[w] a w. és a w+1. munkás között
+    int koord[ELOSZTOTT_MAX_MUNKAS][2], szomszed[ELOSZTOTT_MAX_MUNKAS][2];
+    pid_t pid[ELOSZTOTT_MAX_MUNKAS];
+    for(int w = 0; w < munkasok; w++){
+        int jo = socketpair(AF_UNIX, SOCK_STREAM, 0, koord[w]) == 0;
+        if(jo && w+1 < munkasok && socketpair(AF_UNIX, SOCK_STREAM, 0, szomszed[w]) != 0){
+            close(koord[w][0]);
+            close(koord[w][1]);
+            jo = 0;
+        }
+        if(!jo){
+            for(int v = 0; v < w; v++){
+                close(koord[v][0]);
+                close(koord[v][1]);
+                close(szomszed[v][0]);
+                close(szomszed[v][1]);
+            }
+            return 0;
+        }
+    }
+    fflush(stdout);
+    fflush(stderr);
+    for(int w = 0; w < munkasok; w++){
+        int sor_tol = 1 + (int)((long long)w * (mag-2) / munkasok);
+        int sor_ig = 1 + (int)((long long)(w+1) * (mag-2) / munkasok);
+        pid[w] = fork();
+        if(pid[w] == 0){
+            Munkas m;
+            memset(&m, 0, sizeof(m));
+            m.koord = koord[w][1];
+            m.fel = (w > 0) ? szomszed[w-1][1] : -1;
+            m.le = (w+1 < munkasok) ? szomszed[w][0] : -1;
+            // A többi folyamathoz tartozó socketvégeket bezárja, hogy egy munkás kilépését a többiek észrevegyék
+            for(int v = 0; v < munkasok; v++){
+                close(koord[v][0]);
+                if(v != w) close(koord[v][1]);
+                if(v+1 < munkasok){
+                    if(v != w) close(szomszed[v][0]);
+                    if(v != w-1) close(szomszed[v][1]);
+                }
+            }
+            _exit(munkas_fo(&m, fajlnev, sor_tol, sor_ig));
+        }
+    }
+    for(int w = 0; w < munkasok; w++){
+        close(koord[w][1]);
+        if(w+1 < munkasok){
+            close(szomszed[w][0]);
+            close(szomszed[w][1]);
+        }
+    }
+
+    int siker = 1;
+    for(int w = 0; w < munkasok; w++){
+        char allapot = 'H';
+        if(pid[w] < 0 || !teljes_olvas(koord[w][0], &allapot, 1) || allapot != 'K')
+            siker = 0;
+    }
+
+    if(siker){
+        Parancs p = {'L', n};
+        for(int w = 0; w < munkasok; w++)
+            siker &= teljes_ir(koord[w][0], &p, sizeof(p));
+        memset(e, 0, sizeof(*e));
+        e->min_sor = INT32_MAX;
+        e->min_oszlop = INT32_MAX;
+        e->max_sor = -1;
+        e->max_oszlop = -1;
+        for(int w = 0; w < munkasok && siker; w++){
+            Elosztott_eredmeny resz;
+            if(!teljes_olvas(koord[w][0], &resz, sizeof(resz)) || resz.generacio < 0){
+                siker = 0;
+                break;
+            }
+            e->generacio = resz.generacio;
+            e->nepesseg += resz.nepesseg;
+            e->ossz_szuletes += resz.ossz_szuletes;
+            e->ossz_halalozas += resz.ossz_halalozas;
+            e->hash ^= resz.hash;
+            if(resz.min_sor < e->min_sor) e->min_sor = resz.min_sor;
+            if(resz.max_sor > e->max_sor) e->max_sor = resz.max_sor;
+            if(resz.min_oszlop < e->min_oszlop) e->min_oszlop = resz.min_oszlop;
+            if(resz.max_oszlop > e->max_oszlop) e->max_oszlop = resz.max_oszlop;
+        }
+    }
+
+    if(siker && mentes != NULL){
+        FILE *ki = fopen(mentes, "wt");
+        Cella *sor = calloc(szel, sizeof(Cella));
+        if(ki == NULL || sor == NULL){
+            siker = 0;
+        }
+        else{
+            fprintf(ki, "0.1\n%d %d\n", szel, mag);
+            sor_kiir(ki, sor, szel);
+            Parancs p = {'M', 0};
+            for(int w = 0; w < munkasok && siker; w++){
+                int h = (int)((long long)(w+1) * (mag-2) / munkasok) - (int)((long long)w * (mag-2) / munkasok);
+                siker = teljes_ir(koord[w][0], &p, sizeof(p));
+                for(int i = 0; i < h && siker; i++){
+                    siker = teljes_olvas(koord[w][0], sor, szel);
+                    sor_kiir(ki, sor, szel);
+                }
+            }
+            memset(sor, 0, szel);
+            sor_kiir(ki, sor, szel);
+        }
+        if(ki != NULL)
+            fclose(ki);
+        free(sor);
+    }
+
+    Parancs vege = {'Q', 0};
+    for(int w = 0; w < munkasok; w++){
+        teljes_ir(koord[w][0], &vege, sizeof(vege));
+        close(koord[w][0]);
+    }
+    for(int w = 0; w < munkasok; w++){
+        int statusz;
+        if(pid[w] > 0 && (waitpid(pid[w], &statusz, 0) < 0 || !WIFEXITED(statusz) || WEXITSTATUS(statusz) != 0))
+            siker = 0;
+    }
+    return siker;
+}
+
+#endif
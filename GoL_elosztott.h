@@ -0,0 +1,56 @@
+/**
+ * @file GoL_elosztott.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Több folyamatra elosztott szimuláció (tartományfelbontás).
+ * A tábla belsejét vízszintes sávokra osztja, minden sáv egy külön munkás folyamaté, így egy folyamatnak sem kell
+ * az egész táblát a memóriában tartania. A szomszédos munkások generációnként kicserélik a sávjuk szélső sorát
+ * (egy cellányi "halo"), a koordinátor pedig összesíti a statisztikát és elvégzi a mentést.
+ * A folyamatok Unix socketeken beszélnek, így egy gépen is kipróbálható; csak POSIX rendszeren érhető el.
+ * @version 0.1
+ * @date 2021-12-01
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_ELOSZTOTT_H
+#define GOL_ELOSZTOTT_H
+
+#include <stdint.h>
+
+/** Legfeljebb ennyi munkás folyamat indítható */
+#define ELOSZTOTT_MAX_MUNKAS 64
+
+/**
+ * @brief Az elosztott futás összesített eredménye. Üres táblánál a befoglaló téglalap max értékei kisebbek a min értékeinél.
+ * @param generacio
+ * @param nepesseg
+ * @param ossz_szuletes Az összes születés a futás alatt
+ * @param ossz_halalozas Az összes halálozás a futás alatt
+ * @param min_sor A befoglaló téglalap (a teljes tábla koordinátáiban)
+ * @param min_oszlop
+ * @param max_sor
+ * @param max_oszlop
+ * @param hash A teljes tábla Zobrist hash-e (megegyezik az egy folyamatban futtatott tábláéval)
+ */
+typedef struct Elosztott_eredmeny{
+    long long generacio;
+    long long nepesseg, ossz_szuletes, ossz_halalozas;
+    int min_sor, min_oszlop, max_sor, max_oszlop;
+    uint64_t hash;
+}Elosztott_eredmeny;
+
+/**
+ * @brief Elosztva lefuttatja a mentést n generáción át.
+ * A koordinátor (a hívó folyamat) csak a fájl fejlécét olvassa; a munkások a fájlból csak a saját sávjukat töltik be.
+ * A szabály a motor_aktiv_szabaly (a munkások a fork-kal öröklik).
+ * @param fajlnev A betöltendő mentés
+ * @param n A generációk száma
+ * @param munkasok A munkás folyamatok száma, 1 és ELOSZTOTT_MAX_MUNKAS között (legfeljebb a tábla belső magassága)
+ * @param mentes Ha nem NULL, ide menti a végállapotot
+ * @param e Ide írja az összesített eredményt
+ * @return 1 ha sikeres; 0 ha például egy munkás nem tudta betölteni a sávját (hibás mentés, vagy elfogyott a memória)
+ */
+int elosztott_futtat(const char *fajlnev, long long n, int munkasok, const char *mentes, Elosztott_eredmeny *e);
+
+#endif
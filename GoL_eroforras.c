@@ -0,0 +1,112 @@
+/**
+ * @file GoL_eroforras.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A fontok és képek lusta betöltésének megvalósítása.
+ * @version 0.1
+ * @date 2021-12-08
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <SDL2/SDL_image.h>
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+#include "GoL_eroforras.h"
+
+/** Egy erőforrás teljes elérési útjának legnagyobb hossza */
+#define EROFORRAS_UTVONAL 1024
+
+/**
+ * @brief Egy font fájlja és mérete.
+ */
+typedef struct Font_leiras{
+    const char *fajl;
+    int meret;
+}Font_leiras;
+
+static const Font_leiras font_leirasok[EROFORRAS_FONTOK_SZAMA] = {
+    [ef_menu]   = {"OCRAEXT.TTF", 54},
+    [ef_mentes] = {"Jura-Regular.ttf", 32},
+    [ef_sugo]   = {"Jura-Regular.ttf", 20},
+};
+
+static const char *kep_fajlok[EROFORRAS_KEPEK_SZAMA] = {
+    [ek_ikonok] = "icons.png",
+    [ek_conway] = "John_H_Conway.jpg",
+};
+
+static TTF_Font *fontok[EROFORRAS_FONTOK_SZAMA];
+static SDL_Texture *kepek[EROFORRAS_KEPEK_SZAMA];
+/** A futtatható fájl mappája (SDL_GetBasePath), az első kéréskor lekérdezve */
+static char *alap_mappa;
+
+/**
+ * @brief Az src/ mappában lévő fájl elérési útja. Ha a futtatható fájl mellett nincs src/ mappa
+ * (pl. a forrásmappából futtatva egy build mappában lévő programot), a munkakönyvtár src/ mappáját adja.
+ * @param fajl
+ * @param utvonal EROFORRAS_UTVONAL méretű tömb, ide írja
+ */
+static void eroforras_utvonal(const char *fajl, char *utvonal);
+
+void eroforras_utvonal(const char *fajl, char *utvonal){
+    if(alap_mappa == NULL){
+        alap_mappa = SDL_GetBasePath();
+        if(alap_mappa == NULL)
+            alap_mappa = SDL_strdup("./");
+    }
+    snprintf(utvonal, EROFORRAS_UTVONAL, "%ssrc/%s", alap_mappa, fajl);
+    SDL_RWops *f = SDL_RWFromFile(utvonal, "rb");
+    if(f != NULL){
+        SDL_RWclose(f);
+        return;
+    }
+    snprintf(utvonal, EROFORRAS_UTVONAL, "./src/%s", fajl);
+}
+
+TTF_Font* eroforras_font(Eroforras_font melyik){
+    if(fontok[melyik] == NULL){
+        char utvonal[EROFORRAS_UTVONAL];
+        eroforras_utvonal(font_leirasok[melyik].fajl, utvonal);
+        fontok[melyik] = TTF_OpenFont(utvonal, font_leirasok[melyik].meret);
+        if (!fontok[melyik]) {
+            SDL_Log("Nem sikerult megnyitni a fontot! %s\n", TTF_GetError());
+            exit(1);
+        }
+    }
+    return fontok[melyik];
+}
+
+SDL_Texture* eroforras_kep(SDL_Renderer *renderer, Eroforras_kep melyik){
+    if(kepek[melyik] == NULL){
+        char utvonal[EROFORRAS_UTVONAL];
+        eroforras_utvonal(kep_fajlok[melyik], utvonal);
+        kepek[melyik] = IMG_LoadTexture(renderer, utvonal);
+        if (kepek[melyik] == NULL) {
+            SDL_Log("Nem nyithato meg a kepfajl: %s\n", IMG_GetError());
+            exit(1);
+        }
+    }
+    return kepek[melyik];
+}
+
+void eroforras_torol(void){
+    for(int i = 0; i < EROFORRAS_FONTOK_SZAMA; i++){
+        if(fontok[i] != NULL)
+            TTF_CloseFont(fontok[i]);
+        fontok[i] = NULL;
+    }
+    for(int i = 0; i < EROFORRAS_KEPEK_SZAMA; i++){
+        if(kepek[i] != NULL)
+            SDL_DestroyTexture(kepek[i]);
+        kepek[i] = NULL;
+    }
+    SDL_free(alap_mappa);
+    alap_mappa = NULL;
+}
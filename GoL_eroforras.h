@@ -0,0 +1,69 @@
+/**
+ * @file GoL_eroforras.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A grafikus felület fontjainak és képeinek lusta betöltése.
+ * Minden erőforrás a program mellé csomagolt src/ mappában van, és a futtatható fájl helyéhez képest keresi
+ * (SDL_GetBasePath), nem a munkakönyvtárhoz vagy a rendszer font mappájához képest. Egy erőforrás az első
+ * kérésekor töltődik be, utána a modul tárolja; így az indulás csak a menühöz kellő fontot olvassa be.
+ * @version 0.1
+ * @date 2021-12-08
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_EROFORRAS_H
+#define GOL_EROFORRAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+/**
+ * @brief A program fontjai.
+ */
+typedef enum Eroforras_font{
+    /** A menü gombjai */
+    ef_menu,
+    /** A mentés, betöltés és a tábla méretének képernyői */
+    ef_mentes,
+    /** A súgó szövege */
+    ef_sugo,
+    /** A fontok száma, nem valódi font */
+    EROFORRAS_FONTOK_SZAMA
+}Eroforras_font;
+
+/**
+ * @brief A program képei.
+ */
+typedef enum Eroforras_kep{
+    /** A játék ikonjai (icons.png) */
+    ek_ikonok,
+    /** A súgó képe */
+    ek_conway,
+    /** A képek száma, nem valódi kép */
+    EROFORRAS_KEPEK_SZAMA
+}Eroforras_kep;
+
+/**
+ * @brief A font, első kéréskor betöltve. Ha nem sikerül megnyitni, hibaüzenettel kilép.
+ * @warning Az eroforras_torol-lel felszabadítandó!!
+ * @param melyik
+ * @return a font
+ */
+TTF_Font* eroforras_font(Eroforras_font melyik);
+
+/**
+ * @brief A kép textúrája, első kéréskor betöltve. Ha nem sikerül megnyitni, hibaüzenettel kilép.
+ * @warning Az eroforras_torol-lel felszabadítandó!!
+ * @param renderer Mindig ugyanaz a renderer
+ * @param melyik
+ * @return a textúra
+ */
+SDL_Texture* eroforras_kep(SDL_Renderer *renderer, Eroforras_kep melyik);
+
+/**
+ * @brief Felszabadítja az összes betöltött fontot és képet. A renderer megszüntetése előtt hívandó.
+ */
+void eroforras_torol(void);
+
+#endif
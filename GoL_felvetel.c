@@ -0,0 +1,509 @@
+/**
+ * @file GoL_felvetel.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A képkocka rögzítés és a PNG/GIF/nyers kódolók megvalósítása.
+ * @version 0.1
+ * @date 2021-12-03
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_felvetel.h"
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/** A halott és az élő cella színe (R, G, B), ugyanaz mint a grafikus felületen */
+static const unsigned char PALETTA[2][3] = {{17, 28, 7}, {155, 255, 61}};
+
+/** A PNG CRC32 táblázata, az első felvetel_indit tölti ki (még a kódoló szál indulása előtt) */
+static uint32_t crc_tabla[256];
+
+/**
+ * @brief A GIF LZW kódjait bájtokba, a bájtokat legfeljebb 255 hosszú blokkokba rendezi.
+ * @param fp
+ * @param tar A még ki nem írt bitek
+ * @param bitek A tar-ban lévő bitek száma
+ * @param blokk
+ * @param blokk_db
+ * @param jo 0 ha valamelyik írás nem sikerült
+ */
+typedef struct Gif_iro{
+    FILE *fp;
+    uint32_t tar;
+    int bitek;
+    unsigned char blokk[255];
+    int blokk_db;
+    int jo;
+}Gif_iro;
+
+/**
+ * @brief Kitölti a crc_tabla-t.
+ */
+static void crc_init(void);
+
+/**
+ * @brief Folytatja a c CRC32 számítását az adatokkal (kezdetben c = 0).
+ */
+static uint32_t crc(uint32_t c, const unsigned char *adat, size_t meret);
+
+/**
+ * @brief Egy 32 bites számot ír a pufferbe nagy végű (hálózati) bájtsorrenddel.
+ */
+static void be32(unsigned char *hova, uint32_t ertek);
+
+/**
+ * @brief Egy 16 bites számot ír a fájlba kis végű bájtsorrenddel (a GIF-hez).
+ */
+static void le16_ir(FILE *fp, int ertek);
+
+/**
+ * @brief A képkocka y. pixelsorát (nagyítva, pixelenként 0 vagy 1) az f->pixel_sor-ba írja.
+ */
+static void sor_nagyit(Felvetel *f, const Felvetel_kep *k, int y);
+
+/**
+ * @brief Kiír egy PNG darabot (hossz, típus, adat, CRC).
+ * @return 1 ha sikeres
+ */
+static int png_darab(FILE *fp, const char tipus[4], const unsigned char *adat, size_t meret);
+
+/**
+ * @brief A képkockát egy új PNG fájlba írja: 1 bites palettás kép, tömörítetlen (stored) deflate blokkokkal.
+ * @return 1 ha sikeres
+ */
+static int png_kep(Felvetel *f, const Felvetel_kep *k);
+
+/**
+ * @brief A GIF_iro-ba ír egy meret bites kódot.
+ */
+static void gif_kod(Gif_iro *g, int kod, int meret);
+
+/**
+ * @brief Kiírja a GIF_iro blokkjában összegyűlt bájtokat.
+ */
+static void gif_blokk_urit(Gif_iro *g);
+
+/**
+ * @brief A képkockát az animált GIF következő képeként írja ki, LZW tömörítéssel.
+ * @return 1 ha sikeres
+ */
+static int gif_kep(Felvetel *f, const Felvetel_kep *k);
+
+/**
+ * @brief A képkockát RGB24 formátumban írja ki.
+ * @return 1 ha sikeres
+ */
+static int nyers_kep(Felvetel *f, const Felvetel_kep *k);
+
+/**
+ * @brief A kódoló szál: kiveszi a sorból a képkockákat és kódolja őket, amíg le nem állítják.
+ */
+static int kodolo_szal(void *adat);
+
+void crc_init(void){
+    for(uint32_t n = 0; n < 256; n++){
+        uint32_t c = n;
+        for(int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_tabla[n] = c;
+    }
+}
+
+uint32_t crc(uint32_t c, const unsigned char *adat, size_t meret){
+    c ^= 0xFFFFFFFFu;
+    for(size_t i = 0; i < meret; i++)
+        c = crc_tabla[(c ^ adat[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+void be32(unsigned char *hova, uint32_t ertek){
+    hova[0] = (unsigned char)(ertek >> 24);
+    hova[1] = (unsigned char)(ertek >> 16);
+    hova[2] = (unsigned char)(ertek >> 8);
+    hova[3] = (unsigned char)ertek;
+}
+
+void le16_ir(FILE *fp, int ertek){
+    fputc(ertek & 0xFF, fp);
+    fputc((ertek >> 8) & 0xFF, fp);
+}
+
+void sor_nagyit(Felvetel *f, const Felvetel_kep *k, int y){
+    const unsigned char *cellak = k->cellak + (size_t)(y / f->cellameret) * f->sz;
+    unsigned char *p = f->pixel_sor;
+    for(int oszlop = 0; oszlop < f->sz; oszlop++){
+        memset(p, cellak[oszlop], f->cellameret);
+        p += f->cellameret;
+    }
+}
+
+int png_darab(FILE *fp, const char tipus[4], const unsigned char *adat, size_t meret){
+    unsigned char fej[8];
+    be32(fej, (uint32_t)meret);
+    memcpy(fej + 4, tipus, 4);
+    uint32_t c = crc(crc(0, fej + 4, 4), adat, meret);
+    unsigned char vege[4];
+    be32(vege, c);
+    return fwrite(fej, 1, 8, fp) == 8 && fwrite(adat, 1, meret, fp) == meret && fwrite(vege, 1, 4, fp) == 4;
+}
+
+int png_kep(Felvetel *f, const Felvetel_kep *k){
+    char *fajlnev = malloc(strlen(f->cel) + 16);
+    if(fajlnev == NULL)
+        return 0;
+    sprintf(fajlnev, "%s_%06lld.png", f->cel, f->sorszam);
+    FILE *fp = fopen(fajlnev, "wb");
+    free(fajlnev);
+    if(fp == NULL)
+        return 0;
+
+    int szel = f->sz * f->cellameret, mag = f->m * f->cellameret;
+    size_t sorhossz = 1 + (size_t)(szel + 7) / 8;
+    size_t nyers_meret = sorhossz * mag;
+    // zlib: 2 bájt fejléc, 65535 bájtos tárolt blokkok egyenként 5 bájt fejléccel, végül 4 bájt adler32
+    size_t blokkok = (nyers_meret + 65534) / 65535;
+    size_t z_meret = 2 + nyers_meret + 5 * blokkok + 4;
+    unsigned char *z = malloc(z_meret);
+    if(z == NULL){
+        fclose(fp);
+        return 0;
+    }
+    z[0] = 0x78;
+    z[1] = 0x01;
+    unsigned char *p = z + 2;
+    uint32_t a = 1, b = 0;
+    size_t blokkban = 0;
+    for(int y = 0; y < mag; y++){
+        sor_nagyit(f, k, y);
+        for(size_t i = 0; i < sorhossz; i++){
+            unsigned char bajt = 0;
+            if(i > 0){
+                // Szűrő nélküli sor, a pixelek a bájt felső bitjétől kezdve
+                for(int bit = 0; bit < 8; bit++){
+                    int x = (int)(i - 1) * 8 + bit;
+                    if(x < szel && f->pixel_sor[x])
+                        bajt |= 0x80 >> bit;
+                }
+            }
+            if(blokkban == 0){
+                size_t hatra = nyers_meret - ((size_t)y * sorhossz + i);
+                size_t hossz = hatra < 65535 ? hatra : 65535;
+                p[0] = hatra <= 65535;
+                p[1] = (unsigned char)hossz;
+                p[2] = (unsigned char)(hossz >> 8);
+                p[3] = (unsigned char)~hossz;
+                p[4] = (unsigned char)(~hossz >> 8);
+                p += 5;
+                blokkban = hossz;
+            }
+            *p++ = bajt;
+            blokkban--;
+            a = (a + bajt) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    be32(p, (b << 16) | a);
+
+    static const unsigned char ALAIRAS[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    unsigned char ihdr[13];
+    be32(ihdr, (uint32_t)szel);
+    be32(ihdr + 4, (uint32_t)mag);
+    ihdr[8] = 1;  // bitmélység
+    ihdr[9] = 3;  // palettás
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+    int jo = fwrite(ALAIRAS, 1, 8, fp) == 8;
+    jo = jo && png_darab(fp, "IHDR", ihdr, sizeof(ihdr));
+    jo = jo && png_darab(fp, "PLTE", &PALETTA[0][0], sizeof(PALETTA));
+    jo = jo && png_darab(fp, "IDAT", z, z_meret);
+    jo = jo && png_darab(fp, "IEND", NULL, 0);
+    free(z);
+    return (fclose(fp) == 0) && jo;
+}
+
+void gif_blokk_urit(Gif_iro *g){
+    if(g->blokk_db == 0)
+        return;
+    fputc(g->blokk_db, g->fp);
+    if(fwrite(g->blokk, 1, g->blokk_db, g->fp) != (size_t)g->blokk_db)
+        g->jo = 0;
+    g->blokk_db = 0;
+}
+
+void gif_kod(Gif_iro *g, int kod, int meret){
+    g->tar |= (uint32_t)kod << g->bitek;
+    g->bitek += meret;
+    while(g->bitek >= 8){
+        g->blokk[g->blokk_db++] = (unsigned char)g->tar;
+        g->tar >>= 8;
+        g->bitek -= 8;
+        if(g->blokk_db == 255)
+            gif_blokk_urit(g);
+    }
+}
+
+int gif_kep(Felvetel *f, const Felvetel_kep *k){
+    // A GIF legkisebb kódmérete 2 (4 szín), ebből csak a 0 és az 1 használt
+    enum {MIN_KOD = 2, TOROL = 1 << MIN_KOD, VEGE = TOROL + 1, ELSO_SZABAD = TOROL + 2, MAX_KOD = 4096};
+    int szel = f->sz * f->cellameret, mag = f->m * f->cellameret;
+    FILE *fp = f->fp;
+    // A szótár: kovetkezo[kód][pixel] a kód+pixel sorozat kódja, 0 ha nincs (a 0. kód sosem utód)
+    uint16_t (*kovetkezo)[4] = calloc(MAX_KOD, sizeof(*kovetkezo));
+    if(kovetkezo == NULL)
+        return 0;
+    // Grafikai vezérlő kiterjesztés (késleltetés), majd a kép leírója
+    fputc(0x21, fp); fputc(0xF9, fp); fputc(4, fp); fputc(0, fp);
+    le16_ir(fp, FELVETEL_GIF_KESLELTETES);
+    fputc(0, fp); fputc(0, fp);
+    fputc(0x2C, fp);
+    le16_ir(fp, 0); le16_ir(fp, 0);
+    le16_ir(fp, szel); le16_ir(fp, mag);
+    fputc(0, fp);
+    fputc(MIN_KOD, fp);
+
+    Gif_iro g = {fp, 0, 0, {0}, 0, 1};
+    int meret = MIN_KOD + 1, szabad = ELSO_SZABAD;
+    gif_kod(&g, TOROL, meret);
+    int elotag = -1;
+    for(int y = 0; y < mag; y++){
+        sor_nagyit(f, k, y);
+        for(int x = 0; x < szel; x++){
+            int c = f->pixel_sor[x];
+            if(elotag < 0){
+                elotag = c;
+                continue;
+            }
+            if(kovetkezo[elotag][c]){
+                elotag = kovetkezo[elotag][c];
+                continue;
+            }
+            gif_kod(&g, elotag, meret);
+            if(szabad < MAX_KOD){
+                kovetkezo[elotag][c] = (uint16_t)szabad;
+                if(szabad == (1 << meret))
+                    meret++;
+                szabad++;
+            }
+            else{
+                gif_kod(&g, TOROL, meret);
+                memset(kovetkezo, 0, MAX_KOD * sizeof(*kovetkezo));
+                meret = MIN_KOD + 1;
+                szabad = ELSO_SZABAD;
+            }
+            elotag = c;
+        }
+    }
+    gif_kod(&g, elotag, meret);
+    gif_kod(&g, VEGE, meret);
+    if(g.bitek > 0)
+        gif_kod(&g, 0, 8 - g.bitek);
+    gif_blokk_urit(&g);
+    fputc(0, fp);
+    free(kovetkezo);
+    return g.jo && !ferror(fp);
+}
+
+int nyers_kep(Felvetel *f, const Felvetel_kep *k){
+    int szel = f->sz * f->cellameret, mag = f->m * f->cellameret;
+    unsigned char *rgb = malloc((size_t)szel * 3);
+    int jo = rgb != NULL;
+    for(int y = 0; y < mag && jo; y++){
+        sor_nagyit(f, k, y);
+        for(int x = 0; x < szel; x++)
+            memcpy(rgb + 3 * x, PALETTA[f->pixel_sor[x]], 3);
+        jo = fwrite(rgb, 3, szel, f->fp) == (size_t)szel;
+    }
+    free(rgb);
+    return jo;
+}
+
+int kodolo_szal(void *adat){
+    Felvetel *f = adat;
+    SDL_LockMutex(f->zar);
+    for(;;){
+        while(f->sor_eleje == NULL && !f->leall)
+            SDL_CondWait(f->jel, f->zar);
+        Felvetel_kep *k = f->sor_eleje;
+        if(k == NULL)
+            break;
+        f->sor_eleje = k->next;
+        if(f->sor_eleje == NULL)
+            f->sor_vege = NULL;
+        SDL_UnlockMutex(f->zar);
+
+        int jo;
+        switch(f->formatum){
+            case f_png: jo = png_kep(f, k); break;
+            case f_gif: jo = gif_kep(f, k); break;
+            default:    jo = nyers_kep(f, k); break;
+        }
+        f->sorszam++;
+
+        SDL_LockMutex(f->zar);
+        k->next = f->szabad;
+        f->szabad = k;
+        f->sor_db--;
+        if(!jo)
+            f->hiba = 1;
+        SDL_CondBroadcast(f->jel);
+    }
+    SDL_UnlockMutex(f->zar);
+    return 0;
+}
+
+int felvetel_formatum(const char *nev, Felvetel_formatum *formatum){
+    if(strcmp(nev, "png") == 0)        *formatum = f_png;
+    else if(strcmp(nev, "gif") == 0)   *formatum = f_gif;
+    else if(strcmp(nev, "nyers") == 0) *formatum = f_nyers;
+    else return 0;
+    return 1;
+}
+
+int felvetel_indit(Felvetel *f, Felvetel_formatum formatum, const char *cel, Tabla *t, int cellameret, int var){
+    memset(f, 0, sizeof(*f));
+    f->formatum = formatum;
+    f->var = var;
+    f->sz = t->sz - 2;
+    f->m = t->m - 2;
+    f->cellameret = cellameret > 0 ? cellameret : 1;
+    // A GIF képmérete 16 bites
+    if(formatum == f_gif && ((long long)f->sz * f->cellameret > 65535 || (long long)f->m * f->cellameret > 65535)){
+        SDL_Log("A GIF kep legfeljebb 65535 pixel szeles/magas lehet\n");
+        return 0;
+    }
+    if(formatum == f_nyers && strcmp(cel, "-") == 0){
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        f->fp = stdout;
+    }
+    else if(formatum != f_png){
+        f->fp = fopen(cel, "wb");
+        if(f->fp == NULL){
+            SDL_Log("Hiba a %s fajl megnyitasaban!\n", cel);
+            return 0;
+        }
+    }
+    if(formatum == f_gif){
+        // Fejléc, kétszínű globális paletta, végtelen ismétlés (NETSCAPE2.0 kiterjesztés)
+        fwrite("GIF89a", 1, 6, f->fp);
+        le16_ir(f->fp, f->sz * f->cellameret);
+        le16_ir(f->fp, f->m * f->cellameret);
+        fputc(0x80, f->fp); fputc(0, f->fp); fputc(0, f->fp);
+        fwrite(PALETTA, 1, sizeof(PALETTA), f->fp);
+        fputc(0x21, f->fp); fputc(0xFF, f->fp); fputc(11, f->fp);
+        fwrite("NETSCAPE2.0", 1, 11, f->fp);
+        fputc(3, f->fp); fputc(1, f->fp); le16_ir(f->fp, 0); fputc(0, f->fp);
+    }
+    crc_init();
+    size_t hossz = strlen(cel);
+    f->cel = malloc(hossz + 1);
+    f->pixel_sor = malloc((size_t)f->sz * f->cellameret);
+    if(f->cel != NULL && f->pixel_sor != NULL){
+        memcpy(f->cel, cel, hossz + 1);
+        f->zar = SDL_CreateMutex();
+        f->jel = SDL_CreateCond();
+        if(f->zar != NULL && f->jel != NULL)
+            f->kodolo = SDL_CreateThread(kodolo_szal, "felvetel", f);
+    }
+    if(f->kodolo == NULL){
+        SDL_DestroyCond(f->jel);
+        SDL_DestroyMutex(f->zar);
+        if(f->fp != NULL && f->fp != stdout)
+            fclose(f->fp);
+        free(f->pixel_sor);
+        free(f->cel);
+        return 0;
+    }
+    return 1;
+}
+
+void felvetel_kepkocka(Felvetel *f, Tabla *t){
+    SDL_LockMutex(f->zar);
+    while(f->var && f->sor_db >= FELVETEL_SOR_MAX)
+        SDL_CondWait(f->jel, f->zar);
+    if(f->sor_db >= FELVETEL_SOR_MAX){
+        f->eldobott++;
+        SDL_UnlockMutex(f->zar);
+        return;
+    }
+    // A hely már most foglalt, a másolás a zár nélkül történik
+    f->sor_db++;
+    Felvetel_kep *k = f->szabad;
+    if(k != NULL)
+        f->szabad = k->next;
+    SDL_UnlockMutex(f->zar);
+
+    if(k == NULL){
+        k = malloc(sizeof(Felvetel_kep));
+        if(k != NULL && (k->cellak = malloc((size_t)f->sz * f->m)) == NULL){
+            free(k);
+            k = NULL;
+        }
+        // Ha nincs hely új pufferre, a képkocka a tele sorhoz hasonlóan kimarad
+        if(k == NULL){
+            SDL_LockMutex(f->zar);
+            f->sor_db--;
+            f->eldobott++;
+            SDL_CondBroadcast(f->jel);
+            SDL_UnlockMutex(f->zar);
+            return;
+        }
+    }
+    // Több állapotú szabálynál a haldokló cellák (2, 3, ...) halottként kerülnek a képre
+    for(int sor = 1; sor <= f->m; sor++){
+        const Cella *g = &CELLA(t, sor, 1);
+        unsigned char *hova = k->cellak + (size_t)(sor - 1) * f->sz;
+        for(int oszlop = 0; oszlop < f->sz; oszlop++)
+            hova[oszlop] = g[oszlop] == 1;
+    }
+    k->next = NULL;
+
+    SDL_LockMutex(f->zar);
+    if(f->sor_vege != NULL)
+        f->sor_vege->next = k;
+    else
+        f->sor_eleje = k;
+    f->sor_vege = k;
+    f->rogzitett++;
+    SDL_CondBroadcast(f->jel);
+    SDL_UnlockMutex(f->zar);
+}
+
+int felvetel_leallit(Felvetel *f){
+    SDL_LockMutex(f->zar);
+    f->leall = 1;
+    SDL_CondBroadcast(f->jel);
+    SDL_UnlockMutex(f->zar);
+    SDL_WaitThread(f->kodolo, NULL);
+    SDL_DestroyCond(f->jel);
+    SDL_DestroyMutex(f->zar);
+    if(f->formatum == f_gif)
+        fputc(0x3B, f->fp);
+    if(f->fp == stdout){
+        if(fflush(stdout) != 0)
+            f->hiba = 1;
+    }
+    else if(f->fp != NULL && fclose(f->fp) != 0)
+        f->hiba = 1;
+    while(f->szabad != NULL){
+        Felvetel_kep *k = f->szabad;
+        f->szabad = k->next;
+        free(k->cellak);
+        free(k);
+    }
+    free(f->pixel_sor);
+    free(f->cel);
+    return !f->hiba;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file GoL_felvetel.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Képkockák rögzítése videó készítéséhez, a képernyő felvétele nélkül.
+ * Minden rögzített generációból csak a cellák másolata készül (cellánként egy bájt), a nagyítást (cellánként NxN pixel)
+ * és a kódolást egy háttérszál végzi. A várakozó képkockák sora korlátos: ha tele van, a képkocka eldobódik,
+ * így a rögzítés soha nem lassítja a szimulációt. Kérésre (var) ilyenkor megvárja a kódolót, és egy képkocka sem vész el.
+ * Formátumok:
+ *  - png: képsorozat (<cel>_000000.png, <cel>_000001.png, ...), 1 bites palettás, tömörítetlen deflate blokkokkal
+ *  - gif: egyetlen animált, ismétlődő GIF, LZW tömörítéssel
+ *  - nyers: RGB24 képkockák egymás után (a "-" cél a standard kimenet), pl.:
+ *    ffmpeg -f rawvideo -pix_fmt rgb24 -s <szel>x<mag> -r 30 -i - video.mp4
+ * @version 0.1
+ * @date 2021-12-03
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_FELVETEL_H
+#define GOL_FELVETEL_H
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+
+/** Legfeljebb ennyi kódolásra váró képkocka lehet a sorban; ha tele van, az újak eldobódnak */
+#define FELVETEL_SOR_MAX 16
+/** A GIF képkockák közti késleltetés századmásodpercben */
+#define FELVETEL_GIF_KESLELTETES 5
+
+/**
+ * @brief A felvétel formátuma.
+ */
+typedef enum Felvetel_formatum{
+    f_png, f_gif, f_nyers
+}Felvetel_formatum;
+
+/**
+ * @brief Egy kódolásra váró képkocka.
+ * @param cellak A játéktér cellái (szegély nélkül) soronként, cellánként 0 vagy 1
+ * @param next
+ */
+typedef struct Felvetel_kep{
+    unsigned char *cellak;
+    struct Felvetel_kep *next;
+}Felvetel_kep;
+
+/**
+ * @brief A felvétel állapota.
+ * @param formatum
+ * @param cel A fájl neve (png esetén a fájlnevek eleje)
+ * @param fp A gif/nyers kimenet
+ * @param sz A játéktér szélessége cellában (szegély nélkül)
+ * @param m A játéktér magassága cellában (szegély nélkül)
+ * @param cellameret Egy cella ennyiszer ennyi pixel
+ * @param sorszam A következő kiírandó képkocka sorszáma
+ * @param pixel_sor Egy nagyított pixelsor (csak a kódoló szál használja)
+ * @param kodolo A háttérben kódoló szál
+ * @param zar A sort védő mutex
+ * @param jel A sor változását jelző feltételváltozó
+ * @param sor_eleje A kódolásra váró képkockák
+ * @param sor_vege
+ * @param sor_db
+ * @param szabad Újrahasznosítható képkocka pufferek
+ * @param var 1 ha tele sor esetén a kódolóra vár, 0 ha eldobja a képkockát
+ * @param leall 1 ha a kódolónak a sor kiürítése után ki kell lépnie
+ * @param hiba 1 ha valamelyik írás nem sikerült
+ * @param rogzitett A sorba került képkockák száma
+ * @param eldobott A tele sor, vagy a képkocka pufferéhez elfogyott memória miatt eldobott képkockák száma
+ */
+typedef struct Felvetel{
+    Felvetel_formatum formatum;
+    char *cel;
+    FILE *fp;
+    int sz, m;
+    int cellameret;
+    long long sorszam;
+    unsigned char *pixel_sor;
+    SDL_Thread *kodolo;
+    SDL_mutex *zar;
+    SDL_cond *jel;
+    Felvetel_kep *sor_eleje, *sor_vege;
+    int sor_db;
+    Felvetel_kep *szabad;
+    int var;
+    int leall;
+    int hiba;
+    long long rogzitett, eldobott;
+}Felvetel;
+
+/**
+ * @brief A formátum nevéből (png, gif, nyers) a formátum.
+ * @return 1 ha ismert
+ */
+int felvetel_formatum(const char *nev, Felvetel_formatum *formatum);
+
+/**
+ * @brief Elindítja a felvételt (megnyitja a kimenetet és elindítja a kódoló szálat).
+ * @warning A felvetel_leallit-tal leállítandó!!
+ * @param f
+ * @param formatum
+ * @param cel
+ * @param t A tábla mérete a felvétel alatt nem változhat
+ * @param cellameret
+ * @param var 1 ha tele sor esetén a kódolóra kell várni (teljes videó), 0 ha a képkocka eldobható (a szimuláció nem lassul)
+ * @return 1 ha sikeres; 0 ha a kimenet nem nyitható meg, a kódoló szál nem indítható, vagy elfogyott a memória
+ */
+int felvetel_indit(Felvetel *f, Felvetel_formatum formatum, const char *cel, Tabla *t, int cellameret, int var);
+
+/**
+ * @brief Rögzíti a tábla jelenlegi állapotát (ha a sor tele van, eldobja, vagy var esetén megvárja a kódolót).
+ * @param f
+ * @param t
+ */
+void felvetel_kepkocka(Felvetel *f, Tabla *t);
+
+/**
+ * @brief Megvárja, amíg minden sorban lévő képkocka kiíródik, lezárja a kimenetet és felszabadít mindent.
+ * @param f
+ * @return 1 ha minden írás sikeres volt
+ */
+int felvetel_leallit(Felvetel *f);
+
+#endif
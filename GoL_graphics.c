@@ -18,10 +18,25 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_image.h>
 #include <math.h>
+#include <string.h>
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <dirent.h>
+#endif
+#ifdef GOL_DEBUG
 #include "src/debugmalloc.h"
+#endif
 #include "GoL_logics.h"
 #include "GoL_graphics.h"
+#include "GoL_meres.h"
+#include "GoL_ciklus.h"
+#include "GoL_statisztika.h"
+#include "GoL_motor.h"
+#include "GoL_tortenet.h"
+#include "GoL_felvetel.h"
+#include "GoL_eroforras.h"
+#include "GoL_novekvo.h"
 
 /**
  * @brief Enum az icons.png fájl ikonjaival.
@@ -32,6 +47,107 @@ typedef enum Icon{
     Save, Home
 } Icon;
 
+/** A játéktábla ciklusfigyelője, a tábla minden kézi módosításakor újraindul */
+static Ciklus_figyelo ciklus;
+/** A játéktábla statisztikái, új tábla létrehozásakor/betöltésekor újraindul */
+static Statisztika statisztika;
+/** Ennyi generáció statisztikáit őrzi meg a grafikus felület a CSV exporthoz */
+#define JATEK_STATISZTIKA_ELOZMENY 20000
+/** A játéktábla visszajátszható története, új tábla létrehozásakor/betöltésekor újraindul, kézi módosításkor elvágódik */
+static Tortenet tortenet;
+/** Ennyi generációnként készül kulcskép a történetben */
+#define JATEK_TORTENET_KULCS 64
+/** A történet memóriakerete bájtban */
+#define JATEK_TORTENET_KERET (64u << 20)
+/** A 'v' billentyűvel indítható GIF felvétel, új táblánál leáll */
+static Felvetel felvetel;
+static int felvetel_aktiv = 0;
+/** A felvétel képének legalább ekkora a szélessége pixelben (a cellák ehhez nagyítódnak) */
+#define JATEK_FELVETEL_SZELESSEG 800
+/** A betöltő felület legfeljebb ennyi mentést mutat */
+#define MENTESEK_MAX 10
+/** Az 'n' billentyűvel bekapcsolható automatikus növekedés, új táblánál újraindul */
+static Novekvo novekvo;
+static int novekvo_aktiv = 0;
+
+/** Ennyi kirajzolt szöveg textúráját őrzi meg a szoveg_kiiro */
+#define SZOVEG_CACHE_MERET 64
+/** A tördelt szövegek tördelési szélessége ennek a többszörösére kerekítődik lefelé (pixel), hogy átméretezéskor
+ * ne minden egyes pixelnyi változás rajzolja újra a szöveget */
+#define SZOVEG_CACHE_SAV 32
+
+/**
+ * @brief Egy kirajzolt szöveg textúrája a szoveg_kiiro gyorsítótárában.
+ * @param kulcs A szöveg, a font és a tördelés hash-e (a gyors kereséshez)
+ * @param font
+ * @param tordes A tördelési szélesség, 0 ha a szöveg egy sorban elfér
+ * @param szoveg A szöveg másolata
+ * @param textura
+ * @param w A textúra szélessége
+ * @param h A textúra magassága
+ * @param hasznalat Az utolsó használat "ideje", a legrégebben használt kerül ki elsőként
+ */
+typedef struct Szoveg_bejegyzes{
+    Uint64 kulcs;
+    TTF_Font *font;
+    int tordes;
+    char *szoveg;
+    SDL_Texture *textura;
+    int w, h;
+    Uint64 hasznalat;
+}Szoveg_bejegyzes;
+
+static Szoveg_bejegyzes szoveg_cache[SZOVEG_CACHE_MERET];
+static Uint64 szoveg_cache_ora = 0;
+
+/** A szövegbevitel leghosszabb szövege, a lezáró nullával együtt */
+#define BEVITEL_MAX 64
+
+/**
+ * @brief Egy éppen zajló szövegbevitel (a tábla méreténél és a mentés nevénél).
+ * Nem blokkol: a fő ciklus adja át neki az eseményeket a bevitel_esemeny-nyel.
+ * @param szoveg Az eddig beírt szöveg, \0-val a végén
+ * @param hossz A maximális hossz, ami beolvasható, \0-vel együtt (legfeljebb BEVITEL_MAX)
+ * @param composition Az aktuális szerkesztés (pl. ékezetes karakter összeállítása közben)
+ * @param teglalap A beolvasódoboz helye
+ * @param hatter A háttér színe
+ * @param szin A szöveg színe
+ * @param font A rajzoláshoz használt font
+ */
+typedef struct Bevitel{
+    char szoveg[BEVITEL_MAX];
+    size_t hossz;
+    char composition[SDL_TEXTEDITINGEVENT_TEXT_SIZE];
+    SDL_Rect teglalap;
+    SDL_Color hatter, szin;
+    TTF_Font *font;
+}Bevitel;
+
+/** Az s_tabla_meret és az s_mentes állapot szövegbevitele */
+static Bevitel bevitel;
+/** Az s_tabla_meret állapotban 0, amíg a szélességet, 1 amíg a magasságot kéri */
+static int meret_lepes = 0;
+/** A már megadott szélesség az s_tabla_meret állapotban */
+static long long meret_szel = 0;
+/** A tábla méreténél ennyi karakter írható be, a lezáró nullával együtt (a TABLA_MAX_OLDAL 9 jegyű) */
+#define MERET_BEVITEL_HOSSZ 10
+
+/**
+ * @brief A játéktábla helye a képernyőn; a jatek_kirajzol számolja, ebből adódik minden cella helye és a kattintott cella.
+ * @param x A kirajzolt tábla bal felső sarka
+ * @param y
+ * @param w A kirajzolt tábla szélessége pixelben
+ * @param h A kirajzolt tábla magassága pixelben
+ * @param cella Egy cella mérete pixelben. 0, ha a tábla több cellából áll, mint ahány pixel a felületen elfér: ekkor
+ * kicsinyítve rajzolódik, minden pixel a rá eső cellák közül a bal felsőt mutatja
+ */
+typedef struct Racs_hely{
+    int x, y, w, h;
+    int cella;
+}Racs_hely;
+
+static Racs_hely racs;
+
 /**
  * @brief Kiírja a megadott feliratot a megadott helyre a megadott betűtípussal.
  * 
@@ -41,6 +157,15 @@ typedef enum Icon{
  * @param str
  */
 static void szoveg_kiiro(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect hova, const char str[]);
+/**
+ * @brief A szöveg textúrája a gyorsítótárból; ha nincs benne, kirajzolja, és a legrégebben használt helyére teszi.
+ * @param renderer
+ * @param font
+ * @param str
+ * @param tordes A tördelési szélesség, 0 ha nem kell tördelni
+ * @return a bejegyzés
+ */
+static Szoveg_bejegyzes* szoveg_textura(SDL_Renderer *renderer, TTF_Font *font, const char str[], int tordes);
 /**
  * @brief kirajzol egy téglalapot és a megadott szöveget írja rá.
  * Későbbiekben a kattintás ellenőrzéséhez ajánlott eltárolni a megadott SDL_Rect négyszöget.
@@ -51,14 +176,47 @@ static void szoveg_kiiro(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect hova,
  */
 static void rajzol_gomb(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect gomb, const char felirat[]);
 /**
- * @brief Kirajzolja egy Tábla objektum g gridje szerinti megadott (sor, oszlop) cellát a képernyőre.
- * Frissíti a renderert.
+ * @brief Új vagy betöltött tábla után újraindítja a játék állapotát: a felvételt leállítja, a növekvő táblát (ha be van
+ * kapcsolva) megnöveli, a ciklusfigyelőt, a statisztikát és a történetet az új táblára indítja.
+ * @param t
+ */
+static void jatek_allapot_init(Tabla *t);
+/**
+ * @brief Kirajzol egy cellát a racs szerinti helyére (kicsinyített rajznál csak akkor, ha a cella a pixelét mutatja).
+ * Nem frissíti a képernyőt, a hívó a rajzolás végén egyszer hívja az SDL_RenderPresent-et.
  * @param renderer
  * @param t
  * @param sor
  * @param oszlop
  */
 static void jatek_rajzol_cella(SDL_Renderer *renderer, Tabla *t, int sor, int oszlop);
+
+/**
+ * @brief Megadja a (sor, oszlop) cella helyét a képernyőn a racs alapján.
+ * @param t
+ * @param sor
+ * @param oszlop
+ * @param hova ide írja a cella téglalapját (kicsinyített rajznál 1x1-es)
+ * @return 1 ha a cella látszik, 0 ha kicsinyített rajznál egy másik cella mutatja a pixelét
+ */
+static int cella_helye(const Tabla *t, int sor, int oszlop, SDL_Rect *hova);
+
+/**
+ * @brief A kicsinyített rajznál a p. pixelsor/oszlop által mutatott cella sora/oszlopa.
+ * @param p 0-tól a pixel sorszáma
+ * @param cellak A cellák száma (szegély nélkül)
+ * @param pixelek A kirajzolt tábla mérete pixelben
+ * @return a cella sora/oszlopa, 1-től
+ */
+static int pixel_cella(int p, int cellak, int pixelek);
+
+/**
+ * @brief Frissíti a képernyőt egy képkocka végén: a HUD-dal együtt, ha az be van kapcsolva.
+ * @param env
+ * @param t
+ */
+static void jatek_megjelenit(Ablak_info *env, Tabla *t);
+
 /**
  * @brief Egy megadott felületet letakar és rárajzolja a játékterület összes celláját.
  * Fontos, hogy nem az egész képernyőre raajzol ki, hanem csak a megadott területre.
@@ -69,12 +227,45 @@ static void jatek_rajzol_cella(SDL_Renderer *renderer, Tabla *t, int sor, int os
  */
 static void jatek_kirajzol(SDL_Renderer *renderer, SDL_Rect hova, Tabla *t);
 /**
- * @brief Futtatja a szimulációt megszakításig.
- * 
- * @param env 
- * @param t 
+ * @brief Elkezd egy szövegbevitelt: üres szöveggel indul, és bekapcsolja az SDL szövegbevitelét.
+ * @param b
+ * @param hossz A maximális hossz, ami beolvasható, \0-vel együtt
+ * @param teglalap A beolvasódoboz helye
+ * @param hatter A háttér színe
+ * @param szin A szöveg színe
+ * @param font A rajzoláshoz használt font
  */
-static void jatek_futtat(Ablak_info *env, Tabla *t);
+static void bevitel_indit(Bevitel *b, size_t hossz, SDL_Rect teglalap, SDL_Color hatter, SDL_Color szin, TTF_Font *font);
+/**
+ * @brief Kirajzolja a beolvasódobozt a szöveggel és a kurzorral. Frissíti a renderert.
+ * A kódrészlet az infoC oldalról származik apró módosításokkal.
+ * @param b
+ * @param renderer
+ */
+static void bevitel_rajzol(const Bevitel *b, SDL_Renderer *renderer);
+/**
+ * @brief Feldolgoz egy eseményt a szövegbevitelben, és ha a szöveg változott, újrarajzolja a dobozt.
+ * A bevitel végén kikapcsolja az SDL szövegbevitelét.
+ * @param b
+ * @param renderer
+ * @param ev
+ * @return 0 ha a bevitel folytatódik, 1 ha Enter-rel befejeződött, -1 ha megszakadt (Esc, vagy kattintás a dobozon kívül)
+ */
+static int bevitel_esemeny(Bevitel *b, SDL_Renderer *renderer, const SDL_Event *ev);
+/**
+ * @brief Az s_tabla_meret állapot feliratainak és beolvasódobozainak helye az ablak méretéhez.
+ * @param env
+ * @param szel_r A szélesség beolvasódoboza
+ * @param mag_r A magasság beolvasódoboza
+ * @param szel_szov_helye A "Szélesség:" felirat
+ * @param mag_szov_helye A "Magasság:" felirat
+ */
+static void tabla_meret_helyek(const Ablak_info *env, SDL_Rect *szel_r, SDL_Rect *mag_r, SDL_Rect *szel_szov_helye, SDL_Rect *mag_szov_helye);
+/**
+ * @brief Kirajzolja a mentés név bekérő felületét a jelenlegi képernyő fölé.
+ * @param env
+ */
+static void jatek_mentes_felulet(Ablak_info *env);
 /**
  * @brief Kirajzolja a képernyő koordinátákkal megadott pontjára a kért ikont.
  * 
@@ -85,11 +276,32 @@ static void jatek_futtat(Ablak_info *env, Tabla *t);
  * @return A kirajzolt gomb helye
  */
 static SDL_Rect ikon_kirazol(Ablak_info *env, Icon ikon, int x, int y);
+/**
+ * @brief Kirajzolja a játéktér bal felső sarkába a teljesítményt mutató kijelzőt.
+ * Frissíti a renderert.
+ * @param env
+ * @param t
+ */
+static void jatek_hud_rajzol(Ablak_info *env, Tabla *t);
+/**
+ * @brief Kigyűjti a ./saves mappa első MENTESEK_MAX .txt fájljának nevét (kiterjesztés nélkül).
+ * Windowson FindFirstFile-lal, máshol opendir/readdir-rel; a sorrend két hívás között (változatlan mappán) ugyanaz.
+ * @param nevek
+ * @return a talált mentések száma, 0 ha a mappa nem olvasható
+ */
+static int mentesek_listaz(char nevek[MENTESEK_MAX][255]);
+/**
+ * @brief A betöltő felület i. mentésének gombja.
+ * @param env
+ * @param i
+ */
+static SDL_Rect mentes_gomb(const Ablak_info *env, int i);
 
 
 
 void sdl_init(Ablak_info *env){
-    if (SDL_Init(SDL_INIT_EVERYTHING) != 0){
+    // Csak a videó (és vele az esemény) alrendszer kell; a hang, joystick stb. indítása csak lassítaná az indulást
+    if (SDL_Init(SDL_INIT_VIDEO) != 0){
         SDL_Log("Hiba az SDL inditasaban: %s\n", SDL_GetError());
         exit(1);
     }
@@ -103,13 +315,7 @@ void sdl_init(Ablak_info *env){
         SDL_Log("Nem hozhato letre a megjelenito: %s", SDL_GetError());
         exit(1);
     }
-    SDL_Texture *icons = IMG_LoadTexture(renderer, "./src/icons.png");
-    if (icons == NULL) {
-        SDL_Log("Nem nyithato meg a kepfajl: %s\n", IMG_GetError());
-        exit(1);
-    }
     env->renderer = renderer;
-    env->icons = icons;
     SDL_RenderClear(env->renderer);
     TTF_Init();
 }
@@ -118,19 +324,66 @@ int xy_in_rect(const int x, const int y, SDL_Rect rect){
     return ( (( x > rect.x ) && ( x < rect.x + rect.w ) && ( y > rect.y ) && ( y < rect.y + rect.h )) );
 }
 
-void szoveg_kiiro(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect hova, const char str[]){
-    SDL_Surface *felirat = NULL;
-    SDL_Texture *felirat_t = NULL;
+Szoveg_bejegyzes* szoveg_textura(SDL_Renderer *renderer, TTF_Font *font, const char str[], int tordes){
+    // FNV-1a a szövegre, a fonttal és a tördeléssel keverve
+    Uint64 kulcs = 14695981039346656037ULL ^ (Uint64)(uintptr_t)font ^ ((Uint64)tordes << 48);
+    for(const unsigned char *c = (const unsigned char*)str; *c; c++)
+        kulcs = (kulcs ^ *c) * 1099511628211ULL;
+
+    Szoveg_bejegyzes *cel = &szoveg_cache[0];
+    for(int i = 0; i < SZOVEG_CACHE_MERET; i++){
+        Szoveg_bejegyzes *b = &szoveg_cache[i];
+        if(b->textura != NULL && b->kulcs == kulcs && b->font == font && b->tordes == tordes && strcmp(b->szoveg, str) == 0){
+            b->hasznalat = ++szoveg_cache_ora;
+            return b;
+        }
+        if(cel->textura != NULL && (b->textura == NULL || b->hasznalat < cel->hasznalat))
+            cel = b;
+    }
+
+    if(cel->textura != NULL){
+        SDL_DestroyTexture(cel->textura);
+        free(cel->szoveg);
+    }
     SDL_Color szoveg = {155, 255, 61};
-    felirat = TTF_RenderUTF8_Blended_Wrapped(font, str, szoveg, hova.w);
-    felirat_t = SDL_CreateTextureFromSurface(renderer, felirat);
-    hova.x += (hova.w - felirat->w) / 2;
-    hova.y += (hova.h - felirat->h) / 2;
-    hova.w = felirat->w;
-    hova.h = felirat->h;
-    SDL_RenderCopy(renderer, felirat_t, NULL, &hova);
+    SDL_Surface *felirat = tordes > 0 ? TTF_RenderUTF8_Blended_Wrapped(font, str, szoveg, tordes)
+                                      : TTF_RenderUTF8_Blended(font, str, szoveg);
+    cel->kulcs = kulcs;
+    cel->font = font;
+    cel->tordes = tordes;
+    cel->szoveg = (char*) malloc(strlen(str) + 1);
+    strcpy(cel->szoveg, str);
+    cel->textura = SDL_CreateTextureFromSurface(renderer, felirat);
+    cel->w = felirat->w;
+    cel->h = felirat->h;
+    cel->hasznalat = ++szoveg_cache_ora;
     SDL_FreeSurface(felirat);
-    SDL_DestroyTexture(felirat_t);
+    return cel;
+}
+
+void szoveg_kiiro(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect hova, const char str[]){
+    // Ha a szöveg egy sorban elfér, a doboz szélessége nem számít, így átméretezéskor is ugyanaz a textúra jó
+    int tordes = hova.w / SZOVEG_CACHE_SAV * SZOVEG_CACHE_SAV, egy_sor;
+    if(tordes < SZOVEG_CACHE_SAV)
+        tordes = hova.w;
+    if(strchr(str, '\n') == NULL && TTF_SizeUTF8(font, str, &egy_sor, NULL) == 0 && egy_sor <= hova.w)
+        tordes = 0;
+    Szoveg_bejegyzes *b = szoveg_textura(renderer, font, str, tordes);
+    hova.x += (hova.w - b->w) / 2;
+    hova.y += (hova.h - b->h) / 2;
+    hova.w = b->w;
+    hova.h = b->h;
+    SDL_RenderCopy(renderer, b->textura, NULL, &hova);
+}
+
+void szoveg_cache_torol(void){
+    for(int i = 0; i < SZOVEG_CACHE_MERET; i++){
+        if(szoveg_cache[i].textura != NULL){
+            SDL_DestroyTexture(szoveg_cache[i].textura);
+            free(szoveg_cache[i].szoveg);
+        }
+        szoveg_cache[i].textura = NULL;
+    }
 }
 
 void rajzol_gomb(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect gomb, const char felirat[]){
@@ -140,6 +393,7 @@ void rajzol_gomb(SDL_Renderer *renderer, TTF_Font *font, SDL_Rect gomb, const ch
 
 void menu(Ablak_info *env, TTF_Font *font_menu, Harom_hely *gombok_helye){
     env->state = s_menu;
+    env->fut = 0;
     SDL_RenderClear(env->renderer);
 
     const double width_gomb = env->width_screen*4/6, height_gomb = env->height_screen/7;
@@ -164,7 +418,18 @@ void menu(Ablak_info *env, TTF_Font *font_menu, Harom_hely *gombok_helye){
     SDL_RenderPresent(env->renderer);
 }
 
-void tabla_meret(Ablak_info *env, TTF_Font *font_meret, Tabla *t){
+void tabla_meret_helyek(const Ablak_info *env, SDL_Rect *szel_r, SDL_Rect *mag_r, SDL_Rect *szel_szov_helye, SDL_Rect *mag_szov_helye){
+    SDL_Rect szel = {  env->width_screen/3 - 70, 5*env->height_screen/6, 140, 40};
+    SDL_Rect mag  = {2*env->width_screen/3 - 70, 5*env->height_screen/6, 140, 40};
+    SDL_Rect szel_szov = {0, 2*env->height_screen/3, env->width_screen/2, env->height_screen/6};
+    SDL_Rect mag_szov  = {env->width_screen/2, 2*env->height_screen/3, env->width_screen/2, env->height_screen/6};
+    *szel_r = szel;
+    *mag_r = mag;
+    *szel_szov_helye = szel_szov;
+    *mag_szov_helye = mag_szov;
+}
+
+void tabla_meret(Ablak_info *env, TTF_Font *font_meret){
     env->state = s_tabla_meret;
 
     //Háttér
@@ -175,63 +440,186 @@ void tabla_meret(Ablak_info *env, TTF_Font *font_meret, Tabla *t){
     snprintf(szoveg, sizeof(szoveg), "Üdv a Game of Life szimulációban! Kérlek add meg a kívánt méretét a játéktábládnak. (x, y)!\n\nA neked ajánlott maximális méret: %dx%d", env->width_screen/25, env->height_screen/25);
     szoveg_kiiro(env->renderer, font_meret, szoveg_helye, szoveg);
 
-    char szel_c[4], mag_c[4];
-    int szel = 0, mag = 0;
-    SDL_Rect szel_r = {  env->width_screen/3 - 40, 5*env->height_screen/6, 70, 40};
-    SDL_Rect mag_r  = {2*env->width_screen/3 - 40, 5*env->height_screen/6, 70, 40};
+    SDL_Rect szel_r, mag_r, szel_szov_helye, mag_szov_helye;
+    tabla_meret_helyek(env, &szel_r, &mag_r, &szel_szov_helye, &mag_szov_helye);
     SDL_Color bg = {17, 28, 7}, fg = {155, 255, 61};
-    SDL_Rect szel_szov_helye = {0, 2*env->height_screen/3, env->width_screen/2, env->height_screen/6};
-    SDL_Rect mag_szov_helye  = {env->width_screen/2, 2*env->height_screen/3, env->width_screen/2, env->height_screen/6};
     szoveg_kiiro(env->renderer, font_meret, szel_szov_helye, "Szélesség:");
-    SDL_RenderPresent(env->renderer);
-    while(szel == 0){
-        input_text(szel_c, 3, szel_r, bg, fg, font_meret, env->renderer);
-        szel = atoi(szel_c);
+    meret_lepes = 0;
+    bevitel_indit(&bevitel, MERET_BEVITEL_HOSSZ, szel_r, bg, fg, font_meret);
+    bevitel_rajzol(&bevitel, env->renderer);
+}
+
+int tabla_meret_esemeny(Ablak_info *env, TTF_Font *font_meret, Tabla *t, const SDL_Event *ev){
+    if(ev->type == SDL_KEYDOWN && ev->key.keysym.sym == SDLK_ESCAPE){
+        SDL_StopTextInput();
+        return 1;
     }
-    szoveg_kiiro(env->renderer, font_meret, mag_szov_helye, "Magasság:");
-    SDL_RenderPresent(env->renderer);
-    while(mag == 0){
-        input_text(mag_c, 3, mag_r, bg, fg, font_meret, env->renderer);
-        mag = atoi(mag_c);
+    int eredmeny = bevitel_esemeny(&bevitel, env->renderer, ev);
+    if(eredmeny == 0){
+        return 0;
+    }
+
+    SDL_Rect szel_r, mag_r, szel_szov_helye, mag_szov_helye;
+    tabla_meret_helyek(env, &szel_r, &mag_r, &szel_szov_helye, &mag_szov_helye);
+    long long ertek = eredmeny == 1 ? atoll(bevitel.szoveg) : 0;
+    if(ertek <= 0){
+        // Érvénytelen vagy megszakított bevitel: ugyanazt kéri újra
+        bevitel_indit(&bevitel, bevitel.hossz, meret_lepes == 0 ? szel_r : mag_r, bevitel.hatter, bevitel.szin, font_meret);
+        bevitel_rajzol(&bevitel, env->renderer);
+        return 0;
+    }
+    if(meret_lepes == 0){
+        meret_szel = ertek;
+        meret_lepes = 1;
+        szoveg_kiiro(env->renderer, font_meret, mag_szov_helye, "Magasság:");
+        bevitel_indit(&bevitel, bevitel.hossz, mag_r, bevitel.hatter, bevitel.szin, font_meret);
+        bevitel_rajzol(&bevitel, env->renderer);
+        return 0;
     }
 
-    init_tabla(t, szel, mag);
+    // A túl nagy táblát még a foglalás előtt elutasítja, és újra kéri a méretet
+    char uzenet[256] = "Nem sikerult lefoglalni a tablat";
+    // A történet csak akkor foglal, ha a kulcsképe belefér a keretébe
+    size_t kisero = statisztika_memoria_becsles(meret_szel, ertek, JATEK_STATISZTIKA_ELOZMENY);
+    if(tortenet_memoria_becsles(meret_szel, ertek) <= JATEK_TORTENET_KERET)
+        kisero += JATEK_TORTENET_KERET;
+    if(!tabla_meret_ellenoriz(meret_szel, ertek, tar_suru, kisero, uzenet, sizeof(uzenet)) || !init_tabla(t, (int)meret_szel, (int)ertek)){
+        SDL_Log("%s\n", uzenet);
+        tabla_meret(env, font_meret);
+        SDL_Rect hiba_helye = {env->width_screen/20, env->height_screen/3, 18*env->width_screen/20, env->height_screen/3};
+        szoveg_kiiro(env->renderer, font_meret, hiba_helye, uzenet);
+        SDL_RenderPresent(env->renderer);
+        return 0;
+    }
+    jatek_allapot_init(t);
     jatek(env, t);
+    return 0;
+}
+
+int pixel_cella(int p, int cellak, int pixelek){
+    return 1 + (int)((long long)p * cellak / pixelek);
+}
+
+int cella_helye(const Tabla *t, int sor, int oszlop, SDL_Rect *hova){
+    if(racs.cella > 0){
+        *hova = (SDL_Rect){racs.x + (oszlop-1)*racs.cella, racs.y + (sor-1)*racs.cella, racs.cella, racs.cella};
+        return 1;
+    }
+    // A cellát tartalmazó pixel; a cella csak akkor látszik, ha ő a pixel első cellája
+    int px = (int)((long long)(oszlop-1) * racs.w / (t->sz-2));
+    int py = (int)((long long)(sor-1) * racs.h / (t->m-2));
+    *hova = (SDL_Rect){racs.x + px, racs.y + py, 1, 1};
+    return pixel_cella(px, t->sz-2, racs.w) == oszlop && pixel_cella(py, t->m-2, racs.h) == sor;
 }
 
 void jatek_rajzol_cella(SDL_Renderer *renderer, Tabla *t, int sor, int oszlop){
-    SDL_Rect hova = t->rects[sor][oszlop];
-    if(t->g[sor][oszlop]){
+    Uint64 kezdet = meres_kezd();
+    SDL_Rect hova;
+    if(!cella_helye(t, sor, oszlop, &hova)){
+        meres_vege(m_rajzolas, kezdet);
+        return;
+    }
+    if(racs.cella == 0){
+        // Kicsinyítve nincs keret, egy cella egy pixel
+        if(CELLA(t, sor, oszlop) == 1)
+            pixelRGBA(renderer, hova.x, hova.y, 155, 255, 61, 255);
+        else if(CELLA(t, sor, oszlop))
+            pixelRGBA(renderer, hova.x, hova.y, 86, 142, 34, 255);
+        else
+            pixelRGBA(renderer, hova.x, hova.y, 17, 28, 7, 255);
+    }
+    else if(CELLA(t, sor, oszlop) == 1){
         boxRGBA(renderer, hova.x, hova.y, hova.x + hova.w, hova.y + hova.h, 155, 255, 61, 255);
     }
+    else if(CELLA(t, sor, oszlop)){
+        // Generations szabálynál a haldokló cella halványabb
+        boxRGBA(renderer, hova.x, hova.y, hova.x + hova.w, hova.y + hova.h, 86, 142, 34, 255);
+    }
     else{
         boxRGBA(renderer, hova.x, hova.y, hova.x + hova.w, hova.y + hova.h, 17, 28, 7, 255);
         rectangleRGBA(renderer, hova.x, hova.y, hova.x + hova.w, hova.y + hova.h, 155, 255, 61, 255);
     }
-    SDL_RenderPresent(renderer);
+    meres_vege(m_rajzolas, kezdet);
 }
 
 void jatek_kirajzol(SDL_Renderer *renderer, SDL_Rect hova, Tabla *t){
-    int cella_m = hova.h/(t->m-2), cella_sz = hova.w/(t->sz-2);
+    int cellak_sz = t->sz-2, cellak_m = t->m-2;
+    int cella_m = hova.h/cellak_m, cella_sz = hova.w/cellak_sz;
     // A cellák legyenek négyzet alakúak, akkor is ha a kivetítő felület nem az
     if (cella_m < cella_sz) {cella_sz = cella_m;}
     else {cella_m = cella_sz;}
 
-    // A játéktábla a megjelenitési felület közepén jelenjen meg
-    int jatektabla_szelesseg = cella_sz*(t->sz-2);
-    int jatektabla_magassag  = cella_m *(t->m-2 );
-    hova.x += ((hova.w-(jatektabla_szelesseg))/2);
-    hova.y += ((hova.h-(jatektabla_magassag ))/2);
+    racs.cella = cella_sz;
+    if(racs.cella > 0){
+        racs.w = cella_sz*cellak_sz;
+        racs.h = cella_m *cellak_m;
+    }
+    else{
+        // Nagyobb a tábla, mint a felület: az arányait megtartva kicsinyítve fér el
+        if((long long)cellak_sz * hova.h >= (long long)cellak_m * hova.w){
+            racs.w = hova.w;
+            racs.h = (int)((long long)cellak_m * hova.w / cellak_sz);
+        }
+        else{
+            racs.h = hova.h;
+            racs.w = (int)((long long)cellak_sz * hova.h / cellak_m);
+        }
+        if(racs.w < 1) racs.w = 1;
+        if(racs.h < 1) racs.h = 1;
+    }
 
+    // A játéktábla a megjelenitési felület közepén jelenjen meg
+    racs.x = hova.x + (hova.w-racs.w)/2;
+    racs.y = hova.y + (hova.h-racs.h)/2;
+
+    if(racs.cella == 0){
+        // Pixelenként egy cella: így a rajzolás a felület méretével arányos, nem a tábláéval
+        Uint64 kezdet = meres_kezd();
+        boxRGBA(renderer, racs.x, racs.y, racs.x + racs.w - 1, racs.y + racs.h - 1, 17, 28, 7, 255);
+        for(int py = 0; py < racs.h; py++){
+            const Cella *sor = &CELLA(t, pixel_cella(py, cellak_m, racs.h), 0);
+            for(int px = 0; px < racs.w; px++){
+                Cella c = sor[pixel_cella(px, cellak_sz, racs.w)];
+                if(c == 1)
+                    pixelRGBA(renderer, racs.x + px, racs.y + py, 155, 255, 61, 255);
+                else if(c)
+                    pixelRGBA(renderer, racs.x + px, racs.y + py, 86, 142, 34, 255);
+            }
+        }
+        meres_vege(m_rajzolas, kezdet);
+        return;
+    }
     for(int sor = 1; sor < (t->m-1); sor++){
         for (int oszlop = 1; oszlop < (t->sz-1); oszlop++){
-            SDL_Rect cella = {hova.x + (oszlop-1)*cella_sz, hova.y + (sor-1)*cella_m, cella_sz, cella_m};
-            t -> rects[sor][oszlop] = cella;
             jatek_rajzol_cella(renderer, t, sor, oszlop);
         }
     }
 }
 
+void jatek_megjelenit(Ablak_info *env, Tabla *t){
+    if(env->hud)
+        jatek_hud_rajzol(env, t);
+    else
+        MERES(m_megjelenites, SDL_RenderPresent(env->renderer));
+}
+
+void jatek_allapot_init(Tabla *t){
+    if(felvetel_aktiv)
+        jatek_felvetel_valt(t);
+    // A szegélyhez érő minta már az első lépés előtt nő, a többi állapot az új méretre készül
+    novekvo_init(&novekvo, t);
+    if(novekvo_aktiv)
+        novekvo_nov(&novekvo, t);
+    ciklus_init(&ciklus);
+    statisztika_torol(&statisztika);
+    if(!statisztika_init(&statisztika, t, JATEK_STATISZTIKA_ELOZMENY))
+        SDL_Log("Nem fert a memoriaba a statisztika, kikapcsolva\n");
+    tortenet_torol(&tortenet);
+    tortenet_init(&tortenet, t, JATEK_TORTENET_KULCS, JATEK_TORTENET_KERET);
+    if(!tortenet_aktiv(&tortenet))
+        SDL_Log("A tabla tul nagy a tortenethez, a visszalepes kikapcsolva\n");
+}
+
 void jatek(Ablak_info *env, Tabla *t){
     env->state = s_jatek;
     SDL_RenderClear(env->renderer);
@@ -244,18 +632,18 @@ void jatek(Ablak_info *env, Tabla *t){
     env->ikonok_helye.h = ikon_kirazol(env, Home, env->width_screen - 69, 5                      );
     env->ikonok_helye.s = ikon_kirazol(env, Save, env->width_screen - 69, env->height_screen - 69);
     env->ikonok_helye.n = ikon_kirazol(env, Next, 5,                      env->height_screen - 69);
-    env->ikonok_helye.p = ikon_kirazol(env, Play, 5,                      env->height_screen - (69 + 10 + 64)); // TODO
+    env->ikonok_helye.p = ikon_kirazol(env, env->fut ? Pause : Play, 5,                      env->height_screen - (69 + 10 + 64)); // TODO
 
     SDL_Rect canvas = {(env->width_screen)/10, 0, (8*env->width_screen)/10, env->height_screen};
     boxRGBA(env->renderer, canvas.x, canvas.y, canvas.x + canvas.w, canvas.y + canvas.h, 17, 28, 7, 255);
     rectangleRGBA(env->renderer, canvas.x, canvas.y, canvas.x + canvas.w, canvas.y + canvas.h, 155, 255, 61, 255);
     jatek_kirajzol(env->renderer, canvas, t);
-
+    jatek_megjelenit(env, t);
 }
 
 int jatek_kattint(Ablak_info *env, TTF_Font *font_mentes, Tabla *t, const int x, const int y){
     if(xy_in_rect(x, y, env->ikonok_helye.p)){
-        jatek_futtat(env, t);
+        jatek_futtat_valt(env);
         return 0;
     }
     if(xy_in_rect(x, y, env->ikonok_helye.n)){
@@ -263,150 +651,231 @@ int jatek_kattint(Ablak_info *env, TTF_Font *font_mentes, Tabla *t, const int x,
         return 0;
     }
     if(xy_in_rect(x, y, env->ikonok_helye.s)){
-        jatek_mentes(env, font_mentes, t);
+        jatek_mentes(env, font_mentes);
         return 0;
     }
     if(xy_in_rect(x, y, env->ikonok_helye.h)){
         return 1;
     }
-    for(int sor = 1; sor < (t->m-1); sor++){
-        for (int oszlop = 1; oszlop < (t->sz-1); oszlop++){
-            if(xy_in_rect(x, y, t->rects[sor][oszlop])){
-                // SDL_Log("Kattintva: (%d, %d), Ennek értéke:%d!\n", oszlop, sor, t->g[sor][oszlop]);
-                flip(t, sor, oszlop);
-                jatek_rajzol_cella(env->renderer, t, sor, oszlop);
-                return 0;
-            }
-        }
+    // A kattintott cella a rács helyéből számolható, a kicsinyített rajznál a pixel által mutatott cella
+    if(x < racs.x || y < racs.y || x >= racs.x + racs.w || y >= racs.y + racs.h)
+        return 0;
+    int sor = pixel_cella(y - racs.y, t->m - 2, racs.h), oszlop = pixel_cella(x - racs.x, t->sz - 2, racs.w);
+    // SDL_Log("Kattintva: (%d, %d), Ennek értéke:%d!\n", oszlop, sor, CELLA(t, sor, oszlop));
+    Cella regi = CELLA(t, sor, oszlop);
+    flip(t, sor, oszlop);
+    // A szegély mellé rajzolt cella miatt a tábla már a következő lépés előtt nő
+    if(novekvo_aktiv && novekvo_nov(&novekvo, t)){
+        jatek_allapot_init(t);
+        jatek(env, t);
+        return 0;
     }
+    ciklus_init(&ciklus);
+    statisztika_flip(&statisztika, t, sor, oszlop, regi);
+    tortenet_csonkit(&tortenet, t);
+    jatek_rajzol_cella(env->renderer, t, sor, oszlop);
+    MERES(m_megjelenites, SDL_RenderPresent(env->renderer));
     return 0;
 }
 
-void jatek_nextgen(Ablak_info *env, Tabla *t){
-    OszlopSor_Lista_Elem* fej = uj_generacio(t);
+int jatek_nextgen(Ablak_info *env, Tabla *t){
+    Uint64 kezdet = meres_kezd();
+    OszlopSor_Lista_Elem* fej;
+    MERES(m_generacio, fej = motor_lepes(t));
+    int uj_ciklus = ciklus_frissit(&ciklus, t);
+    statisztika_frissit(&statisztika, t, fej);
+    tortenet_rogzit(&tortenet, t, fej);
+    if(felvetel_aktiv)
+        felvetel_kepkocka(&felvetel, t);
     for(OszlopSor_Lista_Elem* iter = fej; iter != NULL; iter = iter->next){
         jatek_rajzol_cella(env->renderer, t, iter->sor, iter->oszlop);
     }
+    jatek_megjelenit(env, t);
+    meres_vege(m_kepkocka, kezdet);
+
+    valtozasok_felszabadit(fej);
+    if(uj_ciklus)
+        SDL_Log("A tabla ciklusba kerult: periodus %lld, kezdete a %lld. generacio\n", ciklus.periodus, ciklus.kezdet);
+    if(novekvo_aktiv && novekvo_igazit(&novekvo, t)){
+        jatek_allapot_init(t);
+        jatek(env, t);
+    }
+    return uj_ciklus;
+}
 
-    // free linked list
-    OszlopSor_Lista_Elem* elozo = NULL;
-    for(OszlopSor_Lista_Elem* iter = fej; iter != NULL; iter = iter->next){
-        free(elozo);
-        elozo = iter;
+int jatek_statisztika_csv(const char *fajlnev){
+    return statisztika_csv(&statisztika, fajlnev);
+}
+
+void jatek_torol(void){
+    statisztika_torol(&statisztika);
+    tortenet_torol(&tortenet);
+    if(felvetel_aktiv)
+        jatek_felvetel_valt(NULL);
+}
+
+void jatek_felvetel_valt(Tabla *t){
+    if(felvetel_aktiv){
+        felvetel_aktiv = 0;
+        int jo = felvetel_leallit(&felvetel);
+        SDL_Log("Felvetel leallitva: %lld kepkocka, %lld eldobva%s\n", felvetel.rogzitett, felvetel.eldobott, jo ? "" : ", HIBA az irasban");
+        return;
+    }
+    int cellameret = (JATEK_FELVETEL_SZELESSEG + t->sz - 3) / (t->sz - 2);
+    felvetel_aktiv = felvetel_indit(&felvetel, f_gif, "./felvetel.gif", t, cellameret, 0);
+    if(felvetel_aktiv){
+        SDL_Log("Felvetel: ./felvetel.gif\n");
+        felvetel_kepkocka(&felvetel, t);
     }
-    free(elozo);
 }
 
-void jatek_futtat(Ablak_info *env, Tabla *t){
-    boxRGBA(env->renderer, env->ikonok_helye.p.x, env->ikonok_helye.p.y, env->ikonok_helye.p.x + env->ikonok_helye.p.w, env->ikonok_helye.p.y + env->ikonok_helye.p.h, 17, 28, 7, 255);
-    ikon_kirazol(env, Pause, env->ikonok_helye.p.x, env->ikonok_helye.p.y);
-    SDL_RenderPresent(env->renderer);
-    int kilep = 0;
-    while (!kilep){
-        SDL_Event ev;
-        SDL_WaitEvent(&ev);
-        switch (ev.type) {
-            case SDL_MOUSEBUTTONDOWN:
-                if(ev.button.button == SDL_BUTTON_LEFT){
-                    kilep = 1;
-                }
-                break;
-
-            case SDL_KEYDOWN:
-                if (ev.key.keysym.sym == SDLK_ESCAPE){
-                    kilep = 1;
-                }
-                break;
-            
-            case SDL_WINDOWEVENT:
-                if(ev.window.event == SDL_WINDOWEVENT_RESIZED){
-                    SDL_PushEvent(&ev);
-                    kilep = 1;
-                }
-                break;
-
-            case SDL_QUIT:
-                SDL_PushEvent(&ev);
-                kilep = 1;
-                break;
-            
-            default:
-                SDL_PushEvent(&ev);
-        }
+void jatek_novekvo_valt(Ablak_info *env, Tabla *t){
+    novekvo_aktiv = !novekvo_aktiv;
+    novekvo_init(&novekvo, t);
+    SDL_Log("Novekvo tabla: %s\n", novekvo_aktiv ? "be" : "ki");
+    if(novekvo_aktiv && novekvo_nov(&novekvo, t)){
+        jatek_allapot_init(t);
+        jatek(env, t);
+    }
+}
+
+void jatek_ugras(Ablak_info *env, Tabla *t, long long cel){
+    // Előre, a történet végén túl egy lépés: ki kell számolni
+    if(cel == t->generacio + 1 && cel > tortenet_utolso(&tortenet)){
         jatek_nextgen(env, t);
+        return;
+    }
+    if(!tortenet_aktiv(&tortenet))
+        return;
+    if(cel < tortenet_elso(&tortenet))   cel = tortenet_elso(&tortenet);
+    if(cel > tortenet_utolso(&tortenet)) cel = tortenet_utolso(&tortenet);
+    if(cel == t->generacio)
+        return;
+
+    Uint64 kezdet = meres_kezd();
+    int siker;
+    OszlopSor_Lista_Elem *fej = tortenet_ugras(&tortenet, t, cel, &siker);
+    // A ciklusfigyelő és a statisztika csak előre haladva követhető, az ugrás után újraindulnak
+    ciklus_init(&ciklus);
+    statisztika_torol(&statisztika);
+    statisztika_init(&statisztika, t, JATEK_STATISZTIKA_ELOZMENY);
+    for(OszlopSor_Lista_Elem* iter = fej; iter != NULL; iter = iter->next){
+        jatek_rajzol_cella(env->renderer, t, iter->sor, iter->oszlop);
     }
+    jatek_megjelenit(env, t);
+    meres_vege(m_kepkocka, kezdet);
+    valtozasok_felszabadit(fej);
+}
+
+long long jatek_tortenet_elso(void){
+    return tortenet_elso(&tortenet);
+}
+
+void jatek_hud_valt(Ablak_info *env, Tabla *t){
+    env->hud = !env->hud;
+    if(env->hud)
+        jatek_hud_rajzol(env, t);
+    else
+        jatek(env, t);
+}
+
+void jatek_hud_rajzol(Ablak_info *env, Tabla *t){
+    // A szabály külön sorba kerül: egy LtL szabály önmagában kitöltheti a LTL_SZABALY_HOSSZ-t
+    char sorok[9][LTL_SZABALY_HOSSZ + 16];
+    char szabaly[LTL_SZABALY_HOSSZ];
+    motor_szabaly_kiir(szabaly);
+    snprintf(sorok[0], sizeof(sorok[0]), "gen/s:    %.1f", meres_per_masodperc(m_generacio));
+    snprintf(sorok[1], sizeof(sorok[1]), "kepkocka: %.2f ms", meres_atlag(m_kepkocka) / 1000.0);
+    snprintf(sorok[2], sizeof(sorok[2]), "nepesseg: %lld (+%lld/-%lld)", statisztika.jelen.nepesseg, statisztika.jelen.szuletes, statisztika.jelen.halalozas);
+    snprintf(sorok[3], sizeof(sorok[3]), "lepes p50/p99: %.0f/%.0f us", meres_percentilis(m_generacio, 50), meres_percentilis(m_generacio, 99));
+    snprintf(sorok[4], sizeof(sorok[4]), "trace: %s", meres_trace_aktiv() ? "be" : "ki");
+    if(ciklus.periodus)
+        snprintf(sorok[5], sizeof(sorok[5]), "ciklus: p=%lld, %lld. gen-tol%s", ciklus.periodus, ciklus.kezdet, env->ciklus_megall ? " (megall)" : "");
+    else
+        snprintf(sorok[5], sizeof(sorok[5]), "ciklus: -%s", env->ciklus_megall ? " (megall)" : "");
+
+    snprintf(sorok[6], sizeof(sorok[6]), "generacio: %lld, %dx%d%s", t->generacio, t->sz - 2, t->m - 2, novekvo_aktiv ? " (novekvo)" : "");
+    snprintf(sorok[7], sizeof(sorok[7]), "motor: %s", motor_aktiv()->nev);
+    snprintf(sorok[8], sizeof(sorok[8]), "szabaly: %s", szabaly);
+
+    // A doboz a leghosszabb sorhoz igazodik (a gfx betűi 8 pixel szélesek)
+    int szeles = 260;
+    for(int i = 0; i < 9; i++){
+        int kell = (int)strlen(sorok[i]) * 8 + 12;
+        if(kell > szeles)
+            szeles = kell;
+    }
+    int x = env->width_screen/10 + 5, y = 5;
+    boxRGBA(env->renderer, x, y, x + szeles, y + 9*12 + 8, 17, 28, 7, 230);
+    rectangleRGBA(env->renderer, x, y, x + szeles, y + 9*12 + 8, 155, 255, 61, 255);
+    for(int i = 0; i < 9; i++){
+        stringRGBA(env->renderer, x + 6, y + 6 + i*12, sorok[i], 155, 255, 61, 255);
+    }
+    MERES(m_megjelenites, SDL_RenderPresent(env->renderer));
+}
+
+void jatek_futtat_valt(Ablak_info *env){
+    env->fut = !env->fut;
     boxRGBA(env->renderer, env->ikonok_helye.p.x, env->ikonok_helye.p.y, env->ikonok_helye.p.x + env->ikonok_helye.p.w, env->ikonok_helye.p.y + env->ikonok_helye.p.h, 17, 28, 7, 255);
-    ikon_kirazol(env, Play, env->ikonok_helye.p.x, env->ikonok_helye.p.y);
+    ikon_kirazol(env, env->fut ? Pause : Play, env->ikonok_helye.p.x, env->ikonok_helye.p.y);
     SDL_RenderPresent(env->renderer);
 }
 
-void jatek_mentes(Ablak_info *env, TTF_Font *font_mentes, Tabla *t){
-    char name[63] = "./saves/";
+void jatek_futas_lepes(Ablak_info *env, Tabla *t){
+    if(jatek_nextgen(env, t) && env->ciklus_megall){
+        jatek_futtat_valt(env);
+    }
+}
+
+void jatek_mentes_felulet(Ablak_info *env){
+    env->state = s_mentes;
 
     // Háttér
     boxRGBA(env->renderer, 0, 0, env->width_screen, env->height_screen, 17, 28, 7, 220);
 
-    char beolvasott[51];
-    beolvasott[0] = '\0';
+    bevitel.teglalap.x = (env->width_screen-400)/2;
+    bevitel.teglalap.y = (env->height_screen-40)/2;
+    bevitel_rajzol(&bevitel, env->renderer);
+}
+
+void jatek_mentes(Ablak_info *env, TTF_Font *font_mentes){
+    if(env->fut){
+        jatek_futtat_valt(env);
+    }
     SDL_Rect hova = {(env->width_screen-400)/2, (env->height_screen-40)/2, 400, 40};
     SDL_Color hatter = {17, 28, 7};
     SDL_Color szoveg = {155, 255, 61};
-    int sikeres = input_text(beolvasott, 50, hova, hatter, szoveg, font_mentes, env->renderer);
-    strcat(name, beolvasott);
-    if(strlen(beolvasott) && sikeres){
+    bevitel_indit(&bevitel, 50, hova, hatter, szoveg, font_mentes);
+    jatek_mentes_felulet(env);
+}
+
+void jatek_mentes_rajzol(Ablak_info *env, Tabla *t){
+    jatek(env, t);
+    jatek_mentes_felulet(env);
+}
+
+void jatek_mentes_esemeny(Ablak_info *env, Tabla *t, const SDL_Event *ev){
+    int eredmeny = bevitel_esemeny(&bevitel, env->renderer, ev);
+    if(eredmeny == 0){
+        return;
+    }
+    if(eredmeny == 1 && strlen(bevitel.szoveg)){
+        char name[63] = "./saves/";
+        strcat(name, bevitel.szoveg);
         strcat(name, ".txt");
-        FILE* fp = fopen(name, "wt");
-        if(fp == NULL){
-            SDL_Log("Hiba a %s fajl megnyitasaban!\n", name); // placeholder for actual message to the usr
-        }
-        else{
-            fprintf(fp, "0.1\n");
-            fprintf(fp, "%d %d\n", t->sz, t->m);
-            for(int sor = 0; sor < (t->m); sor++){
-            for (int oszlop = 0; oszlop < (t->sz); oszlop++){
-                fprintf(fp, "%d", t->g[sor][oszlop]);
-                if (oszlop != (t->sz-1)){
-                    fputc(' ', fp);
-                }
-            }
-            fputc('\n', fp);
-            }
-            fclose(fp);
-        }
+        tabla_ment(name, t); // hiba esetén a tabla_ment logol, placeholder for actual message to the usr
     }
     jatek(env, t);
 }
 
 int betolt_betoltes(Ablak_info *env, char *name, Tabla *t){
-    
     char filename[63] = "./saves/";
     strcat(filename, name);
     strcat(filename, ".txt");
-    FILE* fp = fopen(filename, "rt");
-    if(fp == NULL){
-        SDL_Log("Hiba a %s fajl megnyitasaban!\n", filename);
+    if(!tabla_betolt(filename, t)){
         return 0;
     }
-
-    //fájl beolvasása
-    char v[4];
-    if (fscanf(fp, "%[^\n]", &v) == 0) {fclose(fp); return 0;}
-    v[4] = '\0';
-    if (strcmp(v, "0.1")) {fclose(fp); return 0;}
-    int szel, mag, hiba;
-    if (fscanf(fp, " %d%d%[^\n]", &szel, &mag, &hiba) != 2) {fclose(fp); return 0;}
-    init_tabla(t, szel-2, mag-2);
-
-    for (int sor = 0; sor < t->m; sor++) {
-        for (int oszlop = 0; oszlop < t->sz; oszlop++) {
-            int c;
-            fscanf(fp, "%d", &c);
-            // if (c != 0 || c != 1) {destroy_tabla(t); return 0;}
-            t->g[sor][oszlop] = c;
-        }
-    }
-    
-    fclose(fp);
+    jatek_allapot_init(t);
     jatek(env, t);
     return 1;
 }
@@ -414,124 +883,125 @@ int betolt_betoltes(Ablak_info *env, char *name, Tabla *t){
 SDL_Rect ikon_kirazol(Ablak_info *env, Icon ikon, int x, int y){
     SDL_Rect honnan = { (ikon % 3) * 64, (ikon / 3) * 64, 64, 64 };
     SDL_Rect hova = { x, y, 64, 64 };
-    SDL_RenderCopy(env->renderer, env->icons, &honnan, &hova);
+    SDL_RenderCopy(env->renderer, eroforras_kep(env->renderer, ek_ikonok), &honnan, &hova);
     return hova;
 }
 
-int input_text(char *dest, size_t hossz, SDL_Rect teglalap, SDL_Color hatter, SDL_Color szoveg, TTF_Font *font, SDL_Renderer *renderer) {
-    /* Ez tartalmazza az aktualis szerkesztest */
-    char composition[SDL_TEXTEDITINGEVENT_TEXT_SIZE];
-    composition[0] = '\0';
+void bevitel_indit(Bevitel *b, size_t hossz, SDL_Rect teglalap, SDL_Color hatter, SDL_Color szin, TTF_Font *font){
+    b->szoveg[0] = '\0';
+    b->composition[0] = '\0';
+    b->hossz = hossz < BEVITEL_MAX ? hossz : BEVITEL_MAX;
+    b->teglalap = teglalap;
+    b->hatter = hatter;
+    b->szin = szin;
+    b->font = font;
+    SDL_StartTextInput();
+}
+
+void bevitel_rajzol(const Bevitel *b, SDL_Renderer *renderer){
     /* Ezt a kirajzolas kozben hasznaljuk */
-    char textandcomposition[hossz + SDL_TEXTEDITINGEVENT_TEXT_SIZE + 1];
+    char textandcomposition[BEVITEL_MAX + SDL_TEXTEDITINGEVENT_TEXT_SIZE + 1];
+    SDL_Rect teglalap = b->teglalap;
+    SDL_Color hatter = b->hatter, szoveg = b->szin;
     /* Max hasznalhato szelesseg */
     int maxw = teglalap.w - 2;
     int maxh = teglalap.h - 2;
- 
-    dest[0] = '\0';
- 
-    int enter = 0;
-    int kilep = 0;
- 
-    SDL_StartTextInput();
-    while (!kilep && !enter) {
-        /* doboz kirajzolasa */
-        boxRGBA(renderer, teglalap.x, teglalap.y, teglalap.x + teglalap.w - 1, teglalap.y + teglalap.h - 1, hatter.r, hatter.g, hatter.b, 255);
-        rectangleRGBA(renderer, teglalap.x, teglalap.y, teglalap.x + teglalap.w - 1, teglalap.y + teglalap.h - 1, szoveg.r, szoveg.g, szoveg.b, 255);
-        /* szoveg kirajzolasa */
-        int w;
-        strcpy(textandcomposition, dest);
-        strcat(textandcomposition, composition);
-        if (textandcomposition[0] != '\0') {
-            SDL_Surface *felirat = TTF_RenderUTF8_Blended(font, textandcomposition, szoveg);
-            SDL_Texture *felirat_t = SDL_CreateTextureFromSurface(renderer, felirat);
-            SDL_Rect cel = { teglalap.x, teglalap.y, felirat->w < maxw ? felirat->w : maxw, felirat->h < maxh ? felirat->h : maxh };
-            SDL_RenderCopy(renderer, felirat_t, NULL, &cel);
-            SDL_FreeSurface(felirat);
-            SDL_DestroyTexture(felirat_t);
-            w = cel.w;
-        } else {
-            w = 0;
-        }
-        /* kurzor kirajzolasa */
-        if (w < maxw) {
-            vlineRGBA(renderer, teglalap.x + w + 2, teglalap.y + 2, teglalap.y + teglalap.h - 3, szoveg.r, szoveg.g, szoveg.b, 192);
-        }
-        /* megjeleniti a képernyon az eddig rajzoltakat */
-        SDL_RenderPresent(renderer);
- 
-        SDL_Event event;
-        SDL_WaitEvent(&event);
-        switch (event.type) {
-            /* Kulonleges karakter */
-            case SDL_KEYDOWN:
-                if (event.key.keysym.sym == SDLK_BACKSPACE) {
-                    int textlen = strlen(dest);
-                    do {
-                        if (textlen == 0) {
-                            break;
-                        }
-                        if ((dest[textlen-1] & 0x80) == 0x00)   {
-                            /* Egy bajt */
-                            dest[textlen-1] = 0x00;
-                            break;
-                        }
-                        if ((dest[textlen-1] & 0xC0) == 0x80) {
-                            /* Bajt, egy tobb-bajtos szekvenciabol */
-                            dest[textlen-1] = 0x00;
-                            textlen--;
-                        }
-                        if ((dest[textlen-1] & 0xC0) == 0xC0) {
-                            /* Egy tobb-bajtos szekvencia elso bajtja */
-                            dest[textlen-1] = 0x00;
-                            break;
-                        }
-                    } while(1);
-                }
-                if (event.key.keysym.sym == SDLK_RETURN) {
-                    enter = 1;
-                }
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    kilep = 1;
-                }
-                break;
- 
-            /* A feldolgozott szoveg bemenete */
-            case SDL_TEXTINPUT:
-                if (strlen(dest) + strlen(event.text.text) < hossz) {
-                    strcat(dest, event.text.text);
-                }
- 
-                /* Az eddigi szerkesztes torolheto */
-                composition[0] = '\0';
-                break;
- 
-            /* Szoveg szerkesztese */
-            case SDL_TEXTEDITING:
-                strcpy(composition, event.edit.text);
-                break;
-
-            case SDL_MOUSEBUTTONDOWN:
-                if (event.button.button == SDL_BUTTON_LEFT) 
-                    if (!xy_in_rect(event.button.x, event.button.y, teglalap))
-                        kilep = 1;
-                break;
-
-            case SDL_QUIT:
-                /* visszatesszuk a sorba ezt az eventet, mert
-                 * sok mindent nem tudunk vele kezdeni */
-                SDL_PushEvent(&event);
-                kilep = 1;
-                break;
-            
-            default:
-                SDL_PushEvent(&event);
-        }
+
+    /* doboz kirajzolasa */
+    boxRGBA(renderer, teglalap.x, teglalap.y, teglalap.x + teglalap.w - 1, teglalap.y + teglalap.h - 1, hatter.r, hatter.g, hatter.b, 255);
+    rectangleRGBA(renderer, teglalap.x, teglalap.y, teglalap.x + teglalap.w - 1, teglalap.y + teglalap.h - 1, szoveg.r, szoveg.g, szoveg.b, 255);
+    /* szoveg kirajzolasa */
+    int w;
+    strcpy(textandcomposition, b->szoveg);
+    strcat(textandcomposition, b->composition);
+    if (textandcomposition[0] != '\0') {
+        SDL_Surface *felirat = TTF_RenderUTF8_Blended(b->font, textandcomposition, szoveg);
+        SDL_Texture *felirat_t = SDL_CreateTextureFromSurface(renderer, felirat);
+        SDL_Rect cel = { teglalap.x, teglalap.y, felirat->w < maxw ? felirat->w : maxw, felirat->h < maxh ? felirat->h : maxh };
+        SDL_RenderCopy(renderer, felirat_t, NULL, &cel);
+        SDL_FreeSurface(felirat);
+        SDL_DestroyTexture(felirat_t);
+        w = cel.w;
+    } else {
+        w = 0;
     }
- 
-    /* 1 jelzi a helyes beolvasast; = ha enter miatt allt meg a ciklus */
-    SDL_StopTextInput();
-    return enter;
+    /* kurzor kirajzolasa */
+    if (w < maxw) {
+        vlineRGBA(renderer, teglalap.x + w + 2, teglalap.y + 2, teglalap.y + teglalap.h - 3, szoveg.r, szoveg.g, szoveg.b, 192);
+    }
+    /* megjeleniti a képernyon az eddig rajzoltakat */
+    SDL_RenderPresent(renderer);
+}
+
+int bevitel_esemeny(Bevitel *b, SDL_Renderer *renderer, const SDL_Event *ev){
+    char *dest = b->szoveg;
+    int eredmeny = 0;
+    switch (ev->type) {
+        /* Kulonleges karakter */
+        case SDL_KEYDOWN:
+            if (ev->key.keysym.sym == SDLK_BACKSPACE) {
+                int textlen = strlen(dest);
+                do {
+                    if (textlen == 0) {
+                        break;
+                    }
+                    if ((dest[textlen-1] & 0x80) == 0x00)   {
+                        /* Egy bajt */
+                        dest[textlen-1] = 0x00;
+                        break;
+                    }
+                    if ((dest[textlen-1] & 0xC0) == 0x80) {
+                        /* Bajt, egy tobb-bajtos szekvenciabol */
+                        dest[textlen-1] = 0x00;
+                        textlen--;
+                    }
+                    if ((dest[textlen-1] & 0xC0) == 0xC0) {
+                        /* Egy tobb-bajtos szekvencia elso bajtja */
+                        dest[textlen-1] = 0x00;
+                        break;
+                    }
+                } while(1);
+            }
+            if (ev->key.keysym.sym == SDLK_RETURN) {
+                eredmeny = 1;
+            }
+            if (ev->key.keysym.sym == SDLK_ESCAPE) {
+                eredmeny = -1;
+            }
+            break;
+
+        /* A feldolgozott szoveg bemenete */
+        case SDL_TEXTINPUT:
+            if (strlen(dest) + strlen(ev->text.text) < b->hossz) {
+                strcat(dest, ev->text.text);
+            }
+
+            /* Az eddigi szerkesztes torolheto */
+            b->composition[0] = '\0';
+            break;
+
+        /* Szoveg szerkesztese */
+        case SDL_TEXTEDITING:
+            strcpy(b->composition, ev->edit.text);
+            break;
+
+        case SDL_MOUSEBUTTONDOWN:
+            if (ev->button.button == SDL_BUTTON_LEFT)
+                if (!xy_in_rect(ev->button.x, ev->button.y, b->teglalap))
+                    eredmeny = -1;
+            break;
+
+        default:
+            /* Nem a bevitelhez tartozó esemény, nincs mit újrarajzolni */
+            return 0;
+    }
+
+    if (eredmeny != 0) {
+        SDL_StopTextInput();
+    } else {
+        bevitel_rajzol(b, renderer);
+    }
+    return eredmeny;
 }
 
 int sugo_kattint(Ablak_info *env, const int x, const int y){
@@ -609,48 +1079,63 @@ void sugo(Ablak_info *env, TTF_Font *font_sugo, SDL_Texture *kep){
     SDL_RenderPresent(env->renderer);
 }
 
-int betolt_kattint(Ablak_info *env, Tabla *t, const int x, const int y){
-    if(xy_in_rect(x, y, env->ikonok_helye.h)){
-        return 1;
-    }
-
+int mentesek_listaz(char nevek[MENTESEK_MAX][255]){
+    char mappa[] = "./saves";
+    int cnt = 0;
+#ifdef _WIN32
     HANDLE find_h = NULL;
     WIN32_FIND_DATA file;
     char path[1023];
-    char filename[255];
-    char mappa[] = "./saves";
-
     sprintf(path, "%s/*.txt", mappa);
-
     if((find_h = FindFirstFile(path, &file)) == INVALID_HANDLE_VALUE){
         SDL_Log("Hiba a %s path-on.", mappa);
-        exit(1);
+        return 0;
     }
-
-    SDL_Rect gombok[10];
-    char filenames[10][255];
-    int cnt = 0;
     do{
-        if(strcmp(file.cFileName, ".") != 0 && strcmp(file.cFileName, "..") != 0){
-            sprintf(filename, "%s", file.cFileName);
-            filename[strlen(filename)-4] = '\0';
-            gombok[cnt].x = 5;
-            gombok[cnt].y = env->height_screen/12 + cnt*(env->height_screen/12 + env->height_screen/12/11);
-            gombok[cnt].w = env->width_screen-10;
-            gombok[cnt].h = env->height_screen/12;
-            strcpy(filenames[cnt],filename);
+        size_t hossz = strlen(file.cFileName);
+        if(hossz > 4 && hossz < 255){
+            strcpy(nevek[cnt], file.cFileName);
+            nevek[cnt++][hossz-4] = '\0';
+        }
+    } while(cnt < MENTESEK_MAX && FindNextFile(find_h, &file));
+    FindClose(find_h);
+#else
+    DIR *d = opendir(mappa);
+    if(d == NULL){
+        SDL_Log("Hiba a %s path-on.", mappa);
+        return 0;
+    }
+    struct dirent *e;
+    while(cnt < MENTESEK_MAX && (e = readdir(d)) != NULL){
+        size_t hossz = strlen(e->d_name);
+        if(hossz > 4 && hossz < 255 && strcmp(e->d_name + hossz - 4, ".txt") == 0){
+            strcpy(nevek[cnt], e->d_name);
+            nevek[cnt++][hossz-4] = '\0';
         }
-    } while(++cnt<10 && FindNextFile(find_h, &file));
+    }
+    closedir(d);
+#endif
+    return cnt;
+}
 
-    for(int i = 0; i<=cnt; i++){
-        if(xy_in_rect(x, y, gombok[i])){
+SDL_Rect mentes_gomb(const Ablak_info *env, int i){
+    SDL_Rect gomb = {5, env->height_screen/12 + i*(env->height_screen/12 + env->height_screen/12/11), env->width_screen-10, env->height_screen/12};
+    return gomb;
+}
+
+int betolt_kattint(Ablak_info *env, Tabla *t, const int x, const int y){
+    if(xy_in_rect(x, y, env->ikonok_helye.h)){
+        return 1;
+    }
+
+    char filenames[MENTESEK_MAX][255];
+    int cnt = mentesek_listaz(filenames);
+    for(int i = 0; i<cnt; i++){
+        if(xy_in_rect(x, y, mentes_gomb(env, i))){
             betolt_betoltes(env, filenames[i], t);
-            FindClose(find_h);
             return 0;
         }
     }
-
-    FindClose(find_h);
     return 0;
 }
 
@@ -661,33 +1146,14 @@ void betolt(Ablak_info *env, TTF_Font *font_betolt){
     // Háttér
     boxRGBA(env->renderer, 0, 0, env->width_screen, env->height_screen, 17, 28, 7, 255);
 
-    HANDLE find_h = NULL;
-    WIN32_FIND_DATA file;
-    char path[1023];
-    char filename[255];
-    char mappa[] = "./saves";
-
-    sprintf(path, "%s/*.txt", mappa);
-
-    if((find_h = FindFirstFile(path, &file)) == INVALID_HANDLE_VALUE){
-        SDL_Log("Hiba a %s path-on.", mappa);
-        exit(1);
-    }
-
-    int cnt = 0;
-    do{
-        if(strcmp(file.cFileName, ".") != 0 && strcmp(file.cFileName, "..") != 0){
-            sprintf(filename, "%s", file.cFileName);
-            filename[strlen(filename)-4] = '\0';
-            SDL_Rect gomb = {5, env->height_screen/12 + cnt*(env->height_screen/12 + env->height_screen/12/11), env->width_screen-10, env->height_screen/12};
-            rajzol_gomb(env->renderer, font_betolt, gomb, filename);
-        }
-    } while(++cnt<10 && FindNextFile(find_h, &file));
+    char filenames[MENTESEK_MAX][255];
+    int cnt = mentesek_listaz(filenames);
+    for(int i = 0; i<cnt; i++)
+        rajzol_gomb(env->renderer, font_betolt, mentes_gomb(env, i), filenames[i]);
 
     char szoveg[] = "Kérlek válassz a mentések közül!";
     SDL_Rect szoveg_rect = {5, 5, env->width_screen-10, env->height_screen/12-10};
     szoveg_kiiro(env->renderer, font_betolt, szoveg_rect, szoveg);
     env->ikonok_helye.h = ikon_kirazol(env, Home, env->width_screen-69, 5);
-    FindClose(find_h);
     SDL_RenderPresent(env->renderer);
 }
\ No newline at end of file
@@ -31,7 +31,9 @@ typedef enum Allapot{
     /** A mentés választó menü, a betöltés gomb megnyomása után */
     s_betolt,
     /** A súgó, a súgó gomb megnyomása után */
-    s_sugo
+    s_sugo,
+    /** A mentés nevének bekérése a játéktábla fölött */
+    s_mentes
 }Allapot;
 
 /**
@@ -64,15 +66,19 @@ typedef struct Ikonok_hely{
  * @param state
  * @param width_screen
  * @param height_screen
- * @param icons
  * @param ikonok_helye
+ * @param hud 1, ha az s_jatek állapotban látszik a teljesítményt mutató kijelző
+ * @param ciklus_megall 1, ha a futó szimuláció megáll, amint a tábla ciklusba kerül
+ * @param fut 1, ha az s_jatek állapotban fut a szimuláció: a fő ciklus ekkor nem vár eseményre, minden körben lép egyet
  */
 typedef struct Ablak_info{
     SDL_Renderer *renderer;
     Allapot state;
     int width_screen, height_screen;
-    SDL_Texture *icons;
     Ikonok_hely ikonok_helye;
+    int hud;
+    int ciklus_megall;
+    int fut;
 }Ablak_info;
 
 /**
@@ -100,12 +106,22 @@ int xy_in_rect(const int x, const int y, SDL_Rect rect);
 void menu(Ablak_info *env, TTF_Font *font_menu, Harom_hely *gombok_helye);
 /**
  * @brief Megváltoztatja az Ablak_info objektum state-jét s_tabla_meret-re.
- * Eltüntet bármit ami épp a képernyőn van és kirajzolja a tábla méretét kiválasztó felületet.
- * Inicializálja a Tabla objektumot a megadott adatokkal.
+ * Eltüntet bármit ami épp a képernyőn van, kirajzolja a tábla méretét kiválasztó felületet, és elkezdi a szélesség bekérését.
+ * Nem vár a bevitelre: az eseményeket a tabla_meret_esemeny dolgozza fel.
  * @param env
+ * @param font_meret
+ */
+void tabla_meret(Ablak_info *env, TTF_Font *font_meret);
+/**
+ * @brief Az s_tabla_meret állapot eseménykezelője: a szélesség, majd a magasság bevitele.
+ * Ha mindkettő megvan, inicializálja a Tabla objektumot a megadott adatokkal, és átvált s_jatek-ra.
+ * @param env
+ * @param font_meret Ugyanaz a font, mint a tabla_meret-nél
  * @param t
+ * @param ev
+ * @return 1, ha ki kell lépni a menübe (Esc), egyébként 0
  */
-void tabla_meret(Ablak_info *env, TTF_Font *font_meret, Tabla *t);
+int tabla_meret_esemeny(Ablak_info *env, TTF_Font *font_meret, Tabla *t, const SDL_Event *ev);
 /**
  * @brief Megváltoztatja az Ablak_info objektum state-jét s_jatek-ra.
  * Eltüntet bármit ami épp a képernyőn van és kirajzolja a játéktáblát.
@@ -132,18 +148,92 @@ int jatek_kattint(Ablak_info *env, TTF_Font *font_mentes, Tabla *t, int x, int y
  * Ki is rajzolja a változásokat.
  * @param env
  * @param t
+ * @return 1, ha ebben a lépésben derült ki, hogy a tábla ciklusba került, különben 0
+ */
+int jatek_nextgen(Ablak_info *env, Tabla *t);
+/**
+ * @brief A játéktábla megőrzött statisztikáit (népesség, születések, halálozások, befoglaló téglalap) CSV fájlba menti.
+ * @param fajlnev
+ * @return 1 ha sikeres
+ */
+int jatek_statisztika_csv(const char *fajlnev);
+/**
+ * @brief Felszabadítja a játék állapotához tartozó memóriát (statisztikák). A program végén hívandó.
+ */
+void jatek_torol(void);
+/**
+ * @brief Felszabadítja a kirajzolt szövegek gyorsítótárát. A fontok bezárása és a program vége előtt hívandó.
+ */
+void szoveg_cache_torol(void);
+/**
+ * @brief A játéktáblát a történet cel generációjára állítja (visszaléptetés, ugrás), és kirajzolja a változásokat.
+ * Ha a cel a történet utáni első generáció, kiszámolja (jatek_nextgen); különben a történet elejére/végére korlátozza.
+ * A ciklusfigyelő és a statisztika az ugrás után újraindul.
+ * @param env
+ * @param t
+ * @param cel
+ */
+void jatek_ugras(Ablak_info *env, Tabla *t, long long cel);
+/**
+ * @brief Elindítja/leállítja a játéktábla GIF felvételét (./felvetel.gif, minden lépés egy képkocka, lásd GoL_felvetel.h).
+ * Új tábla létrehozásakor/betöltésekor és a jatek_torol-ben magától leáll.
+ * @param t Leállításkor nem használt
+ */
+void jatek_felvetel_valt(Tabla *t);
+/**
+ * @brief Be-/kikapcsolja a tábla automatikus növekedését (lásd GoL_novekvo.h). Bekapcsoláskor, ha a minta a szegély
+ * közelében van, a tábla azonnal nő.
+ * Ha a tábla átméreteződik, a ciklusfigyelő, a statisztika és a történet újraindul, és a tábla újra kirajzolódik.
+ * @param env
+ * @param t
+ */
+void jatek_novekvo_valt(Ablak_info *env, Tabla *t);
+/**
+ * @brief A történet legrégebbi, még visszaállítható generációja (-1 ha a történet ki van kapcsolva, erre a jatek_ugras nem lép).
  */
-void jatek_nextgen(Ablak_info *env, Tabla *t);
+long long jatek_tortenet_elso(void);
 /**
- * @brief A felhasználótól bekér egy nevet, majd elmenti a játéktér jelenlegi állapotát azzal a névvel a ./saves mappába.
- * Elenőrzi, hogy a név már foglalt -e, vagy tartalmaz -e invalid karaktereket. Szól a felhasználónak ha igen.
- * Szól ha nem sikerült a mentés.
+ * @brief Ki/be kapcsolja a teljesítményt mutató kijelzőt (generáció/mp, képkocka idő, népesség, lépésidő p50/p99).
+ * Kikapcsoláskor újrarajzolja a játékteret.
+ * @param env
+ * @param t
+ */
+void jatek_hud_valt(Ablak_info *env, Tabla *t);
+/**
+ * @brief A felhasználótól bekér egy nevet, hogy azzal a névvel a ./saves mappába mentse a játéktér jelenlegi állapotát.
+ * Megállítja a futó szimulációt, átvált s_mentes-re, és kirajzolja a beolvasódobozt; a bevitelt és a mentést
+ * a jatek_mentes_esemeny végzi.
  * @warning Léteznie kell egy ./saves mappának!
  * @param env 
  * @param font_mentes A mentés nevének megadásához használandó betöltött betűtípus.
- * @param t 
  */
-void jatek_mentes(Ablak_info *env, TTF_Font *font_mentes, Tabla *t);
+void jatek_mentes(Ablak_info *env, TTF_Font *font_mentes);
+/**
+ * @brief Az s_mentes állapot eseménykezelője: a név bevitele, Enter-re a mentés.
+ * A bevitel végén (Enter, Esc, vagy kattintás a dobozon kívül) visszavált s_jatek-ra.
+ * @param env
+ * @param t
+ * @param ev
+ */
+void jatek_mentes_esemeny(Ablak_info *env, Tabla *t, const SDL_Event *ev);
+/**
+ * @brief Kirajzolja a mentés név bekérő felületét a játéktábla fölé (átméretezés után), a már beírt szöveggel.
+ * @param env
+ * @param t
+ */
+void jatek_mentes_rajzol(Ablak_info *env, Tabla *t);
+/**
+ * @brief Elindítja, illetve megállítja a szimuláció folyamatos futtatását, és átrajzolja a Play/Pause ikont.
+ * @param env
+ */
+void jatek_futtat_valt(Ablak_info *env);
+/**
+ * @brief A futó szimuláció egy lépése, a fő ciklus minden körében hívandó, amíg env->fut.
+ * Ha a tábla ciklusba kerül és a ciklus_megall be van kapcsolva, megállítja a futtatást.
+ * @param env
+ * @param t
+ */
+void jatek_futas_lepes(Ablak_info *env, Tabla *t);
 /**
  * @brief A name nevű fájlt beolvassa, ha létezik tartalmát megjeleníti.
  * Ha nem sikeres a beolvasás, 0-t ad vissza.
@@ -154,19 +244,6 @@ void jatek_mentes(Ablak_info *env, TTF_Font *font_mentes, Tabla *t);
  * @return 1 ha sikeres
  */
 int betolt_betoltes(Ablak_info *env, char *name, Tabla *t);
-/**
- * @brief Beolvas egy szöveget a billentyűzetről.
- * A kódrészlet az infoC oldalról származik apró módosításokkal.
- * @param dest A tömb, ahová a beolvasott szöveg kerül, \0-val a végén.
- * @param hossz A maximális hossz, ami beolvasható, \0-vel együtt.
- * @param teglalap A beolvasódoboz helye.
- * @param hatter A háttár színe.
- * @param szoveg A szöveg színe.
- * @param font A rajzoláshoz használt font.
- * @param renderer 
- * @return 1 ha sikerült, 0 ha nem sikerült a beolvasás
- */
-int input_text(char *dest, size_t hossz, SDL_Rect teglalap, SDL_Color hatter, SDL_Color szoveg, TTF_Font *font, SDL_Renderer *renderer);
 /**
  * @brief Ellenőrzi az (x,y) koordináta helyét.
  * Ha az a home ikon belsejében van, 1 a visszatérési érték és ki kell lépni a főmenübe.
@@ -0,0 +1,126 @@
+/**
+ * @file GoL_idoblokk.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A csempénkénti, több generációs léptetés megvalósítása.
+ * @version 0.1
+ * @date 2021-11-30
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_idoblokk.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief A tábla egy téglalapját a helyi pufferbe másolja; a táblán kívül eső részt nullákkal tölti ki.
+ * @param t
+ * @param helyi A helyi puffer, helyi_lepes hosszú sorokkal
+ * @param helyi_lepes
+ * @param sor0 A téglalap bal felső sarka a táblán (lehet negatív is)
+ * @param oszlop0
+ * @param mag A téglalap magassága
+ * @param szel A téglalap szélessége
+ */
+static void csempe_betolt(Tabla *t, Cella *helyi, int helyi_lepes, int sor0, int oszlop0, int mag, int szel);
+
+/**
+ * @brief Egy generációt lép a helyi puffer megadott téglalapján belül.
+ * A hívó úgy választja a téglalapot, hogy csak a tábla belsejébe eső cellák legyenek benne, így a szegély és a táblán kívüli rész halott marad.
+ * @param regi
+ * @param uj
+ * @param helyi_lepes
+ * @param sor_tol A számolandó sorok [sor_tol, sor_ig) intervalluma a helyi pufferben
+ * @param sor_ig
+ * @param oszlop_tol A számolandó oszlopok [oszlop_tol, oszlop_ig) intervalluma
+ * @param oszlop_ig
+ */
+static void csempe_lepes(const Cella *regi, Cella *uj, int helyi_lepes, int sor_tol, int sor_ig, int oszlop_tol, int oszlop_ig);
+
+void csempe_betolt(Tabla *t, Cella *helyi, int helyi_lepes, int sor0, int oszlop0, int mag, int szel){
+    memset(helyi, 0, (size_t)mag * helyi_lepes);
+    int oszlop_tol = oszlop0 < 0 ? -oszlop0 : 0;
+    int oszlop_ig = oszlop0 + szel > t->sz ? t->sz - oszlop0 : szel;
+    for(int i = 0; i < mag; i++){
+        int sor = sor0 + i;
+        if(sor < 0 || sor >= t->m)
+            continue;
+        memcpy(helyi + (size_t)i * helyi_lepes + oszlop_tol, &CELLA(t, sor, oszlop0 + oszlop_tol), oszlop_ig - oszlop_tol);
+    }
+}
+
+void csempe_lepes(const Cella *regi, Cella *uj, int helyi_lepes, int sor_tol, int sor_ig, int oszlop_tol, int oszlop_ig){
+    for(int i = sor_tol; i < sor_ig; i++){
+        const Cella *fent = regi + (size_t)(i-1) * helyi_lepes;
+        const Cella *kozep = fent + helyi_lepes;
+        const Cella *lent = kozep + helyi_lepes;
+        Cella *ki = uj + (size_t)i * helyi_lepes;
+        for(int j = oszlop_tol; j < oszlop_ig; j++){
+            int szomszedok = fent[j-1] + fent[j] + fent[j+1] + kozep[j-1] + kozep[j+1] + lent[j-1] + lent[j] + lent[j+1];
+            ki[j] = (szomszedok == 3) | (kozep[j] & (szomszedok == 2));
+        }
+    }
+}
+
+OszlopSor_Lista_Elem* idoblokk_lepes(Tabla *t, int k, int csempe){
+    if(k < 1) k = 1;
+    if(k > IDOBLOKK_MAX_K) k = IDOBLOKK_MAX_K;
+    if(csempe < 1) csempe = IDOBLOKK_CSEMPE;
+    int oldal = csempe + 2*k;
+    Cella *a = malloc((size_t)oldal * oldal);
+    Cella *b = malloc((size_t)oldal * oldal);
+    if(a == NULL || b == NULL){
+        free(a);
+        free(b);
+        return NULL;
+    }
+    OszlopSor_Lista_Elem *fej = NULL;
+
+    for(int sor0 = 1; sor0 < t->m-1; sor0 += csempe){
+        int csempe_mag = (sor0 + csempe > t->m-1) ? t->m-1 - sor0 : csempe;
+        for(int oszlop0 = 1; oszlop0 < t->sz-1; oszlop0 += csempe){
+            int csempe_szel = (oszlop0 + csempe > t->sz-1) ? t->sz-1 - oszlop0 : csempe;
+            // A csempe k cellányi szegéllyel: k lépés után a szegély elromlik, de a csempe belseje még pontos
+            int mag = csempe_mag + 2*k, szel = csempe_szel + 2*k;
+            int helyi_sor0 = sor0 - k, helyi_oszlop0 = oszlop0 - k;
+            csempe_betolt(t, a, oldal, helyi_sor0, helyi_oszlop0, mag, szel);
+            memcpy(b, a, (size_t)mag * oldal); // így a soha nem számolt (táblán kívüli) cellák mindkét pufferben halottak
+
+            // A tábla belseje a helyi pufferben; ezen kívül minden cella mindig halott
+            int belso_sor_tol = 1 - helyi_sor0, belso_sor_ig = t->m-1 - helyi_sor0;
+            int belso_oszlop_tol = 1 - helyi_oszlop0, belso_oszlop_ig = t->sz-1 - helyi_oszlop0;
+            for(int lepes = 1; lepes <= k; lepes++){
+                // Az i. lépés után a pereméről i cellányi rész érvénytelen, azt nem érdemes számolni
+                int sor_tol = lepes > belso_sor_tol ? lepes : belso_sor_tol;
+                int sor_ig = mag - lepes < belso_sor_ig ? mag - lepes : belso_sor_ig;
+                int oszlop_tol = lepes > belso_oszlop_tol ? lepes : belso_oszlop_tol;
+                int oszlop_ig = szel - lepes < belso_oszlop_ig ? szel - lepes : belso_oszlop_ig;
+                csempe_lepes(a, b, oldal, sor_tol, sor_ig, oszlop_tol, oszlop_ig);
+                Cella *csere = a;
+                a = b;
+                b = csere;
+            }
+
+            for(int i = 0; i < csempe_mag; i++){
+                const Cella *eredmeny = a + (size_t)(i + k) * oldal + k;
+                const Cella *regi = &CELLA(t, sor0 + i, oszlop0);
+                Cella *uj = t->kov + (size_t)(sor0 + i) * t->lepes + oszlop0;
+                memcpy(uj, eredmeny, csempe_szel);
+                for(int j = 0; j < csempe_szel; j++)
+                    if(eredmeny[j] != regi[j])
+                        fej = valtozas_felvesz(fej, sor0 + i, oszlop0 + j);
+            }
+        }
+    }
+    free(a);
+    free(b);
+    generacio_lezar(t, fej, k);
+    return fej;
+}
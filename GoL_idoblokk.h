@@ -0,0 +1,38 @@
+/**
+ * @file GoL_idoblokk.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Több generációs léptetés csempénként (temporal blocking).
+ * A táblát cache-be férő csempékre bontja; minden csempét k cellányi átfedő szegéllyel együtt egy helyi pufferbe másol,
+ * ott k generációt lép, majd a csempe közepét visszaírja. Így a nagy tábla k generációnként csak egyszer megy át a memórián.
+ * @version 0.1
+ * @date 2021-11-30
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_IDOBLOKK_H
+#define GOL_IDOBLOKK_H
+
+#include "GoL_logics.h"
+
+/** Az alapértelmezett csempeméret cellában; két (csempe+2k)^2 bájtos helyi puffer még bőven elfér az L2-ben */
+#define IDOBLOKK_CSEMPE 128
+/** Ennél több generációt egyszerre nem lép (a szegély miatti többletszámolás k-val nő) */
+#define IDOBLOKK_MAX_K 32
+
+/**
+ * @brief k generációval lépteti a táblát, csempénként.
+ * Az eredmény cellánként megegyezik k egymás utáni uj_generacio hívással.
+ * A visszaadott lista a k lépés összesített ("nettó") változása: azok a cellák, amik a kiinduló és a végső állapotban különböznek.
+ * Ez alapján frissül a hash, a generáció számláló pedig k-val nő.
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param t
+ * @param k A generációk száma, 1 és IDOBLOKK_MAX_K között
+ * @param csempe A csempe oldalhossza cellában (IDOBLOKK_CSEMPE, az ellenőrzés kisebbel is hívja)
+ * @return a megváltoztatott cellák. Ha a csempék pufferei nem foglalhatók le, NULL, és a tábla (a generáció számláló is)
+ * változatlan marad; ezt a hívó a generáció számlálóból látja.
+ */
+OszlopSor_Lista_Elem* idoblokk_lepes(Tabla* t, int k, int csempe);
+
+#endif
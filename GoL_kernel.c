@@ -0,0 +1,142 @@
+/**
+ * @file GoL_kernel.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A specializált lépésmotor megvalósítása.
+ * @version 0.1
+ * @date 2021-12-05
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_kernel.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/*
+ * A szomszédok összege a j. oszlopban; f, k, l a cella fölötti, a cella és a cella alatti sor.
+ * A szegély miatt egyik sem lóg ki a táblából.
+ */
+#define SZOMSZEDOK_MOORE(f, k, l, j)   (f[(j)-1] + f[j] + f[(j)+1] + k[(j)-1] + k[(j)+1] + l[(j)-1] + l[j] + l[(j)+1])
+#define SZOMSZEDOK_NEUMANN(f, k, l, j) (f[j] + k[(j)-1] + k[(j)+1] + l[j])
+#define SZOMSZEDOK_HATSZOG(f, k, l, j) (f[(j)-1] + f[j] + k[(j)-1] + k[(j)+1] + l[j] + l[(j)+1])
+
+/** A szabály táblázata: [állapot << 4 | szomszédok] a cella új állapota */
+static Cella szabaly_tabla[32];
+static int szabaly_kesz = 0;
+
+/**
+ * @brief Tórusz peremnél a szegélyt a szemközti szélekről tölti fel (a sarkokat is).
+ */
+static void szegely_kitolt(Tabla *t);
+
+/**
+ * @brief Visszaállítja a szegélyt halottra.
+ */
+static void szegely_torol(Tabla *t);
+
+/**
+ * @brief Egy specializált lépésfüggvény: a SZOMSZEDOK kifejezés és a TORUSZ konstans fordítási időben rögzített.
+ * A függvény csak a kov belsejét írja és összegyűjti a változásokat; a lezárás a kernel_generacio dolga.
+ */
+#define KERNEL(nev, SZOMSZEDOK, TORUSZ) \
+    static OszlopSor_Lista_Elem* nev(Tabla *t){ \
+        OszlopSor_Lista_Elem *fej = NULL; \
+        if(TORUSZ) \
+            szegely_kitolt(t); \
+        for(int sor = 1; sor < t->m - 1; sor++){ \
+            const Cella *f = t->g + (size_t)(sor - 1) * t->lepes; \
+            const Cella *k = f + t->lepes, *l = k + t->lepes; \
+            Cella *uj = t->kov + (size_t)sor * t->lepes; \
+            for(int j = 1; j < t->sz - 1; j++){ \
+                uj[j] = szabaly_tabla[k[j] << 4 | SZOMSZEDOK(f, k, l, j)]; \
+                if(uj[j] != k[j]) \
+                    fej = valtozas_felvesz(fej, sor, j); \
+            } \
+        } \
+        if(TORUSZ) \
+            szegely_torol(t); \
+        return fej; \
+    }
+
+KERNEL(moore_halott, SZOMSZEDOK_MOORE, 0)
+KERNEL(moore_torusz, SZOMSZEDOK_MOORE, 1)
+KERNEL(neumann_halott, SZOMSZEDOK_NEUMANN, 0)
+KERNEL(neumann_torusz, SZOMSZEDOK_NEUMANN, 1)
+KERNEL(hatszog_halott, SZOMSZEDOK_HATSZOG, 0)
+KERNEL(hatszog_torusz, SZOMSZEDOK_HATSZOG, 1)
+
+/** A lépésfüggvények [szomszédság][perem] szerint */
+static OszlopSor_Lista_Elem* (*const kernelek[3][2])(Tabla *t) = {
+    {moore_halott, moore_torusz},
+    {neumann_halott, neumann_torusz},
+    {hatszog_halott, hatszog_torusz},
+};
+
+static OszlopSor_Lista_Elem* (*aktiv)(Tabla *t) = moore_halott;
+
+static const char *nevek[] = {"moore", "neumann", "hatszog"};
+
+int szomszedsag_beolvas(const char *nev, Szomszedsag *szomszedsag){
+    for(int i = 0; i < 3; i++){
+        if(strcmp(nevek[i], nev) == 0){
+            *szomszedsag = (Szomszedsag)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char* szomszedsag_nev(Szomszedsag szomszedsag){
+    return nevek[szomszedsag];
+}
+
+void szegely_kitolt(Tabla *t){
+    int m = t->m, sz = t->sz;
+    for(int sor = 1; sor < m - 1; sor++){
+        CELLA(t, sor, 0) = CELLA(t, sor, sz - 2);
+        CELLA(t, sor, sz - 1) = CELLA(t, sor, 1);
+    }
+    // A teljes sorok másolása a sarkokat is kitölti
+    memcpy(&CELLA(t, 0, 0), &CELLA(t, m - 2, 0), sz);
+    memcpy(&CELLA(t, m - 1, 0), &CELLA(t, 1, 0), sz);
+}
+
+void szegely_torol(Tabla *t){
+    int m = t->m, sz = t->sz;
+    for(int sor = 1; sor < m - 1; sor++){
+        CELLA(t, sor, 0) = 0;
+        CELLA(t, sor, sz - 1) = 0;
+    }
+    memset(&CELLA(t, 0, 0), 0, sz);
+    memset(&CELLA(t, m - 1, 0), 0, sz);
+}
+
+void kernel_beallit(Szomszedsag szomszedsag, Perem perem){
+    aktiv = kernelek[szomszedsag][perem];
+}
+
+void kernel_szabaly(const Szabaly *sz){
+    memset(szabaly_tabla, 0, sizeof(szabaly_tabla));
+    for(int n = 0; n <= 8; n++){
+        szabaly_tabla[n] = (sz->szuletes >> n) & 1;
+        szabaly_tabla[1 << 4 | n] = (sz->tuleles >> n) & 1;
+    }
+    szabaly_kesz = 1;
+}
+
+OszlopSor_Lista_Elem* kernel_generacio(Tabla *t){
+    if(!szabaly_kesz){
+        Szabaly conway = SZABALY_CONWAY;
+        kernel_szabaly(&conway);
+    }
+    OszlopSor_Lista_Elem *fej = aktiv(t);
+    generacio_lezar(t, fej, 1);
+    return fej;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file GoL_kernel.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Szomszédságonként és peremenként specializált lépésmotor.
+ * Minden (szomszédság, perem) párhoz fordítási időben külön lépésfüggvény készül (a GoL_kernel.c KERNEL makrójával),
+ * amiben a szomszédok összege kiírt kifejezés, a perem pedig konstans, így a belső ciklusban nincs a beállítástól függő elágazás.
+ * A szabály egy 32 elemű táblázat ([állapot << 4 | szomszédok] -> új állapot), a választás egyetlen függvénymutató.
+ * Szomszédságok (a cella a középen, X a szomszéd):
+ *  - moore:   XXX   neumann:  .X.   hatszog:  XX.
+ *             X.X             X.X             X.X
+ *             XXX             .X.             .XX
+ *    (a hatszögrács "ferde" koordinátákkal: minden sor fél cellával jobbra tolódik az előzőhöz képest)
+ * Perem: halott (a tábla szélén túl minden cella halott) vagy tórusz (a szemközti szélek összeérnek).
+ * @version 0.1
+ * @date 2021-12-05
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_KERNEL_H
+#define GOL_KERNEL_H
+
+#include "GoL_logics.h"
+
+/**
+ * @brief A szomszédság alakja.
+ */
+typedef enum Szomszedsag{
+    sz_moore, sz_neumann, sz_hatszog
+}Szomszedsag;
+
+/**
+ * @brief A tábla peremén túli cellák.
+ */
+typedef enum Perem{
+    p_halott, p_torusz
+}Perem;
+
+/**
+ * @brief A szomszédság nevéből (moore, neumann, hatszog) a szomszédság.
+ * @return 1 ha ismert
+ */
+int szomszedsag_beolvas(const char *nev, Szomszedsag *szomszedsag);
+
+/**
+ * @brief A szomszédság neve.
+ */
+const char* szomszedsag_nev(Szomszedsag szomszedsag);
+
+/**
+ * @brief Kiválasztja a szomszédsághoz és peremhez tartozó lépésfüggvényt. Amíg nem hívják, Moore szomszédság, halott perem.
+ * @param szomszedsag
+ * @param perem
+ */
+void kernel_beallit(Szomszedsag szomszedsag, Perem perem);
+
+/**
+ * @brief Beállítja a motor szabályát. Amíg nem hívják, a Conway-féle szabállyal dolgozik.
+ * @param sz
+ */
+void kernel_szabaly(const Szabaly *sz);
+
+/**
+ * @brief A szimulációt továbblépteti a következő állásba a beállított szomszédsággal, peremmel és szabállyal.
+ * Minden szempontból az uj_generacio-val egyezően viselkedik (változáslista, hash, generáció számláló); a tábla szegélye
+ * tórusz peremnél is halott marad (a lépés idejére töltődik fel a szemközti szélekből).
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param t
+ * @return a megváltoztatott cellák
+ */
+OszlopSor_Lista_Elem* kernel_generacio(Tabla *t);
+
+#endif
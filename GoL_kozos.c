@@ -0,0 +1,267 @@
+/**
+ * @file GoL_kozos.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Az osztott memóriás keretgyűrű megvalósítása.
+ * @version 0.1
+ * @date 2021-12-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_kozos.h"
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+#ifdef _WIN32
+
+int kozos_indit(Kozos_gyuru *gy, const char *nev, const Tabla *t, int rekeszek){
+    (void)gy; (void)nev; (void)t; (void)rekeszek;
+    fprintf(stderr, "Az osztott memorias kozzetetel csak POSIX rendszeren erheto el\n");
+    return 0;
+}
+
+void kozos_kozzetesz(Kozos_gyuru *gy, const Tabla *t){
+    (void)gy; (void)t;
+}
+
+void kozos_leallit(Kozos_gyuru *gy){
+    (void)gy;
+}
+
+int kozos_csatlakozik(Kozos_gyuru *gy, const char *nev){
+    (void)gy; (void)nev;
+    fprintf(stderr, "Az osztott memorias kozzetetel csak POSIX rendszeren erheto el\n");
+    return 0;
+}
+
+void kozos_lecsatlakozik(Kozos_gyuru *gy){
+    (void)gy;
+}
+
+const Kozos_keret* kozos_olvasas_kezd(const Kozos_gyuru *gy, uint32_t sorszam, uint32_t *szamlalo){
+    (void)gy; (void)sorszam; (void)szamlalo;
+    return NULL;
+}
+
+int kozos_olvasas_vege(const Kozos_keret *k, uint32_t szamlalo){
+    (void)k; (void)szamlalo;
+    return 0;
+}
+
+const uint8_t* kozos_keret_adat(const Kozos_gyuru *gy, const Kozos_keret *k){
+    (void)gy; (void)k;
+    return NULL;
+}
+
+int kozos_olvas(const Kozos_gyuru *gy, uint32_t sorszam, Tabla *t, Kozos_keret *k){
+    (void)gy; (void)sorszam; (void)t; (void)k;
+    return 0;
+}
+
+#else
+
+/**
+ * @brief A sorszam. keret helye a gyűrűben.
+ */
+static Kozos_keret* keret(const Kozos_gyuru *gy, uint32_t sorszam);
+
+/**
+ * @brief 8 egymás utáni cella (kis végű 64 bites szóként beolvasva) élő celláinak bitjei, az első a legalsó bit.
+ * Csak az 1 állapotú cella él (a többállapotú szabályok haldokló cellái nem).
+ */
+static inline uint8_t csomagol(uint64_t cellak);
+
+Kozos_keret* keret(const Kozos_gyuru *gy, uint32_t sorszam){
+    const Kozos_fejlec *f = gy->fejlec;
+    return (Kozos_keret*)((uint8_t*)f + KOZOS_FEJLEC_MERET + (size_t)((sorszam - 1) % f->rekeszek) * f->keret_meret);
+}
+
+uint8_t csomagol(uint64_t cellak){
+    const uint64_t egyesek = 0x0101010101010101ULL, also7 = 0x7F7F7F7F7F7F7F7FULL;
+    // Az 1-es bájtok nullává válnak; a nulla bájtok felső bitje a szokásos "van-e nulla bájt" trükkel
+    uint64_t x = cellak ^ egyesek;
+    uint64_t elo = ~(((x & also7) + also7) | x | also7) >> 7;
+    // A bájtonkénti 0/1 értékek egy bájtba gyűjtése szorzással
+    return (uint8_t)((elo * 0x0102040810204080ULL) >> 56);
+}
+
+int kozos_indit(Kozos_gyuru *gy, const char *nev, const Tabla *t, int rekeszek){
+    if(rekeszek < 2 || strlen(nev) >= sizeof(gy->nev))
+        return 0;
+    uint32_t sz = t->sz - 2, m = t->m - 2;
+    uint32_t sor_bajt = ((sz + 63) / 64) * 8;
+    size_t keret_meret = (sizeof(Kozos_keret) + (size_t)m * sor_bajt + 63) / 64 * 64;
+    size_t meret = KOZOS_FEJLEC_MERET + (size_t)rekeszek * keret_meret;
+    if(keret_meret > UINT32_MAX)
+        return 0;
+    int fd = shm_open(nev, O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if(fd < 0)
+        return 0;
+    if(ftruncate(fd, (off_t)meret) != 0){
+        close(fd);
+        shm_unlink(nev);
+        return 0;
+    }
+    void *p = mmap(NULL, meret, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED){
+        shm_unlink(nev);
+        return 0;
+    }
+    // Az ftruncate nullákkal tölti fel: minden keret számlálója és sorszáma 0, ilyen sorszámú keret nincs
+    Kozos_fejlec *f = p;
+    f->verzio = KOZOS_VERZIO;
+    f->rekeszek = rekeszek;
+    f->sz = sz;
+    f->m = m;
+    f->sor_bajt = sor_bajt;
+    f->keret_meret = (uint32_t)keret_meret;
+    f->kozzetett = 0;
+    f->lezarva = 0;
+    SDL_MemoryBarrierRelease();
+    // Az azonosító kerül be utoljára, így a félig kitöltött fejlécet egy olvasó sem fogadja el
+    memcpy(f->varazs, KOZOS_VARAZS, 8);
+    gy->fejlec = f;
+    gy->meret = meret;
+    strcpy(gy->nev, nev);
+    return 1;
+}
+
+void kozos_kozzetesz(Kozos_gyuru *gy, const Tabla *t){
+    Kozos_fejlec *f = gy->fejlec;
+    uint32_t sorszam = f->kozzetett + 1;
+    if(sorszam == 0)
+        sorszam = 1;
+    Kozos_keret *k = keret(gy, sorszam);
+    uint32_t szamlalo = k->szamlalo;
+    k->szamlalo = szamlalo + 1;
+    SDL_MemoryBarrierRelease();
+
+    uint8_t *adat = (uint8_t*)(k + 1);
+    uint64_t nepesseg = 0;
+    int bajtok = (int)((f->sz + 7) / 8);
+    // Az utolsó bájt felesleges bitjei a szegély utáni memóriából jönnének
+    uint8_t utolso_maszk = (uint8_t)(f->sz % 8 ? (1u << (f->sz % 8)) - 1 : 0xFF);
+    for(uint32_t sor = 0; sor < f->m; sor++){
+        const Cella *r = t->g + (size_t)(sor + 1) * t->lepes + 1;
+        uint8_t *cel = adat + (size_t)sor * f->sor_bajt;
+        for(int j = 0; j < bajtok; j++){
+            uint64_t cellak;
+            memcpy(&cellak, r + 8 * j, sizeof(cellak));
+            uint8_t b = csomagol(cellak);
+            if(j == bajtok - 1)
+                b &= utolso_maszk;
+            cel[j] = b;
+            nepesseg += __builtin_popcount(b);
+        }
+        memset(cel + bajtok, 0, f->sor_bajt - bajtok);
+    }
+    k->sorszam = sorszam;
+    k->generacio = t->generacio;
+    k->hash = t->hash;
+    k->nepesseg = nepesseg;
+
+    SDL_MemoryBarrierRelease();
+    k->szamlalo = szamlalo + 2;
+    SDL_MemoryBarrierRelease();
+    f->kozzetett = sorszam;
+}
+
+void kozos_leallit(Kozos_gyuru *gy){
+    SDL_MemoryBarrierRelease();
+    gy->fejlec->lezarva = 1;
+    munmap(gy->fejlec, gy->meret);
+    shm_unlink(gy->nev);
+    gy->fejlec = NULL;
+}
+
+int kozos_csatlakozik(Kozos_gyuru *gy, const char *nev){
+    int fd = shm_open(nev, O_RDONLY, 0);
+    if(fd < 0)
+        return 0;
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < KOZOS_FEJLEC_MERET){
+        close(fd);
+        return 0;
+    }
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED)
+        return 0;
+    const Kozos_fejlec *f = p;
+    if(memcmp(f->varazs, KOZOS_VARAZS, 8) != 0 || f->verzio != KOZOS_VERZIO ||
+       KOZOS_FEJLEC_MERET + (size_t)f->rekeszek * f->keret_meret > (size_t)st.st_size){
+        munmap(p, st.st_size);
+        return 0;
+    }
+    SDL_MemoryBarrierAcquire();
+    gy->fejlec = p;
+    gy->meret = st.st_size;
+    gy->nev[0] = '\0';
+    return 1;
+}
+
+void kozos_lecsatlakozik(Kozos_gyuru *gy){
+    munmap(gy->fejlec, gy->meret);
+    gy->fejlec = NULL;
+}
+
+const Kozos_keret* kozos_olvasas_kezd(const Kozos_gyuru *gy, uint32_t sorszam, uint32_t *szamlalo){
+    uint32_t kozzetett = gy->fejlec->kozzetett;
+    // A sorszámok körbeérhetnek, ezért a különbség előjele dönt
+    if(sorszam == 0 || (int32_t)(kozzetett - sorszam) < 0)
+        return NULL;
+    const Kozos_keret *k = keret(gy, sorszam);
+    *szamlalo = k->szamlalo;
+    SDL_MemoryBarrierAcquire();
+    if((*szamlalo & 1) || k->sorszam != sorszam)
+        return NULL;
+    return k;
+}
+
+int kozos_olvasas_vege(const Kozos_keret *k, uint32_t szamlalo){
+    SDL_MemoryBarrierAcquire();
+    return k->szamlalo == szamlalo;
+}
+
+const uint8_t* kozos_keret_adat(const Kozos_gyuru *gy, const Kozos_keret *k){
+    (void)gy;
+    return (const uint8_t*)(k + 1);
+}
+
+int kozos_olvas(const Kozos_gyuru *gy, uint32_t sorszam, Tabla *t, Kozos_keret *k){
+    const Kozos_fejlec *f = gy->fejlec;
+    uint32_t szamlalo;
+    const Kozos_keret *forras = kozos_olvasas_kezd(gy, sorszam, &szamlalo);
+    if(forras == NULL)
+        return 0;
+    *k = *forras;
+    const uint8_t *adat = kozos_keret_adat(gy, forras);
+    for(uint32_t sor = 0; sor < f->m; sor++){
+        const uint8_t *r = adat + (size_t)sor * f->sor_bajt;
+        Cella *cel = t->g + (size_t)(sor + 1) * t->lepes + 1;
+        for(uint32_t oszlop = 0; oszlop < f->sz; oszlop++)
+            cel[oszlop] = (r[oszlop >> 3] >> (oszlop & 7)) & 1;
+    }
+    if(!kozos_olvasas_vege(forras, szamlalo))
+        return 0;
+    t->generacio = k->generacio;
+    t->hash = k->hash;
+    return 1;
+}
+
+#endif
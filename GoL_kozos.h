@@ -0,0 +1,166 @@
+/**
+ * @file GoL_kozos.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A generációk közzététele POSIX osztott memóriában, külső megjelenítőknek és elemzőknek.
+ * A közzétevő egy rekeszek darab keretből álló gyűrűbe írja a generációkat, bitekbe csomagolva; az olvasók (más
+ * folyamatok) a saját címterükbe képezik le a gyűrűt, és másolás, fájlművelet nélkül olvashatják a kereteket.
+ * A kereteket seqlock védi: a keret számlálója írás közben páratlan, utána páros. Az olvasó az olvasás előtt és után is
+ * megnézi a számlálót; ha közben változott (vagy páratlan volt), a keretet felülírták, és az olvasott adat nem érvényes.
+ * A közzétevő így sosem vár az olvasókra; a lemaradt olvasó kimarad egy-egy keretből, és ezt észre is veszi.
+ *
+ * Az elrendezés (minden egész kis végű, a mezők természetes igazítással):
+ *  fejléc (KOZOS_FEJLEC_MERET bájt): Kozos_fejlec
+ *  utána rekeszek darab keret, egyenként keret_meret bájt: Kozos_keret, utána m sor, soronként sor_bajt bájt;
+ *  a sor oszlop. cellája az oszlop/8. bájt oszlop%8. bitje (a legalsó bit az első), 1 ha a cella él.
+ *  A sorszam. keret (1-től számozva) a (sorszam-1) % rekeszek. rekeszben van.
+ * Csak POSIX rendszeren érhető el.
+ * @version 0.1
+ * @date 2021-12-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_KOZOS_H
+#define GOL_KOZOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "GoL_logics.h"
+
+/** A fejléc azonosítója */
+#define KOZOS_VARAZS "GOLGYURU"
+/** Az elrendezés verziója */
+#define KOZOS_VERZIO 1
+/** A fejléc mérete (a keretek ettől kezdődnek) */
+#define KOZOS_FEJLEC_MERET 64
+/** Ennyi keret van a gyűrűben, ha a hívó nem ad meg mást */
+#define KOZOS_ALAP_REKESZEK 8
+
+/**
+ * @brief A gyűrű fejléce.
+ * @param varazs KOZOS_VARAZS (lezáró nulla nélkül)
+ * @param verzio KOZOS_VERZIO
+ * @param rekeszek A keretek száma
+ * @param sz A tábla szélessége (szegély nélkül)
+ * @param m A tábla magassága (szegély nélkül)
+ * @param sor_bajt Egy csomagolt sor mérete bájtban (8-ra kerekítve)
+ * @param keret_meret Egy keret mérete a Kozos_keret fejléccel együtt
+ * @param kozzetett Az utoljára közzétett keret sorszáma, 0 ha még nincs (a keret megírása után nő)
+ * @param lezarva 1 ha a közzétevő befejezte, több keret nem jön
+ */
+typedef struct Kozos_fejlec{
+    char varazs[8];
+    uint32_t verzio;
+    uint32_t rekeszek;
+    uint32_t sz, m;
+    uint32_t sor_bajt;
+    uint32_t keret_meret;
+    volatile uint32_t kozzetett;
+    volatile uint32_t lezarva;
+}Kozos_fejlec;
+
+/**
+ * @brief Egy keret fejléce; utána jönnek a csomagolt sorok.
+ * @param szamlalo A seqlock számlálója: páratlan, amíg a közzétevő írja a keretet
+ * @param sorszam A keret sorszáma (1-től)
+ * @param generacio
+ * @param hash A tábla tabla_hash-e
+ * @param nepesseg Az élő cellák száma
+ */
+typedef struct Kozos_keret{
+    volatile uint32_t szamlalo;
+    uint32_t sorszam;
+    int64_t generacio;
+    uint64_t hash;
+    uint64_t nepesseg;
+}Kozos_keret;
+
+/**
+ * @brief Egy leképezett gyűrű (a közzétevőé vagy egy olvasóé).
+ * @param fejlec A leképezés eleje
+ * @param meret A leképezés mérete
+ * @param nev Az osztott memória neve (csak a közzétevőnél, a leállításkor ezzel törli)
+ */
+typedef struct Kozos_gyuru{
+    Kozos_fejlec *fejlec;
+    size_t meret;
+    char nev[256];
+}Kozos_gyuru;
+
+/**
+ * @brief Létrehozza az osztott memóriát a tábla méretéhez (egy korábbi, azonos nevűt felülír).
+ * @warning A kozos_leallit-tal lezárandó!!
+ * @param gy
+ * @param nev Az osztott memória neve, '/'-rel kezdődik (pl. "/gol")
+ * @param t A tábla, aminek a méretével a gyűrű készül
+ * @param rekeszek A keretek száma, legalább 2
+ * @return 1 ha sikeres
+ */
+int kozos_indit(Kozos_gyuru *gy, const char *nev, const Tabla *t, int rekeszek);
+
+/**
+ * @brief Közzéteszi a tábla jelenlegi generációját a következő keretben. Nem foglal memóriát és nem vár.
+ * @param gy
+ * @param t Ugyanakkora tábla, mint az indításkor
+ */
+void kozos_kozzetesz(Kozos_gyuru *gy, const Tabla *t);
+
+/**
+ * @brief Jelzi az olvasóknak, hogy vége, leképezi és törli az osztott memóriát (a csatlakozott olvasók még olvashatják).
+ * @param gy
+ */
+void kozos_leallit(Kozos_gyuru *gy);
+
+/**
+ * @brief Csatlakozik egy közzétevő gyűrűjéhez (csak olvasásra).
+ * @warning A kozos_lecsatlakozik-kal lezárandó!!
+ * @param gy
+ * @param nev
+ * @return 1 ha sikeres, 0 ha nincs ilyen, vagy nem egyező verziójú gyűrű
+ */
+int kozos_csatlakozik(Kozos_gyuru *gy, const char *nev);
+
+/**
+ * @brief Leválasztja az olvasót a gyűrűről.
+ * @param gy
+ */
+void kozos_lecsatlakozik(Kozos_gyuru *gy);
+
+/**
+ * @brief Az olvasás kezdete (másolás nélküli olvasáshoz): a sorszam. keret, ha épp elérhető.
+ * Az adatot a visszaadott keret után a helyén lehet olvasni, de csak akkor érvényes, ha utána a kozos_olvasas_vege 1-et ad.
+ * @param gy
+ * @param sorszam
+ * @param szamlalo ide írja a seqlock számlálóját, ezt kell a kozos_olvasas_vege-nek átadni
+ * @return a keret, NULL ha a keret még nem készült el, vagy már felülírták
+ */
+const Kozos_keret* kozos_olvasas_kezd(const Kozos_gyuru *gy, uint32_t sorszam, uint32_t *szamlalo);
+
+/**
+ * @brief Az olvasás vége: ellenőrzi, hogy a keretet nem írták-e felül olvasás közben.
+ * @param k
+ * @param szamlalo A kozos_olvasas_kezd-től kapott számláló
+ * @return 1 ha a közben olvasott adat érvényes
+ */
+int kozos_olvasas_vege(const Kozos_keret *k, uint32_t szamlalo);
+
+/**
+ * @brief A keret csomagolt sorai.
+ * @param gy
+ * @param k
+ * @return a 0. sor első bájtja
+ */
+const uint8_t* kozos_keret_adat(const Kozos_gyuru *gy, const Kozos_keret *k);
+
+/**
+ * @brief Kimásolja a sorszam. keretet egy táblába (kényelmi függvény a keret olvasásához).
+ * @param gy
+ * @param sorszam
+ * @param t A gyűrűvel egyező méretű tábla; sikertelen olvasáskor a tartalma nem meghatározott
+ * @param k ide másolja a keret fejlécét
+ * @return 1 ha sikeres, 0 ha a keret még nem készült el, vagy már felülírták
+ */
+int kozos_olvas(const Kozos_gyuru *gy, uint32_t sorszam, Tabla *t, Kozos_keret *k);
+
+#endif
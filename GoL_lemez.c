@@ -0,0 +1,83 @@
+/**
+ * @file GoL_lemez.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A sávonkénti, lemezre optimalizált lépés megvalósítása.
+ * @version 0.1
+ * @date 2021-12-10
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_memoria.h"
+#include "GoL_motor.h"
+#include "GoL_lemez.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief Tanácsot ad a [sor_tol, sor_ig) sorokra mindkét pufferben.
+ * @param t
+ * @param sor_tol
+ * @param sor_ig A táblán túli része elmarad
+ * @param tanacs
+ */
+static void sorok_tanacs(const Tabla *t, int sor_tol, int sor_ig, Memoria_tanacs tanacs);
+
+void sorok_tanacs(const Tabla *t, int sor_tol, int sor_ig, Memoria_tanacs tanacs){
+    if(sor_tol < 0)
+        sor_tol = 0;
+    if(sor_ig > t->m)
+        sor_ig = t->m;
+    if(sor_tol >= sor_ig)
+        return;
+    size_t eleje = (size_t)sor_tol * t->lepes, hossz = (size_t)(sor_ig - sor_tol) * t->lepes;
+    memoria_tanacs(t->g + eleje, hossz, tanacs);
+    memoria_tanacs(t->kov + eleje, hossz, tanacs);
+}
+
+int lemez_lepes_kompatibilis(void){
+    return motor_alap_topologia() && motor_aktiv_ltl() == NULL;
+}
+
+OszlopSor_Lista_Elem* lemez_lepes(Tabla *t){
+    OszlopSor_Lista_Elem *fej = NULL, **vege = &fej;
+    uint64_t hash = t->hash;
+    for(int sor0 = 1; sor0 < t->m - 1; sor0 += LEMEZ_SAV){
+        int sorok = t->m - 1 - sor0 < LEMEZ_SAV ? t->m - 1 - sor0 : LEMEZ_SAV;
+        sorok_tanacs(t, sor0 + LEMEZ_SAV, sor0 + (LEMEZ_ELORE + 1) * LEMEZ_SAV + 1, mt_kell);
+
+        // A sáv egy nézet a táblára a két szomszédos sorral együtt; a motor csak a belsejét, vagyis a sáv sorait írja.
+        // Az alsó szomszéd sorba a motor legfeljebb halott cellát ír a kov-ban, azt a következő sáv úgyis felülírja
+        Tabla sav = *t;
+        sav.g = t->g + (size_t)(sor0 - 1) * t->lepes;
+        sav.kov = t->kov + (size_t)(sor0 - 1) * t->lepes;
+        sav.m = sorok + 2;
+        sav.eltolas_sor = t->eltolas_sor + sor0 - 1;
+        sav.hash = 0;
+        OszlopSor_Lista_Elem *sav_fej = motor_lepes(&sav);
+        // A sáv hash-e a változások kulcsainak XOR-ja (globális koordinátákkal), ez épp a tábla hash-ének változása
+        hash ^= sav.hash;
+        *vege = sav_fej;
+        for(OszlopSor_Lista_Elem *iter = sav_fej; iter != NULL; iter = iter->next){
+            iter->sor += sor0 - 1;
+            vege = &iter->next;
+        }
+
+        // A következő sáv az utolsó sort még olvassa, az előtte lévőket már nem
+        sorok_tanacs(t, sor0 - 1 - LEMEZ_SAV, sor0 + sorok - 1, mt_hideg);
+    }
+    // A nézetek a saját másolatukban cseréltek; a tábla pufferei itt cserélődnek
+    Cella *csere = t->g;
+    t->g = t->kov;
+    t->kov = csere;
+    t->hash = hash;
+    t->generacio++;
+    return fej;
+}
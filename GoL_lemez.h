@@ -0,0 +1,43 @@
+/**
+ * @file GoL_lemez.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A lemezen tárolt (tar_lemez) tábla léptetése: a memóriánál nagyobb táblák futtatása.
+ * A tábla két puffere egy-egy fájlra leképezett blokk (memoria_fajl_foglal), az elrendezésük ugyanaz, mint a memóriában,
+ * így minden motor változtatás nélkül működik rajtuk. A lemez_lepes a táblát LEMEZ_SAV soros, teljes szélességű sávokban
+ * (csempékben) lépteti: egy sáv a fájlban folytonos, és a sávok sorban követik egymást, így a lemezt végig sorban olvassa.
+ * Minden sáv előtt a következő LEMEZ_ELORE sávot előre kéri (madvise WILLNEED), a már nem kellő sávokat pedig hidegnek
+ * jelöli (MADV_COLD), így a memóriában egyszerre csak néhány sáv van, és a lépés sebességét a lemez sávszélessége adja.
+ * A változáslista a memóriában marad, a mérete a változások számával, nem a tábla méretével arányos.
+ * Csak két állapotú, egy sugarú szabállyal és halott peremmel működik (a sávoknak egy sornyi átfedésük van).
+ * @version 0.1
+ * @date 2021-12-10
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_LEMEZ_H
+#define GOL_LEMEZ_H
+
+#include "GoL_logics.h"
+
+/** Egy sáv ennyi sorból áll */
+#define LEMEZ_SAV 256
+/** A feldolgozott sáv után ennyi sávot kér előre */
+#define LEMEZ_ELORE 2
+
+/**
+ * @brief A lemez_lepes használható-e az aktuális szabállyal és topológiával (B/S szabály, Moore szomszédság, halott perem).
+ */
+int lemez_lepes_kompatibilis(void);
+
+/**
+ * @brief Egy generációt lép az aktuális motorral, sávonként (lásd a fájl leírását). Az eredménye a motor_lepes-ével azonos.
+ * Sűrű (tar_suru) táblán is működik, csak ott nincs haszna.
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param t
+ * @return a megváltoztatott cellák
+ */
+OszlopSor_Lista_Elem* lemez_lepes(Tabla *t);
+
+#endif
@@ -0,0 +1,524 @@
+/**
+ * @file GoL_leves.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A leveskeresés megvalósítása.
+ * @version 0.1
+ * @date 2021-12-05
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_memoria.h"
+#include "GoL_leves.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief Egy leves a memóriában.
+ * @param puffer A két puffer (az aréna része), puffer[g] a jelenlegi állapot
+ * @param g
+ * @param valt_min Soronként a legutóbbi lépésben változott cellák első oszlopa (valt_min[v], a másik az előző lépésé)
+ * @param valt_max Soronként a legutóbbi lépésben változott cellák utolsó oszlopa; a sorban nem volt változás, ha min > max
+ * @param v
+ * @param elso Az első sor, amiben a legutóbbi lépésben változás volt (az ezen kívüli sorok valt_ elemei érvénytelenek)
+ * @param utolso Az utolsó ilyen sor; ha elso > utolso, a tábla nem változott
+ * @param hash A jelenlegi állapot hash-e
+ * @param generacio
+ * @param hashek Az utolsó generációk hash-ei (gyűrűs puffer)
+ * @param kov A következő beírandó elem indexe
+ * @param hdb Az érvényes elemek száma
+ * @param sorszam A leves sorszáma
+ * @param uj 1 ha a munkásnak a kör elején el kell vetnie a levest
+ * @param kesz 1 ha a leves befejeződött, és az eredmény ki van töltve
+ * @param hasznalt 1 ha van a helyen leves
+ * @param eredmeny
+ */
+typedef struct Leves_tabla{
+    Cella *puffer[2];
+    int g;
+    int *valt_min[2], *valt_max[2];
+    int v;
+    int elso, utolso;
+    uint64_t hash;
+    int generacio;
+    uint64_t hashek[LEVES_ELOZMENY];
+    int kov, hdb;
+    long long sorszam;
+    int uj, kesz, hasznalt;
+    Leves_eredmeny eredmeny;
+}Leves_tabla;
+
+/**
+ * @brief Egy munkás szál sora: a kör még le nem léptetett tábláinak indexei.
+ * A tulajdonos az elejéről vesz, a többiek a végéről lopnak; mindkettő a spinlock alatt.
+ */
+typedef struct Leves_sor{
+    int *elemek;
+    int eleje, vege;
+    SDL_SpinLock zar;
+}Leves_sor;
+
+/**
+ * @brief A keresés közös állapota.
+ * @param b
+ * @param szabaly_tabla [állapot << 4 | szomszédok] a cella új állapota
+ * @param lepes A pufferek sorhossza
+ * @param szalak
+ * @param tablak
+ * @param sorok Szálanként egy sor
+ * @param zar A kör indítását és befejezését védő mutex
+ * @param indul A kör indulását jelző feltételváltozó
+ * @param vegzett A munkások végzését jelző feltételváltozó
+ * @param kor Az aktuális kör sorszáma
+ * @param kesz_szalak Az aktuális körrel végzett munkások száma
+ * @param leall 1 ha a munkásoknak ki kell lépniük
+ */
+typedef struct Leves_kereses{
+    const Leves_beallitas *b;
+    Cella szabaly_tabla[32];
+    int lepes;
+    int szalak;
+    Leves_tabla *tablak;
+    Leves_sor *sorok;
+    SDL_mutex *zar;
+    SDL_cond *indul, *vegzett;
+    int kor, kesz_szalak, leall;
+}Leves_kereses;
+
+/**
+ * @brief Egy munkás szál paramétere.
+ * @param k
+ * @param index
+ * @param szamlalo A szál népszámlálójának munkaterülete
+ * @param nepszamlalas A szál által befejezett levesek népszámlálásának összege
+ * @param nepszamlalas_hibak A szál elmaradt népszámlálásainak száma
+ */
+typedef struct Leves_munkas{
+    Leves_kereses *k;
+    int index;
+    Nepszamlalo szamlalo;
+    Nepszamlalas nepszamlalas;
+    long long nepszamlalas_hibak;
+}Leves_munkas;
+
+/**
+ * @brief A leves véletlenszám generátorának kezdőállapota (sosem 0).
+ */
+static uint64_t leves_mag(const Leves_beallitas *b, long long sorszam);
+
+/**
+ * @brief Kitölti a sorszam. leves négyzetét (a pufferben eddig csak 0 lehet).
+ * @param g A puffer (szegéllyel)
+ * @param lepes A sorhossz
+ * @param b
+ * @param sorszam
+ * @return a kitöltött állapot hash-e
+ */
+static uint64_t leves_kitolt(Cella *g, int lepes, const Leves_beallitas *b, long long sorszam);
+
+/**
+ * @brief Elveti a tábla következő levesét (a régi maradékát letörli).
+ */
+static void vetes(Leves_kereses *k, Leves_tabla *lt);
+
+/**
+ * @brief Egy generációt lép. Csak az előző lépésben változott cellák környezete változhat, így soronként csak a
+ * szomszédos sorok változásainak eggyel kiszélesített oszloptartományát számolja újra; a többi cella a másik pufferben
+ * (két generációval korábban) is ugyanilyen volt.
+ */
+static void lep(Leves_kereses *k, Leves_tabla *lt);
+
+/**
+ * @brief Felveszi a jelenlegi hash-t az előzmények közé.
+ * @return 1 ha már előfordult (ekkor az eredmény kezdet és periodus mezője ki van töltve)
+ */
+static int hash_felvesz(Leves_tabla *lt);
+
+/**
+ * @brief A tábla egy környi lépése (és a kör elején a vetés, ha kell).
+ * @param m A futtató munkás (a befejeződött leves népszámlálása az ő eredményéhez adódik)
+ */
+static void tabla_futtat(Leves_kereses *k, Leves_tabla *lt, Leves_munkas *m);
+
+/**
+ * @brief A következő léptetendő tábla: a saját sor elejéről, vagy ha az üres, egy másik sor végéről.
+ * @return a tábla indexe, -1 ha minden sor üres
+ */
+static int kovetkezo_tabla(Leves_kereses *k, int index);
+
+/**
+ * @brief A munkás szál: körönként kiüríti a sorokat, majd jelez a fő szálnak.
+ */
+static int munkas_szal(void *adat);
+
+/**
+ * @brief Felszabadítja a keresés szinkronizációs objektumait és tömbjeit (a NULL elemeket kihagyja, így félbemaradt
+ * foglalás után is hívható).
+ * @param k
+ * @param munkasok
+ * @param szalak
+ * @param valtozasok
+ * @param arena
+ */
+static void kereses_felszabadit(Leves_kereses *k, Leves_munkas *munkasok, SDL_Thread **szalak, int *valtozasok, Cella *arena);
+
+uint64_t leves_mag(const Leves_beallitas *b, long long sorszam){
+    uint64_t x = b->mag + (uint64_t)sorszam * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x ? x : 1;
+}
+
+uint64_t leves_kitolt(Cella *g, int lepes, const Leves_beallitas *b, long long sorszam){
+    uint64_t allapot = leves_mag(b, sorszam), hash = 0;
+    int eltolas = 1 + (b->tabla - b->meret) / 2;
+    for(int sor = eltolas; sor < eltolas + b->meret; sor++){
+        for(int oszlop = eltolas; oszlop < eltolas + b->meret; oszlop++){
+            // xorshift64*
+            allapot ^= allapot >> 12;
+            allapot ^= allapot << 25;
+            allapot ^= allapot >> 27;
+            if((int)(((allapot * 0x2545F4914F6CDD1DULL) >> 32) % 100) < b->suruseg){
+                g[(size_t)sor * lepes + oszlop] = 1;
+                hash ^= cella_kulcs(sor, oszlop);
+            }
+        }
+    }
+    return hash;
+}
+
+void vetes(Leves_kereses *k, Leves_tabla *lt){
+    size_t puffer_meret = (size_t)(k->b->tabla + 2) * k->lepes;
+    memset(lt->puffer[0], 0, puffer_meret);
+    memset(lt->puffer[1], 0, puffer_meret);
+    lt->g = 0;
+    lt->hash = leves_kitolt(lt->puffer[0], k->lepes, k->b, lt->sorszam);
+    // A kezdőállapot a (csupa 0) másik pufferhez képest a leves négyzetében változott
+    int eltolas = 1 + (k->b->tabla - k->b->meret) / 2;
+    lt->v = 0;
+    lt->elso = eltolas;
+    lt->utolso = eltolas + k->b->meret - 1;
+    for(int sor = lt->elso; sor <= lt->utolso; sor++){
+        lt->valt_min[0][sor] = eltolas;
+        lt->valt_max[0][sor] = eltolas + k->b->meret - 1;
+    }
+    lt->generacio = 0;
+    lt->kov = lt->hdb = 0;
+    lt->kesz = 0;
+    lt->uj = 0;
+    hash_felvesz(lt);
+}
+
+void lep(Leves_kereses *k, Leves_tabla *lt){
+    const Cella *g = lt->puffer[lt->g];
+    Cella *kov = lt->puffer[!lt->g];
+    const int *elozo_min = lt->valt_min[lt->v], *elozo_max = lt->valt_max[lt->v];
+    int *uj_min = lt->valt_min[!lt->v], *uj_max = lt->valt_max[!lt->v];
+    int utolso_oszlop = k->b->tabla;
+    int elso = lt->elso > 1 ? lt->elso - 1 : 1;
+    int utolso = lt->utolso < utolso_oszlop ? lt->utolso + 1 : utolso_oszlop;
+    int uj_elso = utolso + 1, uj_utolso = 0;
+    uint64_t hash = lt->hash;
+    for(int sor = elso; sor <= utolso; sor++){
+        // A három szomszédos sor változásainak uniója, eggyel kiszélesítve
+        int tol = utolso_oszlop + 1, ig = 0;
+        for(int r = sor - 1; r <= sor + 1; r++){
+            if(r >= lt->elso && r <= lt->utolso && elozo_min[r] <= elozo_max[r]){
+                if(elozo_min[r] < tol) tol = elozo_min[r];
+                if(elozo_max[r] > ig) ig = elozo_max[r];
+            }
+        }
+        int sor_min = utolso_oszlop + 1, sor_max = 0;
+        if(tol <= ig){
+            tol = tol > 1 ? tol - 1 : 1;
+            ig = ig < utolso_oszlop ? ig + 1 : utolso_oszlop;
+            const Cella *f = g + (size_t)(sor - 1) * k->lepes;
+            const Cella *kz = f + k->lepes, *l = kz + k->lepes;
+            Cella *uj = kov + (size_t)sor * k->lepes;
+            for(int j = tol; j <= ig; j++){
+                int szomszedok = f[j-1] + f[j] + f[j+1] + kz[j-1] + kz[j+1] + l[j-1] + l[j] + l[j+1];
+                Cella c = k->szabaly_tabla[kz[j] << 4 | szomszedok];
+                uj[j] = c;
+                if(c != kz[j]){
+                    hash ^= cella_kulcs(sor, j);
+                    if(j < sor_min) sor_min = j;
+                    sor_max = j;
+                }
+            }
+        }
+        uj_min[sor] = sor_min;
+        uj_max[sor] = sor_max;
+        if(sor_min <= sor_max){
+            if(sor < uj_elso) uj_elso = sor;
+            uj_utolso = sor;
+        }
+    }
+    lt->elso = uj_elso;
+    lt->utolso = uj_utolso;
+    lt->v = !lt->v;
+    lt->g = !lt->g;
+    lt->hash = hash;
+    lt->generacio++;
+}
+
+int hash_felvesz(Leves_tabla *lt){
+    int talalt = 0;
+    // A legrégebbi előfordulás kell, hogy a ciklus kezdete pontos legyen (mint a Ciklus_figyelo-nál)
+    int elso = (lt->kov - lt->hdb + LEVES_ELOZMENY) % LEVES_ELOZMENY;
+    for(int i = 0; i < lt->hdb; i++){
+        if(lt->hashek[(elso + i) % LEVES_ELOZMENY] == lt->hash){
+            lt->eredmeny.kezdet = lt->generacio - lt->hdb + i;
+            lt->eredmeny.periodus = lt->generacio - lt->eredmeny.kezdet;
+            talalt = 1;
+            break;
+        }
+    }
+    lt->hashek[lt->kov] = lt->hash;
+    lt->kov = (lt->kov + 1) % LEVES_ELOZMENY;
+    if(lt->hdb < LEVES_ELOZMENY)
+        lt->hdb++;
+    return talalt;
+}
+
+void tabla_futtat(Leves_kereses *k, Leves_tabla *lt, Leves_munkas *m){
+    if(lt->uj)
+        vetes(k, lt);
+    for(int i = 0; i < LEVES_KOR && !lt->kesz; i++){
+        lep(k, lt);
+        int stabil = hash_felvesz(lt);
+        if(stabil || lt->generacio >= k->b->max_generacio){
+            if(!stabil){
+                lt->eredmeny.kezdet = lt->generacio;
+                lt->eredmeny.periodus = 0;
+            }
+            const Cella *g = lt->puffer[lt->g];
+            int nepesseg = 0;
+            for(int sor = 1; sor <= k->b->tabla; sor++)
+                for(int oszlop = 1; oszlop <= k->b->tabla; oszlop++)
+                    nepesseg += g[(size_t)sor * k->lepes + oszlop];
+            lt->eredmeny.sorszam = lt->sorszam;
+            lt->eredmeny.nepesseg = nepesseg;
+            lt->eredmeny.hash = lt->hash;
+            if(k->b->nepszamlalas && !nepszamlalas_racs(&m->szamlalo, g, k->lepes, k->b->tabla + 2, k->b->tabla + 2, &m->nepszamlalas))
+                m->nepszamlalas_hibak++;
+            lt->kesz = 1;
+        }
+    }
+}
+
+int kovetkezo_tabla(Leves_kereses *k, int index){
+    Leves_sor *sajat = &k->sorok[index];
+    int tabla = -1;
+    SDL_AtomicLock(&sajat->zar);
+    if(sajat->eleje < sajat->vege)
+        tabla = sajat->elemek[sajat->eleje++];
+    SDL_AtomicUnlock(&sajat->zar);
+    // Lopás a többiek sorának végéről, a szomszédtól kezdve
+    for(int i = 1; i < k->szalak && tabla < 0; i++){
+        Leves_sor *masik = &k->sorok[(index + i) % k->szalak];
+        SDL_AtomicLock(&masik->zar);
+        if(masik->eleje < masik->vege)
+            tabla = masik->elemek[--masik->vege];
+        SDL_AtomicUnlock(&masik->zar);
+    }
+    return tabla;
+}
+
+int munkas_szal(void *adat){
+    Leves_munkas *m = adat;
+    Leves_kereses *k = m->k;
+    int latott = 0;
+    while(1){
+        SDL_LockMutex(k->zar);
+        while(!k->leall && k->kor == latott)
+            SDL_CondWait(k->indul, k->zar);
+        if(k->leall){
+            SDL_UnlockMutex(k->zar);
+            return 0;
+        }
+        latott = k->kor;
+        SDL_UnlockMutex(k->zar);
+
+        int tabla;
+        while((tabla = kovetkezo_tabla(k, m->index)) >= 0)
+            tabla_futtat(k, &k->tablak[tabla], m);
+
+        SDL_LockMutex(k->zar);
+        if(++k->kesz_szalak == k->szalak)
+            SDL_CondSignal(k->vegzett);
+        SDL_UnlockMutex(k->zar);
+    }
+}
+
+void kereses_felszabadit(Leves_kereses *k, Leves_munkas *munkasok, SDL_Thread **szalak, int *valtozasok, Cella *arena){
+    SDL_DestroyCond(k->indul);
+    SDL_DestroyCond(k->vegzett);
+    SDL_DestroyMutex(k->zar);
+    if(k->sorok != NULL)
+        for(int i = 0; i < k->szalak; i++)
+            free(k->sorok[i].elemek);
+    free(k->sorok);
+    free(k->tablak);
+    free(munkasok);
+    free(szalak);
+    free(valtozasok);
+    memoria_felszabadit(arena);
+}
+
+int leves_tabla(Tabla *t, const Leves_beallitas *b, long long sorszam){
+    if(!init_tabla(t, b->tabla, b->tabla))
+        return 0;
+    memset(t->g, 0, (size_t)t->m * t->lepes);
+    memset(t->kov, 0, (size_t)t->m * t->lepes);
+    leves_kitolt(t->g, t->lepes, b, sorszam);
+    t->hash = tabla_hash(t);
+    return 1;
+}
+
+int leves_kereses(const Leves_beallitas *b, const Szabaly *sz, Leves_eredmeny *eredmenyek, FILE *csv, Leves_osszesites *ossz){
+    if(b->db < 1 || b->tabla < 1 || b->meret < 1 || b->meret > b->tabla || b->suruseg < 0 || b->suruseg > 100 ||
+       b->kotet < 1 || b->max_generacio < 1 || (sz->szuletes & 1) || (b->nepszamlalas && nepszamlalas_memoria_becsles(b->tabla, b->tabla) == 0))
+        return 0;
+    // Minden szálnak saját népszámláló munkaterülete van
+    int szal_db = b->szalak > 0 ? b->szalak : SDL_GetCPUCount();
+    size_t szalankent = b->nepszamlalas ? nepszamlalas_memoria_becsles(b->tabla, b->tabla) : 0;
+    if(!tabla_meret_ellenoriz(b->tabla, b->tabla, tar_suru, (size_t)szal_db * szalankent, NULL, 0))
+        return 0;
+    Leves_kereses k;
+    memset(&k, 0, sizeof(k));
+    k.b = b;
+    for(int n = 0; n <= 8; n++){
+        k.szabaly_tabla[n] = (sz->szuletes >> n) & 1;
+        k.szabaly_tabla[1 << 4 | n] = (sz->tuleles >> n) & 1;
+    }
+    k.szalak = b->szalak > 0 ? b->szalak : SDL_GetCPUCount();
+    if(k.szalak < 1)
+        k.szalak = 1;
+    int kotet = b->kotet < b->db ? b->kotet : (int)b->db;
+    k.lepes = (int)memoria_kerekit(b->tabla + 2);
+    size_t puffer_meret = (size_t)(b->tabla + 2) * k.lepes;
+
+    // Az aréna: minden tábla két puffere egymás után, és külön a soronkénti változások tartományai
+    Cella *arena = memoria_foglal((size_t)kotet * 2 * puffer_meret);
+    int *valtozasok = malloc((size_t)kotet * 4 * (b->tabla + 2) * sizeof(int));
+    k.tablak = calloc(kotet, sizeof(Leves_tabla));
+    k.sorok = calloc(k.szalak, sizeof(Leves_sor));
+    Leves_munkas *munkasok = calloc(k.szalak, sizeof(Leves_munkas));
+    SDL_Thread **szalak = calloc(k.szalak, sizeof(SDL_Thread*));
+    int foglalva = arena != NULL && valtozasok != NULL && k.tablak != NULL && k.sorok != NULL && munkasok != NULL && szalak != NULL;
+    for(int i = 0; i < k.szalak && foglalva; i++)
+        foglalva = (k.sorok[i].elemek = malloc(kotet * sizeof(int))) != NULL;
+    if(foglalva){
+        k.zar = SDL_CreateMutex();
+        k.indul = SDL_CreateCond();
+        k.vegzett = SDL_CreateCond();
+        foglalva = k.zar != NULL && k.indul != NULL && k.vegzett != NULL;
+    }
+    if(!foglalva){
+        kereses_felszabadit(&k, munkasok, szalak, valtozasok, arena);
+        return 0;
+    }
+    long long kovetkezo = 0;
+    for(int i = 0; i < kotet; i++){
+        Leves_tabla *lt = &k.tablak[i];
+        lt->puffer[0] = arena + (size_t)2 * i * puffer_meret;
+        lt->puffer[1] = lt->puffer[0] + puffer_meret;
+        for(int j = 0; j < 2; j++){
+            lt->valt_min[j] = valtozasok + ((size_t)i * 4 + 2 * j) * (b->tabla + 2);
+            lt->valt_max[j] = lt->valt_min[j] + (b->tabla + 2);
+        }
+        lt->sorszam = kovetkezo++;
+        lt->uj = 1;
+        lt->hasznalt = 1;
+    }
+    int indult = 0;
+    for(int i = 0; i < k.szalak; i++){
+        // A katalógust az első init építi fel, ezt még a szálak indítása előtt. Ha nem sikerül, a szálak
+        // népszámlálása kimarad, és elmaradtként számolódik
+        nepszamlalo_init(&munkasok[i].szamlalo);
+        nepszamlalas_init(&munkasok[i].nepszamlalas);
+        munkasok[i].nepszamlalas_hibak = 0;
+    }
+    for(; indult < k.szalak; indult++){
+        munkasok[indult].k = &k;
+        munkasok[indult].index = indult;
+        szalak[indult] = SDL_CreateThread(munkas_szal, "leves", &munkasok[indult]);
+        if(szalak[indult] == NULL)
+            break;
+    }
+
+    memset(ossz, 0, sizeof(*ossz));
+    Uint64 kezdet = SDL_GetPerformanceCounter();
+    int aktiv = indult == k.szalak ? kotet : 0;
+    while(aktiv > 0){
+        // A kör tábláinak szétosztása a sorok között, felváltva
+        for(int i = 0; i < k.szalak; i++)
+            k.sorok[i].eleje = k.sorok[i].vege = 0;
+        int n = 0;
+        for(int i = 0; i < kotet; i++){
+            if(k.tablak[i].hasznalt){
+                Leves_sor *sor = &k.sorok[n++ % k.szalak];
+                sor->elemek[sor->vege++] = i;
+            }
+        }
+        SDL_LockMutex(k.zar);
+        k.kor++;
+        k.kesz_szalak = 0;
+        SDL_CondBroadcast(k.indul);
+        while(k.kesz_szalak < k.szalak)
+            SDL_CondWait(k.vegzett, k.zar);
+        SDL_UnlockMutex(k.zar);
+
+        // A befejeződött levesek begyűjtése és pótlása
+        for(int i = 0; i < kotet; i++){
+            Leves_tabla *lt = &k.tablak[i];
+            if(!lt->hasznalt || !lt->kesz)
+                continue;
+            const Leves_eredmeny *e = &lt->eredmeny;
+            ossz->db++;
+            if(e->periodus == 0)
+                ossz->nem_stabil++;
+            else
+                ossz->periodusok[e->periodus]++;
+            ossz->ossz_generacio += e->kezdet;
+            ossz->ossz_nepesseg += e->nepesseg;
+            if(eredmenyek != NULL)
+                eredmenyek[e->sorszam] = *e;
+            if(csv != NULL)
+                fprintf(csv, "%lld,%d,%d,%d,%016llx\n", e->sorszam, e->kezdet, e->periodus, e->nepesseg, (unsigned long long)e->hash);
+            if(kovetkezo < b->db){
+                lt->sorszam = kovetkezo++;
+                lt->uj = 1;
+                lt->kesz = 0;
+            }
+            else{
+                lt->hasznalt = 0;
+                aktiv--;
+            }
+        }
+    }
+    ossz->ido = (double)(SDL_GetPerformanceCounter() - kezdet) / (double)SDL_GetPerformanceFrequency();
+
+    SDL_LockMutex(k.zar);
+    k.leall = 1;
+    SDL_CondBroadcast(k.indul);
+    SDL_UnlockMutex(k.zar);
+    for(int i = 0; i < indult; i++)
+        SDL_WaitThread(szalak[i], NULL);
+    for(int i = 0; i < k.szalak; i++){
+        nepszamlalas_osszead(&ossz->nepszamlalas, &munkasok[i].nepszamlalas);
+        ossz->nepszamlalas_hibak += munkasok[i].nepszamlalas_hibak;
+        nepszamlalo_torol(&munkasok[i].szamlalo);
+    }
+    kereses_felszabadit(&k, munkasok, szalak, valtozasok, arena);
+    return indult == k.szalak;
+}
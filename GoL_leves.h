@@ -0,0 +1,119 @@
+/**
+ * @file GoL_leves.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Véletlen "levesek" tömeges futtatása a stabilizálódásig (leveskeresés).
+ * Egy leves egy tabla x tabla méretű, halott szegélyű tábla, aminek a közepén egy meret x meret négyzet véletlenül van kitöltve.
+ * A táblák (kotet darab, mindegyik két pufferrel) egyetlen memóriablokkban vannak, a lépések nem foglalnak memóriát, és
+ * csak az előző lépésben változott cellák környezetét számolják újra (a kihűlt, csak csendéletekből álló részeket nem).
+ * A táblák együtt, körönként LEVES_KOR generációt lépnek, a kört a munkás szálak osztják fel egymás között: minden szálnak
+ * saját sora van a táblákból, és ha kiürült, a többiek sorának végéről lop. A körök között a fő szál gyűjti be a
+ * stabilizálódott levesek eredményét, és a helyükre újakat tesz.
+ * Egy leves akkor stabilizálódott, ha az állapota (hash-e) az utolsó LEVES_ELOZMENY generációban már előfordult;
+ * az eredmények a levesek sorszámától függenek csak, a szálak számától nem.
+ * @version 0.1
+ * @date 2021-12-05
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_LEVES_H
+#define GOL_LEVES_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "GoL_logics.h"
+#include "GoL_nepszamlalas.h"
+
+/** Ennyi generáció hash-ét tárolja levesenként, ennél hosszabb periódust nem ismer fel */
+#define LEVES_ELOZMENY 64
+/** Egy körben ennyi generációt lép minden leves */
+#define LEVES_KOR 64
+
+/**
+ * @brief A keresés beállításai.
+ * @param db A futtatandó levesek száma
+ * @param tabla A tábla oldalhossza (szegély nélkül)
+ * @param meret A véletlen négyzet oldalhossza
+ * @param suruseg Az élő cellák aránya a négyzetben, százalékban
+ * @param mag A véletlenszámok magja (a levesek ebből és a sorszámukból készülnek)
+ * @param szalak A munkás szálak száma
+ * @param kotet Egyszerre ennyi leves van a memóriában
+ * @param max_generacio Ennyi generáció után a leves nem stabilizálódottként kerül az eredmények közé
+ * @param nepszamlalas 1 ha minden leves végállapotán népszámlálás is fut
+ */
+typedef struct Leves_beallitas{
+    long long db;
+    int tabla;
+    int meret;
+    int suruseg;
+    uint64_t mag;
+    int szalak;
+    int kotet;
+    int max_generacio;
+    int nepszamlalas;
+}Leves_beallitas;
+
+/** Alapértelmezett beállítások: 256x256-os tábla, 16x16-os leves, 50%, a processzorok száma szál */
+#define LEVES_ALAP {1000, 256, 16, 50, 1, 0, 256, 20000, 0}
+
+/**
+ * @brief Egy leves eredménye.
+ * @param sorszam
+ * @param kezdet A generáció, ahonnan a ciklus kezdődik (stabilizálódás), vagy max_generacio
+ * @param periodus A végállapot periódusa, 0 ha nem stabilizálódott
+ * @param nepesseg A végállapot népessége
+ * @param hash A végállapot hash-e (a tabla_hash-sel egyező)
+ */
+typedef struct Leves_eredmeny{
+    long long sorszam;
+    int kezdet;
+    int periodus;
+    int nepesseg;
+    uint64_t hash;
+}Leves_eredmeny;
+
+/**
+ * @brief A keresés összesítése.
+ * @param db A lefuttatott levesek száma
+ * @param nem_stabil A max_generacio alatt nem stabilizálódott levesek száma
+ * @param periodusok Az n. elem a n periódusú végállapotok száma
+ * @param ossz_generacio A stabilizálódásig lépett generációk összege
+ * @param ossz_nepesseg A végállapotok népességének összege
+ * @param ido A keresés ideje másodpercben
+ * @param nepszamlalas A végállapotok népszámlálásának összege (ha be volt kapcsolva)
+ * @param nepszamlalas_hibak Ennyi végállapot népszámlálása maradt el, mert elfogyott a memória
+ */
+typedef struct Leves_osszesites{
+    long long db;
+    long long nem_stabil;
+    long long periodusok[LEVES_ELOZMENY + 1];
+    long long ossz_generacio;
+    long long ossz_nepesseg;
+    double ido;
+    Nepszamlalas nepszamlalas;
+    long long nepszamlalas_hibak;
+}Leves_osszesites;
+
+/**
+ * @brief Lefuttatja a levesek keresését.
+ * @param b
+ * @param sz A szabály; születés 0 szomszéddal (B0) nem lehet benne
+ * @param eredmenyek ha nem NULL, b->db elemű tömb, a sorszam. elembe kerül a sorszam. leves eredménye
+ * @param csv ha nem NULL, ide írja a levesek eredményét (a befejeződés sorrendjében)
+ * @param ossz ide írja az összesítést
+ * @return 1 ha sikeres, 0 ha a beállítások vagy a szabály érvénytelen, elfogyott a memória, vagy nem sikerült elindítani a szálakat
+ */
+int leves_kereses(const Leves_beallitas *b, const Szabaly *sz, Leves_eredmeny *eredmenyek, FILE *csv, Leves_osszesites *ossz);
+
+/**
+ * @brief Létrehozza a sorszam. leves kezdőállapotát egy önálló táblán (pl. egy érdekes leves elmentéséhez vagy ellenőrzéshez).
+ * @warning A tábla a destroy_tabla-val felszabadítandó!!
+ * @param t inicializálatlan tábla
+ * @param b
+ * @param sorszam
+ * @return 1 ha sikeres, 0 ha elfogyott a memória
+ */
+int leves_tabla(Tabla *t, const Leves_beallitas *b, long long sorszam);
+
+#endif
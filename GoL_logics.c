@@ -13,9 +13,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <SDL2/SDL.h>
 #include "GoL_logics.h"
+#include "GoL_pool.h"
+#include "GoL_memoria.h"
+#include "GoL_lemez.h"
+#ifdef GOL_DEBUG
 #include "src/debugmalloc.h"
+#endif
 
 /**
  * @brief A konzolra kiírja a Tabla objektumot (- a Halott, @ az Élő cella).
@@ -33,33 +39,123 @@ static void print_tabla(Tabla* t);
  */
 static int szomszedok_szama(Tabla* t, int x, int y);
 
-void init_tabla(Tabla* ujtabla, int szelesseg, int magassag){
+/** Az init_tabla tárolási módja (lásd tabla_tarolas_beallit) */
+static Tarolas tarolas = tar_suru;
+
+/** A változáslista elemeinek poolja, így a generációs lépés nem hív malloc-ot */
+static Pool valtozas_pool;
+static int valtozas_pool_kesz = 0;
+
+void tabla_tarolas_beallit(Tarolas mod){
+    tarolas = mod;
+}
+
+Tarolas tabla_tarolas(void){
+    return tarolas;
+}
+
+int init_tabla(Tabla* ujtabla, int szelesseg, int magassag){
+    ujtabla -> g = NULL;
+    ujtabla -> kov = NULL;
+    ujtabla -> sz = 0;
+    ujtabla -> m = 0;
+    ujtabla -> lepes = 0;
+    if(tabla_memoria_becsles(szelesseg, magassag, tarolas, NULL) == 0)
+        return 0;
     szelesseg += 2; // A kívánt x*y tábla körül egy "láthatatlan" keret van, amin mindig halott cellák vannak
     magassag += 2;
     ujtabla -> sz = szelesseg;
     ujtabla -> m = magassag;
-    ujtabla -> g = calloc(magassag, sizeof(int*));
-    ujtabla -> rects = malloc(magassag * sizeof(SDL_Rect*));
-    for(int sor=0; sor<magassag; sor++){
-        ujtabla -> g[sor] = calloc(szelesseg, sizeof(int));
-        ujtabla -> rects[sor] = malloc(szelesseg * sizeof(SDL_Rect));
+    ujtabla -> lepes = (int)memoria_kerekit((size_t)szelesseg * sizeof(Cella));
+    ujtabla -> hash = 0;
+    ujtabla -> generacio = 0;
+    ujtabla -> eltolas_sor = 0;
+    ujtabla -> eltolas_oszlop = 0;
+    size_t meret = (size_t)magassag * ujtabla->lepes;
+    if(tarolas == tar_lemez){
+        ujtabla -> g = memoria_fajl_foglal(meret);
+        ujtabla -> kov = memoria_fajl_foglal(meret);
+    }
+    else{
+        ujtabla -> g = memoria_foglal(meret);
+        ujtabla -> kov = memoria_foglal(meret);
+    }
+    if(ujtabla->g == NULL || ujtabla->kov == NULL){
+        destroy_tabla(ujtabla);
+        return 0;
+    }
+    if(tarolas == tar_lemez){
+        // A lépés elölről hátrafelé, sávonként halad a pufferekben
+        memoria_tanacs(ujtabla->g, meret, mt_sorban);
+        memoria_tanacs(ujtabla->kov, meret, mt_sorban);
     }
+    return 1;
+}
+
+size_t tabla_memoria_becsles(long long szelesseg, long long magassag, Tarolas mod, size_t* lemez){
+    if(lemez != NULL)
+        *lemez = 0;
+    if(szelesseg < 1 || magassag < 1 || szelesseg > TABLA_MAX_OLDAL || magassag > TABLA_MAX_OLDAL)
+        return 0;
+    // Az oldalak legfeljebb 2^28-ak, így a szorzat 64 biten nem csordul túl; csak a címtérbe férést kell nézni
+    uint64_t sor = (uint64_t)memoria_kerekit((size_t)szelesseg + 2), sorok = (uint64_t)magassag + 2;
+    uint64_t teljes = 2 * (sorok * sor + 2 * MEMORIA_IGAZITAS), becsles = 0;
+    if(teljes > SIZE_MAX / 2)
+        return 0;
+    switch(mod){
+        case tar_suru:
+            becsles = teljes;
+            break;
+        case tar_lemez:
+            // A feldolgozott, az előtte lévő és az előre kért sávok mindkét pufferben
+            becsles = 2 * (uint64_t)(LEMEZ_ELORE + 2) * LEMEZ_SAV * sor;
+            if(becsles > teljes)
+                becsles = teljes;
+            if(lemez != NULL)
+                *lemez = (size_t)teljes;
+            break;
+    }
+    return (size_t)becsles;
+}
+
+int tabla_meret_ellenoriz(long long szelesseg, long long magassag, Tarolas mod, size_t kisero, char* uzenet, size_t uzenet_meret){
+    size_t lemez;
+    size_t becsles = tabla_memoria_becsles(szelesseg, magassag, mod, &lemez);
+    if(becsles == 0){
+        if(uzenet != NULL)
+            snprintf(uzenet, uzenet_meret, "Ervenytelen tablameret: %lldx%lld (mindket oldal 1 es %d kozott legyen)",
+                     szelesseg, magassag, TABLA_MAX_OLDAL);
+        return 0;
+    }
+    size_t fizikai = memoria_fizikai();
+    // Az osztás előbb jön, így a két összeg együtt sem csordul túl
+    if(fizikai != 0 && becsles / TABLA_MEMORIA_SZAZALEK + kisero / TABLA_MEMORIA_SZAZALEK > fizikai / 100){
+        if(uzenet != NULL)
+            snprintf(uzenet, uzenet_meret, "A %lldx%lld tabla kb. %llu MB memoriat igenyelne, de csak %llu MB fizikai memoria van "
+                     "(legfeljebb %d%% hasznalhato)%s", szelesseg, magassag, (unsigned long long)((becsles >> 20) + (kisero >> 20)),
+                     (unsigned long long)(fizikai >> 20), TABLA_MEMORIA_SZAZALEK,
+                     mod == tar_suru ? "; a --lemez <konyvtar> kapcsoloval fajlban tarolhato" : "");
+        return 0;
+    }
+    size_t szabad = mod == tar_lemez ? memoria_fajl_szabad() : 0;
+    if(szabad != 0 && lemez > szabad){
+        if(uzenet != NULL)
+            snprintf(uzenet, uzenet_meret, "A %lldx%lld tabla kb. %llu MB helyet igenyelne a lemezen, de csak %llu MB szabad",
+                     szelesseg, magassag, (unsigned long long)(lemez >> 20), (unsigned long long)(szabad >> 20));
+        return 0;
+    }
+    return 1;
 }
 
 void destroy_tabla(Tabla* regitabla){
     if(regitabla != NULL){
-        int magassag = regitabla -> m;
-        for(int sor=0; sor<magassag; sor++){
-            free(regitabla -> g[sor]);
-            free(regitabla -> rects[sor]);
-        }
-        free(regitabla -> g);
-        free(regitabla -> rects);
+        memoria_felszabadit(regitabla -> g);
+        memoria_felszabadit(regitabla -> kov);
         regitabla->g = NULL;
-        regitabla->rects = NULL;
+        regitabla->kov = NULL;
         regitabla->sz = 0;
         regitabla->m = 0;
-
+        regitabla->lepes = 0;
     }
 }
 
@@ -68,7 +164,7 @@ void print_tabla(Tabla* t){
     int szelesseg = t -> sz;
     for(int sor=1; sor<magassag-1; sor++){ // A szélek ne íródjanak ki, azok mindig 0-k; gyakorlatilag nem a játlkterület részei
         for(int oszlop=1; oszlop<szelesseg-1; oszlop++){
-            printf("%c", t -> g[sor][oszlop]?'@':'-');
+            printf("%c", CELLA(t, sor, oszlop)?'@':'-');
         }
         printf("\n");
     }
@@ -76,63 +172,240 @@ void print_tabla(Tabla* t){
 }
 
 int szomszedok_szama(Tabla* t, int x, int y){
-    int szum = 0;
-    for(int sor=-1; sor<2; sor++)
-        for(int oszlop=-1; oszlop<2; oszlop++)
-            if(sor!=0 || oszlop!=0)
-                szum += t -> g[x+sor][y+oszlop];
-    return szum; 
+    // A három érintett sor egymás után, lepes távolságra van a memóriában; a szegély miatt nincs határellenőrzés
+    const Cella *fent = t->g + (size_t)(x-1) * t->lepes + y;
+    const Cella *kozep = fent + t->lepes;
+    const Cella *lent = kozep + t->lepes;
+    return fent[-1] + fent[0] + fent[1] + kozep[-1] + kozep[1] + lent[-1] + lent[0] + lent[1];
 }
 
 void flip(Tabla* t, int sor, int oszlop){
-    if(t->g[sor][oszlop])
-        t->g[sor][oszlop] = 0;
+    Cella regi = CELLA(t, sor, oszlop);
+    if(regi)
+        CELLA(t, sor, oszlop) = 0;
     else
-        t->g[sor][oszlop] = 1;
+        CELLA(t, sor, oszlop) = 1;
+    int gs = sor + t->eltolas_sor, go = oszlop + t->eltolas_oszlop;
+    t->hash ^= allapot_kulcs(gs, go, regi) ^ allapot_kulcs(gs, go, CELLA(t, sor, oszlop));
+}
+
+int tabla_atmeretez(Tabla* t, int sor0, int oszlop0, int szelesseg, int magassag){
+    Tabla uj;
+    if(!init_tabla(&uj, szelesseg, magassag))
+        return 0;
+    memset(uj.g, 0, (size_t)uj.m * uj.lepes);
+    memset(uj.kov, 0, (size_t)uj.m * uj.lepes);
+    // A régi és az új belső terület metszete, a régi tábla koordinátáiban
+    int sor_tol = sor0 > 1 ? sor0 : 1, sor_ig = sor0 + magassag < t->m - 1 ? sor0 + magassag : t->m - 1;
+    int oszlop_tol = oszlop0 > 1 ? oszlop0 : 1, oszlop_ig = oszlop0 + szelesseg < t->sz - 1 ? oszlop0 + szelesseg : t->sz - 1;
+    for(int sor = sor_tol; sor < sor_ig; sor++)
+        if(oszlop_tol < oszlop_ig)
+            memcpy(&CELLA(&uj, sor - sor0 + 1, oszlop_tol - oszlop0 + 1), &CELLA(t, sor, oszlop_tol), oszlop_ig - oszlop_tol);
+    uj.generacio = t->generacio;
+    uj.eltolas_sor = t->eltolas_sor + sor0 - 1;
+    uj.eltolas_oszlop = t->eltolas_oszlop + oszlop0 - 1;
+    uj.hash = tabla_hash(&uj);
+    destroy_tabla(t);
+    *t = uj;
+    return 1;
+}
+
+int tabla_betolt(const char* fajlnev, Tabla* t){
+    FILE* fp = fopen(fajlnev, "rt");
+    if(fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+
+    char v[4];
+    if (fscanf(fp, "%3[^\n]", v) != 1 || strcmp(v, "0.1")) {fclose(fp); return 0;}
+    long long szel, mag;
+    if (fscanf(fp, " %lld%lld", &szel, &mag) != 2 || szel < 3 || mag < 3) {fclose(fp); return 0;}
+    char uzenet[256] = "Nem sikerult lefoglalni a tablat";
+    if (!tabla_meret_ellenoriz(szel-2, mag-2, tarolas, 0, uzenet, sizeof(uzenet)) || !init_tabla(t, (int)szel-2, (int)mag-2)) {
+        SDL_Log("%s: %s\n", fajlnev, uzenet);
+        fclose(fp);
+        return 0;
+    }
+
+    for (int sor = 0; sor < t->m; sor++) {
+        for (int oszlop = 0; oszlop < t->sz; oszlop++) {
+            int c;
+            if (fscanf(fp, "%d", &c) != 1 || c < 0 || c > 255) {fclose(fp); destroy_tabla(t); return 0;}
+            CELLA(t, sor, oszlop) = c;
+        }
+    }
+    t->hash = tabla_hash(t);
+
+    fclose(fp);
+    return 1;
+}
+
+int tabla_ment(const char* fajlnev, Tabla* t){
+    FILE* fp = fopen(fajlnev, "wt");
+    if(fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+    fprintf(fp, "0.1\n");
+    fprintf(fp, "%d %d\n", t->sz, t->m);
+    for(int sor = 0; sor < (t->m); sor++){
+        for (int oszlop = 0; oszlop < (t->sz); oszlop++){
+            fprintf(fp, "%d", CELLA(t, sor, oszlop));
+            if (oszlop != (t->sz-1)){
+                fputc(' ', fp);
+            }
+        }
+        fputc('\n', fp);
+    }
+    fclose(fp);
+    return 1;
+}
+
+OszlopSor_Lista_Elem* valtozas_felvesz(OszlopSor_Lista_Elem* fej, int sor, int oszlop){
+    if(!valtozas_pool_kesz){
+        pool_init(&valtozas_pool, sizeof(OszlopSor_Lista_Elem), 4096);
+        valtozas_pool_kesz = 1;
+    }
+    OszlopSor_Lista_Elem *legutobbi_valtozas = pool_foglal(&valtozas_pool);
+    legutobbi_valtozas->next = fej;
+    legutobbi_valtozas->oszlop = oszlop;
+    legutobbi_valtozas->sor = sor;
+    return legutobbi_valtozas;
 }
 
 OszlopSor_Lista_Elem* uj_generacio(Tabla *t){ 
     int magassag = t -> m;
     int szelesseg = t -> sz;
-    Tabla uj;
     OszlopSor_Lista_Elem *fej = NULL;
 
-    init_tabla(&uj, szelesseg-2, magassag-2); // Sajnos muszáj kivonni kettőt, hiszen a szegélyt az init magától megalkotja
-    for(int sor=0; sor<magassag; sor++){
-        for(int oszlop=0; oszlop<szelesseg; oszlop++){
-            if(sor != 0 && oszlop != 0 && sor != magassag-1 && oszlop != szelesseg-1){ // A szegélyek nem változnak, gyakorlatilag nem is a játékterület részei
-                uj.g[sor][oszlop] = t->g[sor][oszlop];
-                int szomszedok = szomszedok_szama(t, sor, oszlop);
-                if (t->g[sor][oszlop] == 0) {
-                    if (szomszedok == 3){
-                        uj.g[sor][oszlop] = 1;
-                        OszlopSor_Lista_Elem *legutobbi_valtozas;
-                        legutobbi_valtozas = (OszlopSor_Lista_Elem*) malloc(sizeof(OszlopSor_Lista_Elem));
-                        legutobbi_valtozas->next = fej;
-                        legutobbi_valtozas->oszlop = oszlop;
-                        legutobbi_valtozas->sor = sor;
-                        fej = legutobbi_valtozas;
-                    }
+    for(int sor=1; sor<magassag-1; sor++){ // A szegélyek nem változnak, gyakorlatilag nem is a játékterület részei
+        // A második puffer szegélye mindig 0, a belsejét ez a lépés teljesen felülírja
+        const Cella *regi = t->g + (size_t)sor * t->lepes;
+        Cella *uj = t->kov + (size_t)sor * t->lepes;
+        for(int oszlop=1; oszlop<szelesseg-1; oszlop++){
+            uj[oszlop] = regi[oszlop];
+            int szomszedok = szomszedok_szama(t, sor, oszlop);
+            if (regi[oszlop] == 0) {
+                if (szomszedok == 3){
+                    uj[oszlop] = 1;
+                    fej = valtozas_felvesz(fej, sor, oszlop);
                 }
-                else{
-                   if (szomszedok < 2 || szomszedok > 3){
-                        uj.g[sor][oszlop] = 0;
-                        OszlopSor_Lista_Elem *legutobbi_valtozas;
-                        legutobbi_valtozas = (OszlopSor_Lista_Elem*) malloc(sizeof(OszlopSor_Lista_Elem));
-                        legutobbi_valtozas->next = fej;
-                        legutobbi_valtozas->oszlop = oszlop;
-                        legutobbi_valtozas->sor = sor;
-                        fej = legutobbi_valtozas;
-                    }
+            }
+            else{
+                if (szomszedok < 2 || szomszedok > 3){
+                    uj[oszlop] = 0;
+                    fej = valtozas_felvesz(fej, sor, oszlop);
                 }
             }
         }
     }
-    for(int sor=0; sor<magassag; sor++){
-        for(int oszlop=0; oszlop<szelesseg; oszlop++){
-            t->g[sor][oszlop] = uj.g[sor][oszlop];
-        }
-    }
-    destroy_tabla(&uj);
+    generacio_lezar(t, fej, 1);
     return fej;
-}
\ No newline at end of file
+}
+
+void generacio_lezar(Tabla *t, OszlopSor_Lista_Elem *fej, int generaciok){
+    // A két puffer cseréje, másolás nélkül
+    Cella *csere = t->g;
+    t->g = t->kov;
+    t->kov = csere;
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next){
+        size_t i = (size_t)iter->sor * t->lepes + iter->oszlop;
+        Cella regi = t->kov[i], uj = t->g[i];
+        // Két állapotú cellánál (0 <-> 1) a két kulcs XOR-ja éppen a cella kulcsa
+        if((regi | uj) == 1)
+            t->hash ^= cella_kulcs(iter->sor + t->eltolas_sor, iter->oszlop + t->eltolas_oszlop);
+        else
+            t->hash ^= allapot_kulcs(iter->sor + t->eltolas_sor, iter->oszlop + t->eltolas_oszlop, regi)
+                     ^ allapot_kulcs(iter->sor + t->eltolas_sor, iter->oszlop + t->eltolas_oszlop, uj);
+    }
+    t->generacio += generaciok;
+}
+
+int szabaly_beolvas(const char* szoveg, Szabaly* sz){
+    Szabaly uj = {0, 0};
+    if(*szoveg != 'B' && *szoveg != 'b')
+        return 0;
+    for(szoveg++; *szoveg >= '0' && *szoveg <= '8'; szoveg++)
+        uj.szuletes |= 1 << (*szoveg - '0');
+    if(*szoveg++ != '/' || (*szoveg != 'S' && *szoveg != 's'))
+        return 0;
+    for(szoveg++; *szoveg >= '0' && *szoveg <= '8'; szoveg++)
+        uj.tuleles |= 1 << (*szoveg - '0');
+    if(*szoveg != '\0')
+        return 0;
+    *sz = uj;
+    return 1;
+}
+
+void szabaly_kiir(const Szabaly* sz, char* hova){
+    *hova++ = 'B';
+    for(int n = 0; n <= 8; n++)
+        if(sz->szuletes & (1 << n))
+            *hova++ = '0' + n;
+    *hova++ = '/';
+    *hova++ = 'S';
+    for(int n = 0; n <= 8; n++)
+        if(sz->tuleles & (1 << n))
+            *hova++ = '0' + n;
+    *hova = '\0';
+}
+
+long long tabla_nepesseg(Tabla *t){
+    long long nepesseg = 0;
+    for(int sor=1; sor<t->m-1; sor++)
+        for(int oszlop=1; oszlop<t->sz-1; oszlop++)
+            nepesseg += CELLA(t, sor, oszlop) == 1;
+    return nepesseg;
+}
+
+void valtozasok_felszabadit(OszlopSor_Lista_Elem* fej){
+    while(fej != NULL){
+        OszlopSor_Lista_Elem* kov = fej->next;
+        pool_felszabadit(&valtozas_pool, fej);
+        fej = kov;
+    }
+}
+
+void valtozasok_pool_torol(void){
+    if(valtozas_pool_kesz){
+        pool_torol(&valtozas_pool);
+        valtozas_pool_kesz = 0;
+    }
+}
+
+int tabla_masol(Tabla* cel, Tabla* forras){
+    if(!init_tabla(cel, forras->sz-2, forras->m-2))
+        return 0;
+    memcpy(cel->g, forras->g, (size_t)forras->m * forras->lepes);
+    cel->hash = forras->hash;
+    cel->generacio = forras->generacio;
+    cel->eltolas_sor = forras->eltolas_sor;
+    cel->eltolas_oszlop = forras->eltolas_oszlop;
+    return 1;
+}
+
+uint64_t cella_kulcs(int sor, int oszlop){
+    // splitmix64 a koordinátákból
+    uint64_t z = ((uint64_t)(uint32_t)sor << 32 | (uint32_t)oszlop) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t allapot_kulcs(int sor, int oszlop, Cella allapot){
+    if(allapot <= 1)
+        return allapot ? cella_kulcs(sor, oszlop) : 0;
+    uint64_t z = cella_kulcs(sor, oszlop) + allapot * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t tabla_hash(Tabla* t){
+    uint64_t hash = 0;
+    for(int sor=1; sor<t->m-1; sor++)
+        for(int oszlop=1; oszlop<t->sz-1; oszlop++)
+            hash ^= allapot_kulcs(sor + t->eltolas_sor, oszlop + t->eltolas_oszlop, CELLA(t, sor, oszlop));
+    return hash;
+}
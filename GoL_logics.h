@@ -12,20 +12,61 @@
 #ifndef GOL_LOGICS_H
 #define GOL_LOGICS_H
 
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Egy cella értéke: 0/1 (halott/élő)
+ */
+typedef uint8_t Cella;
+
 /**
  * @brief A GoL játéktábla tárolására való struct
- * 
- * @param g grid (2d array), 0/1 (halott/élő)
+ * A rács egyetlen, 64 bájtra igazított, folytonos memóriablokk, soronként lepes bájttal (lásd CELLA).
+ * A sorok hossza 64 bájt többszörösére van kerekítve, így minden sor eleje cache line határra esik.
+ * A szegély (0. és utolsó sor/oszlop) mindig halott, ez a rács "halo"-ja, így a szomszédszámlálásnak nem kell a szélekre figyelnie.
+ * Az oldalak int-ek (legfeljebb TABLA_MAX_OLDAL), de a cellák száma és a bájtméretek már 32 bitet meghaladók lehetnek,
+ * ezért minden index- és méretszámolás size_t-ben történik (lásd CELLA, tabla_memoria_becsles).
+ * @param g grid, 0/1 (halott/élő); több állapotú szabálynál (lásd GoL_ltl.h) 2, 3, ... a haldokló cellák
+ * @param kov A g-vel azonos méretű második puffer, ebbe számolja az uj_generacio a következő állapotot, majd megcseréli a kettőt
  * @param sz szélesség
  * @param m magasság
- * @param rects A képernyőn megjelenített cellák listája (2d array)
+ * @param lepes Egy sor hossza a memóriában (sz felkerekítve 64 többszörösére)
+ * @param hash A cellák Zobrist hash-e (lásd allapot_kulcs), az uj_generacio és a flip frissíti.
+ * A kulcsok a globális koordinátákból számolódnak, így a tábla átméretezése (tabla_atmeretez) nem változtat rajta
+ * @param generacio Hányadik generációnál tart a szimuláció
+ * @param eltolas_sor A (sor, oszlop) cella globális koordinátája (sor + eltolas_sor, oszlop + eltolas_oszlop);
+ * a tabla_atmeretez állítja, hogy a megmaradt cellák globális helye ne változzon (lásd GoL_novekvo.h)
+ * @param eltolas_oszlop
  */
 typedef struct Tabla{
-    int** g; 
+    Cella* g;
+    Cella* kov;
     int sz, m;
-    SDL_Rect** rects;
+    int lepes;
+    uint64_t hash;
+    long long generacio;
+    int eltolas_sor, eltolas_oszlop;
 }Tabla;
 
+/**
+ * @brief A t tábla (sor, oszlop) cellája.
+ */
+#define CELLA(t, sor, oszlop) ((t)->g[(size_t)(sor) * (t)->lepes + (oszlop)])
+
+/**
+ * @brief Egy B/S (születés/túlélés) szabály, pl. a Conway-féle B3/S23.
+ * @param szuletes Az n. bit 1, ha a halott cella n élő szomszéddal megszületik
+ * @param tuleles Az n. bit 1, ha az élő cella n élő szomszéddal életben marad
+ */
+typedef struct Szabaly{
+    uint16_t szuletes;
+    uint16_t tuleles;
+}Szabaly;
+
+/** A Conway-féle szabály (B3/S23) kezdőértékként */
+#define SZABALY_CONWAY {1 << 3, (1 << 2) | (1 << 3)}
+
 /**
  * @brief Linked list elem oszloppal és sorral
  * A megváltoztatott cellák listájának kezelésére
@@ -38,15 +79,70 @@ typedef struct OszlopSor_Lista_Elem{
     struct OszlopSor_Lista_Elem* next;
 }OszlopSor_Lista_Elem;
 
+/** A tábla egy oldalának legnagyobb hossza (szegély nélkül); így a szegélyes méret, a lepes és a globális koordináták
+ * (lásd eltolas_sor) is bőven elférnek egy int-ben */
+#define TABLA_MAX_OLDAL (1 << 28)
+/** A fizikai memória legfeljebb ekkora hányadát (százalékban) foglalhatja egy tábla */
+#define TABLA_MEMORIA_SZAZALEK 75
+
+/**
+ * @brief A tábla tárolási módja. A rács elrendezése mindkét módban ugyanaz (lásd CELLA), csak a pufferek helye más.
+ * @param tar_suru Két teljes, cellánként egy bájtos puffer (g és kov) a memóriában
+ * @param tar_lemez Ugyanez egy fájlra leképezve (memoria_fajl_foglal): a memóriánál nagyobb tábla is lehet, a lépés
+ * sávonként halad rajta (lásd GoL_lemez.h). Csak POSIX rendszeren
+ */
+typedef enum Tarolas{
+    tar_suru, tar_lemez
+}Tarolas;
+
+/**
+ * @brief Beállítja, milyen tárolással hozza létre a táblákat az init_tabla (és így a betöltés, a másolás, az átméretezés).
+ * Alapból tar_suru.
+ * @param mod
+ */
+void tabla_tarolas_beallit(Tarolas mod);
+
+/**
+ * @brief Az init_tabla által használt tárolási mód.
+ */
+Tarolas tabla_tarolas(void);
+
 /**
- * @brief Létrehozza, feltölti nullákkal a Tabla objektumot
+ * @brief Létrehozza, feltölti nullákkal a Tabla objektumot (a tabla_tarolas szerinti tárolással)
  * A tábla sz és m paraméterei nem egyeznek a magassággal, hiszen extra nullásokból álló "szegélyt" kap köré
  * @warning Használat után törlendő memóriaszemetet hagy!!
  * @param ujtabla
- * @param szelesseg
+ * @param szelesseg 1 és TABLA_MAX_OLDAL között
+ * @param magassag
+ * @return 1 ha sikeres, 0 ha a méret érvénytelen vagy nem sikerült a foglalás (ekkor a táblát nem kell felszabadítani)
+ */
+int init_tabla(Tabla* ujtabla, int szelesseg, int magassag);
+
+/**
+ * @brief Megbecsüli egy szelesseg x magassag tábla memóriaigényét a megadott tárolási módban, még a foglalás előtt.
+ * A tar_lemez módban ez a lépés közben a memóriában tartott sávok mérete, a tábla maga a lemezen van.
+ * @param szelesseg szegély nélkül
  * @param magassag
+ * @param mod
+ * @param lemez ha nem NULL, ide írja a lemezen szükséges helyet (tar_suru módban 0-t)
+ * @return bájtban, 0 ha a méret érvénytelen (nem pozitív, TABLA_MAX_OLDAL-nál nagyobb, vagy nem fér el a címtérben)
  */
-void init_tabla(Tabla* ujtabla, int szelesseg, int magassag);
+size_t tabla_memoria_becsles(long long szelesseg, long long magassag, Tarolas mod, size_t* lemez);
+
+/**
+ * @brief Eldönti, hogy egy szelesseg x magassag tábla létrehozható-e: a méret érvényes, a becsült memóriaigénye
+ * nem több a fizikai memória TABLA_MEMORIA_SZAZALEK százalékánál, és tar_lemez módban elfér a lemezen (ha ezek lekérdezhetők).
+ * Ha a tábla a memóriában nem fér el, az üzenet a tar_lemez módot ajánlja.
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @param mod
+ * @param kisero A táblából méretezett kísérő szerkezetek (statisztika, történet, mentéspont, népszámlálás) becsült
+ * memóriaigénye bájtban, ez is a keretbe számít; 0 ha csak a tábla
+ * @param uzenet ha nem NULL, elutasításkor ide írja az okát (a becsült és az elérhető memóriával)
+ * @param uzenet_meret
+ * @return 1 ha létrehozható, 0 ha nem
+ */
+int tabla_meret_ellenoriz(long long szelesseg, long long magassag, Tarolas mod, size_t kisero, char* uzenet, size_t uzenet_meret);
 
 /**
  * @brief Felszabadítja a Tabla objektum memóriahelyét
@@ -54,6 +150,36 @@ void init_tabla(Tabla* ujtabla, int szelesseg, int magassag);
  */
 void destroy_tabla(Tabla* regitabla);
 
+/**
+ * @brief Átméretezi a táblát: az új belső terület a régi tábla (sor0, oszlop0) cellájától kezdődő szelesseg x magassag terület.
+ * A régi táblán kívül eső részek halottak lesznek, a kimaradó cellák elvesznek. Az eltolás úgy változik, hogy a megmaradt
+ * cellák globális koordinátája ne változzon; a hash-t újraszámolja (ha nem veszett el élő cella, az értéke nem változik).
+ * A pufferek újra foglalódnak, a generáció számláló marad.
+ * @param t
+ * @param sor0 Lehet 1-nél kisebb (a tábla felfelé nő) vagy nagyobb (felülről csökken)
+ * @param oszlop0
+ * @param szelesseg Az új szélesség, szegély nélkül, legalább 1
+ * @param magassag
+ * @return 1 ha sikeres, 0 ha az új tábla nem foglalható le (ekkor a t változatlan)
+ */
+int tabla_atmeretez(Tabla* t, int sor0, int oszlop0, int szelesseg, int magassag);
+
+/**
+ * @brief Beolvassa a megadott mentésfájlt (lásd Specifikacio.md) a táblába.
+ * @param fajlnev A fájl teljes elérési útja
+ * @param t Egy üres, iniciálizatlan Tabla objektum.
+ * @return 1 ha sikeres, 0 ha nem (ekkor a t-t nem kell felszabadítani)
+ */
+int tabla_betolt(const char* fajlnev, Tabla* t);
+
+/**
+ * @brief Elmenti a táblát a megadott fájlba (lásd Specifikacio.md).
+ * @param fajlnev A fájl teljes elérési útja
+ * @param t
+ * @return 1 ha sikeres
+ */
+int tabla_ment(const char* fajlnev, Tabla* t);
+
 /**
  * @brief A megadott sorban és oszlopban lévő cella értékét megváltoztatja (Halott -> Élő, Élő -> Halott)
  * @param t
@@ -66,10 +192,103 @@ void flip(Tabla* t, int sor, int oszlop);
  * @brief A szimulációt továbblépteti a következő állásba.
  * A szegély cellái nem változnak, ezek tulajdonképpen nem a szimuláció részei.
  * Linked list (első elemét) ad vissza, a megváltoztatott cellák koordinátájával.
- * @warning Felszabadítandó memóriaszemetet hagy (a linked listtel)!!
+ * A lista alapján frissíti a tábla hash-ét, és növeli a generáció számlálót.
+ * A lépés nem foglal memóriát: a tábla két pufferét cseréli, a lista elemei poolból jönnek.
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
  * @param t
  * @return a megváltoztatott cellák
  */
 OszlopSor_Lista_Elem* uj_generacio(Tabla* t);
 
+/**
+ * @brief Egy új elemet fűz a változáslista elejére, a változáslista poolból foglalva.
+ * Az uj_generacio-n kívüli lépésfüggvényeknek (pl. GoL_idoblokk), hogy ugyanolyan listát adjanak vissza.
+ * @param fej A lista eddigi első eleme
+ * @param sor
+ * @param oszlop
+ * @return A lista új első eleme
+ */
+OszlopSor_Lista_Elem* valtozas_felvesz(OszlopSor_Lista_Elem* fej, int sor, int oszlop);
+
+/**
+ * @brief Lezár egy lépést, miután a lépésfüggvény a t->kov-ba kiszámolta az új állapotot.
+ * Megcseréli a két puffert, a változáslista alapján frissíti a hash-t, és generaciok-kal növeli a számlálót.
+ * A csere után a következő lépésig a t->kov az előző állapot (pl. a statisztika ebből látja, honnan változott egy cella).
+ * @param t
+ * @param fej Azok a cellák, amik a régi és az új állapot között különböznek
+ * @param generaciok Hány generációt lépett a tábla
+ */
+void generacio_lezar(Tabla* t, OszlopSor_Lista_Elem* fej, int generaciok);
+
+/**
+ * @brief Megszámolja a tábla élő (1-es állapotú) celláit.
+ * Az egész táblát végignézi, ezért csak ritkán (pl. kijelzéshez) használandó.
+ * @param t
+ * @return az élő cellák száma
+ */
+long long tabla_nepesseg(Tabla* t);
+
+/**
+ * @brief Felszabadítja az uj_generacio által visszaadott linked listet.
+ * Az elemek a változáslisták poolba kerülnek vissza, a következő uj_generacio újrahasznosítja őket.
+ * @param fej
+ */
+void valtozasok_felszabadit(OszlopSor_Lista_Elem* fej);
+
+/**
+ * @brief Felszabadítja a változáslisták poolját. A program végén hívandó, amikor már nincs élő változáslista.
+ */
+void valtozasok_pool_torol(void);
+
+/**
+ * @brief Létrehozza a forras tábla másolatát.
+ * @warning A cel-t előtte nem kell inicializálni, de használat után törlendő!!
+ * @param cel
+ * @param forras
+ * @return 1 ha sikeres, 0 ha nem sikerült lefoglalni (ekkor a cel-t nem kell törölni)
+ */
+int tabla_masol(Tabla* cel, Tabla* forras);
+
+/**
+ * @brief Beolvas egy "B3/S23" alakú szabályt (a kis- és nagybetű mindegy, pl. "b36/s23", "B2/S").
+ * @param szoveg
+ * @param sz ide írja, ha sikeres
+ * @return 1 ha sikeres, 0 ha a szöveg nem érvényes szabály
+ */
+int szabaly_beolvas(const char* szoveg, Szabaly* sz);
+
+/**
+ * @brief Kiírja a szabályt "B3/S23" alakban.
+ * @param sz
+ * @param hova legalább 22 karakteres puffer
+ */
+void szabaly_kiir(const Szabaly* sz, char* hova);
+
+/**
+ * @brief Egy cella Zobrist kulcsa: a koordinátákból számolt, jól szórt 64 bites szám.
+ * A tábla hash-e az élő cellák kulcsainak XOR-ja, így egy cella megváltozásakor a hash a kulcsával XOR-olva frissíthető.
+ * @param sor
+ * @param oszlop
+ * @return a cella kulcsa
+ */
+uint64_t cella_kulcs(int sor, int oszlop);
+
+/**
+ * @brief Egy cella kulcsa a megadott állapotban: halott cellánál 0, élőnél cella_kulcs, a haldokló állapotoknál
+ * (több állapotú szabályok) a cella_kulcs-ból és az állapotból kevert szám.
+ * A tábla hash-e a cellák állapot kulcsainak XOR-ja; két állapotú táblán ez az élő cellák kulcsainak XOR-ja.
+ * @param sor
+ * @param oszlop
+ * @param allapot
+ * @return a kulcs
+ */
+uint64_t allapot_kulcs(int sor, int oszlop, Cella allapot);
+
+/**
+ * @brief Kiszámolja a tábla 64 bites (Zobrist) hash-ét az egész táblát végignézve.
+ * @param t
+ * @return a hash
+ */
+uint64_t tabla_hash(Tabla* t);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,323 @@
+/**
+ * @file GoL_ltl.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A Larger than Life és Generations motor megvalósítása.
+ * @version 0.1
+ * @date 2021-12-04
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_memoria.h"
+#include "GoL_ltl.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/** A motor szabálya, kezdetben a Conway-féle */
+static Ltl_szabaly ltl_aktiv = {1, 2, 0, 0, {1 << 3}, {(1 << 2) | (1 << 3)}};
+
+/**
+ * A prefix összegek segédtömbje, lépésről lépésre újrahasznosítva.
+ * Az összegek 16 bitesek és túlcsordulhatnak: egy szakasz összege (legfeljebb 2*LTL_MAX_SUGAR+1 cella) így is pontos,
+ * mert a két prefix különbsége modulo 65536 helyes.
+ */
+static uint16_t *seged = NULL;
+static size_t seged_meret = 0;
+
+/**
+ * @brief A szomszédok legnagyobb lehetséges száma a szabály szomszédságában.
+ */
+static int szam_max(const Ltl_szabaly *sz);
+
+/**
+ * @brief Az n. bit értéke.
+ */
+static inline int bit(const uint64_t *bitek, int n);
+
+/**
+ * @brief Beállítja a [tol, ig] intervallum bitjeit (üres, ha tol > ig).
+ */
+static void bitek_be(uint64_t *bitek, int tol, int ig);
+
+/**
+ * @brief A legkisebb és a legnagyobb beállított bit; ha egy sincs, tol = 1, ig = 0.
+ */
+static void bitek_hatarai(const uint64_t *bitek, int *tol, int *ig);
+
+/**
+ * @brief A cella következő állapota a szabály szerint, n élő szomszéd esetén.
+ */
+static inline Cella kovetkezo_allapot(const Ltl_szabaly *sz, Cella c, int n);
+
+/**
+ * @brief Legalább meret elemű segédtömb (a seged-et szükség esetén nagyobbra cseréli).
+ * @return NULL ha elfogyott a memória (ekkor nincs segédtömb, a következő hívás újra próbálja)
+ */
+static uint16_t* seged_foglal(size_t meret);
+
+/**
+ * @brief A négyzetes (Moore) szomszédságú lépés: oszloponkénti prefix összegek, soronként csúszó ablak.
+ * @param fej ide kerül a változáslista
+ * @return 1 ha sikeres, 0 ha a segédtömb nem foglalható le (ekkor a tábla nem változik)
+ */
+static int moore_lepes(Tabla *t, const Ltl_szabaly *sz, OszlopSor_Lista_Elem **fej);
+
+/**
+ * @brief A rombusz (von Neumann) szomszédságú lépés: a két átló menti prefix összegek, soronként csúszó rombusz.
+ * @param fej ide kerül a változáslista
+ * @return 1 ha sikeres, 0 ha a segédtömb nem foglalható le (ekkor a tábla nem változik)
+ */
+static int neumann_lepes(Tabla *t, const Ltl_szabaly *sz, OszlopSor_Lista_Elem **fej);
+
+int szam_max(const Ltl_szabaly *sz){
+    int r = sz->sugar;
+    return (sz->neumann ? 2 * r * (r + 1) : (2 * r + 1) * (2 * r + 1) - 1) + sz->kozep;
+}
+
+int bit(const uint64_t *bitek, int n){
+    return (bitek[n >> 6] >> (n & 63)) & 1;
+}
+
+void bitek_be(uint64_t *bitek, int tol, int ig){
+    for(int n = tol; n <= ig; n++)
+        bitek[n >> 6] |= (uint64_t)1 << (n & 63);
+}
+
+void bitek_hatarai(const uint64_t *bitek, int *tol, int *ig){
+    *tol = 1;
+    *ig = 0;
+    for(int n = 0; n <= LTL_MAX_SZAM; n++){
+        if(bit(bitek, n)){
+            if(*tol > *ig)
+                *tol = n;
+            *ig = n;
+        }
+    }
+}
+
+Cella kovetkezo_allapot(const Ltl_szabaly *sz, Cella c, int n){
+    if(c == 0)
+        return (Cella)bit(sz->szuletes, n);
+    if(c == 1)
+        return bit(sz->tuleles, n) ? 1 : (sz->allapotok > 2 ? 2 : 0);
+    return (c + 1 < sz->allapotok) ? c + 1 : 0;
+}
+
+int ltl_szabaly_beolvas(const char *szoveg, Ltl_szabaly *sz){
+    Ltl_szabaly uj;
+    memset(&uj, 0, sizeof(uj));
+    uj.sugar = 1;
+    uj.allapotok = 2;
+    if(*szoveg == 'R' || *szoveg == 'r'){
+        int allapotok, s_tol, s_ig, b_tol, b_ig, hossz = -1;
+        char szomszedsag;
+        if(sscanf(szoveg, "%*1[Rr]%d,%*1[Cc]%d,%*1[Mm]%d,%*1[Ss]%d..%d,%*1[Bb]%d..%d,%*1[Nn]%c%n", &uj.sugar, &allapotok, &uj.kozep,
+                  &s_tol, &s_ig, &b_tol, &b_ig, &szomszedsag, &hossz) != 8 || hossz < 0 || szoveg[hossz] != '\0')
+            return 0;
+        if(uj.sugar < 1 || uj.sugar > LTL_MAX_SUGAR || allapotok == 1 || allapotok < 0 || allapotok > 255 ||
+           (uj.kozep != 0 && uj.kozep != 1) || s_tol < 0 || b_tol < 0)
+            return 0;
+        if(szomszedsag == 'N' || szomszedsag == 'n') uj.neumann = 1;
+        else if(szomszedsag != 'M' && szomszedsag != 'm') return 0;
+        uj.allapotok = allapotok ? allapotok : 2;
+        int max = szam_max(&uj);
+        bitek_be(uj.tuleles, s_tol, s_ig < max ? s_ig : max);
+        bitek_be(uj.szuletes, b_tol, b_ig < max ? b_ig : max);
+    }
+    else{
+        if(*szoveg != 'B' && *szoveg != 'b')
+            return 0;
+        for(szoveg++; *szoveg >= '0' && *szoveg <= '8'; szoveg++)
+            bitek_be(uj.szuletes, *szoveg - '0', *szoveg - '0');
+        if(*szoveg++ != '/' || (*szoveg != 'S' && *szoveg != 's'))
+            return 0;
+        for(szoveg++; *szoveg >= '0' && *szoveg <= '8'; szoveg++)
+            bitek_be(uj.tuleles, *szoveg - '0', *szoveg - '0');
+        if(*szoveg == '/'){
+            szoveg++;
+            if(*szoveg != 'C' && *szoveg != 'c')
+                return 0;
+            char *vege;
+            long allapotok = strtol(szoveg + 1, &vege, 10);
+            if(vege == szoveg + 1 || allapotok < 2 || allapotok > 255)
+                return 0;
+            uj.allapotok = (int)allapotok;
+            szoveg = vege;
+        }
+        if(*szoveg != '\0')
+            return 0;
+    }
+    *sz = uj;
+    return 1;
+}
+
+void ltl_szabaly_kiir(const Ltl_szabaly *sz, char *hova){
+    if(sz->sugar == 1 && !sz->kozep && !sz->neumann){
+        *hova++ = 'B';
+        for(int n = 0; n <= 8; n++)
+            if(bit(sz->szuletes, n))
+                *hova++ = '0' + n;
+        *hova++ = '/';
+        *hova++ = 'S';
+        for(int n = 0; n <= 8; n++)
+            if(bit(sz->tuleles, n))
+                *hova++ = '0' + n;
+        *hova = '\0';
+        if(sz->allapotok > 2)
+            sprintf(hova, "/C%d", sz->allapotok);
+        return;
+    }
+    int s_tol, s_ig, b_tol, b_ig;
+    bitek_hatarai(sz->tuleles, &s_tol, &s_ig);
+    bitek_hatarai(sz->szuletes, &b_tol, &b_ig);
+    sprintf(hova, "R%d,C%d,M%d,S%d..%d,B%d..%d,N%c", sz->sugar, sz->allapotok, sz->kozep, s_tol, s_ig, b_tol, b_ig, sz->neumann ? 'N' : 'M');
+}
+
+void ltl_szabaly_bs(const Szabaly *bs, Ltl_szabaly *sz){
+    memset(sz, 0, sizeof(*sz));
+    sz->sugar = 1;
+    sz->allapotok = 2;
+    sz->szuletes[0] = bs->szuletes;
+    sz->tuleles[0] = bs->tuleles;
+}
+
+int ltl_szabaly_bs_e(const Ltl_szabaly *sz, Szabaly *bs){
+    if(sz->sugar != 1 || sz->allapotok != 2 || sz->kozep || sz->neumann)
+        return 0;
+    bs->szuletes = (uint16_t)(sz->szuletes[0] & 0x1FF);
+    bs->tuleles = (uint16_t)(sz->tuleles[0] & 0x1FF);
+    return 1;
+}
+
+void ltl_szabaly(const Ltl_szabaly *sz){
+    ltl_aktiv = *sz;
+}
+
+uint16_t* seged_foglal(size_t meret){
+    if(meret > seged_meret){
+        memoria_felszabadit(seged);
+        seged = memoria_foglal(meret * sizeof(uint16_t));
+        seged_meret = seged != NULL ? meret : 0;
+    }
+    return seged;
+}
+
+void ltl_torol(void){
+    memoria_felszabadit(seged);
+    seged = NULL;
+    seged_meret = 0;
+}
+
+int moore_lepes(Tabla *t, const Ltl_szabaly *sz, OszlopSor_Lista_Elem **fej){
+    // A tömb a táblát minden irányban pad cellányi (halott) kerettel veszi körül, így a csúszó ablak sosem lóg ki belőle
+    int r = sz->sugar, pad = r + 2;
+    size_t lepes = (size_t)t->sz + 2 * pad, sorok = (size_t)t->m + 2 * pad;
+    uint16_t *V = seged_foglal(lepes * sorok);
+    if(V == NULL)
+        return 0;
+    // V[i][j]: a j. oszlop élő celláinak száma az i. sorig (bezárólag)
+    memset(V, 0, lepes * sizeof(uint16_t));
+    for(size_t i = 1; i < sorok; i++){
+        uint16_t *v = V + i * lepes, *elozo = v - lepes;
+        int sor = (int)i - pad;
+        memcpy(v, elozo, lepes * sizeof(uint16_t));
+        if(sor >= 0 && sor < t->m){
+            const Cella *g = &CELLA(t, sor, 0);
+            for(int oszlop = 0; oszlop < t->sz; oszlop++)
+                v[pad + oszlop] += g[oszlop] == 1;
+        }
+    }
+
+    *fej = NULL;
+    for(int sor = 1; sor < t->m - 1; sor++){
+        // Az oszlop összege a [sor-r, sor+r] sorokban: also[j] - felso[j]
+        const uint16_t *also = V + (size_t)(sor + r + pad) * lepes + pad;
+        const uint16_t *felso = V + (size_t)(sor - r - 1 + pad) * lepes + pad;
+        int db = 0;
+        for(int j = 1 - r; j <= 1 + r; j++)
+            db += (uint16_t)(also[j] - felso[j]);
+        const Cella *regi = &CELLA(t, sor, 0);
+        Cella *uj = t->kov + (size_t)sor * t->lepes;
+        for(int oszlop = 1; oszlop < t->sz - 1; oszlop++){
+            int n = db - (!sz->kozep && regi[oszlop] == 1);
+            uj[oszlop] = kovetkezo_allapot(sz, regi[oszlop], n);
+            if(uj[oszlop] != regi[oszlop])
+                *fej = valtozas_felvesz(*fej, sor, oszlop);
+            db += (uint16_t)(also[oszlop + r + 1] - felso[oszlop + r + 1]);
+            db -= (uint16_t)(also[oszlop - r] - felso[oszlop - r]);
+        }
+    }
+    return 1;
+}
+
+int neumann_lepes(Tabla *t, const Ltl_szabaly *sz, OszlopSor_Lista_Elem **fej){
+    int r = sz->sugar, pad = r + 2;
+    size_t lepes = (size_t)t->sz + 2 * pad, sorok = (size_t)t->m + 2 * pad;
+    uint16_t *P1 = seged_foglal(2 * lepes * sorok);
+    if(P1 == NULL)
+        return 0;
+    uint16_t *P2 = P1 + lepes * sorok;
+    // P1[i][j]: az élő cellák száma a (i, j)-ben végződő "\" átlón, P2[i][j]: ugyanez a "/" átlón
+    memset(P1, 0, lepes * sizeof(uint16_t));
+    memset(P2, 0, lepes * sizeof(uint16_t));
+    for(size_t i = 1; i < sorok; i++){
+        uint16_t *p1 = P1 + i * lepes, *p2 = P2 + i * lepes;
+        int sor = (int)i - pad;
+        const Cella *g = (sor >= 0 && sor < t->m) ? &CELLA(t, sor, 0) : NULL;
+        for(size_t j = 0; j < lepes; j++){
+            int oszlop = (int)j - pad;
+            uint16_t a = g != NULL && oszlop >= 0 && oszlop < t->sz && g[oszlop] == 1;
+            p1[j] = a + (j > 0 ? p1[j - lepes - 1] : 0);
+            p2[j] = a + (j + 1 < lepes ? p2[j - lepes + 1] : 0);
+        }
+    }
+    // A tábla (sor, oszlop) koordinátáival
+    #define P(tomb, sor, oszlop) (tomb)[(size_t)((sor) + pad) * lepes + (oszlop) + pad]
+    #define ELO(sor, oszlop) ((uint16_t)(P(P1, sor, oszlop) - P(P1, (sor) - 1, (oszlop) - 1)))
+
+    *fej = NULL;
+    for(int sor = 1; sor < t->m - 1; sor++){
+        // Az első rombusz soronként közvetlenül, O(r^2)
+        int db = 0;
+        for(int d = -r; d <= r; d++){
+            int w = r - abs(d);
+            for(int oszlop = 1 - w; oszlop <= 1 + w; oszlop++)
+                db += ELO(sor + d, oszlop);
+        }
+        const Cella *regi = &CELLA(t, sor, 0);
+        Cella *uj = t->kov + (size_t)sor * t->lepes;
+        for(int x = 1; x < t->sz - 1; x++){
+            int n = db - (!sz->kozep && regi[x] == 1);
+            uj[x] = kovetkezo_allapot(sz, regi[x], n);
+            if(uj[x] != regi[x])
+                *fej = valtozas_felvesz(*fej, sor, x);
+            // Belépő jobb szél (x+1 középpontú rombusz): a felső fele "\", az alsó "/" irányú, a középső cella mindkettőben benne van
+            db += (uint16_t)(P(P1, sor, x + 1 + r) - P(P1, sor - r - 1, x));
+            db += (uint16_t)(P(P2, sor + r, x + 1) - P(P2, sor - 1, x + 2 + r));
+            db -= ELO(sor, x + 1 + r);
+            // Kilépő bal szél (x középpontú rombusz): a felső fele "/", az alsó "\" irányú
+            db -= (uint16_t)(P(P2, sor, x - r) - P(P2, sor - r - 1, x + 1));
+            db -= (uint16_t)(P(P1, sor + r, x) - P(P1, sor - 1, x - r - 1));
+            db += ELO(sor, x - r);
+        }
+    }
+    #undef P
+    #undef ELO
+    return 1;
+}
+
+OszlopSor_Lista_Elem* ltl_generacio(Tabla *t){
+    OszlopSor_Lista_Elem *fej;
+    if(!(ltl_aktiv.neumann ? neumann_lepes(t, &ltl_aktiv, &fej) : moore_lepes(t, &ltl_aktiv, &fej)))
+        return NULL;
+    generacio_lezar(t, fej, 1);
+    return fej;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file GoL_ltl.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Larger than Life és Generations szabályok lépésmotorja.
+ * Larger than Life: a szomszédság R sugarú (R <= LTL_MAX_SUGAR) négyzet (Moore) vagy rombusz (von Neumann),
+ * a születés és a túlélés a szomszédok számának egy-egy intervalluma. Generations: több állapotú cellák, az élő cella
+ * ha nem marad életben, nem hal meg azonnal, hanem a 2, 3, ..., C-1 állapotokon át öregszik, majd halott lesz.
+ * Szomszédnak csak az élő (1-es állapotú) cella számít.
+ *
+ * A szomszédok száma cellánként O(1) idejű, a sugártól függetlenül: a motor lépésenként egyenesek menti prefix összegeket
+ * számol (Moore: oszloponként, von Neumann: a két átló mentén), így egy szakasz összege két kivonás. Egy sorban haladva a
+ * szomszédság ablaka egy cellával arrébb csúszik: a belépő és a kilépő szél egy-egy szakasz (Moore), illetve két-két
+ * átlós szakasz (von Neumann).
+ *
+ * Szabályok formátuma:
+ *  - Generations: B<számjegyek>/S<számjegyek>/C<állapotok>, pl. Brian's Brain: B2/S/C3, Star Wars: B2/S345/C4
+ *  - Larger than Life: R<sugár>,C<állapotok>,M<0|1>,S<min>..<max>,B<min>..<max>,N<M|N>
+ *    (M1: a cella maga is számít, NM: Moore, NN: von Neumann szomszédság; C0 és C2 a két állapotú), pl. Bosco: R5,C2,M1,S34..58,B34..45,NM
+ * @version 0.1
+ * @date 2021-12-04
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_LTL_H
+#define GOL_LTL_H
+
+#include <stdint.h>
+#include "GoL_logics.h"
+
+/** A legnagyobb támogatott szomszédsági sugár */
+#define LTL_MAX_SUGAR 10
+/** A szomszédok legnagyobb lehetséges száma (a legnagyobb négyzet, a közepével együtt) */
+#define LTL_MAX_SZAM ((2 * LTL_MAX_SUGAR + 1) * (2 * LTL_MAX_SUGAR + 1))
+/** A szabály szöveges alakjához (ltl_szabaly_kiir) elég puffer mérete */
+#define LTL_SZABALY_HOSSZ 64
+
+/**
+ * @brief Egy Larger than Life / Generations szabály.
+ * @param sugar A szomszédság sugara
+ * @param allapotok Az állapotok száma (2: csak halott és élő)
+ * @param kozep 1 ha a cella maga is beleszámít a szomszédok számába
+ * @param neumann 1 ha a szomszédság rombusz (von Neumann), 0 ha négyzet (Moore)
+ * @param szuletes Az n. bit 1, ha a halott cella n élő szomszéddal megszületik
+ * @param tuleles Az n. bit 1, ha az élő cella n élő szomszéddal életben marad
+ */
+typedef struct Ltl_szabaly{
+    int sugar;
+    int allapotok;
+    int kozep;
+    int neumann;
+    uint64_t szuletes[LTL_MAX_SZAM / 64 + 1];
+    uint64_t tuleles[LTL_MAX_SZAM / 64 + 1];
+}Ltl_szabaly;
+
+/**
+ * @brief Beolvas egy Generations vagy Larger than Life alakú szabályt (lásd fent), a sima B/S alakot is.
+ * @param szoveg
+ * @param sz ide írja, ha sikeres
+ * @return 1 ha sikeres, 0 ha a szöveg nem érvényes szabály
+ */
+int ltl_szabaly_beolvas(const char *szoveg, Ltl_szabaly *sz);
+
+/**
+ * @brief Kiírja a szabályt: 1 sugarú, középpont nélküli Moore szomszédságnál Generations (B/S/C), különben Larger than Life alakban.
+ * @param sz
+ * @param hova legalább LTL_SZABALY_HOSSZ karakteres puffer
+ */
+void ltl_szabaly_kiir(const Ltl_szabaly *sz, char *hova);
+
+/**
+ * @brief Egy B/S szabály megfelelője (1 sugarú Moore szomszédság, két állapot).
+ * @param bs
+ * @param sz
+ */
+void ltl_szabaly_bs(const Szabaly *bs, Ltl_szabaly *sz);
+
+/**
+ * @brief Ha a szabály egy sima B/S szabály (1 sugarú, középpont nélküli Moore szomszédság, két állapot), kiírja a bs-be.
+ * @param sz
+ * @param bs
+ * @return 1 ha B/S szabály
+ */
+int ltl_szabaly_bs_e(const Ltl_szabaly *sz, Szabaly *bs);
+
+/**
+ * @brief Beállítja a motor szabályát. Amíg nem hívják, a Conway-féle szabállyal dolgozik.
+ * @param sz
+ */
+void ltl_szabaly(const Ltl_szabaly *sz);
+
+/**
+ * @brief A szimulációt továbblépteti a következő állásba a beállított szabállyal.
+ * Minden szempontból az uj_generacio-val egyezően viselkedik (változáslista, hash, generáció számláló);
+ * több állapotnál a haldokló cellák öregedése is változás.
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param t
+ * @return a megváltoztatott cellák; NULL, és a tábla (a generáció számlálóval együtt) nem változik, ha a segédtömbhöz
+ * elfogyott a memória
+ */
+OszlopSor_Lista_Elem* ltl_generacio(Tabla *t);
+
+/**
+ * @brief Felszabadítja a motor segédtömbjét. A program végén hívandó.
+ */
+void ltl_torol(void);
+
+#endif
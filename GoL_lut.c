@@ -0,0 +1,118 @@
+/**
+ * @file GoL_lut.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A táblázatos lépésmotor megvalósítása.
+ * @version 0.1
+ * @date 2021-11-30
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_lut.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/*
+ * A 4x4-es környezet oszloponként kerül az indexbe: egy oszlop 4 bitje (felülről lefelé) a 3., 2., 1., 0. bit,
+ * a bal szélső oszlop a legfelső 4 bit. Így két oszloppal jobbra lépve az index 8 bittel eltolható,
+ * és csak a két új oszlopot kell beolvasni.
+ * A táblázat eleme: 0. bit a bal felső, 1. a jobb felső, 2. a bal alsó, 3. a jobb alsó középső cella új értéke.
+ */
+
+/** A (sor, oszlop) cella bitjének helye az indexben, 0 <= sor, oszlop < 4 */
+#define LUT_BIT(sor, oszlop) ((3 - (oszlop)) * 4 + (3 - (sor)))
+
+static uint8_t lut[1 << 16];
+static Szabaly lut_aktiv = SZABALY_CONWAY;
+static int lut_kesz = 0;
+
+/**
+ * @brief Kiszámolja a táblázatot a lut_aktiv szabályhoz.
+ */
+static void lut_epit(void);
+
+/**
+ * @brief Egy oszlop négy cellája az index 4 bitjeként.
+ */
+static inline unsigned oszlop_bitek(const Cella *r0, const Cella *r1, const Cella *r2, const Cella *r3, int oszlop);
+
+void lut_epit(void){
+    for(unsigned index = 0; index < (1u << 16); index++){
+        uint8_t eredmeny = 0;
+        for(int i = 1; i <= 2; i++){
+            for(int j = 1; j <= 2; j++){
+                int szomszedok = 0;
+                for(int di = -1; di <= 1; di++)
+                    for(int dj = -1; dj <= 1; dj++)
+                        if(di || dj)
+                            szomszedok += (index >> LUT_BIT(i+di, j+dj)) & 1;
+                int el = (index >> LUT_BIT(i, j)) & 1;
+                int uj = el ? (lut_aktiv.tuleles >> szomszedok) & 1 : (lut_aktiv.szuletes >> szomszedok) & 1;
+                eredmeny |= uj << ((i-1)*2 + (j-1));
+            }
+        }
+        lut[index] = eredmeny;
+    }
+    lut_kesz = 1;
+}
+
+void lut_szabaly(const Szabaly* sz){
+    if(lut_kesz && sz->szuletes == lut_aktiv.szuletes && sz->tuleles == lut_aktiv.tuleles)
+        return;
+    lut_aktiv = *sz;
+    lut_epit();
+}
+
+unsigned oszlop_bitek(const Cella *r0, const Cella *r1, const Cella *r2, const Cella *r3, int oszlop){
+    return (unsigned)r0[oszlop] << 3 | (unsigned)r1[oszlop] << 2 | (unsigned)r2[oszlop] << 1 | r3[oszlop];
+}
+
+OszlopSor_Lista_Elem* lut_generacio(Tabla *t){
+    if(!lut_kesz)
+        lut_epit();
+    int magassag = t->m;
+    int szelesseg = t->sz;
+    OszlopSor_Lista_Elem *fej = NULL;
+
+    for(int sor = 1; sor < magassag-1; sor += 2){
+        const Cella *r0 = t->g + (size_t)(sor-1) * t->lepes;
+        const Cella *r1 = r0 + t->lepes;
+        const Cella *r2 = r1 + t->lepes;
+        // Páratlan magasságnál az utolsó sorpár alsó sora már a szegély; az alatta lévő sor helyett is a (halott) szegélyt olvassa
+        const Cella *r3 = (sor + 2 < magassag) ? r2 + t->lepes : r2;
+        Cella *u1 = t->kov + (size_t)sor * t->lepes;
+        Cella *u2 = u1 + t->lepes;
+        // A szegélyre eső eredmény bitek nem íródhatnak 1-re
+        unsigned sor_maszk = (sor + 1 < magassag-1) ? 0xF : 0x3;
+
+        unsigned index = oszlop_bitek(r0, r1, r2, r3, 0) << 4 | oszlop_bitek(r0, r1, r2, r3, 1);
+        for(int oszlop = 1; oszlop < szelesseg-1; oszlop += 2){
+            unsigned jobb = (oszlop + 2 < szelesseg) ? oszlop_bitek(r0, r1, r2, r3, oszlop+2) : 0;
+            index = ((index << 8) | oszlop_bitek(r0, r1, r2, r3, oszlop+1) << 4 | jobb) & 0xFFFF;
+            unsigned maszk = (oszlop + 1 < szelesseg-1) ? sor_maszk : (sor_maszk & 0x5);
+            unsigned uj = lut[index] & maszk;
+            unsigned regi = ((index >> LUT_BIT(1, 1)) & 1) | ((index >> LUT_BIT(1, 2)) & 1) << 1 |
+                            ((index >> LUT_BIT(2, 1)) & 1) << 2 | ((index >> LUT_BIT(2, 2)) & 1) << 3;
+            u1[oszlop] = uj & 1;
+            u1[oszlop+1] = (uj >> 1) & 1;
+            u2[oszlop] = (uj >> 2) & 1;
+            u2[oszlop+1] = (uj >> 3) & 1;
+            unsigned valtozas = (uj ^ regi) & maszk;
+            if(valtozas){
+                if(valtozas & 1) fej = valtozas_felvesz(fej, sor, oszlop);
+                if(valtozas & 2) fej = valtozas_felvesz(fej, sor, oszlop+1);
+                if(valtozas & 4) fej = valtozas_felvesz(fej, sor+1, oszlop);
+                if(valtozas & 8) fej = valtozas_felvesz(fej, sor+1, oszlop+1);
+            }
+        }
+    }
+    generacio_lezar(t, fej, 1);
+    return fej;
+}
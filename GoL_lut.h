@@ -0,0 +1,36 @@
+/**
+ * @file GoL_lut.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Táblázatos (lookup table) lépésmotor: egy táblázatolvasás 2x2 cella új értékét adja.
+ * Egy 4x4-es környezet 16 bitbe csomagolva indexel egy előre kiszámolt, 65536 elemű táblázatot,
+ * aminek elemei a környezet közepén lévő 2x2 cella következő állapotát tartalmazzák.
+ * Mivel a táblázat a szabályból készül, tetszőleges B/S szabállyal működik.
+ * @version 0.1
+ * @date 2021-11-30
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_LUT_H
+#define GOL_LUT_H
+
+#include "GoL_logics.h"
+
+/**
+ * @brief Beállítja a motor szabályát, és újraszámolja a táblázatot (ha a szabály változott).
+ * Amíg nem hívják, a Conway-féle szabállyal dolgozik.
+ * @param sz
+ */
+void lut_szabaly(const Szabaly* sz);
+
+/**
+ * @brief A szimulációt továbblépteti a következő állásba, a táblázat segítségével.
+ * Minden szempontból az uj_generacio-val egyezően viselkedik (változáslista, hash, generáció számláló).
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param t
+ * @return a megváltoztatott cellák
+ */
+OszlopSor_Lista_Elem* lut_generacio(Tabla* t);
+
+#endif
@@ -17,123 +17,193 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_image.h>
 #include <math.h>
+#ifdef GOL_DEBUG
 #include "src/debugmalloc.h"
+#endif
 #include "GoL_logics.h"
 #include "GoL_graphics.h"
+#include "GoL_meres.h"
+#include "GoL_parancssor.h"
+#include "GoL_motor.h"
+#include "GoL_ltl.h"
+#include "GoL_eroforras.h"
 
-int main(void){
-    Ablak_info env = {NULL, s_menu, 1000, 600, NULL};
-    sdl_init(&env);
-
-    TTF_Font *font_menu = TTF_OpenFont("C:/Windows/Fonts/OCRAEXT.TTF", 54);
-    if (!font_menu) {
-        SDL_Log("Nem sikerult megnyitni a fontot! %s\n", TTF_GetError());
-        exit(1);
-    }
+/**
+ * @brief Feldolgoz egy eseményt a program aktuális állapota szerint.
+ * A szövegbevitelt kérő állapotok (s_tabla_meret, s_mentes) maguk kapják meg a billentyűzet és az egér eseményeit.
+ * @param env
+ * @param t
+ * @param font_menu
+ * @param gombok_helye
+ * @param ev
+ */
+static void esemeny_kezel(Ablak_info *env, Tabla *t, TTF_Font *font_menu, Harom_hely *gombok_helye, const SDL_Event *ev);
 
-    TTF_Font *font_mentes = TTF_OpenFont("C:/Windows/Fonts/Jura-Regular.ttf", 32);
-    if (!font_mentes) {
-        SDL_Log("Nem sikerult megnyitni a fontot! %s\n", TTF_GetError());
-        exit(1);
+int main(int argc, char *argv[]){
+    // Parancssori módok, grafikus felület nélkül
+    int kilepes = parancssor_futtat(argc, argv);
+    if(kilepes >= 0){
+        return kilepes;
     }
 
-    TTF_Font *font_sugo = TTF_OpenFont("C:/Windows/Fonts/Jura-Regular.ttf", 20);
-    if (!font_sugo) {
-        SDL_Log("Nem sikerult megnyitni a fontot! %s\n", TTF_GetError());
-        exit(1);
-    }
+    Uint64 indulas = meres_kezd();
+    Ablak_info env = {NULL, s_menu, 1000, 600};
+    sdl_init(&env);
 
-    SDL_Texture *kep_conway = IMG_LoadTexture(env.renderer, "./src/John_H_Conway.jpg");
-    if (kep_conway == NULL) {
-        SDL_Log("Nem nyithato meg a kepfajl: %s\n", IMG_GetError());
-        exit(1);
-    }
+    // Az indításkor csak a menü fontja töltődik be, a többi erőforrás az első használatkor (GoL_eroforras.h)
+    TTF_Font *font_menu = eroforras_font(ef_menu);
 
     Harom_hely gombok_helye;
-    Ikonok_hely ikonok_helye;
-    Tabla t = {NULL, 0, 0, NULL};
+    Tabla t = {NULL, NULL, 0, 0, 0};
 
     menu(&env, font_menu, &gombok_helye);
+    meres_vege(m_elso_kepkocka, indulas);
+    SDL_Log("Elso kepkocka: %.1f ms (cel: %d ms)%s\n", meres_atlag(m_elso_kepkocka) / 1000.0, MERES_ELSO_KEPKOCKA_CEL_MS,
+            meres_atlag(m_elso_kepkocka) > MERES_ELSO_KEPKOCKA_CEL_MS * 1000.0 ? " - lassu indulas!" : "");
  
+    // Egyetlen eseményciklus: álló képnél eseményre várva alszik, futó szimulációnál nem vár, hanem a már beérkezett
+    // eseményeket feldolgozva lép egyet, így a bemenet legfeljebb egy generációnyi időt késik
     SDL_Event ev;
-    while (SDL_WaitEvent(&ev) && ev.type != SDL_QUIT) { 
-        switch(ev.type){ 
-            case SDL_WINDOWEVENT:
-                if(ev.window.event == SDL_WINDOWEVENT_RESIZED){
-                    env.width_screen = ev.window.data1;
-                    env.height_screen = ev.window.data2;
-                    switch(env.state){
-                        case s_menu:
-                            menu(&env, font_menu, &gombok_helye);
-                            break;
-                        case s_tabla_meret:
-                            tabla_meret(&env, font_mentes, &t);
-                            break;
-                        case s_jatek:
-                            jatek(&env,&t);
-                            break;
-                        case s_betolt:
-                            betolt(&env, font_mentes);
-                            break;
-                        case s_sugo:
-                            sugo(&env, font_sugo, kep_conway);
-                            break;
+    int kilep = 0;
+    while (!kilep) {
+        Uint64 kezdet = meres_kezd();
+        int van = env.fut ? SDL_PollEvent(&ev) : SDL_WaitEvent(&ev);
+        if (!van && !env.fut) {
+            break;
+        }
+        while (van && !kilep) {
+            if (ev.type == SDL_QUIT) {
+                kilep = 1;
+            }
+            else {
+                esemeny_kezel(&env, &t, font_menu, &gombok_helye, &ev);
+            }
+            van = SDL_PollEvent(&ev);
+        }
+        if (env.fut && !kilep) {
+            meres_vege(m_esemenyek, kezdet);
+            jatek_futas_lepes(&env, &t);
+        }
+    }
+    
+    destroy_tabla(&t);
+    jatek_torol();
+    valtozasok_pool_torol();
+    ltl_torol();
+    meres_trace_leallit();
+    szoveg_cache_torol();
+    eroforras_torol();
+    SDL_Quit();
+    return 0;
+}
+
+void esemeny_kezel(Ablak_info *env, Tabla *t, TTF_Font *font_menu, Harom_hely *gombok_helye, const SDL_Event *ev){
+    if (ev->type == SDL_WINDOWEVENT) {
+        if (ev->window.event == SDL_WINDOWEVENT_RESIZED) {
+            env->width_screen = ev->window.data1;
+            env->height_screen = ev->window.data2;
+            switch (env->state) {
+                case s_menu:
+                    menu(env, font_menu, gombok_helye);
+                    break;
+                case s_tabla_meret:
+                    tabla_meret(env, eroforras_font(ef_mentes));
+                    break;
+                case s_jatek:
+                    jatek(env, t);
+                    break;
+                case s_betolt:
+                    betolt(env, eroforras_font(ef_mentes));
+                    break;
+                case s_sugo:
+                    sugo(env, eroforras_font(ef_sugo), eroforras_kep(env->renderer, ek_conway));
+                    break;
+                case s_mentes:
+                    jatek_mentes_rajzol(env, t);
+                    break;
+            }
+        }
+        return;
+    }
+    if (env->state == s_tabla_meret) {
+        if (tabla_meret_esemeny(env, eroforras_font(ef_mentes), t, ev) == 1) {
+            menu(env, font_menu, gombok_helye);
+        }
+        return;
+    }
+    if (env->state == s_mentes) {
+        jatek_mentes_esemeny(env, t, ev);
+        return;
+    }
+
+    switch (ev->type) {
+        case SDL_MOUSEBUTTONDOWN:
+            if (ev->button.button == SDL_BUTTON_LEFT) {
+                const int x = ev->button.x, y = ev->button.y;
+                if (env->state == s_menu) {
+                    if ( xy_in_rect(x, y, gombok_helye->j) ) {
+                        // Játek
+                        tabla_meret(env, eroforras_font(ef_mentes));
+                    }
+                    else if ( xy_in_rect(x, y, gombok_helye->b) ) {
+                        // Betölt
+                        betolt(env, eroforras_font(ef_mentes));
+                    }
+                    else if ( xy_in_rect(x, y, gombok_helye->s) ) {
+                        // Súgó
+                        sugo(env, eroforras_font(ef_sugo), eroforras_kep(env->renderer, ek_conway));
                     }
                 }
-                break;
-            case SDL_MOUSEBUTTONDOWN:
-                if (ev.button.button == SDL_BUTTON_LEFT) {
-                    const int x = ev.button.x, y = ev.button.y;
-                    if(env.state == s_menu){
-                        if( xy_in_rect(x, y, gombok_helye.j) ){
-                            // Játek
-                            tabla_meret(&env, font_mentes, &t);
-                            
-                        }
-                        else if ( xy_in_rect(x, y, gombok_helye.b) ){
-                            // Betölt
-                            betolt(&env, font_mentes);
-                            // if (!betolt_betoltes(&env, "mentes", &t)){
-                            //     SDL_Log("Nem lehetett betolteni a \"%s\" nevu mentest.", "mentes");
-                            // }
-                        }
-                        else if ( xy_in_rect(x, y, gombok_helye.s) ){
-                            // Súgó
-                            sugo(&env, font_sugo, kep_conway);
-                        }
+                else if (env->state == s_jatek) {
+                    // Futó szimulációnál bármelyik kattintás megállítja
+                    if (env->fut) {
+                        jatek_futtat_valt(env);
                     }
-                    else if(env.state == s_jatek){
-                        if(jatek_kattint(&env, font_mentes, &t, x, y) == 1){
-                            menu(&env, font_menu, &gombok_helye);
-                            destroy_tabla(&t);
-                        }
+                    else if (jatek_kattint(env, eroforras_font(ef_mentes), t, x, y) == 1) {
+                        menu(env, font_menu, gombok_helye);
+                        destroy_tabla(t);
                     }
-                    else if(env.state == s_betolt){
-                        if(betolt_kattint(&env, &t, x, y) == 1){
-                            menu(&env, font_menu, &gombok_helye);
-                        }
+                }
+                else if (env->state == s_betolt) {
+                    if (betolt_kattint(env, t, x, y) == 1) {
+                        menu(env, font_menu, gombok_helye);
                     }
-                    else if(env.state == s_sugo){
-                        if(sugo_kattint(&env, x, y) == 1){
-                            menu(&env, font_menu, &gombok_helye);
-                        }
+                }
+                else if (env->state == s_sugo) {
+                    if (sugo_kattint(env, x, y) == 1) {
+                        menu(env, font_menu, gombok_helye);
                     }
                 }
-                break;
-            case SDL_KEYDOWN:
-                    if (                       ev.key.keysym.sym == SDLK_ESCAPE) {menu(&env, font_menu, &gombok_helye); destroy_tabla(&t);}
-                    if (env.state == s_jatek & ev.key.keysym.sym == SDLK_SPACE ) {jatek_nextgen(&env, &t);} // Ideiglenes, a későbbiekben gomb lesz a grafikai felületen (bárlehet hogy kényelmi szempontből ez is marad)
-                    if (env.state == s_jatek & ev.key.keysym.sym == SDLK_s     ) {jatek_mentes(&env, font_mentes, &t);} // Ideiglenes, a későbbiekben gomb lesz a grafikai felületen (bárlehet hogy kényelmi szempontből ez is marad)
-                break;
+            }
+            break;
+        case SDL_KEYDOWN: {
+            const SDL_Keycode gomb = ev->key.keysym.sym;
+            const int jatekban = env->state == s_jatek;
+            if (gomb == SDLK_ESCAPE) {
+                // Futó szimulációnál az Esc csak megállítja
+                if (jatekban && env->fut) {
+                    jatek_futtat_valt(env);
+                }
+                else {
+                    menu(env, font_menu, gombok_helye);
+                    destroy_tabla(t);
+                }
+            }
+            if (jatekban && gomb == SDLK_SPACE   ) {jatek_nextgen(env, t);}
+            if (jatekban && gomb == SDLK_s       ) {jatek_mentes(env, eroforras_font(ef_mentes));}
+            if (jatekban && gomb == SDLK_i       ) {jatek_hud_valt(env, t);}
+            if (jatekban && gomb == SDLK_e       ) {jatek_statisztika_csv("./statisztika.csv");}
+            if (jatekban && gomb == SDLK_c       ) {env->ciklus_megall = !env->ciklus_megall;}
+            if (jatekban && gomb == SDLK_m       ) {motor_kovetkezo();}
+            if (jatekban && gomb == SDLK_v       ) {jatek_felvetel_valt(t);}
+            if (jatekban && gomb == SDLK_n       ) {jatek_novekvo_valt(env, t);}
+            if (jatekban && gomb == SDLK_LEFT    ) {jatek_ugras(env, t, t->generacio - 1);}
+            if (jatekban && gomb == SDLK_RIGHT   ) {jatek_ugras(env, t, t->generacio + 1);}
+            if (jatekban && gomb == SDLK_PAGEUP  ) {jatek_ugras(env, t, t->generacio - 100);}
+            if (jatekban && gomb == SDLK_PAGEDOWN) {jatek_ugras(env, t, t->generacio + 100);}
+            if (jatekban && gomb == SDLK_HOME    ) {jatek_ugras(env, t, jatek_tortenet_elso());}
+            if (jatekban && gomb == SDLK_t       ) {if (meres_trace_aktiv()) meres_trace_leallit(); else meres_trace_indit("./gol_trace.json");}
+            break;
         }
     }
-    
-    destroy_tabla(&t);
-    TTF_CloseFont(font_menu);
-    TTF_CloseFont(font_mentes);
-    TTF_CloseFont(font_sugo);
-    SDL_DestroyTexture(env.icons);
-    SDL_DestroyTexture(kep_conway);
-    SDL_Quit();
-    return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,225 @@
+/**
+ * @file GoL_memoria.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Az igazított memóriafoglalás megvalósítása.
+ * @version 0.1
+ * @date 2021-11-29
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+#include "GoL_memoria.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief A blokk előtt tárolt fejléc, ebből tudja a felszabadítás, hogyan foglalódott a blokk.
+ * Mérete pontosan MEMORIA_IGAZITAS, így a mögötte lévő adat is igazított marad.
+ * @param eredeti A ténylegesen lefoglalt memória eleje
+ * @param teljes A ténylegesen lefoglalt méret
+ * @param os 1 ha mmap/VirtualAlloc, 2 ha fájlra leképezett (memoria_fajl_foglal), 0 ha malloc
+ */
+typedef union Memoria_fejlec{
+    struct{
+        void *eredeti;
+        size_t teljes;
+        int os;
+    }adat;
+    char kitoltes[MEMORIA_IGAZITAS];
+}Memoria_fejlec;
+
+/**
+ * @brief Nagy blokk foglalása az operációs rendszertől. A kapott memória nullázott és laphatárra igazított.
+ */
+static void* os_foglal(size_t meret);
+
+/**
+ * @brief Az os_foglal párja (a fájlra leképezett blokkokat is ez szabadítja fel).
+ */
+static void os_felszabadit(void *p, size_t meret);
+
+/** A memoria_fajl_foglal fájljainak könyvtára */
+static char fajl_konyvtar[1024] = ".";
+
+size_t memoria_kerekit(size_t meret){
+    return (meret + MEMORIA_IGAZITAS - 1) / MEMORIA_IGAZITAS * MEMORIA_IGAZITAS;
+}
+
+size_t memoria_fizikai(void){
+#ifdef _WIN32
+    MEMORYSTATUSEX allapot;
+    allapot.dwLength = sizeof(allapot);
+    if(!GlobalMemoryStatusEx(&allapot))
+        return 0;
+    return allapot.ullTotalPhys > SIZE_MAX ? SIZE_MAX : (size_t)allapot.ullTotalPhys;
+#else
+    long lapok = sysconf(_SC_PHYS_PAGES), lapmeret = sysconf(_SC_PAGESIZE);
+    if(lapok <= 0 || lapmeret <= 0)
+        return 0;
+    if((unsigned long)lapok > SIZE_MAX / (unsigned long)lapmeret)
+        return SIZE_MAX;
+    return (size_t)lapok * (size_t)lapmeret;
+#endif
+}
+
+void* os_foglal(size_t meret){
+#ifdef _WIN32
+    return VirtualAlloc(NULL, meret, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void *p = mmap(NULL, meret, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED)
+        return NULL;
+#ifdef MADV_HUGEPAGE
+    madvise(p, meret, MADV_HUGEPAGE); // csak tanács, ha nem támogatott, nem baj
+#endif
+    return p;
+#endif
+}
+
+void os_felszabadit(void *p, size_t meret){
+#ifdef _WIN32
+    (void)meret;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, meret);
+#endif
+}
+
+void* memoria_foglal(size_t meret){
+    if(meret > SIZE_MAX - 2*MEMORIA_IGAZITAS)
+        return NULL;
+    Memoria_fejlec *fejlec;
+    if(meret >= MEMORIA_NAGY_BLOKK){
+        size_t teljes = meret + MEMORIA_IGAZITAS;
+        void *eredeti = os_foglal(teljes);
+        if(eredeti == NULL)
+            return NULL;
+        fejlec = eredeti;
+        fejlec->adat.eredeti = eredeti;
+        fejlec->adat.teljes = teljes;
+        fejlec->adat.os = 1;
+    }
+    else{
+        // A malloc igazítása nem garantált, ezért egy igazításnyival többet kér és a fejléc után kerekít
+        size_t teljes = meret + 2*MEMORIA_IGAZITAS;
+        void *eredeti = calloc(1, teljes);
+        if(eredeti == NULL)
+            return NULL;
+        uintptr_t cim = ((uintptr_t)eredeti + MEMORIA_IGAZITAS) / MEMORIA_IGAZITAS * MEMORIA_IGAZITAS;
+        fejlec = (Memoria_fejlec*)cim;
+        fejlec->adat.eredeti = eredeti;
+        fejlec->adat.teljes = teljes;
+        fejlec->adat.os = 0;
+    }
+    return fejlec + 1;
+}
+
+void memoria_felszabadit(void *p){
+    if(p == NULL)
+        return;
+    Memoria_fejlec *fejlec = (Memoria_fejlec*)p - 1;
+    if(fejlec->adat.os)
+        os_felszabadit(fejlec->adat.eredeti, fejlec->adat.teljes);
+    else
+        free(fejlec->adat.eredeti);
+}
+
+int memoria_fajl_konyvtar(const char *konyvtar){
+#ifdef _WIN32
+    (void)konyvtar;
+    return 0;
+#else
+    if(strlen(konyvtar) + 32 > sizeof(fajl_konyvtar))
+        return 0;
+    strcpy(fajl_konyvtar, konyvtar);
+    return 1;
+#endif
+}
+
+void* memoria_fajl_foglal(size_t meret){
+#ifdef _WIN32
+    (void)meret;
+    return NULL;
+#else
+    if(meret > SIZE_MAX - 2*MEMORIA_IGAZITAS)
+        return NULL;
+    char nev[sizeof(fajl_konyvtar) + 32];
+    snprintf(nev, sizeof(nev), "%s/gol_lemez_XXXXXX", fajl_konyvtar);
+    int fd = mkstemp(nev);
+    if(fd < 0)
+        return NULL;
+    // A név nélküli fájl a leképezés megszűnésével törlődik, akkor is, ha a program összeomlik
+    unlink(nev);
+    size_t teljes = meret + MEMORIA_IGAZITAS;
+    if(ftruncate(fd, (off_t)teljes) != 0){
+        close(fd);
+        return NULL;
+    }
+    void *eredeti = mmap(NULL, teljes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(eredeti == MAP_FAILED)
+        return NULL;
+    Memoria_fejlec *fejlec = eredeti;
+    fejlec->adat.eredeti = eredeti;
+    fejlec->adat.teljes = teljes;
+    fejlec->adat.os = 2;
+    return fejlec + 1;
+#endif
+}
+
+size_t memoria_fajl_szabad(void){
+#ifdef _WIN32
+    return 0;
+#else
+    struct statvfs st;
+    if(statvfs(fajl_konyvtar, &st) != 0)
+        return 0;
+    unsigned long long szabad = (unsigned long long)st.f_bavail * st.f_frsize;
+    return szabad > SIZE_MAX ? SIZE_MAX : (size_t)szabad;
+#endif
+}
+
+void memoria_tanacs(const void *p, size_t meret, Memoria_tanacs tanacs){
+#ifdef _WIN32
+    (void)p; (void)meret; (void)tanacs;
+#else
+    static long lapmeret = 0;
+    if(lapmeret <= 0)
+        lapmeret = sysconf(_SC_PAGESIZE);
+    if(lapmeret <= 0 || meret == 0)
+        return;
+    // A madvise laphatárt vár: az elejét lefelé kerekíti, a méretet ennyivel megnöveli
+    uintptr_t eleje = (uintptr_t)p / (uintptr_t)lapmeret * (uintptr_t)lapmeret;
+    size_t hossz = meret + ((uintptr_t)p - eleje);
+    int jel = -1;
+    switch(tanacs){
+        case mt_kell:
+            jel = MADV_WILLNEED;
+            break;
+        case mt_hideg:
+#ifdef MADV_COLD
+            jel = MADV_COLD;
+#endif
+            break;
+        case mt_sorban:
+            jel = MADV_SEQUENTIAL;
+            break;
+    }
+    if(jel >= 0)
+        madvise((void*)eleje, hossz, jel); // csak tanács, ha nem sikerül, nem baj
+#endif
+}
@@ -0,0 +1,93 @@
+/**
+ * @file GoL_memoria.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Nagy, cache-line-ra igazított, nullázott memóriablokkok foglalása (a játéktábla rácsához).
+ * Kis blokkokat a malloc-ból, nagyokat közvetlenül az operációs rendszertől (mmap / VirtualAlloc) kér,
+ * Linuxon transparent huge page tanáccsal.
+ * A memoria_fajl_foglal blokkjai egy (törölt, névtelen) fájlra vannak leképezve, így a memóriánál nagyobbak is lehetnek:
+ * az operációs rendszer lapozza őket a lemezről (lásd GoL_lemez.h). Ez csak POSIX rendszeren érhető el.
+ * @version 0.1
+ * @date 2021-11-29
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_MEMORIA_H
+#define GOL_MEMORIA_H
+
+#include <stddef.h>
+
+/** A visszaadott blokkok igazítása bájtban (egy cache line) */
+#define MEMORIA_IGAZITAS 64
+/** Ekkora méret felett közvetlenül az operációs rendszertől foglal */
+#define MEMORIA_NAGY_BLOKK ((size_t)32 << 20)
+
+/**
+ * @brief Hozzáférési tanács egy blokk egy részéhez (lásd memoria_tanacs).
+ * @param mt_kell Hamarosan kell: az operációs rendszer előre beolvashatja
+ * @param mt_hideg Egy ideig nem kell: elsőként ez kerülhet ki a memóriából
+ * @param mt_sorban Sorban, elölről hátrafelé lesz olvasva
+ */
+typedef enum Memoria_tanacs{
+    mt_kell, mt_hideg, mt_sorban
+}Memoria_tanacs;
+
+/**
+ * @brief Lefoglal egy nullázott, MEMORIA_IGAZITAS-ra igazított blokkot.
+ * @param meret bájtban
+ * @return a blokk, NULL ha nem sikerült
+ */
+void* memoria_foglal(size_t meret);
+
+/**
+ * @brief Felszabadít egy memoria_foglal által adott blokkot.
+ * @param p lehet NULL
+ */
+void memoria_felszabadit(void *p);
+
+/**
+ * @brief A meret-et felkerekíti MEMORIA_IGAZITAS többszörösére (pl. a tábla sorhosszához).
+ * @param meret
+ * @return a felkerekített méret
+ */
+size_t memoria_kerekit(size_t meret);
+
+/**
+ * @brief A gép fizikai memóriájának mérete (a nagy táblák előzetes méretellenőrzéséhez).
+ * @return bájtban, 0 ha nem sikerült lekérdezni
+ */
+size_t memoria_fizikai(void);
+
+/**
+ * @brief Beállítja a könyvtárat, ahol a memoria_fajl_foglal a fájljait létrehozza.
+ * @param konyvtar
+ * @return 1 ha sikeres, 0 ha a név túl hosszú, vagy a rendszeren nincs fájlra leképezett foglalás
+ */
+int memoria_fajl_konyvtar(const char *konyvtar);
+
+/**
+ * @brief Lefoglal egy nullázott, MEMORIA_IGAZITAS-ra igazított blokkot egy fájlra leképezve a beállított könyvtárban.
+ * A fájl a létrehozása után azonnal törlődik, így a felszabadításkor (vagy a program végén) a helye is felszabadul.
+ * A fájl ritka (sparse): csak a ténylegesen írt lapok foglalnak helyet a lemezen. Felszabadítani a memoria_felszabadit-tal kell.
+ * @param meret bájtban
+ * @return a blokk, NULL ha nem sikerült
+ */
+void* memoria_fajl_foglal(size_t meret);
+
+/**
+ * @brief A szabad hely a beállított könyvtár fájlrendszerén.
+ * @return bájtban, 0 ha nem sikerült lekérdezni
+ */
+size_t memoria_fajl_szabad(void);
+
+/**
+ * @brief Tanácsot ad az operációs rendszernek a blokk [p, p+meret) részének használatáról. Csak tanács: a tartalom nem változik,
+ * és ha a rendszer nem támogatja, nem csinál semmit. A tartomány a lapokra igazodik.
+ * @param p
+ * @param meret
+ * @param tanacs
+ */
+void memoria_tanacs(const void *p, size_t meret, Memoria_tanacs tanacs);
+
+#endif
@@ -0,0 +1,492 @@
+/**
+ * @file GoL_mentespont.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Az automatikus mentéspontok megvalósítása.
+ * @version 0.1
+ * @date 2021-12-01
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_statisztika.h"
+#include "GoL_motor.h"
+#include "GoL_memoria.h"
+#include "GoL_mentespont.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+static const char FEJLEC_JEL[8] = {'G', 'O', 'L', 'M', 'P', '1', 0, 0};
+static const char DELTA_JEL[4] = {'D', 'E', 'L', 'T'};
+
+/**
+ * @brief Egy növekvő bájtpuffer, ebbe állítja össze a mentéspontot a szimulációs szál.
+ * Ha a növelés nem sikerül, a hiba 1 lesz, és a további írások kimaradnak (az adat az addig írt rész marad).
+ */
+typedef struct Puffer{
+    unsigned char *adat;
+    size_t meret, kapacitas;
+    int hiba;
+}Puffer;
+
+/**
+ * @brief A mentéspont állapot része, ahogy a fájlban van.
+ */
+typedef struct Allapot_rekord{
+    int64_t generacio;
+    uint64_t hash;
+    int64_t szuletes, halalozas, ossz_szuletes, ossz_halalozas;
+}Allapot_rekord;
+
+/**
+ * @brief A puffer végére írja az adatot, szükség esetén megnöveli.
+ */
+static void puffer_ir(Puffer *p, const void *adat, size_t meret);
+
+/**
+ * @brief Jelzi, hogy egy mentéspont elmaradt (a mentespont_leallit ezt hibaként adja vissza).
+ */
+static void hiba_jelez(Mentespont *mp);
+
+/**
+ * @brief Az adat 64 bites FNV-1a ellenőrzőösszege.
+ */
+static uint64_t ellenorzo(const unsigned char *adat, size_t meret);
+
+/**
+ * @brief Kitölti az állapot rekordot a táblából és a statisztikából.
+ */
+static void allapot_keszit(Allapot_rekord *a, Tabla *t, Statisztika *s);
+
+/**
+ * @brief Összeállít egy teljes pillanatképet és beadja az írónak; a változásnaplót kiüríti.
+ */
+static void teljes_keszit(Mentespont *mp, Tabla *t, Statisztika *s);
+
+/**
+ * @brief Összeállít egy deltát a legutóbbi mentéspont óta változott cellákból és beadja az írónak.
+ */
+static void delta_keszit(Mentespont *mp, Tabla *t, Statisztika *s);
+
+/**
+ * @brief Beállít egy feladatot az író sorába; ha a sor tele van, megvárja, amíg felszabadul egy hely.
+ * @return 1 ha sikeres; 0 ha elfogyott a memória (ekkor a puffert felszabadítja)
+ */
+static int feladat_bead(Mentespont *mp, int teljes, Puffer *p);
+
+/**
+ * @brief Az író szál: a sorból a feladatokat sorban kiírja a fájlba.
+ */
+static int iro_szal(void *adat);
+
+/**
+ * @brief Egy feladat kiírása: a teljes pillanatkép ideiglenes fájlba íródik és átnevezéssel lecseréli a régit, a delta a fájl végére kerül.
+ * @return 1 ha sikeres
+ */
+static int feladat_kiir(Mentespont *mp, Mentespont_feladat *f);
+
+/**
+ * @brief meret bájtot olvas a memóriában lévő fájlból.
+ * @return 1 ha volt még ennyi adat
+ */
+static int olvas(const unsigned char **p, const unsigned char *vege, void *hova, size_t meret);
+
+void puffer_ir(Puffer *p, const void *adat, size_t meret){
+    if(p->hiba)
+        return;
+    if(p->meret + meret > p->kapacitas){
+        size_t uj = p->kapacitas ? p->kapacitas : 4096;
+        while(uj < p->meret + meret)
+            uj *= 2;
+        unsigned char *uj_adat = realloc(p->adat, uj);
+        if(uj_adat == NULL){
+            p->hiba = 1;
+            return;
+        }
+        p->adat = uj_adat;
+        p->kapacitas = uj;
+    }
+    memcpy(p->adat + p->meret, adat, meret);
+    p->meret += meret;
+}
+
+void hiba_jelez(Mentespont *mp){
+    SDL_LockMutex(mp->zar);
+    mp->hiba = 1;
+    SDL_UnlockMutex(mp->zar);
+}
+
+uint64_t ellenorzo(const unsigned char *adat, size_t meret){
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < meret; i++){
+        h ^= adat[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+void allapot_keszit(Allapot_rekord *a, Tabla *t, Statisztika *s){
+    a->generacio = t->generacio;
+    a->hash = t->hash;
+    a->szuletes = s->jelen.szuletes;
+    a->halalozas = s->jelen.halalozas;
+    a->ossz_szuletes = s->ossz_szuletes;
+    a->ossz_halalozas = s->ossz_halalozas;
+}
+
+void teljes_keszit(Mentespont *mp, Tabla *t, Statisztika *s){
+    Puffer p = {NULL, 0, 0, 0};
+    int32_t meret[2] = {t->sz, t->m};
+    const Szabaly *sz = motor_aktiv_szabaly();
+    Allapot_rekord a;
+    allapot_keszit(&a, t, s);
+    puffer_ir(&p, FEJLEC_JEL, sizeof(FEJLEC_JEL));
+    puffer_ir(&p, meret, sizeof(meret));
+    puffer_ir(&p, &sz->szuletes, sizeof(sz->szuletes));
+    puffer_ir(&p, &sz->tuleles, sizeof(sz->tuleles));
+    puffer_ir(&p, &a, sizeof(a));
+    size_t csomag = (size_t)(t->sz + 7) / 8;
+    unsigned char *sor_bitek = malloc(csomag);
+    if(sor_bitek == NULL)
+        p.hiba = 1;
+    for(int sor = 0; sor < t->m && !p.hiba; sor++){
+        memset(sor_bitek, 0, csomag);
+        for(int oszlop = 0; oszlop < t->sz; oszlop++)
+            sor_bitek[oszlop >> 3] |= CELLA(t, sor, oszlop) << (oszlop & 7);
+        puffer_ir(&p, sor_bitek, csomag);
+    }
+    free(sor_bitek);
+    if(!p.hiba){
+        uint64_t osszeg = ellenorzo(p.adat, p.meret);
+        puffer_ir(&p, &osszeg, sizeof(osszeg));
+    }
+    if(p.hiba)
+        free(p.adat);
+    // Ha elmaradt, a változásnapló marad: a következő mentéspont a legutóbbi kiírthoz képest készül
+    if(p.hiba || !feladat_bead(mp, 1, &p)){
+        hiba_jelez(mp);
+        return;
+    }
+
+    for(size_t i = 0; i < mp->erintett_db; i++)
+        mp->jelzo[mp->erintett[i]] = 0;
+    mp->erintett_db = 0;
+    mp->deltak = 0;
+}
+
+void delta_keszit(Mentespont *mp, Tabla *t, Statisztika *s){
+    Puffer p = {NULL, 0, 0, 0};
+    uint32_t db = 0;
+    Allapot_rekord a;
+    allapot_keszit(&a, t, s);
+    puffer_ir(&p, DELTA_JEL, sizeof(DELTA_JEL));
+    puffer_ir(&p, &db, sizeof(db));
+    puffer_ir(&p, &a, sizeof(a));
+    for(size_t i = 0; i < mp->erintett_db; i++){
+        size_t index = mp->erintett[i];
+        // Ami azóta visszaváltozott, vagy már szerepelt (ismétlődés), az kimarad
+        if(!mp->jelzo[index])
+            continue;
+        mp->jelzo[index] = 0;
+        int32_t koord[2] = {(int32_t)(index / t->lepes), (int32_t)(index % t->lepes)};
+        puffer_ir(&p, koord, sizeof(koord));
+        db++;
+    }
+    if(!p.hiba){
+        memcpy(p.adat + sizeof(DELTA_JEL), &db, sizeof(db));
+        uint64_t osszeg = ellenorzo(p.adat, p.meret);
+        puffer_ir(&p, &osszeg, sizeof(osszeg));
+    }
+    mp->erintett_db = 0;
+    mp->deltak++;
+    if(p.hiba)
+        free(p.adat);
+    if(p.hiba || !feladat_bead(mp, 0, &p)){
+        // A jelzők egy része már törlődött, így csak egy teljes pillanatkép lehet a következő
+        mp->deltak = MENTESPONT_DELTAK_MAX;
+        hiba_jelez(mp);
+    }
+}
+
+int feladat_bead(Mentespont *mp, int teljes, Puffer *p){
+    Mentespont_feladat *f = malloc(sizeof(Mentespont_feladat));
+    if(f == NULL){
+        free(p->adat);
+        return 0;
+    }
+    f->teljes = teljes;
+    f->adat = p->adat;
+    f->meret = p->meret;
+    f->next = NULL;
+    SDL_LockMutex(mp->zar);
+    while(mp->sor_db >= MENTESPONT_SOR_MAX)
+        SDL_CondWait(mp->jel, mp->zar);
+    if(mp->sor_vege != NULL)
+        mp->sor_vege->next = f;
+    else
+        mp->sor_eleje = f;
+    mp->sor_vege = f;
+    mp->sor_db++;
+    SDL_CondBroadcast(mp->jel);
+    SDL_UnlockMutex(mp->zar);
+    return 1;
+}
+
+int feladat_kiir(Mentespont *mp, Mentespont_feladat *f){
+    if(!f->teljes){
+        FILE *fp = fopen(mp->fajlnev, "ab");
+        if(fp == NULL)
+            return 0;
+        int jo = fwrite(f->adat, 1, f->meret, fp) == f->meret;
+        return (fclose(fp) == 0) && jo;
+    }
+    size_t hossz = strlen(mp->fajlnev);
+    char *ideiglenes = malloc(hossz + 5);
+    if(ideiglenes == NULL)
+        return 0;
+    memcpy(ideiglenes, mp->fajlnev, hossz);
+    memcpy(ideiglenes + hossz, ".tmp", 5);
+    FILE *fp = fopen(ideiglenes, "wb");
+    int jo = fp != NULL;
+    if(jo){
+        jo = fwrite(f->adat, 1, f->meret, fp) == f->meret;
+        jo = (fclose(fp) == 0) && jo;
+    }
+#ifdef _WIN32
+    // Windowson a rename nem írja felül a létező fájlt
+    if(jo)
+        remove(mp->fajlnev);
+#endif
+    jo = jo && rename(ideiglenes, mp->fajlnev) == 0;
+    free(ideiglenes);
+    return jo;
+}
+
+int iro_szal(void *adat){
+    Mentespont *mp = adat;
+    SDL_LockMutex(mp->zar);
+    for(;;){
+        while(mp->sor_eleje == NULL && !mp->leall)
+            SDL_CondWait(mp->jel, mp->zar);
+        Mentespont_feladat *f = mp->sor_eleje;
+        if(f == NULL)
+            break;
+        mp->sor_eleje = f->next;
+        if(mp->sor_eleje == NULL)
+            mp->sor_vege = NULL;
+        SDL_UnlockMutex(mp->zar);
+
+        int jo = feladat_kiir(mp, f);
+        free(f->adat);
+        free(f);
+
+        SDL_LockMutex(mp->zar);
+        // Csak kiírás után szabadul fel a hely, így a sorban lévő és az íródó feladat együtt sem több MENTESPONT_SOR_MAX-nál
+        mp->sor_db--;
+        if(!jo)
+            mp->hiba = 1;
+        SDL_CondBroadcast(mp->jel);
+    }
+    SDL_UnlockMutex(mp->zar);
+    return 0;
+}
+
+size_t mentespont_memoria_becsles(long long szelesseg, long long magassag){
+    if(szelesseg < 1 || magassag < 1)
+        return 0;
+    // A cellánkénti jelző, és a sorban álló, az íródó meg az épülő teljes pillanatkép
+    size_t jelzo = (size_t)(magassag + 2) * memoria_kerekit((size_t)szelesseg + 2);
+    size_t teljes = (size_t)(magassag + 2) * (size_t)((szelesseg + 2 + 7) / 8);
+    return jelzo + (MENTESPONT_SOR_MAX + 1) * teljes;
+}
+
+int mentespont_indit(Mentespont *mp, const char *fajlnev, long long gyakorisag, double masodperc, Tabla *t, Statisztika *s){
+    memset(mp, 0, sizeof(*mp));
+    size_t hossz = strlen(fajlnev);
+    mp->fajlnev = malloc(hossz + 1);
+    mp->gyakorisag = gyakorisag > 0 ? gyakorisag : 0;
+    mp->idokoz = masodperc > 0 ? (Uint32)(masodperc * 1000) : 0;
+    mp->jelzo = calloc((size_t)t->m * t->lepes, 1);
+    mp->erintett_kapacitas = 1024;
+    mp->erintett = malloc(mp->erintett_kapacitas * sizeof(size_t));
+    if(mp->fajlnev == NULL || mp->jelzo == NULL || mp->erintett == NULL){
+        free(mp->erintett);
+        free(mp->jelzo);
+        free(mp->fajlnev);
+        return 0;
+    }
+    memcpy(mp->fajlnev, fajlnev, hossz + 1);
+    mp->zar = SDL_CreateMutex();
+    mp->jel = SDL_CreateCond();
+    if(mp->zar != NULL && mp->jel != NULL)
+        mp->iro = SDL_CreateThread(iro_szal, "mentespont", mp);
+    if(mp->iro == NULL){
+        SDL_DestroyCond(mp->jel);
+        SDL_DestroyMutex(mp->zar);
+        free(mp->erintett);
+        free(mp->jelzo);
+        free(mp->fajlnev);
+        return 0;
+    }
+    mp->utolso_generacio = t->generacio;
+    mp->utolso_ido = SDL_GetTicks();
+    teljes_keszit(mp, t, s);
+    return 1;
+}
+
+void mentespont_frissit(Mentespont *mp, Tabla *t, Statisztika *s, OszlopSor_Lista_Elem *fej){
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next){
+        size_t index = (size_t)iter->sor * t->lepes + iter->oszlop;
+        mp->jelzo[index] ^= 1;
+        if(mp->jelzo[index]){
+            if(mp->erintett_db == mp->erintett_kapacitas){
+                size_t *uj = realloc(mp->erintett, mp->erintett_kapacitas * 2 * sizeof(size_t));
+                if(uj == NULL){
+                    // A cella nem kerülhet a deltába, ezért a következő mentéspont teljes lesz, az pedig a táblából olvas
+                    mp->jelzo[index] = 0;
+                    mp->deltak = MENTESPONT_DELTAK_MAX;
+                    continue;
+                }
+                mp->erintett = uj;
+                mp->erintett_kapacitas *= 2;
+            }
+            mp->erintett[mp->erintett_db++] = index;
+        }
+    }
+    if((mp->gyakorisag && t->generacio - mp->utolso_generacio >= mp->gyakorisag) ||
+       (mp->idokoz && SDL_GetTicks() - mp->utolso_ido >= mp->idokoz))
+        mentespont_most(mp, t, s);
+}
+
+void mentespont_most(Mentespont *mp, Tabla *t, Statisztika *s){
+    // Ha a delta nagyobb lenne a teljes pillanatképnél (cellánként 8 bájt vs. 1 bit), vagy túl sok delta gyűlt össze, teljeset ír
+    size_t teljes_meret = (size_t)t->m * ((t->sz + 7) / 8);
+    if(mp->deltak >= MENTESPONT_DELTAK_MAX || mp->erintett_db * 8 > teljes_meret)
+        teljes_keszit(mp, t, s);
+    else
+        delta_keszit(mp, t, s);
+    mp->utolso_generacio = t->generacio;
+    mp->utolso_ido = SDL_GetTicks();
+}
+
+int mentespont_leallit(Mentespont *mp){
+    SDL_LockMutex(mp->zar);
+    mp->leall = 1;
+    SDL_CondBroadcast(mp->jel);
+    SDL_UnlockMutex(mp->zar);
+    SDL_WaitThread(mp->iro, NULL);
+    SDL_DestroyCond(mp->jel);
+    SDL_DestroyMutex(mp->zar);
+    free(mp->erintett);
+    free(mp->jelzo);
+    free(mp->fajlnev);
+    return !mp->hiba;
+}
+
+int olvas(const unsigned char **p, const unsigned char *vege, void *hova, size_t meret){
+    if((size_t)(vege - *p) < meret)
+        return 0;
+    memcpy(hova, *p, meret);
+    *p += meret;
+    return 1;
+}
+
+int mentespont_betolt(const char *fajlnev, Tabla *t, Mentespont_allapot *a){
+    FILE *fp = fopen(fajlnev, "rb");
+    if(fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+    Puffer f = {NULL, 0, 0, 0};
+    unsigned char darab[65536];
+    size_t n;
+    while((n = fread(darab, 1, sizeof(darab), fp)) > 0 && !f.hiba)
+        puffer_ir(&f, darab, n);
+    fclose(fp);
+    if(f.hiba){
+        SDL_Log("%s: a mentespont nem fer a memoriaba\n", fajlnev);
+        free(f.adat);
+        return 0;
+    }
+    const unsigned char *p = f.adat, *vege = f.adat + f.meret;
+
+    char jel[8];
+    int32_t meret[2];
+    Szabaly sz;
+    Allapot_rekord allapot;
+    uint64_t osszeg;
+    if(!olvas(&p, vege, jel, sizeof(jel)) || memcmp(jel, FEJLEC_JEL, sizeof(jel)) || !olvas(&p, vege, meret, sizeof(meret)) ||
+       meret[0] < 3 || meret[1] < 3 || !olvas(&p, vege, &sz.szuletes, sizeof(sz.szuletes)) || !olvas(&p, vege, &sz.tuleles, sizeof(sz.tuleles)) ||
+       !olvas(&p, vege, &allapot, sizeof(allapot))){
+        free(f.adat);
+        return 0;
+    }
+    size_t csomag = (size_t)(meret[0] + 7) / 8;
+    const unsigned char *racs = p;
+    if((size_t)(vege - p) < csomag * meret[1] + sizeof(osszeg)){
+        free(f.adat);
+        return 0;
+    }
+    p += csomag * meret[1];
+    memcpy(&osszeg, p, sizeof(osszeg));
+    if(osszeg != ellenorzo(f.adat, p - f.adat)){
+        free(f.adat);
+        return 0;
+    }
+    p += sizeof(osszeg);
+
+    char uzenet[256] = "Nem sikerult lefoglalni a tablat";
+    if(!tabla_meret_ellenoriz(meret[0]-2, meret[1]-2, tabla_tarolas(), 0, uzenet, sizeof(uzenet)) || !init_tabla(t, meret[0]-2, meret[1]-2)){
+        SDL_Log("%s: %s\n", fajlnev, uzenet);
+        free(f.adat);
+        return 0;
+    }
+    for(int sor = 0; sor < t->m; sor++)
+        for(int oszlop = 0; oszlop < t->sz; oszlop++)
+            CELLA(t, sor, oszlop) = (racs[sor * csomag + (oszlop >> 3)] >> (oszlop & 7)) & 1;
+
+    // A deltak sorban; az első sérült vagy hiányos deltánál megáll
+    for(;;){
+        const unsigned char *rekord = p;
+        uint32_t db;
+        Allapot_rekord uj;
+        if(!olvas(&p, vege, jel, sizeof(DELTA_JEL)) || memcmp(jel, DELTA_JEL, sizeof(DELTA_JEL)) || !olvas(&p, vege, &db, sizeof(db)) ||
+           !olvas(&p, vege, &uj, sizeof(uj)) || (size_t)(vege - p) < (size_t)db * 8 + sizeof(osszeg))
+            break;
+        const unsigned char *koordinatak = p;
+        p += (size_t)db * 8;
+        memcpy(&osszeg, p, sizeof(osszeg));
+        if(osszeg != ellenorzo(rekord, p - rekord))
+            break;
+        p += sizeof(osszeg);
+        for(uint32_t i = 0; i < db; i++){
+            int32_t koord[2];
+            memcpy(koord, koordinatak + (size_t)i * 8, sizeof(koord));
+            if(koord[0] >= 1 && koord[0] < t->m-1 && koord[1] >= 1 && koord[1] < t->sz-1)
+                CELLA(t, koord[0], koord[1]) ^= 1;
+        }
+        allapot = uj;
+    }
+    free(f.adat);
+
+    t->hash = tabla_hash(t);
+    if(t->hash != allapot.hash){
+        SDL_Log("A %s mentespont serult (a hash nem egyezik)\n", fajlnev);
+        destroy_tabla(t);
+        return 0;
+    }
+    t->generacio = allapot.generacio;
+    a->szuletes = allapot.szuletes;
+    a->halalozas = allapot.halalozas;
+    a->ossz_szuletes = allapot.ossz_szuletes;
+    a->ossz_halalozas = allapot.ossz_halalozas;
+    motor_szabaly(&sz);
+    return 1;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file GoL_mentespont.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Automatikus mentéspontok hosszú, felügyelet nélküli futásokhoz.
+ * N generációnként vagy T másodpercenként ment. A fájl egy teljes pillanatképpel kezdődik, utána csak a legutóbbi
+ * mentéspont óta megváltozott cellák (delta) fűződnek hozzá, a generációnkénti változáslistákból összegyűjtve.
+ * A fájlba írás egy háttérszálon történik, a szimuláció csak a (kicsi) puffer összeállításáig áll.
+ *
+ * A fájl formátuma (a gép saját bájtsorrendjével):
+ *  - fejléc: "GOLMP1\0\0", int32 sz, int32 m, uint16 születés, uint16 túlélés maszk, állapot, a rács soronként bitekbe csomagolva, uint64 ellenőrzőösszeg
+ *  - delta: "DELT", uint32 db, állapot, db darab (int32 sor, int32 oszlop), uint64 ellenőrzőösszeg
+ *  - állapot: int64 generáció, uint64 hash, int64 születés, halálozás, összes születés, összes halálozás
+ * Egy félbeszakadt (pl. összeomláskor írt) delta ellenőrzőösszege nem stimmel; a visszatöltés az utolsó ép mentéspontnál áll meg.
+ * @version 0.1
+ * @date 2021-12-01
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_MENTESPONT_H
+#define GOL_MENTESPONT_H
+
+#include <stddef.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_statisztika.h"
+
+/** Ennyi delta után újra teljes pillanatképet ír, hogy a visszatöltés ne legyen túl lassú */
+#define MENTESPONT_DELTAK_MAX 32
+/** Legfeljebb ennyi kiírásra váró mentéspont lehet a sorban; ha tele van, a szimuláció megvárja az írót */
+#define MENTESPONT_SOR_MAX 4
+
+/**
+ * @brief Egy kiírásra váró mentéspont.
+ * @param teljes 1 ha teljes pillanatkép (a fájlt lecseréli), 0 ha delta (a fájl végére fűzi)
+ * @param adat
+ * @param meret
+ * @param next
+ */
+typedef struct Mentespont_feladat{
+    int teljes;
+    unsigned char *adat;
+    size_t meret;
+    struct Mentespont_feladat *next;
+}Mentespont_feladat;
+
+/**
+ * @brief A mentéspont író állapota.
+ * @param fajlnev
+ * @param gyakorisag Ennyi generációnként ment, 0 ha nem a generációk száma alapján
+ * @param idokoz Ennyi ms-onként ment, 0 ha nem idő alapján
+ * @param utolso_generacio A legutóbbi mentéspont generációja
+ * @param utolso_ido A legutóbbi mentéspont ideje (SDL_GetTicks)
+ * @param jelzo Cellánként 1, ha a legutóbbi mentéspont óta páratlan sokszor változott (a tábla rácsával azonos elrendezés)
+ * @param erintett A legutóbbi mentéspont óta változott cellák indexei (ismétlődhetnek)
+ * @param erintett_db
+ * @param erintett_kapacitas
+ * @param deltak A legutóbbi teljes pillanatkép óta írt deltak száma
+ * @param iro A háttérben író szál
+ * @param zar A sort védő mutex
+ * @param jel A sor változását jelző feltételváltozó
+ * @param sor_eleje A kiírásra váró feladatok
+ * @param sor_vege
+ * @param sor_db
+ * @param leall 1 ha az írónak a sor kiürítése után ki kell lépnie
+ * @param hiba 1 ha valamelyik írás nem sikerült, vagy egy mentéspont a memória hiánya miatt elmaradt
+ */
+typedef struct Mentespont{
+    char *fajlnev;
+    long long gyakorisag;
+    Uint32 idokoz;
+    long long utolso_generacio;
+    Uint32 utolso_ido;
+    unsigned char *jelzo;
+    size_t *erintett;
+    size_t erintett_db, erintett_kapacitas;
+    int deltak;
+    SDL_Thread *iro;
+    SDL_mutex *zar;
+    SDL_cond *jel;
+    Mentespont_feladat *sor_eleje, *sor_vege;
+    int sor_db;
+    int leall;
+    int hiba;
+}Mentespont;
+
+/**
+ * @brief A visszatöltött mentéspont statisztikái (a statisztika_init után visszaírandók).
+ * @param szuletes A legutóbbi generáció születései
+ * @param halalozas A legutóbbi generáció halálozásai
+ * @param ossz_szuletes
+ * @param ossz_halalozas
+ */
+typedef struct Mentespont_allapot{
+    long long szuletes, halalozas;
+    long long ossz_szuletes, ossz_halalozas;
+}Mentespont_allapot;
+
+/**
+ * @brief A mentéspont író memóriaigénye egy szelesseg x magassag táblán: a cellánkénti jelző és a teljes pillanatképek.
+ * A tabla_meret_ellenoriz kísérő memóriájába számítandó.
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @return bájtban, 0 ha a méret érvénytelen
+ */
+size_t mentespont_memoria_becsles(long long szelesseg, long long magassag);
+
+/**
+ * @brief Elindítja a mentéspontok írását: kiír egy teljes pillanatképet és elindítja az író szálat.
+ * @warning A mentespont_leallit-tal leállítandó!!
+ * @param mp
+ * @param fajlnev
+ * @param gyakorisag Ennyi generációnként ment (0: soha)
+ * @param masodperc Ennyi másodpercenként ment (0: soha)
+ * @param t
+ * @param s A tábla statisztikája
+ * @return 1 ha sikeres; 0 ha az író szál nem indítható, vagy a cellánkénti jelző nem fér a memóriába. Ha csak az első
+ * pillanatképhez fogy el a memória, a mentespont_leallit jelzi
+ */
+int mentespont_indit(Mentespont *mp, const char *fajlnev, long long gyakorisag, double masodperc, Tabla *t, Statisztika *s);
+
+/**
+ * @brief Minden lépés után hívandó: feljegyzi a változásokat, és ha esedékes, mentéspontot készít.
+ * @param mp
+ * @param t
+ * @param s A már frissített statisztika
+ * @param fej A lépés változáslistája
+ */
+void mentespont_frissit(Mentespont *mp, Tabla *t, Statisztika *s, OszlopSor_Lista_Elem *fej);
+
+/**
+ * @brief Azonnal mentéspontot készít (pl. a futás végén).
+ */
+void mentespont_most(Mentespont *mp, Tabla *t, Statisztika *s);
+
+/**
+ * @brief Megvárja, amíg minden mentéspont kiíródik, majd leállítja az író szálat és felszabadít mindent.
+ * @param mp
+ * @return 1 ha minden írás sikeres volt
+ */
+int mentespont_leallit(Mentespont *mp);
+
+/**
+ * @brief Visszatölti a fájl utolsó ép mentéspontját (a szabályt is beállítja a motor_szabaly-lyal).
+ * @param fajlnev
+ * @param t Egy üres, iniciálizatlan Tabla objektum
+ * @param a Ide írja a statisztikákat
+ * @return 1 ha sikeres, 0 ha nem (ekkor a t-t nem kell felszabadítani)
+ */
+int mentespont_betolt(const char *fajlnev, Tabla *t, Mentespont_allapot *a);
+
+#endif
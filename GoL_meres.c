@@ -0,0 +1,151 @@
+/**
+ * @file GoL_meres.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A fázisonkénti időmérés megvalósítása.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+#include "GoL_meres.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief Egy fázis utolsó méréseit tároló gyűrűs puffer.
+ * @param ido A mérések hossza mikroszekundumban
+ * @param vege A mérések végének időpontja (performance counter)
+ * @param kov A következő beírandó elem indexe
+ * @param db A pufferben lévő érvényes mérések száma
+ */
+typedef struct Meres_gyuru{
+    double ido[MERES_GYURU_MERET];
+    Uint64 vege[MERES_GYURU_MERET];
+    int kov, db;
+}Meres_gyuru;
+
+static Meres_gyuru gyuruk[MERES_FAZISOK_SZAMA];
+static FILE *trace_fp = NULL;
+static Uint64 trace_kezdet = 0;
+static int trace_elso = 1;
+
+static const char *fazis_nevek[MERES_FAZISOK_SZAMA] = {
+    "uj_generacio", "jatek_rajzol_cella", "SDL_RenderPresent", "esemenyek", "kepkocka", "elso_kepkocka"
+};
+
+/**
+ * @brief qsort-hoz összehasonlító függvény double-ökre.
+ */
+static int double_hasonlit(const void *a, const void *b);
+
+Uint64 meres_kezd(void){
+    return SDL_GetPerformanceCounter();
+}
+
+void meres_vege(Meres_fazis fazis, Uint64 kezdet){
+    Uint64 most = SDL_GetPerformanceCounter();
+    double frekvencia = (double)SDL_GetPerformanceFrequency();
+    Meres_gyuru *gy = &gyuruk[fazis];
+    double ido = (double)(most - kezdet) * 1e6 / frekvencia;
+
+    gy->ido[gy->kov] = ido;
+    gy->vege[gy->kov] = most;
+    gy->kov = (gy->kov + 1) % MERES_GYURU_MERET;
+    if(gy->db < MERES_GYURU_MERET)
+        gy->db++;
+
+    if(trace_fp != NULL){
+        double ts = (double)(kezdet - trace_kezdet) * 1e6 / frekvencia;
+        fprintf(trace_fp, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}",
+                trace_elso ? "" : ",", fazis_nevek[fazis], ts, ido);
+        trace_elso = 0;
+    }
+}
+
+double meres_atlag(Meres_fazis fazis){
+    Meres_gyuru *gy = &gyuruk[fazis];
+    if(gy->db == 0)
+        return 0;
+    double szum = 0;
+    for(int i = 0; i < gy->db; i++)
+        szum += gy->ido[i];
+    return szum / gy->db;
+}
+
+int double_hasonlit(const void *a, const void *b){
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+double meres_percentilis(Meres_fazis fazis, double p){
+    Meres_gyuru *gy = &gyuruk[fazis];
+    if(gy->db == 0)
+        return 0;
+    double rendezett[MERES_GYURU_MERET];
+    for(int i = 0; i < gy->db; i++)
+        rendezett[i] = gy->ido[i];
+    qsort(rendezett, gy->db, sizeof(double), double_hasonlit);
+    int index = (int)(p / 100.0 * (gy->db - 1) + 0.5);
+    if(index < 0) index = 0;
+    if(index >= gy->db) index = gy->db - 1;
+    return rendezett[index];
+}
+
+double meres_per_masodperc(Meres_fazis fazis){
+    Meres_gyuru *gy = &gyuruk[fazis];
+    if(gy->db < 2)
+        return 0;
+    int utolso = (gy->kov + MERES_GYURU_MERET - 1) % MERES_GYURU_MERET;
+    int elso = (gy->db < MERES_GYURU_MERET) ? 0 : gy->kov;
+    double eltelt = (double)(gy->vege[utolso] - gy->vege[elso]) / (double)SDL_GetPerformanceFrequency();
+    if(eltelt <= 0)
+        return 0;
+    return (gy->db - 1) / eltelt;
+}
+
+void meres_hisztogram(Meres_fazis fazis, int vodrok[MERES_VODROK]){
+    Meres_gyuru *gy = &gyuruk[fazis];
+    for(int i = 0; i < MERES_VODROK; i++)
+        vodrok[i] = 0;
+    for(int i = 0; i < gy->db; i++){
+        int vodor = 0;
+        for(double hatar = 2; hatar <= gy->ido[i] && vodor < MERES_VODROK-1; hatar *= 2)
+            vodor++;
+        vodrok[vodor]++;
+    }
+}
+
+const char* meres_fazis_nev(Meres_fazis fazis){
+    return fazis_nevek[fazis];
+}
+
+int meres_trace_indit(const char *fajlnev){
+    meres_trace_leallit();
+    trace_fp = fopen(fajlnev, "wt");
+    if(trace_fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+    trace_kezdet = SDL_GetPerformanceCounter();
+    trace_elso = 1;
+    fprintf(trace_fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    return 1;
+}
+
+void meres_trace_leallit(void){
+    if(trace_fp != NULL){
+        fprintf(trace_fp, "\n]}\n");
+        fclose(trace_fp);
+        trace_fp = NULL;
+    }
+}
+
+int meres_trace_aktiv(void){
+    return trace_fp != NULL;
+}
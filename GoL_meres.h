@@ -0,0 +1,122 @@
+/**
+ * @file GoL_meres.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A program futásidejének fázisonkénti mérésére szolgáló függvények.
+ * Minden fázis utolsó mérései egy gyűrűs pufferben vannak, ebből számolható átlag, percentilis és hisztogram.
+ * Opcionálisan Chrome trace (JSON) formátumú fájlba is írja a méréseket.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_MERES_H
+#define GOL_MERES_H
+
+#include <SDL2/SDL.h>
+
+/** Ennyi utolsó mérést tart meg fázisonként a gyűrűs puffer */
+#define MERES_GYURU_MERET 512
+/** A hisztogram vödreinek száma (2 hatványai mikroszekundumban) */
+#define MERES_VODROK 24
+/** Az indulástól az első képkockáig megengedett idő (ms); a program induláskor kiírja a mértet, és figyelmeztet, ha több */
+#define MERES_ELSO_KEPKOCKA_CEL_MS 250
+
+/**
+ * @brief A mért fázisok.
+ */
+typedef enum Meres_fazis{
+    /** Az uj_generacio futása */
+    m_generacio,
+    /** A cellák kirajzolása (jatek_rajzol_cella) */
+    m_rajzolas,
+    /** SDL_RenderPresent hívások */
+    m_megjelenites,
+    /** Eseménykezelés a fő ciklusban, futó szimuláció mellett (generációnként) */
+    m_esemenyek,
+    /** Egy teljes képkocka: generáció, rajzolás és megjelenítés */
+    m_kepkocka,
+    /** A program indulásától az első megjelenített képkockáig (egyszer mérve) */
+    m_elso_kepkocka,
+    /** A fázisok száma, nem valódi fázis */
+    MERES_FAZISOK_SZAMA
+}Meres_fazis;
+
+/**
+ * @brief Egy utasítás futásidejét méri és rögzíti a megadott fázishoz.
+ * Pl.: MERES(m_generacio, fej = uj_generacio(t));
+ */
+#define MERES(fazis, utasitas) do{ Uint64 meres_kezdet_ = meres_kezd(); utasitas; meres_vege((fazis), meres_kezdet_); }while(0)
+
+/**
+ * @brief Visszaadja a jelenlegi időpontot a méréshez.
+ * @return a performance counter értéke
+ */
+Uint64 meres_kezd(void);
+
+/**
+ * @brief Rögzíti a kezdet óta eltelt időt a fázis gyűrűs pufferében.
+ * Ha a trace írás aktív, a fájlba is kiírja.
+ * @param fazis
+ * @param kezdet a meres_kezd által visszaadott érték
+ */
+void meres_vege(Meres_fazis fazis, Uint64 kezdet);
+
+/**
+ * @brief A fázis utolsó méréseinek átlaga.
+ * @param fazis
+ * @return átlag mikroszekundumban, 0 ha nincs mérés
+ */
+double meres_atlag(Meres_fazis fazis);
+
+/**
+ * @brief A fázis utolsó méréseinek p-edik percentilise.
+ * @param fazis
+ * @param p 0 és 100 közötti szám
+ * @return percentilis mikroszekundumban, 0 ha nincs mérés
+ */
+double meres_percentilis(Meres_fazis fazis, double p);
+
+/**
+ * @brief Hány mérés történt másodpercenként a fázisban (a puffer első és utolsó mérése alapján).
+ * A m_generacio fázisra ez a generáció/másodperc.
+ * @param fazis
+ * @return mérések száma másodpercenként
+ */
+double meres_per_masodperc(Meres_fazis fazis);
+
+/**
+ * @brief Kitölti a fázis hisztogramját a gyűrűs puffer alapján.
+ * Az i. vödörbe a [2^i, 2^(i+1)) mikroszekundumos mérések kerülnek, az utolsóba minden ennél hosszabb.
+ * @param fazis
+ * @param vodrok MERES_VODROK méretű tömb
+ */
+void meres_hisztogram(Meres_fazis fazis, int vodrok[MERES_VODROK]);
+
+/**
+ * @brief A fázis olvasható neve.
+ * @param fazis
+ * @return a név
+ */
+const char* meres_fazis_nev(Meres_fazis fazis);
+
+/**
+ * @brief Elindítja a mérések Chrome trace formátumú fájlba írását (chrome://tracing, Perfetto).
+ * @param fajlnev
+ * @return 1 ha sikeres
+ */
+int meres_trace_indit(const char *fajlnev);
+
+/**
+ * @brief Lezárja a trace fájlt.
+ */
+void meres_trace_leallit(void);
+
+/**
+ * @brief Megmondja, hogy épp íródik -e trace fájl.
+ * @return 1 vagy 0
+ */
+int meres_trace_aktiv(void);
+
+#endif
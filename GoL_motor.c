@@ -0,0 +1,163 @@
+/**
+ * @file GoL_motor.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A lépésmotorok nyilvántartásának megvalósítása.
+ * @version 0.1
+ * @date 2021-11-30
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_lut.h"
+#include "GoL_ltl.h"
+#include "GoL_kernel.h"
+#include "GoL_motor.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/** Az összes választható motor; új motor ide veendő fel (és a GoL_ellenorzes összevetendő motorjai közé) */
+static const Motor motorok[] = {
+    {"referencia", uj_generacio, 0, 0},
+    {"lut", lut_generacio, 1, 0},
+    {"kernel", kernel_generacio, 1, 1},
+    {"ltl", ltl_generacio, 2, 0},
+};
+
+#define MOTOROK_SZAMA ((int)(sizeof(motorok)/sizeof(motorok[0])))
+
+static int aktiv = 0;
+static Szabaly szabaly = SZABALY_CONWAY;
+/** A Larger than Life / Generations szabály, ha kiterjesztett == 1 */
+static Ltl_szabaly ltl;
+static int kiterjesztett = 0;
+static Szomszedsag szomszedsag = sz_moore;
+static Perem perem = p_halott;
+
+/**
+ * @brief A motor tudja -e az aktuális szabályt.
+ */
+static int tudja(const Motor *motor);
+
+/**
+ * @brief Ha az aktuális motor nem tudja az aktuális szabályt és topológiát, az első olyanra vált, ami tudja.
+ */
+static void alkalmasra_valt(void);
+
+int tudja(const Motor *motor){
+    if(!motor->barmely_topologia && !motor_alap_topologia())
+        return 0;
+    if(motor->barmely_szabaly == 2)
+        return 1;
+    if(motor->barmely_szabaly == 1)
+        return !kiterjesztett;
+    return motor_conway();
+}
+
+int motor_conway(void){
+    Szabaly c = SZABALY_CONWAY;
+    return !kiterjesztett && motor_alap_topologia() && szabaly.szuletes == c.szuletes && szabaly.tuleles == c.tuleles;
+}
+
+int motor_alap_topologia(void){
+    return szomszedsag == sz_moore && perem == p_halott;
+}
+
+void alkalmasra_valt(void){
+    if(tudja(&motorok[aktiv]))
+        return;
+    for(int i = 0; i < MOTOROK_SZAMA; i++){
+        if(tudja(&motorok[i])){
+            aktiv = i;
+            return;
+        }
+    }
+}
+
+const Motor* motor_lista(int *db){
+    *db = MOTOROK_SZAMA;
+    return motorok;
+}
+
+int motor_valaszt(const char *nev){
+    for(int i = 0; i < MOTOROK_SZAMA; i++){
+        if(strcmp(motorok[i].nev, nev) == 0){
+            if(!tudja(&motorok[i]))
+                return 0;
+            aktiv = i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void motor_kovetkezo(void){
+    for(int i = 1; i <= MOTOROK_SZAMA; i++){
+        int jelolt = (aktiv + i) % MOTOROK_SZAMA;
+        if(tudja(&motorok[jelolt])){
+            aktiv = jelolt;
+            return;
+        }
+    }
+}
+
+const Motor* motor_aktiv(void){
+    return &motorok[aktiv];
+}
+
+void motor_szabaly(const Szabaly *sz){
+    szabaly = *sz;
+    kiterjesztett = 0;
+    lut_szabaly(sz);
+    kernel_szabaly(sz);
+    ltl_szabaly_bs(sz, &ltl);
+    ltl_szabaly(&ltl);
+    alkalmasra_valt();
+}
+
+void motor_ltl_szabaly(const Ltl_szabaly *sz){
+    Szabaly bs;
+    if(ltl_szabaly_bs_e(sz, &bs)){
+        motor_szabaly(&bs);
+        return;
+    }
+    ltl = *sz;
+    kiterjesztett = 1;
+    ltl_szabaly(sz);
+    alkalmasra_valt();
+}
+
+int motor_topologia(Szomszedsag uj_szomszedsag, Perem uj_perem){
+    if(kiterjesztett && (uj_szomszedsag != sz_moore || uj_perem != p_halott))
+        return 0;
+    szomszedsag = uj_szomszedsag;
+    perem = uj_perem;
+    kernel_beallit(szomszedsag, perem);
+    alkalmasra_valt();
+    return 1;
+}
+
+const Szabaly* motor_aktiv_szabaly(void){
+    return &szabaly;
+}
+
+const Ltl_szabaly* motor_aktiv_ltl(void){
+    return kiterjesztett ? &ltl : NULL;
+}
+
+void motor_szabaly_kiir(char *hova){
+    if(kiterjesztett)
+        ltl_szabaly_kiir(&ltl, hova);
+    else
+        szabaly_kiir(&szabaly, hova);
+}
+
+OszlopSor_Lista_Elem* motor_lepes(Tabla *t){
+    return motorok[aktiv].lepes(t);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file GoL_motor.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A lépésmotorok nyilvántartása és futásidejű kiválasztása.
+ * A grafikus felület és a parancssori módok a motor_lepes-en keresztül léptetnek, így a motor menet közben cserélhető.
+ * @version 0.1
+ * @date 2021-11-30
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_MOTOR_H
+#define GOL_MOTOR_H
+
+#include "GoL_logics.h"
+#include "GoL_ltl.h"
+#include "GoL_kernel.h"
+
+/**
+ * @brief Egy lépésfüggvény, ami az uj_generacio-val azonos módon viselkedik.
+ */
+typedef OszlopSor_Lista_Elem* (*Lepes_fuggveny)(Tabla *t);
+
+/**
+ * @brief Egy választható motor.
+ * @param nev A parancssorban és a HUD-on használt név
+ * @param lepes
+ * @param barmely_szabaly 2 ha Larger than Life és Generations szabállyal is működik, 1 ha tetszőleges B/S szabállyal, 0 ha csak a Conway-féllel
+ * @param barmely_topologia 1 ha más szomszédsággal és tórusz peremmel is működik, 0 ha csak Moore szomszédsággal, halott peremmel
+ */
+typedef struct Motor{
+    const char *nev;
+    Lepes_fuggveny lepes;
+    int barmely_szabaly;
+    int barmely_topologia;
+}Motor;
+
+/**
+ * @brief A választható motorok listája.
+ * @param db ide írja a motorok számát
+ * @return a lista első eleme
+ */
+const Motor* motor_lista(int *db);
+
+/**
+ * @brief Kiválasztja a megadott nevű motort.
+ * @param nev
+ * @return 1 ha sikeres; 0 ha nincs ilyen motor, vagy nem tudja az aktuális szabályt
+ */
+int motor_valaszt(const char *nev);
+
+/**
+ * @brief A lista következő motorjára vált (ami tudja az aktuális szabályt).
+ */
+void motor_kovetkezo(void);
+
+/**
+ * @brief Az aktuális motor.
+ */
+const Motor* motor_aktiv(void);
+
+/**
+ * @brief Beállítja a szabályt. Ha az aktuális motor nem tudja, az első olyanra vált, ami tudja (a táblázatosra vagy a kernelre).
+ * @param sz
+ */
+void motor_szabaly(const Szabaly *sz);
+
+/**
+ * @brief Beállít egy Larger than Life vagy Generations szabályt. Ha az sima B/S szabály, a motor_szabaly-lyal egyezik;
+ * különben, ha az aktuális motor nem tudja, az ltl motorra vált. Csak az alapértelmezett topológiával használható.
+ * @param sz
+ */
+void motor_ltl_szabaly(const Ltl_szabaly *sz);
+
+/**
+ * @brief Beállítja a szomszédságot és a peremet. Ha az aktuális motor nem tudja, a kernel motorra vált.
+ * @param szomszedsag
+ * @param perem
+ * @return 1 ha sikeres; 0 ha az aktuális szabály Larger than Life / Generations (az csak Moore szomszédsággal, halott peremmel megy)
+ */
+int motor_topologia(Szomszedsag szomszedsag, Perem perem);
+
+/**
+ * @brief A topológia az alapértelmezett (Moore szomszédság, halott perem) -e.
+ */
+int motor_alap_topologia(void);
+
+/**
+ * @brief Az aktuális B/S szabály (kiterjesztett szabálynál a legutóbbi B/S szabály, lásd motor_aktiv_ltl).
+ */
+const Szabaly* motor_aktiv_szabaly(void);
+
+/**
+ * @brief Az aktuális Larger than Life / Generations szabály.
+ * @return NULL ha az aktuális szabály sima B/S szabály
+ */
+const Ltl_szabaly* motor_aktiv_ltl(void);
+
+/**
+ * @brief Kiírja az aktuális szabályt (B/S, Generations vagy Larger than Life alakban).
+ * @param hova legalább LTL_SZABALY_HOSSZ karakteres puffer
+ */
+void motor_szabaly_kiir(char *hova);
+
+/**
+ * @brief Az aktuális szabály a (két állapotú, Moore szomszédságú, halott peremű) Conway-féle -e (a csak Conway-félét ismerő lépésfüggvények, pl. az idoblokk_lepes előtt ellenőrzendő).
+ */
+int motor_conway(void);
+
+/**
+ * @brief Egy generációt lép az aktuális motorral (lásd uj_generacio).
+ * @warning A linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param t
+ * @return a megváltoztatott cellák
+ */
+OszlopSor_Lista_Elem* motor_lepes(Tabla *t);
+
+#endif
@@ -0,0 +1,485 @@
+/**
+ * @file GoL_nepszamlalas.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A népszámlálás megvalósítása.
+ * @version 0.1
+ * @date 2021-12-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_memoria.h"
+#include "GoL_nepszamlalas.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/** A katalógus; az oszcillátorok és az űrhajók többi fázisa léptetéssel készül */
+static const Katalogus_elem katalogus[] = {
+    {"blokk", o_csendelet, 1, "oo/oo"},
+    {"meheskas", o_csendelet, 1, ".oo./o..o/.oo."},
+    {"cipo", o_csendelet, 1, ".oo./o..o/.o.o/..o."},
+    {"csonak", o_csendelet, 1, "oo./o.o/.o."},
+    {"hajo", o_csendelet, 1, "oo./o.o/.oo"},
+    {"kad", o_csendelet, 1, ".o./o.o/.o."},
+    {"to", o_csendelet, 1, ".oo./o..o/o..o/.oo."},
+    {"hosszu csonak", o_csendelet, 1, "oo../o.o./.o.o/..o."},
+    {"barka", o_csendelet, 1, ".o../o.o./.o.o/..o."},
+    {"mango", o_csendelet, 1, ".oo../o..o./.o..o/..oo."},
+    {"hosszu hajo", o_csendelet, 1, "oo../o.o./.o.o/..oo"},
+    {"horog (evo)", o_csendelet, 1, "oo../o.o./..o./..oo"},
+    {"kigyo", o_csendelet, 1, "oo.o/o.oo"},
+    {"repulogep-hordozo", o_csendelet, 1, "oo../o..o/..oo"},
+    {"villogo", o_oszcillator, 2, "ooo"},
+    {"varangy", o_oszcillator, 2, ".ooo/ooo."},
+    {"jelzofeny", o_oszcillator, 2, "oo../oo../..oo/..oo"},
+    {"ora", o_oszcillator, 2, "..o./o.o./.o.o/.o.."},
+    {"pulzar", o_oszcillator, 3, "..ooo...ooo../............./o....o.o....o/o....o.o....o/o....o.o....o/..ooo...ooo../"
+                                 "............./..ooo...ooo../o....o.o....o/o....o.o....o/o....o.o....o/............./..ooo...ooo.."},
+    {"pentadekatlon", o_oszcillator, 15, "..o....o../oo.oooo.oo/..o....o.."},
+    {"siklo", o_urhajo, 4, ".o./..o/ooo"},
+    {"konnyu urhajo", o_urhajo, 4, ".o..o/o..../o...o/oooo."},
+    {"kozepes urhajo", o_urhajo, 4, "...o../.o...o/o...../o....o/ooooo."},
+    {"nehez urhajo", o_urhajo, 4, "...oo../.o....o/o....../o.....o/oooooo."},
+};
+
+#define KATALOGUS_DB ((int)(sizeof(katalogus)/sizeof(katalogus[0])))
+/** Legfeljebb ennyi különböző fázis lehet a katalógusban */
+#define KANONIKUS_MAX 128
+/** Ennyi cella (Csebisev-)távolságon belül egy csoportba kerül két komponens (a pulzár darabjai, a jelzőfény) */
+#define KOZEL 2
+/** Ennyi távolságon belül két ismeretlen komponens is egy csoportba kerül (a pentadekatlon fázisainak két fele) */
+#define ISMERETLEN_KOZEL 7
+
+/**
+ * @brief Egy katalógusbeli fázis kanonikus hash-e.
+ */
+typedef struct Kanonikus{
+    uint64_t hash;
+    int index;
+}Kanonikus;
+
+/** A katalógus fázisai hash szerint rendezve */
+static Kanonikus kanonikusok[KANONIKUS_MAX];
+static int kanonikus_db = 0;
+static int katalogus_kesz = 0;
+
+/**
+ * @brief Egy (x, y) koordinátapár kulcsa (splitmix64).
+ */
+static inline uint64_t koordinata_kulcs(int x, int y);
+
+/**
+ * @brief A cellák (a rács indexei) kanonikus hash-e: a 8 szimmetriával transzformált alakzatok hash-einek minimuma.
+ * @param cellak
+ * @param db
+ * @param lepes A rács sorhossza
+ */
+static uint64_t kanonikus_hash(const int *cellak, int db, int lepes);
+
+/**
+ * @brief Felépíti a kanonikusok táblázatát (a minták minden fázisát léptetéssel).
+ * @return 1 ha sikeres; 0 ha elfogyott a memória (ekkor a táblázat üres, és a következő nepszamlalo_init újrapróbálja)
+ */
+static int katalogus_epit(void);
+
+/**
+ * @brief A kanonikus hash-ű objektum katalógusbeli indexe.
+ * @return -1 ha nincs a katalógusban
+ */
+static int katalogus_keres(uint64_t hash);
+
+/**
+ * @brief Két Kanonikus összehasonlítása a qsort-hoz.
+ */
+static int kanonikus_hasonlit(const void *a, const void *b);
+
+/**
+ * @brief Legalább db elemű cellánkénti és komponensenkénti tömbök.
+ * @return 1 ha sikeres, 0 ha elfogyott a memória (a régi tömbök megmaradnak)
+ */
+static int kapacitas_biztosit(Nepszamlalo *sz, size_t db);
+
+/**
+ * @brief Az unió-holvan gyökere, útfelezéssel.
+ */
+static inline int gyoker(int *szulo, int i);
+
+/**
+ * @brief Egyesíti a két elem halmazát (a kisebb indexű gyökér marad).
+ */
+static inline void egyesit(int *szulo, int a, int b);
+
+uint64_t koordinata_kulcs(int x, int y){
+    uint64_t z = ((uint64_t)(uint32_t)x << 32 | (uint32_t)y) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t kanonikus_hash(const int *cellak, int db, int lepes){
+    int min_sor = INT_MAX, max_sor = INT_MIN, min_oszlop = INT_MAX, max_oszlop = INT_MIN;
+    for(int i = 0; i < db; i++){
+        int sor = cellak[i] / lepes, oszlop = cellak[i] % lepes;
+        if(sor < min_sor) min_sor = sor;
+        if(sor > max_sor) max_sor = sor;
+        if(oszlop < min_oszlop) min_oszlop = oszlop;
+        if(oszlop > max_oszlop) max_oszlop = oszlop;
+    }
+    int w = max_oszlop - min_oszlop + 1, h = max_sor - min_sor + 1;
+    // Az összeg nem függ a cellák sorrendjétől, így nem kell rendezni
+    uint64_t hashek[8] = {0};
+    for(int i = 0; i < db; i++){
+        int y = cellak[i] / lepes - min_sor, x = cellak[i] % lepes - min_oszlop;
+        hashek[0] += koordinata_kulcs(x, y);
+        hashek[1] += koordinata_kulcs(w - 1 - x, y);
+        hashek[2] += koordinata_kulcs(x, h - 1 - y);
+        hashek[3] += koordinata_kulcs(w - 1 - x, h - 1 - y);
+        hashek[4] += koordinata_kulcs(y, x);
+        hashek[5] += koordinata_kulcs(h - 1 - y, x);
+        hashek[6] += koordinata_kulcs(y, w - 1 - x);
+        hashek[7] += koordinata_kulcs(h - 1 - y, w - 1 - x);
+    }
+    uint64_t min = hashek[0];
+    for(int i = 1; i < 8; i++)
+        if(hashek[i] < min)
+            min = hashek[i];
+    return min;
+}
+
+int kanonikus_hasonlit(const void *a, const void *b){
+    uint64_t x = ((const Kanonikus*)a)->hash, y = ((const Kanonikus*)b)->hash;
+    return (x > y) - (x < y);
+}
+
+int katalogus_epit(void){
+    for(int k = 0; k < KATALOGUS_DB; k++){
+        const Katalogus_elem *e = &katalogus[k];
+        int w = 0, h = 1, sor_hossz = 0;
+        for(const char *c = e->minta; *c; c++){
+            if(*c == '/'){
+                h++;
+                sor_hossz = 0;
+            }
+            else if(++sor_hossz > w){
+                w = sor_hossz;
+            }
+        }
+        // Az űrhajó egy periódus alatt legfeljebb periodus cellát mozdul
+        int margo = e->periodus + 2;
+        Tabla t;
+        if(!init_tabla(&t, w + 2 * margo, h + 2 * margo)){
+            kanonikus_db = 0;
+            return 0;
+        }
+        memset(t.g, 0, (size_t)t.m * t.lepes);
+        memset(t.kov, 0, (size_t)t.m * t.lepes);
+        int sor = 1 + margo, oszlop = 1 + margo;
+        for(const char *c = e->minta; *c; c++){
+            if(*c == '/'){
+                sor++;
+                oszlop = 1 + margo;
+                continue;
+            }
+            CELLA(&t, sor, oszlop++) = *c == 'o';
+        }
+        t.hash = tabla_hash(&t);
+        int *cellak = malloc((size_t)t.m * t.lepes * sizeof(int));
+        if(cellak == NULL){
+            destroy_tabla(&t);
+            kanonikus_db = 0;
+            return 0;
+        }
+        for(int fazis = 0; fazis < e->periodus; fazis++){
+            int db = 0;
+            for(int i = 0; i < t.m * t.lepes; i++)
+                if(t.g[i] == 1)
+                    cellak[db++] = i;
+            uint64_t hash = kanonikus_hash(cellak, db, t.lepes);
+            int uj = 1;
+            for(int i = 0; i < kanonikus_db; i++)
+                uj &= kanonikusok[i].hash != hash;
+            if(uj && kanonikus_db < KANONIKUS_MAX){
+                kanonikusok[kanonikus_db].hash = hash;
+                kanonikusok[kanonikus_db].index = k;
+                kanonikus_db++;
+            }
+            valtozasok_felszabadit(uj_generacio(&t));
+        }
+        free(cellak);
+        destroy_tabla(&t);
+    }
+    qsort(kanonikusok, kanonikus_db, sizeof(Kanonikus), kanonikus_hasonlit);
+    katalogus_kesz = 1;
+    return 1;
+}
+
+int katalogus_keres(uint64_t hash){
+    int also = 0, felso = kanonikus_db - 1;
+    while(also <= felso){
+        int kozep = (also + felso) / 2;
+        if(kanonikusok[kozep].hash == hash)
+            return kanonikusok[kozep].index;
+        if(kanonikusok[kozep].hash < hash)
+            also = kozep + 1;
+        else
+            felso = kozep - 1;
+    }
+    return -1;
+}
+
+const Katalogus_elem* nepszamlalas_katalogus(int *db){
+    *db = KATALOGUS_DB;
+    return katalogus;
+}
+
+void nepszamlalas_init(Nepszamlalas *n){
+    memset(n, 0, sizeof(*n));
+}
+
+int nepszamlalo_init(Nepszamlalo *sz){
+    memset(sz, 0, sizeof(*sz));
+    return katalogus_kesz || katalogus_epit();
+}
+
+void nepszamlalo_torol(Nepszamlalo *sz){
+    free(sz->szulo);
+    free(sz->cellak);
+    free(sz->rendezett);
+    free(sz->csoport_cellak);
+    free(sz->komp_eleje);
+    free(sz->komp_db);
+    free(sz->komp_fajta);
+    free(sz->komp_szulo);
+    free(sz->komp_sorrend);
+    memset(sz, 0, sizeof(*sz));
+}
+
+int kapacitas_biztosit(Nepszamlalo *sz, size_t db){
+    if(db <= sz->kapacitas)
+        return 1;
+    size_t uj = sz->kapacitas ? sz->kapacitas : 1024;
+    while(uj < db)
+        uj *= 2;
+    int **tombok[] = {&sz->cellak, &sz->rendezett, &sz->csoport_cellak, &sz->komp_eleje, &sz->komp_db, &sz->komp_fajta,
+                      &sz->komp_szulo, &sz->komp_sorrend};
+    // A már megnövelt tömbök maradhatnak nagyobbak, a kapacitás csak a végén nő
+    for(size_t i = 0; i < sizeof(tombok)/sizeof(tombok[0]); i++){
+        int *p = realloc(*tombok[i], uj * sizeof(int));
+        if(p == NULL)
+            return 0;
+        *tombok[i] = p;
+    }
+    sz->kapacitas = uj;
+    return 1;
+}
+
+int gyoker(int *szulo, int i){
+    while(szulo[i] != i){
+        szulo[i] = szulo[szulo[i]];
+        i = szulo[i];
+    }
+    return i;
+}
+
+void egyesit(int *szulo, int a, int b){
+    a = gyoker(szulo, a);
+    b = gyoker(szulo, b);
+    if(a < b)
+        szulo[b] = a;
+    else if(b < a)
+        szulo[a] = b;
+}
+
+size_t nepszamlalas_memoria_becsles(long long szelesseg, long long magassag){
+    if(szelesseg < 1 || magassag < 1 || szelesseg > TABLA_MAX_OLDAL || magassag > TABLA_MAX_OLDAL)
+        return 0;
+    // A cellák indexei int-ek: a szegélyes, sorhosszra kerekített rács legfeljebb INT_MAX cellás lehet
+    uint64_t racs = (uint64_t)memoria_kerekit((size_t)szelesseg + 2) * (uint64_t)(magassag + 2);
+    if(racs > INT_MAX || racs * sizeof(int) > SIZE_MAX / 2)
+        return 0;
+    return (size_t)racs * sizeof(int);
+}
+
+int nepszamlalas_racs(Nepszamlalo *sz, const Cella *g, int lepes, int szel, int mag, Nepszamlalas *n){
+    size_t racs = (size_t)mag * lepes;
+    if(racs > INT_MAX || !katalogus_kesz)
+        return 0;
+    if(racs > sz->racs_meret){
+        free(sz->szulo);
+        sz->szulo = malloc(racs * sizeof(int));
+        sz->racs_meret = sz->szulo != NULL ? racs : 0;
+        if(sz->szulo == NULL)
+            return 0;
+    }
+    int *szulo = sz->szulo;
+
+    // 1. Az élő cellák összegyűjtése és egyesítése a már látott (fölötte és balra lévő) élő szomszédaikkal
+    int elo = 0;
+    for(int sor = 1; sor < mag - 1; sor++){
+        const Cella *r = g + (size_t)sor * lepes;
+        for(int oszlop = 1; oszlop < szel - 1; oszlop++){
+            // Az üres részek 8 bájtonként ugorhatók
+            if((oszlop & 7) == 0 && oszlop + 8 <= szel - 1){
+                uint64_t szo;
+                memcpy(&szo, r + oszlop, sizeof(szo));
+                if(szo == 0){
+                    oszlop += 7;
+                    continue;
+                }
+            }
+            if(r[oszlop] != 1)
+                continue;
+            int i = sor * lepes + oszlop;
+            if((size_t)elo == sz->kapacitas && !kapacitas_biztosit(sz, (size_t)elo + 1))
+                return 0;
+            sz->cellak[elo++] = i;
+            szulo[i] = i;
+            if(g[i - lepes - 1] == 1) egyesit(szulo, i, i - lepes - 1);
+            if(g[i - lepes] == 1) egyesit(szulo, i, i - lepes);
+            if(g[i - lepes + 1] == 1) egyesit(szulo, i, i - lepes + 1);
+            if(g[i - 1] == 1) egyesit(szulo, i, i - 1);
+        }
+    }
+    if(elo == 0)
+        return 1;
+
+    // 2. Komponensek sorszámozása: a gyökér szülője ideiglenesen -(sorszám+1), majd minden cella szülője a sorszám
+    int komp = 0;
+    int *gyokerek = sz->rendezett;
+    for(int c = 0; c < elo; c++)
+        gyokerek[c] = gyoker(szulo, sz->cellak[c]);
+    for(int c = 0; c < elo; c++){
+        int r = gyokerek[c];
+        if(szulo[r] >= 0 && szulo[r] == r){
+            szulo[r] = -(komp + 1);
+            sz->komp_db[komp] = 0;
+            komp++;
+        }
+        gyokerek[c] = -szulo[r] - 1;
+    }
+    for(int c = 0; c < elo; c++){
+        szulo[sz->cellak[c]] = gyokerek[c];
+        sz->komp_db[gyokerek[c]]++;
+    }
+
+    // 3. A cellák komponensenként (leszámláló rendezés)
+    int eleje = 0;
+    for(int k = 0; k < komp; k++){
+        sz->komp_eleje[k] = eleje;
+        sz->komp_sorrend[k] = eleje;
+        eleje += sz->komp_db[k];
+    }
+    for(int c = 0; c < elo; c++)
+        sz->rendezett[sz->komp_sorrend[szulo[sz->cellak[c]]]++] = sz->cellak[c];
+
+    // 4. Felismerés
+    for(int k = 0; k < komp; k++){
+        sz->komp_fajta[k] = katalogus_keres(kanonikus_hash(sz->rendezett + sz->komp_eleje[k], sz->komp_db[k], lepes));
+        sz->komp_szulo[k] = k;
+    }
+
+    // 5. A közeli komponensek egyesítése csoportokká: bármely kettő KOZEL, két ismeretlen ISMERETLEN_KOZEL távolságig
+    for(int k = 0; k < komp; k++){
+        int ismeretlen = sz->komp_fajta[k] < 0;
+        int r = ismeretlen ? ISMERETLEN_KOZEL : KOZEL;
+        for(int c = sz->komp_eleje[k]; c < sz->komp_eleje[k] + sz->komp_db[k]; c++){
+            int sor = sz->rendezett[c] / lepes, oszlop = sz->rendezett[c] % lepes;
+            for(int s = sor - r; s <= sor + r; s++){
+                for(int o = oszlop - r; o <= oszlop + r; o++){
+                    if(s < 0 || s >= mag || o < 0 || o >= szel || g[s * lepes + o] != 1)
+                        continue;
+                    int masik = szulo[s * lepes + o];
+                    if(masik == k)
+                        continue;
+                    int tav = abs(s - sor) > abs(o - oszlop) ? abs(s - sor) : abs(o - oszlop);
+                    if(tav <= KOZEL || (ismeretlen && sz->komp_fajta[masik] < 0))
+                        egyesit(sz->komp_szulo, k, masik);
+                }
+            }
+        }
+    }
+
+    // 6. Számlálás: a több komponensű csoport egy objektum, ha egyben felismerhető, különben a komponensei külön számítanak.
+    // A csoportok tagjai láncolt listában: a gyökér (a legkisebb sorszám) után a többi, növekvő sorrendben
+    int *kovetkezo = sz->komp_sorrend;
+    for(int k = 0; k < komp; k++)
+        kovetkezo[k] = -1;
+    for(int k = komp - 1; k >= 0; k--){
+        int r = gyoker(sz->komp_szulo, k);
+        if(r != k){
+            kovetkezo[k] = kovetkezo[r];
+            kovetkezo[r] = k;
+        }
+    }
+    for(int k = 0; k < komp; k++){
+        if(gyoker(sz->komp_szulo, k) != k)
+            continue;
+        if(kovetkezo[k] >= 0){
+            int cellak = 0;
+            for(int m = k; m >= 0; m = kovetkezo[m]){
+                memcpy(sz->csoport_cellak + cellak, sz->rendezett + sz->komp_eleje[m], sz->komp_db[m] * sizeof(int));
+                cellak += sz->komp_db[m];
+            }
+            int fajta = katalogus_keres(kanonikus_hash(sz->csoport_cellak, cellak, lepes));
+            if(fajta >= 0){
+                n->db[fajta]++;
+                n->objektumok++;
+                continue;
+            }
+        }
+        for(int m = k; m >= 0; m = kovetkezo[m]){
+            n->objektumok++;
+            if(sz->komp_fajta[m] >= 0){
+                n->db[sz->komp_fajta[m]]++;
+            }
+            else{
+                n->ismeretlen++;
+                n->ismeretlen_cellak += sz->komp_db[m];
+            }
+        }
+    }
+    return 1;
+}
+
+int nepszamlalas_tabla(Nepszamlalo *sz, Tabla *t, Nepszamlalas *n){
+    return nepszamlalas_racs(sz, t->g, t->lepes, t->sz, t->m, n);
+}
+
+void nepszamlalas_osszead(Nepszamlalas *cel, const Nepszamlalas *forras){
+    for(int i = 0; i < NEPSZAMLALAS_KATALOGUS_MAX; i++)
+        cel->db[i] += forras->db[i];
+    cel->objektumok += forras->objektumok;
+    cel->ismeretlen += forras->ismeretlen;
+    cel->ismeretlen_cellak += forras->ismeretlen_cellak;
+}
+
+void nepszamlalas_kiir(const Nepszamlalas *n, FILE *ki){
+    long long tipusonkent[3] = {0, 0, 0};
+    int sorrend[KATALOGUS_DB];
+    for(int i = 0; i < KATALOGUS_DB; i++){
+        tipusonkent[katalogus[i].tipus] += n->db[i];
+        sorrend[i] = i;
+    }
+    // Csökkenő darabszám szerint (beszúrásos rendezés, a katalógus kicsi)
+    for(int i = 1; i < KATALOGUS_DB; i++){
+        int x = sorrend[i], j = i;
+        while(j > 0 && n->db[sorrend[j-1]] < n->db[x]){
+            sorrend[j] = sorrend[j-1];
+            j--;
+        }
+        sorrend[j] = x;
+    }
+    fprintf(ki, "objektumok: %lld (csendelet: %lld, oszcillator: %lld, urhajo: %lld, ismeretlen: %lld / %lld cella)\n", n->objektumok,
+            tipusonkent[o_csendelet], tipusonkent[o_oszcillator], tipusonkent[o_urhajo], n->ismeretlen, n->ismeretlen_cellak);
+    for(int i = 0; i < KATALOGUS_DB && n->db[sorrend[i]]; i++)
+        fprintf(ki, "  %-20s %lld\n", katalogus[sorrend[i]].nev, n->db[sorrend[i]]);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file GoL_nepszamlalas.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Népszámlálás: a táblán lévő objektumok (csendéletek, oszcillátorok, űrhajók) felismerése és megszámolása.
+ * Az objektumok az élő cellák 8-szomszédos összefüggő komponensei (unió-holvan a rácson). Minden komponensnek kanonikus
+ * hash-e van, ami a forgatásra és a tükrözésre (a négyzet 8 szimmetriájára) invariáns: a cellák koordinátáiból képzett
+ * kulcsok összege mind a 8 transzformációval, és ezek minimuma. Ezt egy beépített katalógusban keresi; a katalógus
+ * oszcillátorainak és űrhajóinak minden fázisa benne van (az első használatkor léptetéssel készül).
+ * Egyes objektumok több darabra esnek (pl. a pulzár, a jelzőfény vagy a pentadekatlon egyes fázisai); ezért a legfeljebb
+ * 2 cella távolságra lévő komponensek (két fel nem ismert komponens 7 celláig) csoportba egyesülnek, és ha a csoport
+ * egyben felismerhető, egy objektumként számít, különben a komponensei külön-külön.
+ * A futási idő az élő cellák számával arányos (a rács üres részét 8 bájtonként ugorja át), így minden leves után futtatható.
+ * @version 0.1
+ * @date 2021-12-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_NEPSZAMLALAS_H
+#define GOL_NEPSZAMLALAS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "GoL_logics.h"
+
+/** A katalógus legfeljebb ennyi objektumot tartalmaz */
+#define NEPSZAMLALAS_KATALOGUS_MAX 32
+
+/**
+ * @brief Az objektum fajtája.
+ */
+typedef enum Objektum_tipus{
+    o_csendelet, o_oszcillator, o_urhajo
+}Objektum_tipus;
+
+/**
+ * @brief A katalógus egy objektuma.
+ * @param nev
+ * @param tipus
+ * @param periodus Csendéletnél 1
+ * @param minta Egy fázisa soronként ('o' élő, '.' halott cella, a sorok '/'-rel elválasztva)
+ */
+typedef struct Katalogus_elem{
+    const char *nev;
+    Objektum_tipus tipus;
+    int periodus;
+    const char *minta;
+}Katalogus_elem;
+
+/**
+ * @brief A népszámlálás eredménye (több tábla eredménye összeadható).
+ * @param db Az i. katalógusbeli objektum darabszáma
+ * @param objektumok Az összes objektum
+ * @param ismeretlen A fel nem ismert objektumok száma
+ * @param ismeretlen_cellak A fel nem ismert objektumok celláinak száma
+ */
+typedef struct Nepszamlalas{
+    long long db[NEPSZAMLALAS_KATALOGUS_MAX];
+    long long objektumok;
+    long long ismeretlen;
+    long long ismeretlen_cellak;
+}Nepszamlalas;
+
+/**
+ * @brief Egy népszámláló munkaterülete (szálanként egy kell).
+ * @param szulo Cellánként az unió-holvan szülője, a végén a cella komponensének sorszáma (csak az élő cellák eleme érvényes)
+ * @param racs_meret A szulo elemszáma
+ * @param cellak Az élő cellák indexei a rácson
+ * @param rendezett Az élő cellák komponensenként csoportosítva
+ * @param csoport_cellak Egy csoport komponenseinek cellái
+ * @param komp_eleje A komponens első cellája a rendezett-ben
+ * @param komp_db A komponens celláinak száma
+ * @param komp_fajta A komponens katalógusbeli indexe, -1 ha ismeretlen
+ * @param komp_szulo A közeli komponensek csoportba egyesítésének unió-holvan szülője
+ * @param komp_sorrend Segédtömb: a rendezésnél az írási pozíciók, majd az egyesített csoportok láncolt listája
+ * @param kapacitas A cellánkénti és komponensenkénti tömbök mérete
+ */
+typedef struct Nepszamlalo{
+    int *szulo;
+    size_t racs_meret;
+    int *cellak, *rendezett, *csoport_cellak;
+    int *komp_eleje, *komp_db, *komp_fajta, *komp_szulo, *komp_sorrend;
+    size_t kapacitas;
+}Nepszamlalo;
+
+/**
+ * @brief Üres eredmény.
+ * @param n
+ */
+void nepszamlalas_init(Nepszamlalas *n);
+
+/**
+ * @brief Előkészít egy munkaterületet. Az első hívás a katalógust is felépíti, ezért először a fő szálon hívandó.
+ * @warning A nepszamlalo_torol-lel felszabadítandó!! (sikertelen init után is)
+ * @param sz
+ * @return 1 ha sikeres; 0 ha a katalógushoz elfogyott a memória (ekkor a nepszamlalas_racs is 0-t ad)
+ */
+int nepszamlalo_init(Nepszamlalo *sz);
+
+/**
+ * @brief Felszabadítja a munkaterületet.
+ * @param sz
+ */
+void nepszamlalo_torol(Nepszamlalo *sz);
+
+/**
+ * @brief A népszámlálás cellánkénti munkaterületének mérete egy szelesseg x magassag táblán.
+ * A cellák indexei int-ek, ezért legfeljebb INT_MAX cellás (szegélyes, kerekített sorhosszú) rácson működik.
+ * A tabla_meret_ellenoriz kísérő memóriájába számítandó.
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @return bájtban, 0 ha a tábla ehhez túl nagy vagy érvénytelen
+ */
+size_t nepszamlalas_memoria_becsles(long long szelesseg, long long magassag);
+
+/**
+ * @brief Megszámolja egy halott szegélyű rács objektumait, és hozzáadja az eredményhez.
+ * @param sz
+ * @param g A rács (a szegéllyel együtt)
+ * @param lepes A sorhossz
+ * @param szel A rács szélessége (a szegéllyel)
+ * @param mag A rács magassága (a szegéllyel)
+ * @param n
+ * @return 1 ha sikeres; 0 ha a rács több mint INT_MAX cellás, a katalógus nem épült fel, vagy elfogyott a memória (az
+ * eredmény ilyenkor hiányos)
+ */
+int nepszamlalas_racs(Nepszamlalo *sz, const Cella *g, int lepes, int szel, int mag, Nepszamlalas *n);
+
+/**
+ * @brief Megszámolja a tábla objektumait, és hozzáadja az eredményhez.
+ * @param sz
+ * @param t
+ * @param n
+ * @return 1 ha sikeres, lásd nepszamlalas_racs
+ */
+int nepszamlalas_tabla(Nepszamlalo *sz, Tabla *t, Nepszamlalas *n);
+
+/**
+ * @brief A forras eredményét hozzáadja a cel-hoz.
+ */
+void nepszamlalas_osszead(Nepszamlalas *cel, const Nepszamlalas *forras);
+
+/**
+ * @brief A katalógus (az eredmény db tömbjének indexei ennek az indexei).
+ * @param db ide írja a katalógus méretét
+ * @return a katalógus első eleme
+ */
+const Katalogus_elem* nepszamlalas_katalogus(int *db);
+
+/**
+ * @brief Kiírja az eredményt (fajtánként összesítve, majd objektumonként, csökkenő darabszám szerint).
+ * @param n
+ * @param ki
+ */
+void nepszamlalas_kiir(const Nepszamlalas *n, FILE *ki);
+
+#endif
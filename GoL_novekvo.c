@@ -0,0 +1,184 @@
+/**
+ * @file GoL_novekvo.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A növekvő tábla megvalósítása.
+ * @version 0.1
+ * @date 2021-12-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_motor.h"
+#include "GoL_novekvo.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief Van -e nem halott cella a tábla [sor_tol, sor_ig) x [oszlop_tol, oszlop_ig) területén.
+ */
+static int van_elo(const Tabla *t, int sor_tol, int sor_ig, int oszlop_tol, int oszlop_ig);
+
+/**
+ * @brief Egy sor n cellája között van -e nem halott; 8 cellát egyszerre néz.
+ */
+static int sor_van_elo(const Cella *p, int n);
+
+/**
+ * @brief A nem halott cellák befoglaló téglalapja (a szegélyen belül).
+ * @return 0 ha a tábla üres
+ */
+static int befoglalo(const Tabla *t, int *min_sor, int *max_sor, int *min_oszlop, int *max_oszlop);
+
+/**
+ * @brief Az egyik tengely zsugorítása: a [min, max] kiterjedésű mintához tartozó új kezdet és méret.
+ * @param meret A jelenlegi méret (szegély nélkül)
+ * @param min
+ * @param max
+ * @param kezdet ide írja az új terület első cellájának régi koordinátáját
+ * @param uj_meret ide írja az új méretet
+ * @return 1 ha az adott tengelyen érdemes zsugorítani
+ */
+static int tengely_zsugorit(int meret, int min, int max, int *kezdet, int *uj_meret);
+
+/**
+ * @brief Melyik szélső sávban van nem halott cella.
+ * @return 1 ha legalább egyben van
+ */
+static int szelen_elo(const Tabla *t, int *fent, int *lent, int *bal, int *jobb);
+
+/**
+ * @brief A tábla növelése a megadott irányokba.
+ * @return 1 ha a tábla nőtt, 0 ha a nagyobb tábla nem hozható létre
+ */
+static int novel(Novekvo *n, Tabla *t, int fent, int lent, int bal, int jobb);
+
+int sor_van_elo(const Cella *p, int n){
+    int i = 0;
+    for(; i + 8 <= n; i += 8){
+        uint64_t szo;
+        memcpy(&szo, p + i, sizeof(szo));
+        if(szo)
+            return 1;
+    }
+    for(; i < n; i++)
+        if(p[i])
+            return 1;
+    return 0;
+}
+
+int van_elo(const Tabla *t, int sor_tol, int sor_ig, int oszlop_tol, int oszlop_ig){
+    for(int sor = sor_tol; sor < sor_ig; sor++)
+        if(sor_van_elo(&CELLA(t, sor, oszlop_tol), oszlop_ig - oszlop_tol))
+            return 1;
+    return 0;
+}
+
+int befoglalo(const Tabla *t, int *min_sor, int *max_sor, int *min_oszlop, int *max_oszlop){
+    *min_sor = t->m;
+    *max_sor = -1;
+    *min_oszlop = t->sz;
+    *max_oszlop = -1;
+    for(int sor = 1; sor < t->m - 1; sor++){
+        const Cella *r = &CELLA(t, sor, 0);
+        if(!sor_van_elo(r + 1, t->sz - 2))
+            continue;
+        if(*min_sor > sor)
+            *min_sor = sor;
+        *max_sor = sor;
+        int bal = 1, jobb = t->sz - 2;
+        while(!r[bal]) bal++;
+        while(!r[jobb]) jobb--;
+        if(*min_oszlop > bal)
+            *min_oszlop = bal;
+        if(*max_oszlop < jobb)
+            *max_oszlop = jobb;
+    }
+    return *max_sor >= 0;
+}
+
+int tengely_zsugorit(int meret, int min, int max, int *kezdet, int *uj_meret){
+    int cel = (max - min + 1) + 2 * (NOVEKVO_MARGO + NOVEKVO_DARAB);
+    if(cel < NOVEKVO_MIN)
+        cel = NOVEKVO_MIN;
+    // Csak ha legalább a felére csökkenne, különben a következő növekedés úgyis visszanövesztené
+    if(2 * cel > meret)
+        return 0;
+    *kezdet = (min + max) / 2 - cel / 2;
+    *uj_meret = cel;
+    return 1;
+}
+
+int szelen_elo(const Tabla *t, int *fent, int *lent, int *bal, int *jobb){
+    int sz = t->sz - 2, m = t->m - 2;
+    int margo = NOVEKVO_MARGO < m ? NOVEKVO_MARGO : m;
+    int margo_o = NOVEKVO_MARGO < sz ? NOVEKVO_MARGO : sz;
+    *fent = van_elo(t, 1, 1 + margo, 1, sz + 1);
+    *lent = van_elo(t, m + 1 - margo, m + 1, 1, sz + 1);
+    *bal = van_elo(t, 1, m + 1, 1, 1 + margo_o);
+    *jobb = van_elo(t, 1, m + 1, sz + 1 - margo_o, sz + 1);
+    return *fent || *lent || *bal || *jobb;
+}
+
+int novel(Novekvo *n, Tabla *t, int fent, int lent, int bal, int jobb){
+    int sz = t->sz - 2, m = t->m - 2;
+    // A darab a mérettel arányos, így n cellányi növekedés összesen O(n) másolással jár
+    int darab_sor = m / 2 > NOVEKVO_DARAB ? m / 2 : NOVEKVO_DARAB;
+    int darab_oszlop = sz / 2 > NOVEKVO_DARAB ? sz / 2 : NOVEKVO_DARAB;
+    int uj_fent = fent ? darab_sor : 0, uj_lent = lent ? darab_sor : 0;
+    int uj_bal = bal ? darab_oszlop : 0, uj_jobb = jobb ? darab_oszlop : 0;
+    // Ha a nagyobb tábla már nem fér el, a mostani méretén fut tovább (a szegélyen túli rész elvész)
+    if(!tabla_meret_ellenoriz((long long)sz + uj_bal + uj_jobb, (long long)m + uj_fent + uj_lent, tabla_tarolas(), 0, NULL, 0) ||
+       !tabla_atmeretez(t, 1 - uj_fent, 1 - uj_bal, sz + uj_bal + uj_jobb, m + uj_fent + uj_lent))
+        return 0;
+    n->novelesek++;
+    return 1;
+}
+
+void novekvo_init(Novekvo *n, const Tabla *t){
+    n->kov_zsugoritas = t->generacio + NOVEKVO_ZSUGORITAS_KOZ;
+    n->novelesek = 0;
+    n->zsugoritasok = 0;
+}
+
+int novekvo_nov(Novekvo *n, Tabla *t){
+    int fent, lent, bal, jobb;
+    if(!motor_alap_topologia() || !szelen_elo(t, &fent, &lent, &bal, &jobb))
+        return 0;
+    return novel(n, t, fent, lent, bal, jobb);
+}
+
+int novekvo_igazit(Novekvo *n, Tabla *t){
+    if(!motor_alap_topologia())
+        return 0;
+    int sz = t->sz - 2, m = t->m - 2;
+    int fent, lent, bal, jobb;
+    if(szelen_elo(t, &fent, &lent, &bal, &jobb))
+        return novel(n, t, fent, lent, bal, jobb);
+    if(t->generacio < n->kov_zsugoritas)
+        return 0;
+    n->kov_zsugoritas = t->generacio + NOVEKVO_ZSUGORITAS_KOZ;
+
+    int min_sor, max_sor, min_oszlop, max_oszlop;
+    if(!befoglalo(t, &min_sor, &max_sor, &min_oszlop, &max_oszlop)){
+        // Üres táblán a közepére zsugorodik
+        min_sor = max_sor = (m + 1) / 2;
+        min_oszlop = max_oszlop = (sz + 1) / 2;
+    }
+    int sor0 = 1, oszlop0 = 1, uj_m = m, uj_sz = sz;
+    int zsugorit = tengely_zsugorit(m, min_sor, max_sor, &sor0, &uj_m);
+    zsugorit |= tengely_zsugorit(sz, min_oszlop, max_oszlop, &oszlop0, &uj_sz);
+    if(!zsugorit)
+        return 0;
+    if(!tabla_atmeretez(t, sor0, oszlop0, uj_sz, uj_m))
+        return 0;
+    n->zsugoritasok++;
+    return 1;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file GoL_novekvo.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A minta kiterjedését követő, magától növekvő és zsugorodó tábla.
+ * Minden lépés után (és a követés kezdetén, illetve a tábla kézi módosítása után is, lásd novekvo_nov) megnézi a tábla szélén lévő NOVEKVO_MARGO széles sávokat; ha egy sávban nem halott cella van, a tábla
+ * abba az irányba egy nagyobb darabbal (legalább NOVEKVO_DARAB, de legalább a jelenlegi méret fele) nő, így az
+ * átméretezés (másolás) amortizáltan ritka. NOVEKVO_ZSUGORITAS_KOZ generációnként a teljes befoglaló téglalapot is
+ * kiszámolja, és ha a minta a tábla felénél kisebbre húzódott össze, a táblát a mintára szűkíti.
+ * Ha a nagyobb tábla már nem hozható létre (lásd tabla_meret_ellenoriz), a tábla a mostani méretén fut tovább.
+ * Az átméretezés a tábla eltolását (Tabla.eltolas_sor, eltolas_oszlop) állítja, a cellák globális koordinátája és így
+ * a hash sem változik: a ciklusfigyelő és a hash-alapú összevetések átméretezés után is működnek.
+ * Csak az alapértelmezett topológiával (Moore szomszédság, halott perem) működik, máskor a novekvo_igazit nem csinál semmit.
+ * @version 0.1
+ * @date 2021-12-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_NOVEKVO_H
+#define GOL_NOVEKVO_H
+
+#include "GoL_logics.h"
+#include "GoL_ltl.h"
+
+/** A szélső sávok szélessége: ennyi cellán belül a szegélyhez a tábla nő. Nagyobb, mint a legnagyobb LtL sugár,
+ * így egy lépés alatt semmi sem érheti el a szegélyt */
+#define NOVEKVO_MARGO (LTL_MAX_SUGAR + 6)
+/** A növekedés legkisebb darabja cellában */
+#define NOVEKVO_DARAB 64
+/** Ennyi generációnként nézi meg, hogy a tábla zsugorítható -e */
+#define NOVEKVO_ZSUGORITAS_KOZ 256
+/** A tábla legkisebb mérete (szegély nélkül), ennél kisebbre nem zsugorodik */
+#define NOVEKVO_MIN (2 * NOVEKVO_MARGO + 8)
+
+/**
+ * @brief A növekvő tábla követésének állapota.
+ * @param kov_zsugoritas Az a generáció, amikor legközelebb a zsugorítást meg kell nézni
+ * @param novelesek Ahányszor a tábla nőtt
+ * @param zsugoritasok Ahányszor a tábla zsugorodott
+ */
+typedef struct Novekvo{
+    long long kov_zsugoritas;
+    long long novelesek, zsugoritasok;
+}Novekvo;
+
+/**
+ * @brief Elkezdi egy tábla követését.
+ * @param n
+ * @param t
+ */
+void novekvo_init(Novekvo *n, const Tabla *t);
+
+/**
+ * @brief Csak a növekedés: ha a szélső sávokban nem halott cella van, megnöveli a táblát. A követés kezdetén és a tábla
+ * kézi módosítása (pl. flip) után, a következő lépés előtt hívandó, különben a szegély melletti cellák születései elvesznek.
+ * Átméretezés után a korábbi változáslisták és a tábla méretét eltároló adatok érvénytelenek, mint a novekvo_igazit-nál.
+ * @param n
+ * @param t
+ * @return 1 ha a tábla nőtt, 0 ha nem
+ */
+int novekvo_nov(Novekvo *n, Tabla *t);
+
+/**
+ * @brief Egy lépés után szükség esetén átméretezi a táblát (nő, vagy ritkán zsugorodik).
+ * Átméretezés után a tábla pufferei és a koordinátái megváltoztak: a korábbi változáslisták és minden,
+ * ami a tábla méretét eltárolta (pl. statisztika, történet, felvétel), érvénytelen.
+ * @param n
+ * @param t
+ * @return 1 ha a tábla mérete megváltozott, 0 ha nem
+ */
+int novekvo_igazit(Novekvo *n, Tabla *t);
+
+#endif
@@ -0,0 +1,744 @@
+/**
+ * @file GoL_parancssor.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A parancssori módok megvalósítása.
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_ciklus.h"
+#include "GoL_statisztika.h"
+#include "GoL_ellenorzes.h"
+#include "GoL_idoblokk.h"
+#include "GoL_motor.h"
+#include "GoL_ltl.h"
+#include "GoL_kernel.h"
+#include "GoL_leves.h"
+#include "GoL_nepszamlalas.h"
+#include "GoL_kozos.h"
+#include "GoL_novekvo.h"
+#include "GoL_lemez.h"
+#include "GoL_memoria.h"
+#include "GoL_ritka.h"
+#include "GoL_szerver.h"
+#include "GoL_elosztott.h"
+#include "GoL_mentespont.h"
+#include "GoL_felvetel.h"
+#include "GoL_parancssor.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief A --futtat és a --folytat mód: betölti a mentést (illetve a mentéspontot), és a cel-adik generációig léptet.
+ * @param argc
+ * @param argv argv[1] a mód, argv[2] a fájl, argv[3] a cél generáció, utána opciók
+ * @return a program visszatérési értéke
+ */
+static int kotegelt_futtatas(int argc, char *argv[]);
+
+/**
+ * @brief A --futtat --ritka mód: a mentést csempénként tömörített táblába tölti, és azon lépteti a cel-adik generációig.
+ * @param fajlnev
+ * @param cel
+ * @param mentes ha nem NULL, ide menti a végén
+ * @return a program visszatérési értéke
+ */
+static int ritka_futtatas(const char *fajlnev, long long cel, const char *mentes);
+
+/**
+ * @brief Az --osszemer mód: minden motorral lefuttatja a mentést N generáción át, és kiírja a sebességüket.
+ * @param argc
+ * @param argv argv[2] a fájl, argv[3] a generációk száma
+ * @return a program visszatérési értéke
+ */
+static int motorok_osszemerese(int argc, char *argv[]);
+
+/**
+ * @brief Az --elosztott mód: a mentést P munkás folyamatra osztva futtatja N generáción át.
+ * @param argc
+ * @param argv argv[2] a fájl, argv[3] a generációk száma, argv[4] a munkások száma, utána opciók
+ * @return a program visszatérési értéke
+ */
+static int elosztott_futtatas(int argc, char *argv[]);
+
+/**
+ * @brief A --leves mód: N véletlen leves futtatása a stabilizálódásig, összesítéssel.
+ * @param argc
+ * @param argv argv[2] a levesek száma, utána opciók
+ * @return a program visszatérési értéke
+ */
+static int leves_futtatas(int argc, char *argv[]);
+
+/**
+ * @brief A --kozos-olvas mód: egy --kozos-szel futó szimuláció kereteinek követése más folyamatból, a közzétevő végéig.
+ * @param argc
+ * @param argv argv[2] az osztott memória neve, utána opciók
+ * @return a program visszatérési értéke
+ */
+static int kozos_olvasas(int argc, char *argv[]);
+
+/**
+ * @brief A --kliens mód: a standard bemenet parancsait elküldi a szervernek, és a végén kiírja a tükrözött tábla állapotát.
+ * @param argc
+ * @param argv argv[2] a szerver címe
+ * @return a program visszatérési értéke
+ */
+static int kliens_mod(int argc, char *argv[]);
+
+/**
+ * @brief Lefuttatja a tábla másolatát n generáción át, és kiírja a sebességet.
+ * @param nev
+ * @param eredeti
+ * @param n
+ * @param lepes A lépésfüggvény; ha NULL, akkor idoblokk_lepes blokk generációnként
+ * @param blokk
+ * @param alap_ido Az első (referencia) mérés ideje, ehhez viszonyít; ha 0, ez az első mérés
+ * @param hash ide írja a végső hash-t
+ * @return a mérés ideje másodpercben
+ */
+static double osszemer_egy(const char *nev, Tabla *eredeti, long long n, Lepes_fuggveny lepes, int blokk, double alap_ido, uint64_t *hash);
+
+int kotegelt_futtatas(int argc, char *argv[]){
+    if(argc < 4){
+        fprintf(stderr, "Hasznalat: --futtat <fajl> <N> [--megall|--ugras] [--ment <fajl>] [--csv <fajl>] [--blokk <k>] [--motor <nev>] [--szabaly <szabaly>]\n"
+                        "                  [--szomszedsag <moore|neumann|hatszog>] [--torusz]\n"
+                        "                  [--mentespont <fajl> [--mp-generacio <N>] [--mp-ido <mp>]]\n"
+                        "                  [--felvetel <png|gif|nyers> <cel> [--cellameret <N>] [--felvetel-var]] [--nepszamlalas]\n"
+                        "                  [--kozos </nev> [--kozos-rekeszek <N>]] [--novekvo] [--lemez <konyvtar>]\n"
+                        "          --futtat <fajl> <N> --ritka [--ment <fajl>] [--szabaly <B../S..>]\n"
+                        "          --folytat <mentespont> <N> [ugyanazok az opciok]\n");
+        return 2;
+    }
+    int folytat = strcmp(argv[1], "--folytat") == 0;
+    const char *fajlnev = argv[2];
+    long long cel = atoll(argv[3]);
+    int megall = 0, ugras = 0, blokk = 1;
+    const char *mentes = NULL, *csv = NULL, *motor = NULL, *mentespont = NULL, *kozos = NULL, *lemez = NULL;
+    int kozos_rekeszek = KOZOS_ALAP_REKESZEK;
+    long long mp_generacio = 100000;
+    double mp_ido = 300;
+    const char *felvetel = NULL, *felvetel_formatum_nev = NULL;
+    int cellameret = 1, felvetel_var = 0, nepszamlalas = 0, novekvo = 0, ritka = 0;
+    Szomszedsag szomszedsag = sz_moore;
+    Perem perem = p_halott;
+    for(int i = 4; i < argc; i++){
+        if(strcmp(argv[i], "--megall") == 0) megall = 1;
+        else if(strcmp(argv[i], "--ugras") == 0) ugras = 1;
+        else if(strcmp(argv[i], "--ment") == 0 && i+1 < argc) mentes = argv[++i];
+        else if(strcmp(argv[i], "--csv") == 0 && i+1 < argc) csv = argv[++i];
+        else if(strcmp(argv[i], "--blokk") == 0 && i+1 < argc) blokk = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--motor") == 0 && i+1 < argc) motor = argv[++i];
+        else if(strcmp(argv[i], "--mentespont") == 0 && i+1 < argc) mentespont = argv[++i];
+        else if(strcmp(argv[i], "--mp-generacio") == 0 && i+1 < argc) mp_generacio = atoll(argv[++i]);
+        else if(strcmp(argv[i], "--mp-ido") == 0 && i+1 < argc) mp_ido = atof(argv[++i]);
+        else if(strcmp(argv[i], "--cellameret") == 0 && i+1 < argc) cellameret = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--felvetel-var") == 0) felvetel_var = 1;
+        else if(strcmp(argv[i], "--nepszamlalas") == 0) nepszamlalas = 1;
+        else if(strcmp(argv[i], "--novekvo") == 0) novekvo = 1;
+        else if(strcmp(argv[i], "--lemez") == 0 && i+1 < argc) lemez = argv[++i];
+        else if(strcmp(argv[i], "--ritka") == 0) ritka = 1;
+        else if(strcmp(argv[i], "--kozos") == 0 && i+1 < argc) kozos = argv[++i];
+        else if(strcmp(argv[i], "--kozos-rekeszek") == 0 && i+1 < argc) kozos_rekeszek = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--torusz") == 0) perem = p_torusz;
+        else if(strcmp(argv[i], "--szomszedsag") == 0 && i+1 < argc){
+            if(!szomszedsag_beolvas(argv[++i], &szomszedsag)){
+                fprintf(stderr, "Ismeretlen szomszedsag: %s (moore, neumann vagy hatszog)\n", argv[i]);
+                return 2;
+            }
+        }
+        else if(strcmp(argv[i], "--felvetel") == 0 && i+2 < argc){
+            felvetel_formatum_nev = argv[++i];
+            felvetel = argv[++i];
+        }
+        else if(strcmp(argv[i], "--szabaly") == 0 && i+1 < argc){
+            Szabaly sz;
+            Ltl_szabaly ltl;
+            if(szabaly_beolvas(argv[++i], &sz))
+                motor_szabaly(&sz);
+            else if(ltl_szabaly_beolvas(argv[i], &ltl))
+                motor_ltl_szabaly(&ltl);
+            else{
+                fprintf(stderr, "Hibas szabaly: %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else{
+            fprintf(stderr, "Ismeretlen opcio: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if(!motor_topologia(szomszedsag, perem)){
+        fprintf(stderr, "A --szomszedsag es a --torusz csak B/S szaballyal hasznalhato\n");
+        return 2;
+    }
+    // A mentéspont csak B/S szabályt tud tárolni, és csak az alapértelmezett topológiával
+    if((folytat || mentespont != NULL) && (motor_aktiv_ltl() != NULL || !motor_alap_topologia())){
+        fprintf(stderr, "A mentespont csak B/S szaballyal, Moore szomszedsaggal es halott peremmel hasznalhato\n");
+        return 2;
+    }
+    // A felvétel, az osztott memória és a mentéspont rögzített méretű táblát vár
+    if(novekvo && (!motor_alap_topologia() || folytat || mentespont != NULL || felvetel != NULL || kozos != NULL)){
+        fprintf(stderr, "A --novekvo csak Moore szomszedsaggal es halott peremmel, felvetel, mentespont es --kozos nelkul hasznalhato\n");
+        return 2;
+    }
+    // A ritka tábla saját lépéssel fut, a sűrű táblára épülő kiegészítők nélkül
+    if(ritka){
+        if(folytat || megall || ugras || csv != NULL || blokk != 1 || motor != NULL || mentespont != NULL || felvetel != NULL ||
+           nepszamlalas || novekvo || kozos != NULL || lemez != NULL || !motor_alap_topologia() || motor_aktiv_ltl() != NULL ||
+           !ritka_szabaly_jo(motor_aktiv_szabaly())){
+            fprintf(stderr, "A --ritka csak --futtat-tal, B0 nelkuli B/S szaballyal, Moore szomszedsaggal es halott peremmel, "
+                            "a --ment es a --szabaly kivetelevel mas opcio nelkul hasznalhato\n");
+            return 2;
+        }
+        return ritka_futtatas(fajlnev, cel, mentes);
+    }
+    // A lemezes tábla sávonként lép, ez csak egy sugarú B/S szabállyal és halott peremmel megy; átméretezni nem lehet
+    if(lemez != NULL){
+        if(!lemez_lepes_kompatibilis() || novekvo || blokk > 1){
+            fprintf(stderr, "A --lemez csak B/S szaballyal, Moore szomszedsaggal es halott peremmel, --blokk es --novekvo nelkul hasznalhato\n");
+            return 2;
+        }
+        if(!memoria_fajl_konyvtar(lemez)){
+            fprintf(stderr, "A --lemez nem hasznalhato ezen a rendszeren, vagy tul hosszu a konyvtar neve: %s\n", lemez);
+            return 2;
+        }
+        tabla_tarolas_beallit(tar_lemez);
+    }
+
+    // A mentéspont a szabályt is visszaállítja, ezért a motor ellenőrzése a betöltés után jön
+    Tabla t;
+    Mentespont_allapot folytatott;
+    int betoltve = folytat ? mentespont_betolt(fajlnev, &t, &folytatott) : tabla_betolt(fajlnev, &t);
+    // Csak a betöltött tábla kerül lemezre, a futás közbeni segédtáblák (pl. népszámlálás) a memóriában maradnak
+    tabla_tarolas_beallit(tar_suru);
+    if(!betoltve){
+        fprintf(stderr, "Nem lehetett betolteni: %s\n", fajlnev);
+        return 1;
+    }
+    int rossz_opcio = 1;
+    Felvetel_formatum formatum = f_png;
+    // A táblából méretezett kísérő szerkezetek is a memóriakeretbe számítanak
+    char uzenet[256] = "";
+    size_t kisero = statisztika_memoria_becsles(t.sz - 2, t.m - 2, 1) +
+                    (mentespont != NULL ? mentespont_memoria_becsles(t.sz - 2, t.m - 2) : 0) +
+                    (nepszamlalas ? nepszamlalas_memoria_becsles(t.sz - 2, t.m - 2) : 0);
+    if(felvetel != NULL && !felvetel_formatum(felvetel_formatum_nev, &formatum))
+        fprintf(stderr, "Ismeretlen felvetel formatum: %s (png, gif vagy nyers)\n", felvetel_formatum_nev);
+    else if(cellameret < 1)
+        fprintf(stderr, "A --cellameret legalabb 1\n");
+    else if(kozos_rekeszek < 2)
+        fprintf(stderr, "A --kozos-rekeszek legalabb 2\n");
+    else if(blokk < 1 || blokk > IDOBLOKK_MAX_K)
+        fprintf(stderr, "A --blokk erteke 1 es %d kozott lehet\n", IDOBLOKK_MAX_K);
+    else if(motor != NULL && !motor_valaszt(motor))
+        fprintf(stderr, "Ismeretlen motor, vagy nem tudja a szabalyt: %s\n", motor);
+    else if(blokk > 1 && !motor_conway())
+        fprintf(stderr, "A --blokk csak a Conway-fele szaballyal hasznalhato\n");
+    else if(nepszamlalas && !motor_conway())
+        fprintf(stderr, "A --nepszamlalas csak a Conway-fele szaballyal hasznalhato\n");
+    else if(nepszamlalas && nepszamlalas_memoria_becsles(t.sz - 2, t.m - 2) == 0)
+        fprintf(stderr, "A tabla tul nagy a --nepszamlalas-hoz (legfeljebb %d cella)\n", INT_MAX);
+    else if(!tabla_meret_ellenoriz(t.sz - 2, t.m - 2, tabla_tarolas(), kisero, uzenet, sizeof(uzenet)))
+        fprintf(stderr, "%s (a statisztikaval, a mentesponttal es a nepszamlalassal egyutt)\n", uzenet);
+    else
+        rossz_opcio = 0;
+    if(rossz_opcio){
+        destroy_tabla(&t);
+        return 2;
+    }
+    // A szegélyhez érő mintának már az első lépés előtt nőnie kell (a statisztika stb. már az új méretet látja)
+    Novekvo nv;
+    novekvo_init(&nv, &t);
+    if(novekvo)
+        novekvo_nov(&nv, &t);
+    // Ha a felvétel a standard kimenetre megy, az üzenetek a hibakimenetre kerülnek
+    FILE *naplo = (felvetel != NULL && formatum == f_nyers && strcmp(felvetel, "-") == 0) ? stderr : stdout;
+    Felvetel fv;
+    if(felvetel != NULL && !felvetel_indit(&fv, formatum, felvetel, &t, cellameret, felvetel_var)){
+        fprintf(stderr, "Nem indithato a felvetel: %s\n", felvetel);
+        destroy_tabla(&t);
+        return 1;
+    }
+    if(felvetel != NULL)
+        felvetel_kepkocka(&fv, &t);
+    Kozos_gyuru gyuru;
+    int kozos_aktiv = 0;
+    if(kozos != NULL){
+        kozos_aktiv = kozos_indit(&gyuru, kozos, &t, kozos_rekeszek);
+        if(kozos_aktiv)
+            kozos_kozzetesz(&gyuru, &t);
+        else
+            fprintf(stderr, "Nem hozhato letre az osztott memoria: %s\n", kozos);
+    }
+    Ciklus_figyelo *ciklus = malloc(sizeof(Ciklus_figyelo));
+    if(ciklus == NULL){
+        fprintf(stderr, "Nem fert a memoriaba a ciklusfigyelo\n");
+        if(kozos_aktiv)
+            kozos_leallit(&gyuru);
+        if(felvetel != NULL)
+            felvetel_leallit(&fv);
+        destroy_tabla(&t);
+        return 1;
+    }
+    ciklus_init(ciklus);
+    ciklus_frissit(ciklus, &t);
+    Statisztika stat;
+    if(!statisztika_init(&stat, &t, 1)){
+        fprintf(stderr, "Nem fert a memoriaba a statisztika\n");
+        if(kozos_aktiv)
+            kozos_leallit(&gyuru);
+        if(felvetel != NULL)
+            felvetel_leallit(&fv);
+        statisztika_torol(&stat);
+        free(ciklus);
+        destroy_tabla(&t);
+        return 1;
+    }
+    if(folytat){
+        stat.jelen.szuletes = folytatott.szuletes;
+        stat.jelen.halalozas = folytatott.halalozas;
+        stat.ossz_szuletes = folytatott.ossz_szuletes;
+        stat.ossz_halalozas = folytatott.ossz_halalozas;
+        fprintf(naplo, "folytatas a %lld. generaciotol\n", t.generacio);
+    }
+    Mentespont mp;
+    int mp_aktiv = 0;
+    if(mentespont != NULL){
+        mp_aktiv = mentespont_indit(&mp, mentespont, mp_generacio, mp_ido, &t, &stat);
+        if(!mp_aktiv)
+            fprintf(stderr, "Nem indithato a mentespont iro: %s\n", mentespont);
+    }
+    FILE *csv_fp = NULL;
+    if(csv != NULL){
+        csv_fp = fopen(csv, "wt");
+        if(csv_fp == NULL)
+            fprintf(stderr, "Nem lehetett megnyitni: %s\n", csv);
+        statisztika_csv_folyam(&stat, csv_fp);
+    }
+
+    // --blokk k esetén k generációnként lép csempénként; a statisztika és a ciklusfigyelő ilyenkor csak minden k. generációt látja,
+    // így a születés/halálozás a k lépés nettó változása, a felismert periódus pedig a valódi többszöröse is lehet
+    int hiba = 0;
+    while(t.generacio < cel){
+        int k = (cel - t.generacio < blokk) ? (int)(cel - t.generacio) : blokk;
+        long long elotte = t.generacio;
+        OszlopSor_Lista_Elem *fej = (k > 1) ? idoblokk_lepes(&t, k, IDOBLOKK_CSEMPE) : (lemez != NULL) ? lemez_lepes(&t) : motor_lepes(&t);
+        if(t.generacio == elotte){
+            fprintf(stderr, "Elfogyott a memoria a %lld. generacio leptetesekor\n", elotte);
+            hiba = 1;
+            break;
+        }
+        statisztika_frissit(&stat, &t, fej);
+        if(novekvo && novekvo_igazit(&nv, &t)){
+            // A statisztika a tábla méretével dolgozik, az új táblára újraindul; az összesítők megmaradnak
+            long long ossz_szuletes = stat.ossz_szuletes, ossz_halalozas = stat.ossz_halalozas;
+            statisztika_torol(&stat);
+            if(!statisztika_init(&stat, &t, 1))
+                fprintf(stderr, "A megnott tablara nem fert a memoriaba a statisztika, a tovabbiakban nem szamol\n");
+            stat.ossz_szuletes = ossz_szuletes;
+            stat.ossz_halalozas = ossz_halalozas;
+            stat.csv = csv_fp;
+        }
+        if(mp_aktiv)
+            mentespont_frissit(&mp, &t, &stat, fej);
+        if(felvetel != NULL)
+            felvetel_kepkocka(&fv, &t);
+        if(kozos_aktiv)
+            kozos_kozzetesz(&gyuru, &t);
+        valtozasok_felszabadit(fej);
+        if(ciklus_frissit(ciklus, &t)){
+            fprintf(naplo, "ciklus: periodus %lld, kezdete a %lld. generacio\n", ciklus->periodus, ciklus->kezdet);
+            if(megall)
+                break;
+            if(ugras){
+                long long atugrott = ciklus_ugras(ciklus, &t, cel);
+                if(atugrott)
+                    fprintf(naplo, "atugorva %lld generacio\n", atugrott);
+            }
+        }
+    }
+    fprintf(naplo, "generacio: %lld, nepesseg: %lld, szuletes: %lld, halalozas: %lld, hash: %016llx\n", t.generacio, stat.jelen.nepesseg,
+           stat.ossz_szuletes, stat.ossz_halalozas, (unsigned long long)t.hash);
+    if(stat.jelen.nepesseg > 0)
+        fprintf(naplo, "befoglalo teglalap: (%d, %d) - (%d, %d)\n", stat.jelen.min_sor, stat.jelen.min_oszlop, stat.jelen.max_sor, stat.jelen.max_oszlop);
+    if(novekvo)
+        fprintf(naplo, "novekvo tabla: %dx%d, eltolas (%d, %d), %lld noveles, %lld zsugoritas\n", t.sz - 2, t.m - 2,
+                t.eltolas_sor, t.eltolas_oszlop, nv.novelesek, nv.zsugoritasok);
+    if(nepszamlalas){
+        Nepszamlalo szamlalo;
+        Nepszamlalas n;
+        nepszamlalas_init(&n);
+        // A --novekvo tábla azóta túlnőhetett a számlálón
+        if(nepszamlalo_init(&szamlalo) && nepszamlalas_tabla(&szamlalo, &t, &n))
+            nepszamlalas_kiir(&n, naplo);
+        else{
+            fprintf(stderr, "A nepszamlalas nem sikerult: a tabla tul nagy, vagy elfogyott a memoria\n");
+            hiba = 1;
+        }
+        nepszamlalo_torol(&szamlalo);
+    }
+
+    if(kozos_aktiv)
+        kozos_leallit(&gyuru);
+    if(felvetel != NULL){
+        if(!felvetel_leallit(&fv)){
+            fprintf(stderr, "Hiba a felvetel irasakor: %s\n", felvetel);
+            hiba = 1;
+        }
+        fprintf(naplo, "felvetel: %lld kepkocka (%dx%d pixel), %lld eldobva\n", fv.rogzitett, fv.sz * fv.cellameret, fv.m * fv.cellameret, fv.eldobott);
+    }
+    if(mp_aktiv){
+        mentespont_most(&mp, &t, &stat);
+        if(!mentespont_leallit(&mp)){
+            fprintf(stderr, "Hiba a mentespontok irasakor: %s\n", mentespont);
+            hiba = 1;
+        }
+    }
+    if(mentes != NULL && !tabla_ment(mentes, &t))
+        hiba = 1;
+    if(csv_fp != NULL)
+        fclose(csv_fp);
+    statisztika_torol(&stat);
+    free(ciklus);
+    destroy_tabla(&t);
+    return hiba;
+}
+
+int ritka_futtatas(const char *fajlnev, long long cel, const char *mentes){
+    Ritka_tabla r;
+    if(!ritka_betolt(fajlnev, &r)){
+        fprintf(stderr, "Nem lehetett betolteni: %s\n", fajlnev);
+        return 1;
+    }
+    long long ossz_szuletes = 0, ossz_halalozas = 0;
+    int hiba = 0;
+    while(r.generacio < cel){
+        if(ritka_lepes(&r, motor_aktiv_szabaly()) < 0){
+            fprintf(stderr, "Elfogyott a memoria a %lld. generacio leptetesekor\n", r.generacio);
+            hiba = 1;
+            break;
+        }
+        ossz_szuletes += r.szuletes;
+        ossz_halalozas += r.halalozas;
+    }
+    printf("generacio: %lld, nepesseg: %lld, szuletes: %lld, halalozas: %lld, hash: %016llx\n", r.generacio, r.nepesseg,
+           ossz_szuletes, ossz_halalozas, (unsigned long long)r.hash);
+    printf("ritka tabla: %lld ures, %lld lista, %lld suru csempe, %lld formavaltas; %llu KB (surun %llu KB lenne)\n",
+           r.tipusok[ct_ures], r.tipusok[ct_lista], r.tipusok[ct_suru], r.atalakitasok, (unsigned long long)(ritka_memoria(&r) >> 10),
+           (unsigned long long)(tabla_memoria_becsles(r.sz - 2, r.m - 2, tar_suru, NULL) >> 10));
+    hiba = hiba || (mentes != NULL && !ritka_ment(mentes, &r));
+    ritka_torol(&r);
+    return hiba;
+}
+
+double osszemer_egy(const char *nev, Tabla *eredeti, long long n, Lepes_fuggveny lepes, int blokk, double alap_ido, uint64_t *hash){
+    Tabla t;
+    tabla_masol(&t, eredeti);
+    Uint64 kezdet = SDL_GetPerformanceCounter();
+    while(t.generacio < eredeti->generacio + n){
+        long long hatra = eredeti->generacio + n - t.generacio;
+        if(lepes != NULL)
+            valtozasok_felszabadit(lepes(&t));
+        else
+            valtozasok_felszabadit(idoblokk_lepes(&t, hatra < blokk ? (int)hatra : blokk, IDOBLOKK_CSEMPE));
+        // Elfogyott a memória: az eltérő hash hibaként jelenik meg
+        if(t.generacio == eredeti->generacio + n - hatra){
+            fprintf(stderr, "%s: elfogyott a memoria\n", nev);
+            break;
+        }
+    }
+    double ido = (double)(SDL_GetPerformanceCounter() - kezdet) / (double)SDL_GetPerformanceFrequency();
+    double cellak = (double)(t.m-2) * (t.sz-2) * n;
+    printf("%-14s %9.3f s %10.1f gen/s %8.2f ns/cella %6.2fx  hash %016llx\n", nev, ido, n / ido, ido * 1e9 / cellak,
+           alap_ido > 0 ? alap_ido / ido : 1.0, (unsigned long long)t.hash);
+    *hash = t.hash;
+    destroy_tabla(&t);
+    return ido;
+}
+
+int motorok_osszemerese(int argc, char *argv[]){
+    if(argc < 4){
+        fprintf(stderr, "Hasznalat: --osszemer <fajl> <N>\n");
+        return 2;
+    }
+    long long n = atoll(argv[3]);
+    Tabla eredeti;
+    if(n < 1 || !tabla_betolt(argv[2], &eredeti)){
+        fprintf(stderr, "Nem lehetett betolteni: %s\n", argv[2]);
+        return 1;
+    }
+    printf("%dx%d tabla, %lld generacio\n", eredeti.sz-2, eredeti.m-2, n);
+    int db, hiba = 0;
+    const Motor *lista = motor_lista(&db);
+    uint64_t alap_hash = 0, hash;
+    double alap_ido = 0;
+    for(int i = 0; i < db; i++){
+        double ido = osszemer_egy(lista[i].nev, &eredeti, n, lista[i].lepes, 1, alap_ido, &hash);
+        if(i == 0){
+            alap_ido = ido;
+            alap_hash = hash;
+        }
+        hiba |= hash != alap_hash;
+    }
+    osszemer_egy("idoblokk k=8", &eredeti, n, NULL, 8, alap_ido, &hash);
+    hiba |= hash != alap_hash;
+    if(hiba)
+        printf("HIBA: a motorok vegallapota elter!\n");
+    destroy_tabla(&eredeti);
+    return hiba;
+}
+
+int elosztott_futtatas(int argc, char *argv[]){
+    if(argc < 5){
+        fprintf(stderr, "Hasznalat: --elosztott <fajl> <N> <P> [--ment <fajl>] [--szabaly <B../S..>]\n");
+        return 2;
+    }
+    const char *mentes = NULL;
+    for(int i = 5; i < argc; i++){
+        if(strcmp(argv[i], "--ment") == 0 && i+1 < argc) mentes = argv[++i];
+        else if(strcmp(argv[i], "--szabaly") == 0 && i+1 < argc){
+            Szabaly sz;
+            if(!szabaly_beolvas(argv[++i], &sz)){
+                fprintf(stderr, "Hibas szabaly: %s\n", argv[i]);
+                return 2;
+            }
+            motor_szabaly(&sz);
+        }
+        else{
+            fprintf(stderr, "Ismeretlen opcio: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    Elosztott_eredmeny e;
+    if(!elosztott_futtat(argv[2], atoll(argv[3]), atoi(argv[4]), mentes, &e)){
+        fprintf(stderr, "Az elosztott futtatas nem sikerult: %s\n", argv[2]);
+        return 1;
+    }
+    printf("generacio: %lld, nepesseg: %lld, szuletes: %lld, halalozas: %lld, hash: %016llx\n", e.generacio, e.nepesseg,
+           e.ossz_szuletes, e.ossz_halalozas, (unsigned long long)e.hash);
+    if(e.nepesseg > 0)
+        printf("befoglalo teglalap: (%d, %d) - (%d, %d)\n", e.min_sor, e.min_oszlop, e.max_sor, e.max_oszlop);
+    return 0;
+}
+
+int leves_futtatas(int argc, char *argv[]){
+    if(argc < 3){
+        fprintf(stderr, "Hasznalat: --leves <N> [--tabla <meret>] [--meret <meret>] [--suruseg <szazalek>] [--mag <szam>] [--szalak <P>]\n"
+                        "                [--kotet <db>] [--max-generacio <N>] [--szabaly <B../S..>] [--csv <fajl>] [--nepszamlalas]\n");
+        return 2;
+    }
+    Leves_beallitas b = LEVES_ALAP;
+    Szabaly sz = SZABALY_CONWAY;
+    const char *csv = NULL;
+    b.db = atoll(argv[2]);
+    for(int i = 3; i < argc; i++){
+        if(strcmp(argv[i], "--tabla") == 0 && i+1 < argc) b.tabla = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--meret") == 0 && i+1 < argc) b.meret = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--suruseg") == 0 && i+1 < argc) b.suruseg = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--mag") == 0 && i+1 < argc) b.mag = strtoull(argv[++i], NULL, 10);
+        else if(strcmp(argv[i], "--szalak") == 0 && i+1 < argc) b.szalak = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--kotet") == 0 && i+1 < argc) b.kotet = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--max-generacio") == 0 && i+1 < argc) b.max_generacio = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--csv") == 0 && i+1 < argc) csv = argv[++i];
+        else if(strcmp(argv[i], "--nepszamlalas") == 0) b.nepszamlalas = 1;
+        else if(strcmp(argv[i], "--szabaly") == 0 && i+1 < argc){
+            if(!szabaly_beolvas(argv[++i], &sz)){
+                fprintf(stderr, "Hibas szabaly: %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else{
+            fprintf(stderr, "Ismeretlen opcio: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    Szabaly conway = SZABALY_CONWAY;
+    if(b.nepszamlalas && (sz.szuletes != conway.szuletes || sz.tuleles != conway.tuleles)){
+        fprintf(stderr, "A --nepszamlalas csak a Conway-fele szaballyal hasznalhato\n");
+        return 2;
+    }
+    if(b.szalak <= 0)
+        b.szalak = SDL_GetCPUCount();
+    FILE *fp = NULL;
+    if(csv != NULL){
+        fp = fopen(csv, "wt");
+        if(fp == NULL){
+            fprintf(stderr, "Nem lehetett megnyitni: %s\n", csv);
+            return 1;
+        }
+        fprintf(fp, "sorszam,kezdet,periodus,nepesseg,hash\n");
+    }
+    Leves_osszesites ossz;
+    int sikeres = leves_kereses(&b, &sz, NULL, fp, &ossz);
+    if(fp != NULL)
+        fclose(fp);
+    if(!sikeres){
+        fprintf(stderr, "Ervenytelen beallitasok (vagy B0 szabaly), elfogyott a memoria, vagy nem indulhattak el a szalak\n");
+        return 2;
+    }
+    printf("%lld leves (%dx%d, %d%%, %dx%d-es tablan), %d szal: %.2f s, %.0f leves/s\n", ossz.db, b.meret, b.meret, b.suruseg,
+           b.tabla, b.tabla, b.szalak, ossz.ido, ossz.ido > 0 ? ossz.db / ossz.ido : 0.0);
+    printf("stabilizalodott: %lld, nem stabilizalodott %d generacio alatt: %lld\n", ossz.db - ossz.nem_stabil, b.max_generacio, ossz.nem_stabil);
+    printf("atlagos stabilizalodas: %.1f generacio, atlagos vegso nepesseg: %.1f\n", (double)ossz.ossz_generacio / ossz.db,
+           (double)ossz.ossz_nepesseg / ossz.db);
+    printf("periodusok:");
+    for(int p = 1; p <= LEVES_ELOZMENY; p++)
+        if(ossz.periodusok[p])
+            printf(" p%d: %lld", p, ossz.periodusok[p]);
+    printf("\n");
+    if(b.nepszamlalas)
+        nepszamlalas_kiir(&ossz.nepszamlalas, stdout);
+    if(ossz.nepszamlalas_hibak > 0){
+        fprintf(stderr, "%lld leves nepszamlalasa elmaradt (elfogyott a memoria)\n", ossz.nepszamlalas_hibak);
+        return 1;
+    }
+    return 0;
+}
+
+int kozos_olvasas(int argc, char *argv[]){
+    if(argc < 3){
+        fprintf(stderr, "Hasznalat: --kozos-olvas </nev> [--ment <fajl>] [--elejetol]\n");
+        return 2;
+    }
+    const char *mentes = NULL;
+    int elejetol = 0;
+    for(int i = 3; i < argc; i++){
+        if(strcmp(argv[i], "--ment") == 0 && i+1 < argc) mentes = argv[++i];
+        else if(strcmp(argv[i], "--elejetol") == 0) elejetol = 1;
+        else{
+            fprintf(stderr, "Ismeretlen opcio: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    Kozos_gyuru gy;
+    if(!kozos_csatlakozik(&gy, argv[2])){
+        fprintf(stderr, "Nem lehetett csatlakozni: %s\n", argv[2]);
+        return 1;
+    }
+    const Kozos_fejlec *f = gy.fejlec;
+    Tabla t;
+    if(!init_tabla(&t, f->sz, f->m)){
+        fprintf(stderr, "Nem lehetett lefoglalni a %ux%u tablat\n", f->sz, f->m);
+        kozos_lecsatlakozik(&gy);
+        return 1;
+    }
+    memset(t.g, 0, (size_t)t.m * t.lepes);
+    memset(t.kov, 0, (size_t)t.m * t.lepes);
+    Kozos_keret k;
+    memset(&k, 0, sizeof(k));
+    // Alapból a legutóbbi kerettől követ; a régebbiek közül a még meglévőktől, ha --elejetol
+    uint32_t kovetkezo = f->kozzetett + 1;
+    if(elejetol)
+        kovetkezo = f->kozzetett >= f->rekeszek ? f->kozzetett - f->rekeszek + 1 : 1;
+    else if(f->kozzetett > 0)
+        kovetkezo = f->kozzetett;
+    long long beolvasott = 0, kimaradt = 0;
+    Uint64 kezdet = SDL_GetPerformanceCounter();
+    while(1){
+        int vege = f->lezarva;
+        SDL_MemoryBarrierAcquire();
+        uint32_t kozzetett = f->kozzetett;
+        if((int32_t)(kozzetett - kovetkezo) < 0){
+            if(vege)
+                break;
+            SDL_Delay(1);
+            continue;
+        }
+        // Ami már biztosan felülíródott, azt meg sem próbálja
+        if(kozzetett - kovetkezo >= f->rekeszek){
+            kimaradt += kozzetett - kovetkezo - f->rekeszek + 1;
+            kovetkezo = kozzetett - f->rekeszek + 1;
+        }
+        if(kozos_olvas(&gy, kovetkezo, &t, &k))
+            beolvasott++;
+        else
+            kimaradt++;
+        kovetkezo++;
+    }
+    double ido = (double)(SDL_GetPerformanceCounter() - kezdet) / (double)SDL_GetPerformanceFrequency();
+    printf("%ux%u tabla, %lld keret beolvasva, %lld kimaradt, %.2f s\n", f->sz, f->m, beolvasott, kimaradt, ido);
+    int hiba = 0;
+    if(beolvasott > 0){
+        printf("utolso keret: generacio: %lld, nepesseg: %llu, hash: %016llx\n", (long long)k.generacio,
+               (unsigned long long)k.nepesseg, (unsigned long long)k.hash);
+        if(mentes != NULL && !tabla_ment(mentes, &t))
+            hiba = 1;
+    }
+    destroy_tabla(&t);
+    kozos_lecsatlakozik(&gy);
+    return hiba;
+}
+
+int kliens_mod(int argc, char *argv[]){
+    if(argc != 3){
+        fprintf(stderr, "Hasznalat: --kliens <tcp:port|unix:utvonal>   (a parancsok a standard bemenetrol)\n");
+        return 2;
+    }
+    Kliens_eredmeny e;
+    int sikeres = kliens_futtat(argv[2], stdin, stdout, &e);
+    if(!sikeres && e.deltak == 0 && e.kulcsok == 0 && e.szerver_generacio == 0){
+        fprintf(stderr, "Nem lehetett kapcsolodni: %s\n", argv[2]);
+        return 1;
+    }
+    printf("kliens: %lld valtozas, %lld kulcskepkocka, %lld elutasitott parancs\n", e.deltak, e.kulcsok, e.elutasitott);
+    if(e.generacio >= 0)
+        printf("tukor: generacio: %lld, hash: %016llx, %s\n", e.generacio, (unsigned long long)e.hash,
+               e.hibak ? "HIBA: eltert a szerveretol" : "egyezett a szerverevel");
+    return !sikeres || e.hibak != 0;
+}
+
+int parancssor_futtat(int argc, char *argv[]){
+    if(argc < 2)
+        return -1;
+    int eredmeny = -1;
+    if(strcmp(argv[1], "--ellenorzes") == 0){
+        eredmeny = ellenorzes_futtat(stdout) ? 1 : 0;
+    }
+    else if(strcmp(argv[1], "--arany") == 0){
+        ellenorzes_arany_general(stdout);
+        eredmeny = 0;
+    }
+    else if(strcmp(argv[1], "--futtat") == 0 || strcmp(argv[1], "--folytat") == 0){
+        eredmeny = kotegelt_futtatas(argc, argv);
+    }
+    else if(strcmp(argv[1], "--elosztott") == 0){
+        eredmeny = elosztott_futtatas(argc, argv);
+    }
+    else if(strcmp(argv[1], "--osszemer") == 0){
+        eredmeny = motorok_osszemerese(argc, argv);
+    }
+    else if(strcmp(argv[1], "--leves") == 0){
+        eredmeny = leves_futtatas(argc, argv);
+    }
+    else if(strcmp(argv[1], "--kozos-olvas") == 0){
+        eredmeny = kozos_olvasas(argc, argv);
+    }
+    else if(strcmp(argv[1], "--szerver") == 0){
+        if(argc < 3 || argc > 4){
+            fprintf(stderr, "Hasznalat: --szerver <tcp:port|unix:utvonal> [fajl]\n");
+            eredmeny = 2;
+        }
+        else{
+            eredmeny = szerver_futtat(argv[2], argc == 4 ? argv[3] : NULL) ? 0 : 1;
+        }
+    }
+    else if(strcmp(argv[1], "--kliens") == 0){
+        eredmeny = kliens_mod(argc, argv);
+    }
+    if(eredmeny >= 0){
+        valtozasok_pool_torol();
+        ltl_torol();
+    }
+    return eredmeny;
+}
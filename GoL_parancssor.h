@@ -0,0 +1,58 @@
+/**
+ * @file GoL_parancssor.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A grafikus felület nélküli, parancssori módok (ellenőrzés, kötegelt futtatás).
+ * @version 0.1
+ * @date 2021-11-27
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_PARANCSSOR_H
+#define GOL_PARANCSSOR_H
+
+/**
+ * @brief Ha a paraméterek valamelyik parancssori módot kérik, lefuttatja azt.
+ * Módok:
+ *  --ellenorzes                 önteszt az arany értékekkel
+ *  --arany                      az arany értékek újragenerálása
+ *  --futtat <fajl> <N> [--megall|--ugras] [--ment <fajl>] [--csv <fajl>] [--blokk <k>] [--motor <nev>] [--szabaly <szabaly>]
+ *                    [--szomszedsag <moore|neumann|hatszog>] [--torusz]
+ *                    [--mentespont <fajl> [--mp-generacio <N>] [--mp-ido <mp>]]
+ *                    [--felvetel <png|gif|nyers> <cel> [--cellameret <N>] [--felvetel-var]] [--nepszamlalas]
+ *                    [--kozos </nev> [--kozos-rekeszek <N>]]
+ *                               a mentés futtatása az N. generációig, ciklusfelismeréssel és statisztikával,
+ *                               kérésre automatikus mentéspontokkal (alapból 100000 generációnként vagy 300 másodpercenként)
+ *                               és minden generáció felvételével (cellánként NxN pixel, lásd GoL_felvetel.h); a felvétel alapból
+ *                               eldobja a képkockát, ha a kódoló lemaradt, --felvetel-var esetén inkább a szimuláció vár;
+ *                               a szabály B/S, Generations vagy Larger than Life alakú (lásd GoL_ltl.h), a mentéspont csak B/S-sel megy;
+ *                               B/S szabálynál a szomszédság és a perem is választható (lásd GoL_kernel.h);
+ *                               --nepszamlalas esetén a végén a tábla objektumait is megszámolja (lásd GoL_nepszamlalas.h);
+ *                               --kozos esetén minden generációt közzétesz egy osztott memóriás gyűrűben (lásd GoL_kozos.h)
+ *  --folytat <mentespont> <N> [opciók]
+ *                               egy mentéspont folytatása az N. generációig (az opciók a --futtat-éi)
+ *  --elosztott <fajl> <N> <P> [--ment <fajl>] [--szabaly <B../S..>]
+ *                               a mentés N generációs futtatása P munkás folyamatra osztva (csak POSIX)
+ *  --osszemer <fajl> <N>        a motorok sebességének összemérése a mentés N generációs futtatásán
+ *  --leves <N> [--tabla <meret>] [--meret <meret>] [--suruseg <szazalek>] [--mag <szam>] [--szalak <P>]
+ *              [--kotet <db>] [--max-generacio <N>] [--szabaly <B../S..>] [--csv <fajl>] [--nepszamlalas]
+ *                               N véletlen leves futtatása a stabilizálódásig, minden processzormagon (lásd GoL_leves.h),
+ *                               alapból 16x16-os, 50%-os levesek 256x256-os táblán; kiírja a leves/s sebességet és a végállapotok összesítését,
+ *                               --nepszamlalas esetén a végállapotok objektumainak népszámlálását is
+ *  --kozos-olvas </nev> [--ment <fajl>] [--elejetol]
+ *                               egy --kozos-szel futó szimuláció kereteinek követése a közzétevő végéig (csak POSIX);
+ *                               kiírja a beolvasott és a kimaradt keretek számát, és elmentheti az utolsót
+ *  --szerver <tcp:port|unix:utvonal> [fajl]
+ *                               helyi vezérlő szerver: parancsokra léptet, tölt be, ment, szabályt vált, és a feliratkozott
+ *                               klienseknek generációnként a változásokat küldi (lásd GoL_szerver.h; csak POSIX)
+ *  --kliens <tcp:port|unix:utvonal>
+ *                               tesztkliens: a standard bemenet parancsait küldi, a kapott változásokból tükrözi a táblát,
+ *                               és a végén kiírja, egyezett-e minden generációban a szerverével
+ * @param argc
+ * @param argv
+ * @return -1 ha nincs parancssori mód (indulhat a grafikus felület), különben a program visszatérési értéke
+ */
+int parancssor_futtat(int argc, char *argv[]);
+
+#endif
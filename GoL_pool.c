@@ -0,0 +1,68 @@
+/**
+ * @file GoL_pool.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A pool allokátor megvalósítása.
+ * @version 0.1
+ * @date 2021-11-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "GoL_pool.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+void pool_init(Pool *p, size_t elem_meret, int lap_elemek){
+    // Minden elemnek el kell tudnia tárolni a szabadlista pointerét, és pointerhez igazítottnak kell lennie
+    if(elem_meret < sizeof(void*))
+        elem_meret = sizeof(void*);
+    elem_meret = (elem_meret + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+    p->elem_meret = elem_meret;
+    p->lap_elemek = lap_elemek > 0 ? lap_elemek : 1;
+    p->szabad = NULL;
+    p->lapok = NULL;
+    p->foglalt = 0;
+}
+
+void* pool_foglal(Pool *p){
+    if(p->szabad == NULL){
+        // A fejléc után jönnek az elemek; a fejléc mérete is pointernyi, így az elemek igazítottak maradnak
+        Pool_lap *lap = malloc(sizeof(Pool_lap) + p->elem_meret * p->lap_elemek);
+        if(lap == NULL)
+            return NULL;
+        lap->kov = p->lapok;
+        p->lapok = lap;
+        char *elemek = (char*)(lap + 1);
+        for(int i = p->lap_elemek - 1; i >= 0; i--){
+            void *elem = elemek + i * p->elem_meret;
+            *(void**)elem = p->szabad;
+            p->szabad = elem;
+        }
+    }
+    void *elem = p->szabad;
+    p->szabad = *(void**)elem;
+    p->foglalt++;
+    return elem;
+}
+
+void pool_felszabadit(Pool *p, void *elem){
+    if(elem == NULL)
+        return;
+    *(void**)elem = p->szabad;
+    p->szabad = elem;
+    p->foglalt--;
+}
+
+void pool_torol(Pool *p){
+    while(p->lapok != NULL){
+        Pool_lap *kov = p->lapok->kov;
+        free(p->lapok);
+        p->lapok = kov;
+    }
+    p->szabad = NULL;
+    p->foglalt = 0;
+}
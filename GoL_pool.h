@@ -0,0 +1,72 @@
+/**
+ * @file GoL_pool.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Egyforma méretű objektumok gyors foglalására szolgáló pool (slab) allokátor.
+ * A memóriát nagy lapokban kéri el, a felszabadított elemeket egy szabadlistán tartja, így a foglalás és a
+ * felszabadítás is O(1), és a lapok a pool törléséig újrahasznosulnak.
+ * @warning Nem szálbiztos, szálanként külön pool használandó.
+ * @version 0.1
+ * @date 2021-11-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_POOL_H
+#define GOL_POOL_H
+
+#include <stddef.h>
+
+/**
+ * @brief Egy lefoglalt lap fejléce, a lapok linked listet alkotnak.
+ * @param kov
+ */
+typedef struct Pool_lap{
+    struct Pool_lap *kov;
+}Pool_lap;
+
+/**
+ * @brief A pool állapota.
+ * @param elem_meret Egy elem mérete (legalább egy pointernyi, pointerhez igazítva)
+ * @param lap_elemek Ennyi elem fér egy lapra
+ * @param szabad A szabad elemek listája (az elem első pointere mutat a következőre)
+ * @param lapok A lefoglalt lapok listája
+ * @param foglalt Az épp kiadott elemek száma
+ */
+typedef struct Pool{
+    size_t elem_meret;
+    int lap_elemek;
+    void *szabad;
+    Pool_lap *lapok;
+    long long foglalt;
+}Pool;
+
+/**
+ * @brief Inicializálja a poolt. Memóriát csak az első foglaláskor kér.
+ * @param p
+ * @param elem_meret
+ * @param lap_elemek Egy lapon lévő elemek száma
+ */
+void pool_init(Pool *p, size_t elem_meret, int lap_elemek);
+
+/**
+ * @brief Kiad egy elemet a poolból, ha kell, új lapot foglal.
+ * @param p
+ * @return az elem, NULL ha elfogyott a memória
+ */
+void* pool_foglal(Pool *p);
+
+/**
+ * @brief Visszaad egy elemet a poolba.
+ * @param p
+ * @param elem a pool_foglal által adott elem
+ */
+void pool_felszabadit(Pool *p, void *elem);
+
+/**
+ * @brief Felszabadítja a pool összes lapját. Utána a poolból kiadott elemek érvénytelenek.
+ * @param p
+ */
+void pool_torol(Pool *p);
+
+#endif
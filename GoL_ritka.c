@@ -0,0 +1,521 @@
+/**
+ * @file GoL_ritka.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A csempénként tömörített tábla megvalósítása.
+ * @version 0.1
+ * @date 2021-12-11
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_memoria.h"
+#include "GoL_pool.h"
+#include "GoL_ritka.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief Kibontja a csempét soronkénti bitekre.
+ * @param c
+ * @param sorok ide írja a RITKA_CSEMPE sort
+ */
+static void csempe_kibont(const Ritka_csempe *c, uint64_t *sorok);
+
+/**
+ * @brief A csempe egyetlen sora (a szomszéd csempék széléhez).
+ * @param c
+ * @param sor 0 és RITKA_CSEMPE-1 között
+ */
+static uint64_t csempe_sor(const Ritka_csempe *c, int sor);
+
+/**
+ * @brief A soronkénti bitekből a népességéhez illő formában kódolja a csempét (a régi blokkját nem szabadítja fel).
+ * @param r
+ * @param c
+ * @param sorok RITKA_CSEMPE sor
+ * @return 1 ha sikeres; 0 ha a blokkhoz elfogyott a memória (ekkor a csempe nem változik)
+ */
+static int csempe_kodol(Ritka_tabla *r, Ritka_csempe *c, const uint64_t *sorok);
+
+/**
+ * @brief Visszaadja a csempe blokkját a poolba.
+ * @param r
+ * @param c
+ */
+static void csempe_elenged(Ritka_tabla *r, Ritka_csempe *c);
+
+/**
+ * @brief Egy üres csempe helyére teszi a sorokból kódolt csempét, és frissíti a számlálókat és a hash-t (betöltéskor).
+ * @param r
+ * @param csor A csempesor
+ * @param coszlop A csempe a csempesorban
+ * @param sorok RITKA_CSEMPE sor
+ * @return 1 ha sikeres, 0 ha elfogyott a memória
+ */
+static int csempe_betesz(Ritka_tabla *r, int csor, int coszlop, const uint64_t *sorok);
+
+/**
+ * @brief Változott-e az előző lépésben a csempe vagy valamelyik szomszédja.
+ * @param r
+ * @param csor
+ * @param coszlop
+ */
+static int kornyek_valtozott(const Ritka_tabla *r, int csor, int coszlop);
+
+/**
+ * @brief Egy félbemaradt lépés visszavonása: elengedi az új blokkokat, és visszaállítja a lépés előtti számlálókat.
+ * @param r
+ * @param kesz Az eddig újraszámolt csempék (a kov első kesz eleme)
+ * @param hash A lépés előtti hash
+ * @param tipusok A lépés előtti típusonkénti darabszámok
+ * @param atalakitasok
+ */
+static void lepes_visszavon(Ritka_tabla *r, size_t kesz, uint64_t hash, const long long *tipusok, long long atalakitasok);
+
+/**
+ * @brief A csempesor érvényes (a táblán belüli) sorainak száma.
+ */
+static int csempe_magassag(const Ritka_tabla *r, int csor);
+
+/**
+ * @brief A csempe érvényes (a táblán belüli) oszlopainak bitmaszkja.
+ */
+static uint64_t csempe_maszk(const Ritka_tabla *r, int coszlop);
+
+/**
+ * @brief Egy teljes összeadó 64 cellán egyszerre.
+ * @param a
+ * @param b
+ * @param c
+ * @param osszeg az összeg bitjei
+ * @param atvitel az átvitel bitjei
+ */
+static inline void osszead(uint64_t a, uint64_t b, uint64_t c, uint64_t *osszeg, uint64_t *atvitel);
+
+void csempe_kibont(const Ritka_csempe *c, uint64_t *sorok){
+    switch(c->tipus){
+        case ct_suru:
+            memcpy(sorok, c->adat, RITKA_CSEMPE * sizeof(uint64_t));
+            break;
+        case ct_lista:
+            memset(sorok, 0, RITKA_CSEMPE * sizeof(uint64_t));
+            for(int i = 0; i < c->db; i++){
+                uint16_t hely = ((const uint16_t*)c->adat)[i];
+                sorok[hely / RITKA_CSEMPE] |= 1ULL << (hely % RITKA_CSEMPE);
+            }
+            break;
+        default:
+            memset(sorok, 0, RITKA_CSEMPE * sizeof(uint64_t));
+            break;
+    }
+}
+
+uint64_t csempe_sor(const Ritka_csempe *c, int sor){
+    uint64_t szo = 0;
+    switch(c->tipus){
+        case ct_suru:
+            szo = ((const uint64_t*)c->adat)[sor];
+            break;
+        case ct_lista:
+            for(int i = 0; i < c->db; i++){
+                uint16_t hely = ((const uint16_t*)c->adat)[i];
+                if(hely / RITKA_CSEMPE == sor)
+                    szo |= 1ULL << (hely % RITKA_CSEMPE);
+            }
+            break;
+        default:
+            break;
+    }
+    return szo;
+}
+
+int csempe_kodol(Ritka_tabla *r, Ritka_csempe *c, const uint64_t *sorok){
+    int db = 0;
+    for(int sor = 0; sor < RITKA_CSEMPE; sor++)
+        db += __builtin_popcountll(sorok[sor]);
+    if(db == 0){
+        c->tipus = ct_ures;
+        c->adat = NULL;
+    }
+    else if(db <= RITKA_LISTA){
+        uint16_t *lista = pool_foglal(&r->lista_pool);
+        if(lista == NULL)
+            return 0;
+        int k = 0;
+        for(int sor = 0; sor < RITKA_CSEMPE; sor++)
+            for(uint64_t szo = sorok[sor]; szo != 0; szo &= szo - 1)
+                lista[k++] = (uint16_t)(sor * RITKA_CSEMPE + __builtin_ctzll(szo));
+        c->tipus = ct_lista;
+        c->adat = lista;
+    }
+    else{
+        uint64_t *suru = pool_foglal(&r->suru_pool);
+        if(suru == NULL)
+            return 0;
+        memcpy(suru, sorok, RITKA_CSEMPE * sizeof(uint64_t));
+        c->tipus = ct_suru;
+        c->adat = suru;
+    }
+    c->db = db;
+    c->valtozott = 1;
+    return 1;
+}
+
+void csempe_elenged(Ritka_tabla *r, Ritka_csempe *c){
+    if(c->tipus == ct_lista)
+        pool_felszabadit(&r->lista_pool, c->adat);
+    else if(c->tipus == ct_suru)
+        pool_felszabadit(&r->suru_pool, c->adat);
+    c->tipus = ct_ures;
+    c->adat = NULL;
+    c->db = 0;
+}
+
+int csempe_betesz(Ritka_tabla *r, int csor, int coszlop, const uint64_t *sorok){
+    Ritka_csempe *c = &r->cs[(size_t)csor * r->csz + coszlop];
+    if(!csempe_kodol(r, c, sorok))
+        return 0;
+    if(c->tipus == ct_ures){
+        c->valtozott = 0;
+        return 1;
+    }
+    r->tipusok[ct_ures]--;
+    r->tipusok[c->tipus]++;
+    r->nepesseg += c->db;
+    for(int sor = 0; sor < RITKA_CSEMPE; sor++)
+        for(uint64_t szo = sorok[sor]; szo != 0; szo &= szo - 1)
+            r->hash ^= cella_kulcs(1 + csor * RITKA_CSEMPE + sor, 1 + coszlop * RITKA_CSEMPE + __builtin_ctzll(szo));
+    return 1;
+}
+
+int kornyek_valtozott(const Ritka_tabla *r, int csor, int coszlop){
+    for(int i = csor - 1; i <= csor + 1; i++){
+        if(i < 0 || i >= r->cm)
+            continue;
+        for(int j = coszlop - 1; j <= coszlop + 1; j++)
+            if(j >= 0 && j < r->csz && r->cs[(size_t)i * r->csz + j].valtozott)
+                return 1;
+    }
+    return 0;
+}
+
+void lepes_visszavon(Ritka_tabla *r, size_t kesz, uint64_t hash, const long long *tipusok, long long atalakitasok){
+    for(size_t hely = 0; hely < kesz; hely++)
+        if(r->kov[hely].adat != NULL && r->kov[hely].adat != r->cs[hely].adat)
+            csempe_elenged(r, &r->kov[hely]);
+    r->hash = hash;
+    memcpy(r->tipusok, tipusok, sizeof(r->tipusok));
+    r->atalakitasok = atalakitasok;
+}
+
+int csempe_magassag(const Ritka_tabla *r, int csor){
+    int maradek = r->m - 2 - csor * RITKA_CSEMPE;
+    return maradek < RITKA_CSEMPE ? maradek : RITKA_CSEMPE;
+}
+
+uint64_t csempe_maszk(const Ritka_tabla *r, int coszlop){
+    int maradek = r->sz - 2 - coszlop * RITKA_CSEMPE;
+    return maradek < RITKA_CSEMPE ? (1ULL << maradek) - 1 : ~0ULL;
+}
+
+void osszead(uint64_t a, uint64_t b, uint64_t c, uint64_t *osszeg, uint64_t *atvitel){
+    uint64_t ab = a ^ b;
+    *osszeg = ab ^ c;
+    *atvitel = (a & b) | (ab & c);
+}
+
+size_t ritka_memoria_becsles(long long szelesseg, long long magassag){
+    if(szelesseg < 1 || magassag < 1 || szelesseg > TABLA_MAX_OLDAL || magassag > TABLA_MAX_OLDAL)
+        return 0;
+    // Legfeljebb 2^22 x 2^22 csempe, a szorzat 64 biten nem csordul túl
+    uint64_t csempek = (uint64_t)((szelesseg + RITKA_CSEMPE - 1) / RITKA_CSEMPE) * ((magassag + RITKA_CSEMPE - 1) / RITKA_CSEMPE);
+    uint64_t becsles = 2 * csempek * sizeof(Ritka_csempe);
+    if(becsles > SIZE_MAX / 2)
+        return 0;
+    return (size_t)becsles;
+}
+
+int ritka_init(Ritka_tabla *r, int szelesseg, int magassag){
+    memset(r, 0, sizeof(Ritka_tabla));
+    size_t becsles = ritka_memoria_becsles(szelesseg, magassag), fizikai = memoria_fizikai();
+    if(becsles == 0 || (fizikai != 0 && becsles / TABLA_MEMORIA_SZAZALEK > fizikai / 100))
+        return 0;
+    r->sz = szelesseg + 2;
+    r->m = magassag + 2;
+    r->csz = (szelesseg + RITKA_CSEMPE - 1) / RITKA_CSEMPE;
+    r->cm = (magassag + RITKA_CSEMPE - 1) / RITKA_CSEMPE;
+    pool_init(&r->lista_pool, RITKA_LISTA * sizeof(uint16_t), 1024);
+    pool_init(&r->suru_pool, RITKA_CSEMPE * sizeof(uint64_t), 128);
+    // A nullázott leíró üres, változatlan csempe
+    r->cs = memoria_foglal(becsles / 2);
+    r->kov = memoria_foglal(becsles / 2);
+    if(r->cs == NULL || r->kov == NULL){
+        ritka_torol(r);
+        return 0;
+    }
+    r->tipusok[ct_ures] = (long long)r->csz * r->cm;
+    return 1;
+}
+
+void ritka_torol(Ritka_tabla *r){
+    pool_torol(&r->lista_pool);
+    pool_torol(&r->suru_pool);
+    memoria_felszabadit(r->cs);
+    memoria_felszabadit(r->kov);
+    r->cs = NULL;
+    r->kov = NULL;
+}
+
+int ritka_cella(const Ritka_tabla *r, int sor, int oszlop){
+    int csor = (sor - 1) / RITKA_CSEMPE, coszlop = (oszlop - 1) / RITKA_CSEMPE;
+    const Ritka_csempe *c = &r->cs[(size_t)csor * r->csz + coszlop];
+    return (int)((csempe_sor(c, (sor - 1) % RITKA_CSEMPE) >> ((oszlop - 1) % RITKA_CSEMPE)) & 1);
+}
+
+size_t ritka_memoria(const Ritka_tabla *r){
+    return 2 * (size_t)r->csz * r->cm * sizeof(Ritka_csempe) + (size_t)r->lista_pool.foglalt * r->lista_pool.elem_meret +
+           (size_t)r->suru_pool.foglalt * r->suru_pool.elem_meret;
+}
+
+int ritka_tablabol(Ritka_tabla *r, const Tabla *t){
+    if(t->eltolas_sor != 0 || t->eltolas_oszlop != 0 || !ritka_init(r, t->sz - 2, t->m - 2))
+        return 0;
+    uint64_t sorok[RITKA_CSEMPE];
+    for(int i = 0; i < r->cm; i++){
+        int magassag = csempe_magassag(r, i);
+        for(int j = 0; j < r->csz; j++){
+            int szelesseg = r->sz - 2 - j * RITKA_CSEMPE < RITKA_CSEMPE ? r->sz - 2 - j * RITKA_CSEMPE : RITKA_CSEMPE;
+            memset(sorok, 0, sizeof(sorok));
+            for(int sor = 0; sor < magassag; sor++){
+                const Cella *forras = &CELLA(t, 1 + i * RITKA_CSEMPE + sor, 1 + j * RITKA_CSEMPE);
+                for(int oszlop = 0; oszlop < szelesseg; oszlop++){
+                    if(forras[oszlop] > 1){
+                        ritka_torol(r);
+                        return 0;
+                    }
+                    sorok[sor] |= (uint64_t)forras[oszlop] << oszlop;
+                }
+            }
+            if(!csempe_betesz(r, i, j, sorok)){
+                ritka_torol(r);
+                return 0;
+            }
+        }
+    }
+    r->generacio = t->generacio;
+    return 1;
+}
+
+int ritka_tablaba(const Ritka_tabla *r, Tabla *t){
+    if(!init_tabla(t, r->sz - 2, r->m - 2))
+        return 0;
+    uint64_t sorok[RITKA_CSEMPE];
+    for(int i = 0; i < r->cm; i++){
+        int magassag = csempe_magassag(r, i);
+        for(int j = 0; j < r->csz; j++){
+            const Ritka_csempe *c = &r->cs[(size_t)i * r->csz + j];
+            if(c->tipus == ct_ures)
+                continue;
+            csempe_kibont(c, sorok);
+            for(int sor = 0; sor < magassag; sor++)
+                for(uint64_t szo = sorok[sor]; szo != 0; szo &= szo - 1)
+                    CELLA(t, 1 + i * RITKA_CSEMPE + sor, 1 + j * RITKA_CSEMPE + __builtin_ctzll(szo)) = 1;
+        }
+    }
+    t->hash = r->hash;
+    t->generacio = r->generacio;
+    return 1;
+}
+
+int ritka_betolt(const char *fajlnev, Ritka_tabla *r){
+    FILE* fp = fopen(fajlnev, "rt");
+    if(fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+
+    char v[4];
+    if (fscanf(fp, "%3[^\n]", v) != 1 || strcmp(v, "0.1")) {fclose(fp); return 0;}
+    long long szel, mag;
+    if (fscanf(fp, " %lld%lld", &szel, &mag) != 2 || szel < 3 || mag < 3) {fclose(fp); return 0;}
+    if (ritka_memoria_becsles(szel-2, mag-2) == 0 || !ritka_init(r, (int)szel-2, (int)mag-2)) {
+        SDL_Log("%s: ervenytelen meret, vagy a %lldx%lld tabla csempeleiroi sem fernek el\n", fajlnev, szel-2, mag-2);
+        fclose(fp);
+        return 0;
+    }
+
+    // Egy csempesor bitjei: a j. csempe sorai a sav[j * RITKA_CSEMPE]-tól
+    uint64_t *sav = calloc((size_t)r->csz * RITKA_CSEMPE, sizeof(uint64_t));
+    int jo = sav != NULL, elfogyott = sav == NULL;
+    for (int sor = 0; sor < r->m && jo; sor++) {
+        for (int oszlop = 0; oszlop < r->sz && jo; oszlop++) {
+            int c;
+            if (fscanf(fp, "%d", &c) != 1 || c < 0 || c > 1)
+                jo = 0;
+            else if (c == 1 && (sor == 0 || oszlop == 0 || sor == r->m-1 || oszlop == r->sz-1))
+                jo = 0;
+            else if (c == 1)
+                sav[(size_t)(oszlop-1) / RITKA_CSEMPE * RITKA_CSEMPE + (sor-1) % RITKA_CSEMPE] |= 1ULL << ((oszlop-1) % RITKA_CSEMPE);
+        }
+        // A csempesor utolsó sora után a sáv csempékre bomlik
+        if (jo && sor >= 1 && sor <= r->m-2 && ((sor-1) % RITKA_CSEMPE == RITKA_CSEMPE-1 || sor == r->m-2)) {
+            for (int j = 0; j < r->csz && jo; j++)
+                jo = csempe_betesz(r, (sor-1) / RITKA_CSEMPE, j, sav + (size_t)j * RITKA_CSEMPE);
+            elfogyott = !jo;
+            memset(sav, 0, (size_t)r->csz * RITKA_CSEMPE * sizeof(uint64_t));
+        }
+    }
+    free(sav);
+    fclose(fp);
+    if (elfogyott)
+        SDL_Log("%s: a tabla csempei nem fernek a memoriaba\n", fajlnev);
+    else if (!jo)
+        SDL_Log("%s: hibas, nem ket allapotu, vagy a szegelyen elo cellat tartalmazo tabla\n", fajlnev);
+    if (!jo)
+        ritka_torol(r);
+    return jo;
+}
+
+int ritka_ment(const char *fajlnev, const Ritka_tabla *r){
+    FILE* fp = fopen(fajlnev, "wt");
+    if(fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+    uint64_t *sav = malloc((size_t)r->csz * RITKA_CSEMPE * sizeof(uint64_t));
+    if(sav == NULL){
+        fclose(fp);
+        return 0;
+    }
+    fprintf(fp, "0.1\n");
+    fprintf(fp, "%d %d\n", r->sz, r->m);
+    for(int sor = 0; sor < r->m; sor++){
+        if(sor >= 1 && sor <= r->m - 2 && (sor - 1) % RITKA_CSEMPE == 0)
+            for(int j = 0; j < r->csz; j++)
+                csempe_kibont(&r->cs[(size_t)((sor - 1) / RITKA_CSEMPE) * r->csz + j], sav + (size_t)j * RITKA_CSEMPE);
+        for(int oszlop = 0; oszlop < r->sz; oszlop++){
+            int el = 0;
+            if(sor >= 1 && sor <= r->m - 2 && oszlop >= 1 && oszlop <= r->sz - 2)
+                el = (int)((sav[(size_t)(oszlop - 1) / RITKA_CSEMPE * RITKA_CSEMPE + (sor - 1) % RITKA_CSEMPE] >> ((oszlop - 1) % RITKA_CSEMPE)) & 1);
+            fputc('0' + el, fp);
+            if(oszlop != r->sz - 1)
+                fputc(' ', fp);
+        }
+        fputc('\n', fp);
+    }
+    free(sav);
+    int hiba = ferror(fp);
+    fclose(fp);
+    return !hiba;
+}
+
+int ritka_szabaly_jo(const Szabaly *sz){
+    return !(sz->szuletes & 1);
+}
+
+long long ritka_lepes(Ritka_tabla *r, const Szabaly *sz){
+    uint64_t bal[RITKA_CSEMPE + 2], kozep[RITKA_CSEMPE + 2], jobb[RITKA_CSEMPE + 2], uj[RITKA_CSEMPE];
+    long long szuletes = 0, halalozas = 0;
+    // Ha egy csempe blokkja nem foglalható le, a lépés ezekre áll vissza
+    uint64_t hash = r->hash;
+    long long tipusok[3], atalakitasok = r->atalakitasok;
+    memcpy(tipusok, r->tipusok, sizeof(tipusok));
+    for(int i = 0; i < r->cm; i++){
+        int magassag = csempe_magassag(r, i);
+        for(int j = 0; j < r->csz; j++){
+            size_t hely = (size_t)i * r->csz + j;
+            const Ritka_csempe *regi = &r->cs[hely];
+            Ritka_csempe *ujcs = &r->kov[hely];
+            // A csempe a régi blokkján marad; ha mégis változik, a blokkot csak a teljes lépés után lehet elengedni
+            *ujcs = *regi;
+            ujcs->valtozott = 0;
+            if(!kornyek_valtozott(r, i, j))
+                continue;
+
+            // Három csempeoszlop, a csempe feletti és alatti szomszéd sorral együtt
+            uint64_t *oszlopok[3] = {bal, kozep, jobb};
+            for(int k = 0; k < 3; k++){
+                int cj = j - 1 + k;
+                if(cj < 0 || cj >= r->csz){
+                    memset(oszlopok[k], 0, sizeof(kozep));
+                    continue;
+                }
+                oszlopok[k][0] = i > 0 ? csempe_sor(&r->cs[hely - r->csz - 1 + k], RITKA_CSEMPE - 1) : 0;
+                csempe_kibont(&r->cs[hely - 1 + k], oszlopok[k] + 1);
+                oszlopok[k][RITKA_CSEMPE + 1] = i < r->cm - 1 ? csempe_sor(&r->cs[hely + r->csz - 1 + k], 0) : 0;
+            }
+
+            uint64_t maszk = csempe_maszk(r, j), valtozas = 0;
+            memset(uj, 0, sizeof(uj));
+            for(int sor = 1; sor <= magassag; sor++){
+                // A nyolc szomszéd: a bit balra tolva a bal, jobbra tolva a jobb szomszédot adja (a szomszéd csempe szélével)
+                uint64_t n[8];
+                for(int d = -1, k = 0; d <= 1; d++){
+                    uint64_t s = kozep[sor + d];
+                    n[k++] = (s << 1) | (bal[sor + d] >> 63);
+                    n[k++] = (s >> 1) | (jobb[sor + d] << 63);
+                    if(d != 0)
+                        n[k++] = s;
+                }
+                // Bitenkénti összeadás: a szomszédok száma 64 cellára egyszerre, négy bitsíkban
+                uint64_t s1, k1, s2, k2, b0, c1, t0, t1;
+                osszead(n[0], n[1], n[2], &s1, &k1);
+                osszead(n[3], n[4], n[5], &s2, &k2);
+                osszead(s1, s2, n[6] ^ n[7], &b0, &c1);
+                osszead(k1, k2, n[6] & n[7], &t0, &t1);
+                uint64_t b1 = t0 ^ c1, negyes = t0 & c1;
+                uint64_t b2 = t1 ^ negyes, b3 = t1 & negyes;
+
+                uint64_t el = kozep[sor], kov = 0;
+                for(int db = 1; db <= 8; db++){
+                    int szul = (sz->szuletes >> db) & 1, tul = (sz->tuleles >> db) & 1;
+                    if(!szul && !tul)
+                        continue;
+                    uint64_t pont = (db & 1 ? b0 : ~b0) & (db & 2 ? b1 : ~b1) & (db & 4 ? b2 : ~b2) & (db & 8 ? b3 : ~b3);
+                    kov |= pont & ((tul ? el : 0) | (szul ? ~el : 0));
+                }
+                // A szabályban B0 nincs, így 0 szomszéddal csak a túlélés számít
+                if(sz->tuleles & 1)
+                    kov |= el & ~(b0 | b1 | b2 | b3);
+                kov &= maszk;
+                uj[sor - 1] = kov;
+
+                uint64_t kulonbseg = kov ^ el;
+                valtozas |= kulonbseg;
+                szuletes += __builtin_popcountll(kulonbseg & kov);
+                halalozas += __builtin_popcountll(kulonbseg & el);
+                for(; kulonbseg != 0; kulonbseg &= kulonbseg - 1)
+                    r->hash ^= cella_kulcs(i * RITKA_CSEMPE + sor, 1 + j * RITKA_CSEMPE + __builtin_ctzll(kulonbseg));
+            }
+            if(valtozas == 0)
+                continue;
+            if(!csempe_kodol(r, ujcs, uj)){
+                lepes_visszavon(r, hely, hash, tipusok, atalakitasok);
+                return -1;
+            }
+            r->tipusok[regi->tipus]--;
+            r->tipusok[ujcs->tipus]++;
+            if(regi->tipus != ujcs->tipus)
+                r->atalakitasok++;
+        }
+    }
+    // A megváltozott csempék régi blokkjai már nem kellenek
+    for(size_t hely = 0; hely < (size_t)r->csz * r->cm; hely++)
+        if(r->cs[hely].adat != NULL && r->cs[hely].adat != r->kov[hely].adat)
+            csempe_elenged(r, &r->cs[hely]);
+    Ritka_csempe *csere = r->cs;
+    r->cs = r->kov;
+    r->kov = csere;
+    r->generacio++;
+    r->nepesseg += szuletes - halalozas;
+    r->szuletes = szuletes;
+    r->halalozas = halalozas;
+    return szuletes + halalozas;
+}
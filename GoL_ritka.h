@@ -0,0 +1,177 @@
+/**
+ * @file GoL_ritka.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Csempénként tömörített tábla ritka (nagyrészt halott) mintákhoz.
+ * A tábla RITKA_CSEMPE x RITKA_CSEMPE cellás csempékből áll, és minden csempe a tartalmához illő formában tárolódik:
+ *  ct_ures   a csupa halott csempe, nem foglal helyet (csak a csempe leírója)
+ *  ct_lista  legfeljebb RITKA_LISTA élő cella koordinátái (sor * RITKA_CSEMPE + oszlop, 16 biten)
+ *  ct_suru   a csempe bitekbe csomagolva, soronként egy 64 bites szó
+ * A lista- és a sűrű blokkok egy-egy poolból jönnek. A lépés minden újraszámolt csempét a népessége szerint újra
+ * kódol, így a csempék maguktól váltanak formát, ahogy nő vagy csökken bennük az élet.
+ * A lépés csak azokat a csempéket számolja újra, amelyeknek az előző lépésben változott ő maga vagy egy szomszédja;
+ * egy csendélet vagy üres terület csempéjén így nincs munka. A csempe egy sorát egyszerre, bitpárhuzamosan lépteti.
+ * Csak két állapotú B/S szabályt tud, Moore szomszédsággal, halott peremmel, és B0 nélkül (az üres csempe üres marad).
+ * A cellák koordinátái és a hash a Tabla-éval egyeznek (a szegéllyel együtt számolva, eltolás nélkül).
+ * @version 0.1
+ * @date 2021-12-11
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_RITKA_H
+#define GOL_RITKA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "GoL_logics.h"
+#include "GoL_pool.h"
+
+/** Egy csempe oldalhossza cellában (egy csempesor egy 64 bites szó) */
+#define RITKA_CSEMPE 64
+/** Legfeljebb ennyi élő cellájú csempe tárolódik koordinátalistaként (egy listablokk 64 bájt) */
+#define RITKA_LISTA 32
+
+/**
+ * @brief Egy csempe tárolási formája.
+ */
+typedef enum Csempe_tipus{
+    ct_ures, ct_lista, ct_suru
+}Csempe_tipus;
+
+/**
+ * @brief Egy csempe leírója.
+ * @param tipus Csempe_tipus
+ * @param valtozott 1 ha a csempe az előző lépésben változott (ilyenkor ő és a szomszédai újraszámolandók)
+ * @param db Az élő cellák száma
+ * @param adat ct_lista esetén RITKA_LISTA darab uint16_t, ct_suru esetén RITKA_CSEMPE darab uint64_t, különben NULL
+ */
+typedef struct Ritka_csempe{
+    uint8_t tipus;
+    uint8_t valtozott;
+    uint16_t db;
+    void *adat;
+}Ritka_csempe;
+
+/**
+ * @brief A csempénként tömörített tábla.
+ * @param sz A szélesség a szegéllyel együtt (mint a Tabla-nál)
+ * @param m A magasság a szegéllyel együtt
+ * @param csz A csempék száma egy csempesorban
+ * @param cm A csempesorok száma
+ * @param cs A csempék, csempesoronként
+ * @param kov A lépés második leírótömbje
+ * @param lista_pool A listablokkok poolja
+ * @param suru_pool A sűrű blokkok poolja
+ * @param hash A cellák Zobrist hash-e, a Tabla hash-ével egyezik
+ * @param generacio
+ * @param nepesseg Az élő cellák száma
+ * @param szuletes Az utolsó lépés születései
+ * @param halalozas Az utolsó lépés halálozásai
+ * @param tipusok A csempék száma típusonként
+ * @param atalakitasok Ennyiszer váltott egy csempe formát (összesen)
+ */
+typedef struct Ritka_tabla{
+    int sz, m;
+    int csz, cm;
+    Ritka_csempe *cs, *kov;
+    Pool lista_pool, suru_pool;
+    uint64_t hash;
+    long long generacio;
+    long long nepesseg;
+    long long szuletes, halalozas;
+    long long tipusok[3];
+    long long atalakitasok;
+}Ritka_tabla;
+
+/**
+ * @brief Megbecsüli egy szelesseg x magassag ritka tábla legkisebb memóriaigényét (a csempeleírókét, üres táblánál).
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @return bájtban, 0 ha a méret érvénytelen
+ */
+size_t ritka_memoria_becsles(long long szelesseg, long long magassag);
+
+/**
+ * @brief Létrehoz egy üres ritka táblát.
+ * @warning A ritka_torol-lel felszabadítandó!!
+ * @param r
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @return 1 ha sikeres; 0 ha a méret érvénytelen, a leírók nem férnek a memóriába, vagy elfogyott a memória
+ */
+int ritka_init(Ritka_tabla *r, int szelesseg, int magassag);
+
+/**
+ * @brief Felszabadítja a ritka táblát.
+ * @param r
+ */
+void ritka_torol(Ritka_tabla *r);
+
+/**
+ * @brief Egy cella állapota.
+ * @param r
+ * @param sor 1 és m-2 között (mint a CELLA-ban)
+ * @param oszlop 1 és sz-2 között
+ * @return 1 ha él
+ */
+int ritka_cella(const Ritka_tabla *r, int sor, int oszlop);
+
+/**
+ * @brief A ritka tábla aktuális memóriafoglalása: a leírók és a kiadott blokkok.
+ * @param r
+ * @return bájtban
+ */
+size_t ritka_memoria(const Ritka_tabla *r);
+
+/**
+ * @brief Létrehozza a tábla ritka változatát.
+ * @warning A ritka_torol-lel felszabadítandó!!
+ * @param r
+ * @param t Két állapotú tábla, eltolás nélkül
+ * @return 1 ha sikeres, 0 ha a tábla nem két állapotú, el van tolva, vagy elfogyott a memória
+ */
+int ritka_tablabol(Ritka_tabla *r, const Tabla *t);
+
+/**
+ * @brief Kicsomagolja a ritka táblát egy új, sűrű táblába.
+ * @warning A destroy_tabla-val felszabadítandó!!
+ * @param r
+ * @param t
+ * @return 1 ha sikeres
+ */
+int ritka_tablaba(const Ritka_tabla *r, Tabla *t);
+
+/**
+ * @brief Betölt egy mentést (a tabla_betolt formátumában) közvetlenül ritka táblába, csempesoronként, így a sűrű tábla
+ * sosem jön létre.
+ * @warning A ritka_torol-lel felszabadítandó!!
+ * @param fajlnev
+ * @param r
+ * @return 1 ha sikeres; 0 ha a fájl hibás, nem két állapotú, a szegélyén élő cella van, vagy nem fér a memóriába
+ */
+int ritka_betolt(const char *fajlnev, Ritka_tabla *r);
+
+/**
+ * @brief Elmenti a ritka táblát a tabla_ment formátumában, csempesoronként.
+ * @param fajlnev
+ * @param r
+ * @return 1 ha sikeres
+ */
+int ritka_ment(const char *fajlnev, const Ritka_tabla *r);
+
+/**
+ * @brief A ritka tábla használható-e a szabállyal (két állapotú, B0 nélküli B/S szabály).
+ * @param sz
+ */
+int ritka_szabaly_jo(const Szabaly *sz);
+
+/**
+ * @brief Egy generációt lép a szabállyal. Frissíti a hash-t, a népességet, a születéseket és a halálozásokat.
+ * @param r
+ * @param sz A ritka_szabaly_jo szerint használható szabály
+ * @return a megváltozott cellák száma; -1 ha egy csempe blokkjához elfogyott a memória (ekkor a tábla nem változik)
+ */
+long long ritka_lepes(Ritka_tabla *r, const Szabaly *sz);
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file GoL_statisztika.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A statisztikák növekményes számolása.
+ * @version 0.1
+ * @date 2021-11-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_statisztika.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief Egy cella élővé válását könyveli (népesség, sor/oszlop számlálók, befoglaló téglalap).
+ */
+static void cella_el(Statisztika *s, int sor, int oszlop);
+
+/**
+ * @brief Egy cella halottá válását könyveli. A befoglaló téglalapot szükség esetén szűkíti.
+ */
+static void cella_hal(Statisztika *s, int sor, int oszlop);
+
+/**
+ * @brief Felveszi a jelen adatait az előzménybe, és ha van, a csv fájlba.
+ */
+static void elozmeny_rogzit(Statisztika *s);
+
+/**
+ * @brief Kiír egy generációt CSV sorként.
+ */
+static void csv_sor(FILE *fp, const Gen_adat *adat);
+
+/**
+ * @brief Kiírja a CSV fejlécét.
+ */
+static void csv_fejlec(FILE *fp);
+
+size_t statisztika_memoria_becsles(long long szelesseg, long long magassag, int elozmeny_meret){
+    if(szelesseg < 1 || magassag < 1)
+        return 0;
+    return (size_t)(szelesseg + magassag + 4) * sizeof(int) + (size_t)(elozmeny_meret > 0 ? elozmeny_meret : 1) * sizeof(Gen_adat);
+}
+
+int statisztika_init(Statisztika *s, Tabla *t, int elozmeny_meret){
+    s->m = t->m;
+    s->sz = t->sz;
+    s->sor_db = calloc(t->m, sizeof(int));
+    s->oszlop_db = calloc(t->sz, sizeof(int));
+    s->elozmeny_meret = elozmeny_meret > 0 ? elozmeny_meret : 1;
+    s->elozmeny = malloc(s->elozmeny_meret * sizeof(Gen_adat));
+    int sikeres = s->sor_db != NULL && s->oszlop_db != NULL && s->elozmeny != NULL;
+    if(!sikeres){
+        // Üres, kikapcsolt statisztika marad: a többi függvény nem csinál rajta semmit
+        statisztika_torol(s);
+        s->elozmeny_meret = 1;
+    }
+    s->elozmeny_kov = 0;
+    s->elozmeny_db = 0;
+    s->csv = NULL;
+    s->ossz_szuletes = 0;
+    s->ossz_halalozas = 0;
+
+    s->jelen.generacio = t->generacio;
+    s->jelen.nepesseg = 0;
+    s->jelen.szuletes = 0;
+    s->jelen.halalozas = 0;
+    s->jelen.min_sor = t->m;
+    s->jelen.min_oszlop = t->sz;
+    s->jelen.max_sor = -1;
+    s->jelen.max_oszlop = -1;
+    if(!sikeres)
+        return 0;
+    for(int sor=1; sor<t->m-1; sor++)
+        for(int oszlop=1; oszlop<t->sz-1; oszlop++)
+            if(CELLA(t, sor, oszlop) == 1)
+                cella_el(s, sor, oszlop);
+    elozmeny_rogzit(s);
+    return 1;
+}
+
+void statisztika_torol(Statisztika *s){
+    free(s->sor_db);
+    free(s->oszlop_db);
+    free(s->elozmeny);
+    s->sor_db = NULL;
+    s->oszlop_db = NULL;
+    s->elozmeny = NULL;
+    s->elozmeny_db = 0;
+}
+
+void cella_el(Statisztika *s, int sor, int oszlop){
+    Gen_adat *j = &s->jelen;
+    j->nepesseg++;
+    s->sor_db[sor]++;
+    s->oszlop_db[oszlop]++;
+    if(sor < j->min_sor) j->min_sor = sor;
+    if(sor > j->max_sor) j->max_sor = sor;
+    if(oszlop < j->min_oszlop) j->min_oszlop = oszlop;
+    if(oszlop > j->max_oszlop) j->max_oszlop = oszlop;
+}
+
+void cella_hal(Statisztika *s, int sor, int oszlop){
+    Gen_adat *j = &s->jelen;
+    j->nepesseg--;
+    s->sor_db[sor]--;
+    s->oszlop_db[oszlop]--;
+    if(j->nepesseg == 0){
+        j->min_sor = s->m;
+        j->min_oszlop = s->sz;
+        j->max_sor = -1;
+        j->max_oszlop = -1;
+        return;
+    }
+    // Csak akkor kell szűkíteni, ha egy szélső sor/oszlop ürült ki; a szűkítés amortizáltan olcsó
+    while(s->sor_db[j->min_sor] == 0) j->min_sor++;
+    while(s->sor_db[j->max_sor] == 0) j->max_sor--;
+    while(s->oszlop_db[j->min_oszlop] == 0) j->min_oszlop++;
+    while(s->oszlop_db[j->max_oszlop] == 0) j->max_oszlop--;
+}
+
+void statisztika_frissit(Statisztika *s, Tabla *t, OszlopSor_Lista_Elem *fej){
+    if(s->sor_db == NULL)
+        return;
+    Gen_adat *j = &s->jelen;
+    j->szuletes = 0;
+    j->halalozas = 0;
+    // Előbb a születések, hogy a szűkítés ne fusson feleslegesen a később visszatöltődő sorokra
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next){
+        if(CELLA(t, iter->sor, iter->oszlop) == 1){
+            cella_el(s, iter->sor, iter->oszlop);
+            j->szuletes++;
+        }
+    }
+    // Több állapotú szabálynál a haldokló cellák öregedése nem halálozás: csak ami az előző állapotban (t->kov) élt
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next){
+        size_t i = (size_t)iter->sor * t->lepes + iter->oszlop;
+        if(t->kov[i] == 1 && t->g[i] != 1){
+            cella_hal(s, iter->sor, iter->oszlop);
+            j->halalozas++;
+        }
+    }
+    j->generacio = t->generacio;
+    s->ossz_szuletes += j->szuletes;
+    s->ossz_halalozas += j->halalozas;
+    elozmeny_rogzit(s);
+}
+
+void statisztika_flip(Statisztika *s, Tabla *t, int sor, int oszlop, Cella regi){
+    if(s->sor_db == NULL)
+        return;
+    if(regi != 1 && CELLA(t, sor, oszlop) == 1)
+        cella_el(s, sor, oszlop);
+    else if(regi == 1 && CELLA(t, sor, oszlop) != 1)
+        cella_hal(s, sor, oszlop);
+    // A kézi módosítás a jelenlegi generáció adatait írja felül, új sort nem vesz fel
+    if(s->elozmeny_db > 0)
+        s->elozmeny[(s->elozmeny_kov + s->elozmeny_meret - 1) % s->elozmeny_meret] = s->jelen;
+}
+
+void elozmeny_rogzit(Statisztika *s){
+    s->elozmeny[s->elozmeny_kov] = s->jelen;
+    s->elozmeny_kov = (s->elozmeny_kov + 1) % s->elozmeny_meret;
+    if(s->elozmeny_db < s->elozmeny_meret)
+        s->elozmeny_db++;
+    if(s->csv != NULL)
+        csv_sor(s->csv, &s->jelen);
+}
+
+void csv_fejlec(FILE *fp){
+    fprintf(fp, "generacio,nepesseg,szuletes,halalozas,min_sor,min_oszlop,max_sor,max_oszlop\n");
+}
+
+void statisztika_csv_folyam(Statisztika *s, FILE *fp){
+    s->csv = fp;
+    if(fp != NULL){
+        csv_fejlec(fp);
+        csv_sor(fp, &s->jelen);
+    }
+}
+
+void csv_sor(FILE *fp, const Gen_adat *adat){
+    if(adat->nepesseg == 0)
+        fprintf(fp, "%lld,0,%lld,%lld,,,,\n", adat->generacio, adat->szuletes, adat->halalozas);
+    else
+        fprintf(fp, "%lld,%lld,%lld,%lld,%d,%d,%d,%d\n", adat->generacio, adat->nepesseg, adat->szuletes, adat->halalozas,
+                adat->min_sor, adat->min_oszlop, adat->max_sor, adat->max_oszlop);
+}
+
+int statisztika_csv(Statisztika *s, const char *fajlnev){
+    FILE *fp = fopen(fajlnev, "wt");
+    if(fp == NULL){
+        SDL_Log("Hiba a %s fajl megnyitasaban!\n", fajlnev);
+        return 0;
+    }
+    csv_fejlec(fp);
+    int elso = (s->elozmeny_db < s->elozmeny_meret) ? 0 : s->elozmeny_kov;
+    for(int i = 0; i < s->elozmeny_db; i++)
+        csv_sor(fp, &s->elozmeny[(elso + i) % s->elozmeny_meret]);
+    fclose(fp);
+    return 1;
+}
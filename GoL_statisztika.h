@@ -0,0 +1,125 @@
+/**
+ * @file GoL_statisztika.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A szimuláció statisztikái (népesség, születések, halálozások, befoglaló téglalap) generációnként.
+ * Az uj_generacio változáslistájából frissül, a tábla újraolvasása nélkül.
+ * @version 0.1
+ * @date 2021-11-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_STATISZTIKA_H
+#define GOL_STATISZTIKA_H
+
+#include <stdio.h>
+#include "GoL_logics.h"
+
+/**
+ * @brief Egy generáció statisztikái.
+ * Üres táblánál a befoglaló téglalap max értékei kisebbek a min értékeinél.
+ * @param generacio
+ * @param nepesseg Az élő cellák száma
+ * @param szuletes Az ebben a generációban született cellák
+ * @param halalozas Az ebben a generációban meghalt cellák
+ * @param min_sor A befoglaló téglalap
+ * @param min_oszlop
+ * @param max_sor
+ * @param max_oszlop
+ */
+typedef struct Gen_adat{
+    long long generacio;
+    long long nepesseg, szuletes, halalozas;
+    int min_sor, min_oszlop, max_sor, max_oszlop;
+}Gen_adat;
+
+/**
+ * @brief A futó statisztika.
+ * @param jelen A legutóbbi generáció adatai
+ * @param ossz_szuletes Az összes születés a statisztika indítása óta
+ * @param ossz_halalozas Az összes halálozás a statisztika indítása óta
+ * @param sor_db Soronként az élő cellák száma (a befoglaló téglalap szűkítéséhez)
+ * @param oszlop_db Oszloponként az élő cellák száma
+ * @param m A tábla magassága (sor_db mérete)
+ * @param sz A tábla szélessége (oszlop_db mérete)
+ * @param elozmeny Az utolsó generációk adatai (gyűrűs puffer)
+ * @param elozmeny_meret Az elozmeny tömb mérete
+ * @param elozmeny_kov A következő beírandó elem indexe
+ * @param elozmeny_db Az érvényes elemek száma
+ * @param csv Ha nem NULL, minden generáció sora ide is kiíródik (hosszú futásokhoz)
+ */
+typedef struct Statisztika{
+    Gen_adat jelen;
+    long long ossz_szuletes, ossz_halalozas;
+    int *sor_db, *oszlop_db;
+    int m, sz;
+    Gen_adat *elozmeny;
+    int elozmeny_meret, elozmeny_kov, elozmeny_db;
+    FILE *csv;
+}Statisztika;
+
+/**
+ * @brief Létrehozza a statisztikát a tábla jelenlegi állapotából (ehhez egyszer végignézi a táblát).
+ * @warning Használat után a statisztika_torol-lel felszabadítandó!!
+ * @param s
+ * @param t
+ * @param elozmeny_meret Ennyi generáció adatait őrzi meg
+ * @return 1 ha sikeres; 0 ha elfogyott a memória, ekkor a statisztika üres és kikapcsolt (a frissítés nem csinál
+ * semmit), de ugyanúgy törölhető
+ */
+int statisztika_init(Statisztika *s, Tabla *t, int elozmeny_meret);
+
+/**
+ * @brief A statisztika_init foglalásának mérete egy szelesseg x magassag táblán.
+ * A tabla_meret_ellenoriz kísérő memóriájába számítandó.
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @param elozmeny_meret
+ * @return bájtban, 0 ha a méret érvénytelen
+ */
+size_t statisztika_memoria_becsles(long long szelesseg, long long magassag, int elozmeny_meret);
+
+/**
+ * @brief Felszabadítja a statisztika memóriáját. A csv fájlt nem zárja be.
+ * @param s
+ */
+void statisztika_torol(Statisztika *s);
+
+/**
+ * @brief Frissíti a statisztikát egy uj_generacio után, a változáslista alapján.
+ * A változások számával arányos időt vesz igénybe.
+ * @param s
+ * @param t A már léptetett tábla (a t->kov az előző állapot, lásd generacio_lezar)
+ * @param fej Az uj_generacio által visszaadott lista
+ */
+void statisztika_frissit(Statisztika *s, Tabla *t, OszlopSor_Lista_Elem *fej);
+
+/**
+ * @brief Frissíti a statisztikát egy kézi cellaváltoztatás (flip) után. Nem számít születésnek/halálozásnak.
+ * Csak az élő (1-es) állapot számít: egy haldokló cella törlése nem változtat a népességen.
+ * @param s
+ * @param t
+ * @param sor
+ * @param oszlop
+ * @param regi A cella flip előtti állapota
+ */
+void statisztika_flip(Statisztika *s, Tabla *t, int sor, int oszlop, Cella regi);
+
+/**
+ * @brief Bekapcsolja a generációnkénti CSV kiírást a megadott fájlba (fejléc és a jelenlegi generáció sora).
+ * Hosszú futásoknál használandó, ahol az előzmény puffere nem elég.
+ * @param s
+ * @param fp Nyitott fájl, a hívó zárja be; NULL esetén kikapcsol
+ */
+void statisztika_csv_folyam(Statisztika *s, FILE *fp);
+
+/**
+ * @brief A megőrzött előzményt CSV fájlba menti.
+ * @param s
+ * @param fajlnev
+ * @return 1 ha sikeres
+ */
+int statisztika_csv(Statisztika *s, const char *fajlnev);
+
+#endif
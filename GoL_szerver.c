@@ -0,0 +1,807 @@
+/**
+ * @file GoL_szerver.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A helyi vezérlő szerver és a tesztkliens megvalósítása.
+ * @version 0.1
+ * @date 2021-12-07
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_motor.h"
+#include "GoL_ltl.h"
+#include "GoL_szerver.h"
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+#ifdef _WIN32
+
+int szerver_futtat(const char *cim, const char *fajl){
+    (void)cim; (void)fajl;
+    fprintf(stderr, "A szerver csak POSIX rendszeren erheto el\n");
+    return 0;
+}
+
+int kliens_futtat(const char *cim, FILE *be, FILE *ki, Kliens_eredmeny *e){
+    (void)cim; (void)be; (void)ki; (void)e;
+    fprintf(stderr, "A kliens csak POSIX rendszeren erheto el\n");
+    return 0;
+}
+
+#else
+
+/**
+ * @brief Egy növekvő kimenő puffer; a kuldott-ig már elment.
+ * Ha a növelés nem sikerül, a régi adat megmarad, a hiba 1 lesz, és a további írások kimaradnak.
+ */
+typedef struct Puffer{
+    char *adat;
+    size_t db, kap, kuldott;
+    int hiba;
+}Puffer;
+
+/**
+ * @brief Egy kapcsolódott kliens.
+ * @param fd -1 ha a hely szabad
+ * @param sor A félig beérkezett parancssor
+ * @param sor_db
+ * @param ki
+ * @param feliratkozott
+ * @param kulcs_kell 1 ha a következő üzenete egy kulcsképkocka (feliratkozás vagy betöltés után)
+ * @param lemaradt 1 ha a puffere túlnőtt a korláton; kiürülése után kulcsképkockát kap
+ * @param zar 1 ha a puffer kiürülése után a kapcsolat lezárandó (ha a puffere nem nőhetett tovább, azonnal bontódik)
+ * @param lep_hatra A lep parancsából még hátralévő lépések; amíg nem 0, a további parancsai nem hajtódnak végre
+ */
+typedef struct Kliens{
+    int fd;
+    char sor[SZERVER_SOR];
+    size_t sor_db;
+    Puffer ki;
+    int feliratkozott, kulcs_kell, lemaradt, zar;
+    long long lep_hatra;
+}Kliens;
+
+/**
+ * @brief A szerver állapota.
+ * @param hallgato
+ * @param kliensek
+ * @param t A szimulált tábla
+ * @param van_tabla
+ * @param fut 1 ha folyamatosan fut
+ * @param sebesseg Generáció másodpercenként, 0 ha korlátlan
+ * @param kovetkezo A következő lépés ideje (SDL_GetPerformanceCounter)
+ * @param leall
+ * @param uzenet A változás-sor és a kulcsképkocka közös munkapuffere
+ * @param lep_kov A következő lépés ennek a kliensnek a lep parancsából jön (ha van), körbejárva
+ */
+typedef struct Szerver{
+    int hallgato;
+    Kliens kliensek[SZERVER_MAX_KLIENS];
+    Tabla t;
+    int van_tabla;
+    int fut;
+    double sebesseg;
+    Uint64 kovetkezo;
+    int leall;
+    Puffer uzenet;
+    int lep_kov;
+}Szerver;
+
+/**
+ * @brief A "tcp:<port>" vagy "unix:<utvonal>" cím socket címmé alakítása.
+ * @return 1 ha érvényes
+ */
+static int cim_felbont(const char *cim, struct sockaddr_storage *sa, socklen_t *hossz);
+
+/**
+ * @brief A puffer végére írja az adatot (ha a puffer nem nőhet tovább, a hibáját állítja be).
+ */
+static void puffer_ir(Puffer *p, const char *adat, size_t meret);
+
+/**
+ * @brief A puffer végére írja a formázott szöveget.
+ */
+static void puffer_printf(Puffer *p, const char *formatum, ...);
+
+/**
+ * @brief Elküldi a kliens pufferéből, amit a socket most elfogad (nem vár).
+ * @return 0 ha a kapcsolat megszakadt
+ */
+static int kliens_kuld(Kliens *k);
+
+/**
+ * @brief Lezárja a kliens kapcsolatát, és felszabadítja a helyét.
+ */
+static void kliens_bont(Kliens *k);
+
+/**
+ * @brief A tábla kulcsképkockája az uzenet pufferbe.
+ */
+static void kulcskep_keszit(Szerver *sz);
+
+/**
+ * @brief Egy generáció léptetése, és a változások elküldése a feliratkozott klienseknek.
+ */
+static void szerver_lep(Szerver *sz);
+
+/**
+ * @brief A kliens által küldött mentésnév fájlútvonallá alakítása: SZERVER_MENTESEK/<nev>.txt.
+ * @return 0 ha a név üres, túl hosszú, vagy '/', '\\' vagy ".." van benne
+ */
+static int mentes_ut(const char *nev, char *ut, size_t meret);
+
+/**
+ * @brief Végrehajtja a kliens egy parancsát, és a válaszát a pufferébe írja (a lep parancsét csak az utolsó lépés után).
+ */
+static void parancs_vegrehajt(Szerver *sz, Kliens *k, char *sor);
+
+/**
+ * @brief A sikeres parancs "OK generacio <g> hash <h>" válasza.
+ */
+static void valasz_ok(Szerver *sz, Kliens *k);
+
+/**
+ * @brief Végrehajtja a kliens beérkezett teljes parancssorait, amíg nincs függőben lévő lep parancsa.
+ */
+static void kliens_sorok(Szerver *sz, Kliens *k);
+
+/**
+ * @brief A lep parancsokból egy lépés, a kliensek között körbejárva; az utolsó lépés után válaszol a kliensnek.
+ * @return 0 ha nem volt függőben lévő lépés
+ */
+static int sorban_lep(Szerver *sz);
+
+/**
+ * @brief A kliens pufferének ürítése, és ha kell, a kulcsképkocka vagy a lezárás.
+ */
+static void kliens_kiszolgal(Szerver *sz, Kliens *k);
+
+/**
+ * @brief Egy beérkezett D vagy K sor alkalmazása a tükrözött táblára.
+ */
+static void tukor_frissit(Tabla *tukor, int *van_tukor, const char *sor, Kliens_eredmeny *e);
+
+/**
+ * @brief A következő teljes sor a socketről (a sort lezáró '\n' nélkül), ha kell, várakozva.
+ * @param fd
+ * @param p A beolvasott, de még fel nem dolgozott adat
+ * @return a sor (a p-ben, a következő hívásig érvényes), NULL ha a kapcsolat lezárult, vagy a sor nem fér a memóriába
+ */
+static char* sor_olvas(int fd, Puffer *p);
+
+int cim_felbont(const char *cim, struct sockaddr_storage *sa, socklen_t *hossz){
+    memset(sa, 0, sizeof(*sa));
+    if(strncmp(cim, "tcp:", 4) == 0){
+        int port = atoi(cim + 4);
+        if(port < 1 || port > 65535)
+            return 0;
+        // Csak helyi kapcsolatokat fogad
+        struct sockaddr_in *in = (struct sockaddr_in*)sa;
+        in->sin_family = AF_INET;
+        in->sin_port = htons((uint16_t)port);
+        in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        *hossz = sizeof(*in);
+        return 1;
+    }
+    if(strncmp(cim, "unix:", 5) == 0){
+        struct sockaddr_un *un = (struct sockaddr_un*)sa;
+        if(strlen(cim + 5) == 0 || strlen(cim + 5) >= sizeof(un->sun_path))
+            return 0;
+        un->sun_family = AF_UNIX;
+        strcpy(un->sun_path, cim + 5);
+        *hossz = sizeof(*un);
+        return 1;
+    }
+    return 0;
+}
+
+void puffer_ir(Puffer *p, const char *adat, size_t meret){
+    if(p->hiba)
+        return;
+    if(p->db + meret > p->kap){
+        size_t uj = p->kap ? p->kap : 4096;
+        while(uj < p->db + meret)
+            uj *= 2;
+        char *uj_adat = realloc(p->adat, uj);
+        if(uj_adat == NULL){
+            p->hiba = 1;
+            return;
+        }
+        p->adat = uj_adat;
+        p->kap = uj;
+    }
+    memcpy(p->adat + p->db, adat, meret);
+    p->db += meret;
+}
+
+void puffer_printf(Puffer *p, const char *formatum, ...){
+    char sor[512];
+    va_list args;
+    va_start(args, formatum);
+    int n = vsnprintf(sor, sizeof(sor), formatum, args);
+    va_end(args);
+    if(n > (int)sizeof(sor) - 1)
+        n = sizeof(sor) - 1;
+    puffer_ir(p, sor, n);
+}
+
+int kliens_kuld(Kliens *k){
+    Puffer *p = &k->ki;
+    while(p->kuldott < p->db){
+        ssize_t n = send(k->fd, p->adat + p->kuldott, p->db - p->kuldott, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return 1;
+        if(n <= 0)
+            return 0;
+        p->kuldott += n;
+    }
+    p->db = p->kuldott = 0;
+    return 1;
+}
+
+void kliens_bont(Kliens *k){
+    close(k->fd);
+    free(k->ki.adat);
+    memset(k, 0, sizeof(*k));
+    k->fd = -1;
+}
+
+void kulcskep_keszit(Szerver *sz){
+    Tabla *t = &sz->t;
+    long long db = 0;
+    for(int sor = 1; sor < t->m - 1; sor++)
+        for(int oszlop = 1; oszlop < t->sz - 1; oszlop++)
+            db += CELLA(t, sor, oszlop) != 0;
+    sz->uzenet.db = 0;
+    sz->uzenet.hiba = 0;
+    puffer_printf(&sz->uzenet, "K %lld %d %d %016llx %lld", t->generacio, t->sz - 2, t->m - 2, (unsigned long long)t->hash, db);
+    for(int sor = 1; sor < t->m - 1; sor++)
+        for(int oszlop = 1; oszlop < t->sz - 1; oszlop++)
+            if(CELLA(t, sor, oszlop))
+                puffer_printf(&sz->uzenet, " %d %d %d", sor, oszlop, CELLA(t, sor, oszlop));
+    puffer_ir(&sz->uzenet, "\n", 1);
+}
+
+void szerver_lep(Szerver *sz){
+    Tabla *t = &sz->t;
+    OszlopSor_Lista_Elem *fej = motor_lepes(t);
+    int van = 0;
+    for(int i = 0; i < SZERVER_MAX_KLIENS; i++){
+        Kliens *k = &sz->kliensek[i];
+        van |= k->fd >= 0 && k->feliratkozott && !k->kulcs_kell && !k->lemaradt && !k->zar;
+    }
+    if(van){
+        // Az üzenet egyszer készül el, és minden feliratkozott kliens pufferébe bemásolódik
+        long long db = 0;
+        for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next)
+            db++;
+        sz->uzenet.db = 0;
+        sz->uzenet.hiba = 0;
+        puffer_printf(&sz->uzenet, "D %lld %016llx %lld", t->generacio, (unsigned long long)t->hash, db);
+        for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next)
+            puffer_printf(&sz->uzenet, " %d %d %d", iter->sor, iter->oszlop, CELLA(t, iter->sor, iter->oszlop));
+        puffer_ir(&sz->uzenet, "\n", 1);
+        for(int i = 0; i < SZERVER_MAX_KLIENS; i++){
+            Kliens *k = &sz->kliensek[i];
+            if(k->fd < 0 || !k->feliratkozott || k->kulcs_kell || k->lemaradt || k->zar)
+                continue;
+            // Ha az üzenet nem fért a memóriába, a kliens lemarad, és később kulcsképkockát kap
+            if(sz->uzenet.hiba)
+                k->lemaradt = 1;
+            else
+                puffer_ir(&k->ki, sz->uzenet.adat, sz->uzenet.db);
+            if(k->ki.db - k->ki.kuldott > SZERVER_KORLAT)
+                k->lemaradt = 1;
+        }
+    }
+    valtozasok_felszabadit(fej);
+}
+
+int mentes_ut(const char *nev, char *ut, size_t meret){
+    if(nev[0] == '\0' || strchr(nev, '/') != NULL || strchr(nev, '\\') != NULL || strstr(nev, "..") != NULL)
+        return 0;
+    int n = snprintf(ut, meret, "%s/%s.txt", SZERVER_MENTESEK, nev);
+    return n > 0 && (size_t)n < meret;
+}
+
+void parancs_vegrehajt(Szerver *sz, Kliens *k, char *sor){
+    char parancs[32] = "", arg[SZERVER_SOR] = "";
+    sscanf(sor, "%31s %1023[^\n]", parancs, arg);
+    int ok = 1;
+    const char *hiba = NULL;
+    char ut[SZERVER_SOR + 32];
+    if(parancs[0] == '\0')
+        return;
+    if(strcmp(parancs, "betolt") == 0){
+        Tabla uj;
+        if(!mentes_ut(arg, ut, sizeof(ut))){
+            hiba = "hibas mentesnev";
+        }
+        else if(tabla_betolt(ut, &uj)){
+            if(sz->van_tabla)
+                destroy_tabla(&sz->t);
+            sz->t = uj;
+            sz->van_tabla = 1;
+            for(int i = 0; i < SZERVER_MAX_KLIENS; i++)
+                sz->kliensek[i].kulcs_kell = sz->kliensek[i].feliratkozott;
+        }
+        else{
+            hiba = "nem lehetett betolteni";
+        }
+    }
+    else if(strcmp(parancs, "szabaly") == 0){
+        Szabaly szabaly;
+        Ltl_szabaly ltl;
+        if(szabaly_beolvas(arg, &szabaly))
+            motor_szabaly(&szabaly);
+        else if(ltl_szabaly_beolvas(arg, &ltl))
+            motor_ltl_szabaly(&ltl);
+        else
+            hiba = "hibas szabaly";
+    }
+    else if(strcmp(parancs, "sebesseg") == 0){
+        double s = atof(arg);
+        if(s < 0)
+            hiba = "a sebesseg nem lehet negativ";
+        else
+            sz->sebesseg = s;
+        sz->kovetkezo = SDL_GetPerformanceCounter();
+    }
+    else if(strcmp(parancs, "feliratkozas") == 0){
+        k->feliratkozott = 1;
+        k->kulcs_kell = 1;
+    }
+    else if(strcmp(parancs, "leiratkozas") == 0){
+        k->feliratkozott = 0;
+    }
+    else if(strcmp(parancs, "kilep") == 0){
+        k->zar = 1;
+    }
+    else if(strcmp(parancs, "leallit") == 0){
+        sz->leall = 1;
+    }
+    else if(!sz->van_tabla && strcmp(parancs, "allapot") != 0){
+        ok = 0;
+    }
+    else if(strcmp(parancs, "lep") == 0){
+        long long n = atoll(arg);
+        if(n < 0)
+            hiba = "a lepesszam nem lehet negativ";
+        else if(n > 0){
+            // A lépések a poll ciklusban, adagonként futnak; a válasz az utolsó után megy
+            k->lep_hatra = n;
+            return;
+        }
+    }
+    else if(strcmp(parancs, "indit") == 0){
+        sz->fut = 1;
+        sz->kovetkezo = SDL_GetPerformanceCounter();
+    }
+    else if(strcmp(parancs, "megallit") == 0){
+        sz->fut = 0;
+    }
+    else if(strcmp(parancs, "ment") == 0){
+        if(!mentes_ut(arg, ut, sizeof(ut)))
+            hiba = "hibas mentesnev";
+        else if(!tabla_ment(ut, &sz->t))
+            hiba = "nem lehetett menteni";
+    }
+    else if(strcmp(parancs, "allapot") != 0){
+        hiba = "ismeretlen parancs";
+    }
+    if(!ok)
+        hiba = "nincs betoltott tabla";
+    if(hiba != NULL){
+        puffer_printf(&k->ki, "HIBA %s\n", hiba);
+        return;
+    }
+    if(strcmp(parancs, "allapot") == 0){
+        long long generacio = sz->van_tabla ? sz->t.generacio : 0;
+        unsigned long long hash = sz->van_tabla ? (unsigned long long)sz->t.hash : 0;
+        char szabaly[LTL_SZABALY_HOSSZ];
+        motor_szabaly_kiir(szabaly);
+        int kliensek = 0;
+        for(int i = 0; i < SZERVER_MAX_KLIENS; i++)
+            kliensek += sz->kliensek[i].fd >= 0;
+        puffer_printf(&k->ki, "OK generacio %lld hash %016llx meret %d %d nepesseg %lld szabaly %s fut %d kliensek %d\n", generacio, hash,
+                      sz->van_tabla ? sz->t.sz - 2 : 0, sz->van_tabla ? sz->t.m - 2 : 0, sz->van_tabla ? tabla_nepesseg(&sz->t) : 0,
+                      szabaly, sz->fut, kliensek);
+    }
+    else{
+        valasz_ok(sz, k);
+    }
+}
+
+void valasz_ok(Szerver *sz, Kliens *k){
+    long long generacio = sz->van_tabla ? sz->t.generacio : 0;
+    unsigned long long hash = sz->van_tabla ? (unsigned long long)sz->t.hash : 0;
+    puffer_printf(&k->ki, "OK generacio %lld hash %016llx\n", generacio, hash);
+}
+
+void kliens_sorok(Szerver *sz, Kliens *k){
+    char *eleje = k->sor, *vege;
+    while(!k->zar && !sz->leall && k->lep_hatra == 0 && (vege = memchr(eleje, '\n', k->sor_db - (eleje - k->sor))) != NULL){
+        *vege = '\0';
+        if(vege > eleje && vege[-1] == '\r')
+            vege[-1] = '\0';
+        parancs_vegrehajt(sz, k, eleje);
+        eleje = vege + 1;
+    }
+    k->sor_db -= eleje - k->sor;
+    memmove(k->sor, eleje, k->sor_db);
+    k->sor[k->sor_db] = '\0';
+}
+
+int sorban_lep(Szerver *sz){
+    for(int i = 0; i < SZERVER_MAX_KLIENS; i++){
+        Kliens *k = &sz->kliensek[(sz->lep_kov + i) % SZERVER_MAX_KLIENS];
+        if(k->fd < 0 || k->lep_hatra == 0)
+            continue;
+        sz->lep_kov = (sz->lep_kov + i + 1) % SZERVER_MAX_KLIENS;
+        szerver_lep(sz);
+        if(--k->lep_hatra == 0){
+            valasz_ok(sz, k);
+            kliens_sorok(sz, k);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+void kliens_kiszolgal(Szerver *sz, Kliens *k){
+    if(k->fd < 0)
+        return;
+    // A puffere nem nőhetett tovább, így a kimenete hiányos lenne
+    if(k->ki.hiba || !kliens_kuld(k)){
+        kliens_bont(k);
+        return;
+    }
+    // Kulcsképkocka: feliratkozás és betöltés után azonnal, lemaradás után a puffer kiürülésekor
+    int ures = k->ki.db == 0;
+    if(k->feliratkozott && sz->van_tabla && ((k->kulcs_kell && !k->lemaradt) || (k->lemaradt && ures))){
+        kulcskep_keszit(sz);
+        if(!sz->uzenet.hiba)
+            puffer_ir(&k->ki, sz->uzenet.adat, sz->uzenet.db);
+        k->kulcs_kell = k->lemaradt = 0;
+        if(sz->uzenet.hiba || k->ki.hiba || !kliens_kuld(k)){
+            kliens_bont(k);
+            return;
+        }
+    }
+    if(k->zar && k->ki.db == 0)
+        kliens_bont(k);
+}
+
+int szerver_futtat(const char *cim, const char *fajl){
+    struct sockaddr_storage sa;
+    socklen_t hossz;
+    if(!cim_felbont(cim, &sa, &hossz)){
+        fprintf(stderr, "Hibas cim: %s (tcp:<port> vagy unix:<utvonal>)\n", cim);
+        return 0;
+    }
+    Szerver *sz = calloc(1, sizeof(Szerver));
+    if(sz == NULL){
+        fprintf(stderr, "Nem lehetett elinditani a szervert: elfogyott a memoria\n");
+        return 0;
+    }
+    for(int i = 0; i < SZERVER_MAX_KLIENS; i++)
+        sz->kliensek[i].fd = -1;
+    if(fajl != NULL){
+        if(!tabla_betolt(fajl, &sz->t)){
+            fprintf(stderr, "Nem lehetett betolteni: %s\n", fajl);
+            free(sz);
+            return 0;
+        }
+        sz->van_tabla = 1;
+    }
+    int unix_socket = sa.ss_family == AF_UNIX;
+    if(unix_socket)
+        unlink(((struct sockaddr_un*)&sa)->sun_path);
+    sz->hallgato = socket(sa.ss_family, SOCK_STREAM, 0);
+    int igen = 1;
+    if(sz->hallgato >= 0 && !unix_socket)
+        setsockopt(sz->hallgato, SOL_SOCKET, SO_REUSEADDR, &igen, sizeof(igen));
+    if(sz->hallgato < 0 || bind(sz->hallgato, (struct sockaddr*)&sa, hossz) != 0 || listen(sz->hallgato, SZERVER_MAX_KLIENS) != 0){
+        fprintf(stderr, "Nem lehetett elinditani a szervert: %s (%s)\n", cim, strerror(errno));
+        if(sz->hallgato >= 0)
+            close(sz->hallgato);
+        if(sz->van_tabla)
+            destroy_tabla(&sz->t);
+        free(sz);
+        return 0;
+    }
+
+    Uint64 frekvencia = SDL_GetPerformanceFrequency();
+    while(!sz->leall){
+        struct pollfd pfd[SZERVER_MAX_KLIENS + 1];
+        pfd[0].fd = sz->hallgato;
+        pfd[0].events = POLLIN;
+        for(int i = 0; i < SZERVER_MAX_KLIENS; i++){
+            Kliens *k = &sz->kliensek[i];
+            pfd[i + 1].fd = k->fd;
+            // Amíg a lep parancsa fut, a további parancsai nem olvasódnak be
+            pfd[i + 1].events = (k->zar || k->lep_hatra > 0 ? 0 : POLLIN) | (k->ki.db > 0 ? POLLOUT : 0);
+            pfd[i + 1].revents = 0;
+        }
+        // Futás közben csak a következő lépés idejéig vár, függőben lévő lep parancsnál egyáltalán nem
+        int varakozas = -1;
+        int van_lep = 0;
+        for(int i = 0; i < SZERVER_MAX_KLIENS; i++)
+            van_lep |= sz->kliensek[i].fd >= 0 && sz->kliensek[i].lep_hatra > 0;
+        if(van_lep)
+            varakozas = 0;
+        else if(sz->fut && sz->van_tabla){
+            Uint64 most = SDL_GetPerformanceCounter();
+            varakozas = (sz->sebesseg <= 0 || most >= sz->kovetkezo) ? 0 : (int)((sz->kovetkezo - most) * 1000 / frekvencia);
+        }
+        if(poll(pfd, SZERVER_MAX_KLIENS + 1, varakozas) < 0 && errno != EINTR)
+            break;
+
+        if(pfd[0].revents & POLLIN){
+            int fd = accept(sz->hallgato, NULL, NULL);
+            int hely = -1;
+            for(int i = 0; i < SZERVER_MAX_KLIENS && hely < 0 && fd >= 0; i++)
+                if(sz->kliensek[i].fd < 0)
+                    hely = i;
+            if(hely < 0){
+                if(fd >= 0)
+                    close(fd);
+            }
+            else{
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                sz->kliensek[hely].fd = fd;
+            }
+        }
+        for(int i = 0; i < SZERVER_MAX_KLIENS && !sz->leall; i++){
+            Kliens *k = &sz->kliensek[i];
+            if(k->fd < 0 || pfd[i + 1].fd != k->fd)
+                continue;
+            // A lep parancsára váró kliens nem olvasódik, de ha közben bontott, a lépései is elmaradnak
+            if(k->lep_hatra > 0){
+                if(pfd[i + 1].revents & (POLLHUP | POLLERR))
+                    kliens_bont(k);
+                continue;
+            }
+            if(!(pfd[i + 1].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            ssize_t n = recv(k->fd, k->sor + k->sor_db, sizeof(k->sor) - 1 - k->sor_db, 0);
+            if(n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+                continue;
+            if(n <= 0){
+                kliens_bont(k);
+                continue;
+            }
+            k->sor_db += n;
+            kliens_sorok(sz, k);
+            if(k->sor_db == sizeof(k->sor) - 1){
+                puffer_printf(&k->ki, "HIBA tul hosszu sor\n");
+                k->zar = 1;
+            }
+        }
+
+        // A lep parancsok lépései egy adagnyi ideig, hogy a többi kliens se várjon sokat
+        if(van_lep && !sz->leall){
+            Uint64 hatar = SDL_GetPerformanceCounter() + frekvencia * SZERVER_LEP_ADAG_MS / 1000;
+            int lepett;
+            do
+                lepett = sorban_lep(sz);
+            while(lepett && !sz->leall && SDL_GetPerformanceCounter() < hatar);
+        }
+        if(sz->fut && sz->van_tabla && !sz->leall){
+            Uint64 most = SDL_GetPerformanceCounter();
+            if(sz->sebesseg <= 0 || most >= sz->kovetkezo){
+                szerver_lep(sz);
+                if(sz->sebesseg > 0){
+                    sz->kovetkezo += (Uint64)(frekvencia / sz->sebesseg);
+                    // Ha nagyon lemaradt (pl. lassú lépés), nem próbálja behozni
+                    if(sz->kovetkezo + frekvencia < most)
+                        sz->kovetkezo = most;
+                }
+            }
+        }
+        for(int i = 0; i < SZERVER_MAX_KLIENS; i++)
+            kliens_kiszolgal(sz, &sz->kliensek[i]);
+    }
+
+    // A leállítás előtt a válaszokat még elküldi (legfeljebb egy másodpercig vár a kliensekre)
+    for(int i = 0; i < SZERVER_MAX_KLIENS; i++){
+        Kliens *k = &sz->kliensek[i];
+        for(int j = 0; j < 100 && k->fd >= 0 && !k->ki.hiba && k->ki.db > 0; j++){
+            if(!kliens_kuld(k))
+                break;
+            if(k->ki.db > 0)
+                SDL_Delay(10);
+        }
+        if(k->fd >= 0)
+            kliens_bont(k);
+    }
+    close(sz->hallgato);
+    if(unix_socket)
+        unlink(((struct sockaddr_un*)&sa)->sun_path);
+    if(sz->van_tabla)
+        destroy_tabla(&sz->t);
+    free(sz->uzenet.adat);
+    free(sz);
+    return 1;
+}
+
+char* sor_olvas(int fd, Puffer *p){
+    // Az előző sor eldobása
+    if(p->kuldott > 0){
+        memmove(p->adat, p->adat + p->kuldott, p->db - p->kuldott);
+        p->db -= p->kuldott;
+        p->kuldott = 0;
+    }
+    size_t nezett = 0;
+    while(1){
+        char *vege = p->adat ? memchr(p->adat + nezett, '\n', p->db - nezett) : NULL;
+        if(vege != NULL){
+            *vege = '\0';
+            p->kuldott = vege - p->adat + 1;
+            return p->adat;
+        }
+        nezett = p->db;
+        char darab[65536];
+        ssize_t n = recv(fd, darab, sizeof(darab), 0);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return NULL;
+        puffer_ir(p, darab, n);
+        if(p->hiba)
+            return NULL;
+    }
+}
+
+void tukor_frissit(Tabla *tukor, int *van_tukor, const char *sor, Kliens_eredmeny *e){
+    char *p;
+    long long generacio = strtoll(sor + 2, &p, 10);
+    if(sor[0] == 'K'){
+        int szel = (int)strtol(p, &p, 10), mag = (int)strtol(p, &p, 10);
+        if(!*van_tukor || tukor->sz != szel + 2 || tukor->m != mag + 2){
+            if(*van_tukor)
+                destroy_tabla(tukor);
+            *van_tukor = init_tabla(tukor, szel, mag);
+            if(!*van_tukor){
+                e->hibak++;
+                return;
+            }
+        }
+        memset(tukor->g, 0, (size_t)tukor->m * tukor->lepes);
+        memset(tukor->kov, 0, (size_t)tukor->m * tukor->lepes);
+        tukor->hash = 0;
+        e->kulcsok++;
+    }
+    else{
+        e->deltak++;
+        // A változás csak az előző generációra alkalmazható
+        if(!*van_tukor || generacio != tukor->generacio + 1){
+            e->hibak++;
+            return;
+        }
+    }
+    uint64_t hash = strtoull(p, &p, 16);
+    long long db = strtoll(p, &p, 10);
+    for(long long i = 0; i < db; i++){
+        int s = (int)strtol(p, &p, 10), o = (int)strtol(p, &p, 10);
+        Cella uj = (Cella)strtol(p, &p, 10);
+        if(s < 1 || s > tukor->m - 2 || o < 1 || o > tukor->sz - 2){
+            e->hibak++;
+            return;
+        }
+        Cella regi = CELLA(tukor, s, o);
+        // Mint a generacio_lezar-ban
+        if((regi | uj) == 1)
+            tukor->hash ^= cella_kulcs(s, o);
+        else
+            tukor->hash ^= allapot_kulcs(s, o, regi) ^ allapot_kulcs(s, o, uj);
+        CELLA(tukor, s, o) = uj;
+    }
+    tukor->generacio = generacio;
+    if(tukor->hash != hash)
+        e->hibak++;
+}
+
+int kliens_futtat(const char *cim, FILE *be, FILE *ki, Kliens_eredmeny *e){
+    memset(e, 0, sizeof(*e));
+    e->generacio = -1;
+    struct sockaddr_storage sa;
+    socklen_t hossz;
+    if(!cim_felbont(cim, &sa, &hossz)){
+        fprintf(stderr, "Hibas cim: %s (tcp:<port> vagy unix:<utvonal>)\n", cim);
+        return 0;
+    }
+    int fd = socket(sa.ss_family, SOCK_STREAM, 0);
+    if(fd < 0 || connect(fd, (struct sockaddr*)&sa, hossz) != 0){
+        if(fd >= 0)
+            close(fd);
+        return 0;
+    }
+    Puffer bejovo = {NULL, 0, 0, 0, 0};
+    Tabla tukor;
+    int van_tukor = 0, rendben = 1;
+    char parancs[SZERVER_SOR];
+    int vege = 0;
+    while(!vege && rendben){
+        if(fgets(parancs, sizeof(parancs), be) == NULL){
+            strcpy(parancs, "kilep\n");
+            vege = 1;
+        }
+        long long cel;
+        int ms;
+        if(sscanf(parancs, "varj %lld", &cel) == 1){
+            // A tükrözött tábla a cel. generációig
+            char *sor;
+            while(van_tukor && tukor.generacio < cel && (sor = sor_olvas(fd, &bejovo)) != NULL)
+                if(sor[0] == 'D' || sor[0] == 'K')
+                    tukor_frissit(&tukor, &van_tukor, sor, e);
+            rendben = van_tukor && tukor.generacio >= cel;
+            continue;
+        }
+        if(sscanf(parancs, "alszik %d", &ms) == 1){
+            SDL_Delay(ms);
+            continue;
+        }
+        if(strchr(parancs, '\n') == NULL)
+            strcat(parancs, "\n");
+        // A leallit után a szerver zárja le a kapcsolatot
+        if(strncmp(parancs, "leallit", 7) == 0)
+            vege = 1;
+        if(send(fd, parancs, strlen(parancs), MSG_NOSIGNAL) != (ssize_t)strlen(parancs)){
+            rendben = 0;
+            break;
+        }
+        // A válaszig (kilep után a kapcsolat lezárásáig) a kapott változások feldolgozása
+        char *sor;
+        while((sor = sor_olvas(fd, &bejovo)) != NULL){
+            if(sor[0] == 'D' || sor[0] == 'K'){
+                tukor_frissit(&tukor, &van_tukor, sor, e);
+                continue;
+            }
+            if(ki != NULL)
+                fprintf(ki, "%s\n", sor);
+            unsigned long long h;
+            if(sscanf(sor, "OK generacio %lld hash %llx", &e->szerver_generacio, &h) == 2)
+                e->szerver_hash = h;
+            else
+                e->elutasitott++;
+            if(!vege)
+                break;
+        }
+        // Csak a kilep után szabad lezárnia a szervernek
+        if(sor == NULL && !vege)
+            rendben = 0;
+    }
+    if(van_tukor){
+        e->generacio = tukor.generacio;
+        e->hash = tukor.hash;
+        destroy_tabla(&tukor);
+    }
+    free(bejovo.adat);
+    close(fd);
+    return rendben;
+}
+
+#endif
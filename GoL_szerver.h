@@ -0,0 +1,91 @@
+/**
+ * @file GoL_szerver.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief Helyi vezérlő szerver: a szimuláció irányítása és a változások folyamatos küldése socketen (pl. egy
+ * böngészős vagy szkriptes felületnek), és egy tesztkliens hozzá.
+ * A szerver egy helyi TCP porton (csak a 127.0.0.1 címen) vagy egy Unix socketen hallgat, és egyetlen szálon, poll-lal
+ * szolgálja ki a klienseket. A protokoll soralapú szöveg; a kliens parancsaira egy "OK ..." vagy "HIBA ..." sor a válasz:
+ *  betolt <nev>         a ./saves/<nev>.txt mentés betöltése (mint a grafikus felületen; '/', '\\' és ".." nem lehet benne)
+ *  lep <N>              N generáció léptetése; a lépések SZERVER_LEP_ADAG_MS-os adagokban futnak, közben a többi kliens
+ *                       is kiszolgálódik, a válasz az N. lépés után jön, és addig a kliens további parancsai várnak
+ *  indit / megallit     folyamatos futtatás indítása / megállítása
+ *  sebesseg <gen/s>     a folyamatos futtatás sebessége (0: amilyen gyorsan csak lehet)
+ *  szabaly <szabaly>    B/S, Generations vagy Larger than Life szabály (lásd GoL_ltl.h)
+ *  ment <nev>           a tábla mentése a ./saves/<nev>.txt fájlba
+ *  allapot              generáció, hash, népesség, szabály, fut-e
+ *  feliratkozas / leiratkozas   a változások küldése a kliensnek, illetve annak vége
+ *  kilep                a kliens kapcsolatának lezárása;   leallit   a szerver leállítása
+ * Minden sikeres válasz "OK generacio <g> hash <h>"-val kezdődik.
+ * A feliratkozott kliens generációnként egy sort kap a lépés változáslistájából (nem a teljes táblát):
+ *  D <generacio> <hash> <db> <sor> <oszlop> <allapot> ...
+ * és a feliratkozáskor, betöltéskor, illetve ha lemaradt, egy kulcsképkockát a tábla összes nem halott cellájával:
+ *  K <generacio> <szelesseg> <magassag> <hash> <db> <sor> <oszlop> <allapot> ...
+ * (a sor és az oszlop 1-től számít, mint a CELLA-ban). A szerver sosem vár a kliensre: ha egy kliens kimenő puffere
+ * SZERVER_KORLAT fölé nő, nem kap több változást, és amint a puffere kiürült, egy kulcsképkockát kap helyettük.
+ * Csak POSIX rendszeren érhető el.
+ * @version 0.1
+ * @date 2021-12-07
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_SZERVER_H
+#define GOL_SZERVER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/** Legfeljebb ennyi kliens lehet egyszerre */
+#define SZERVER_MAX_KLIENS 16
+/** Ha egy kliens kimenő puffere ennél nagyobb, lemaradtnak számít (bájt) */
+#define SZERVER_KORLAT (256 * 1024)
+/** Egy parancssor legnagyobb hossza */
+#define SZERVER_SOR 1024
+/** A lep parancsok lépései egy körben legfeljebb nagyjából ennyi ideig futnak (ms), utána a szerver kiszolgálja a klienseket */
+#define SZERVER_LEP_ADAG_MS 20
+/** A betolt és a ment parancs ebben a mappában, .txt kiterjesztéssel keresi a mentést */
+#define SZERVER_MENTESEK "./saves"
+
+/**
+ * @brief A tesztkliens futásának eredménye.
+ * @param deltak A kapott változás-sorok száma
+ * @param kulcsok A kapott kulcsképkockák száma
+ * @param hibak Ahány sornál a tükrözött tábla hash-e nem egyezett a szerver által küldöttel
+ * @param generacio A tükrözött tábla generációja a végén (-1 ha nem volt feliratkozva)
+ * @param hash A tükrözött tábla hash-e a végén
+ * @param szerver_generacio Az utolsó OK válaszban kapott generáció
+ * @param szerver_hash Az utolsó OK válaszban kapott hash
+ * @param elutasitott A HIBA válaszok száma
+ */
+typedef struct Kliens_eredmeny{
+    long long deltak, kulcsok, hibak;
+    long long generacio;
+    uint64_t hash;
+    long long szerver_generacio;
+    uint64_t szerver_hash;
+    long long elutasitott;
+}Kliens_eredmeny;
+
+/**
+ * @brief Elindítja a szervert, és a leallit parancsig kiszolgálja a klienseket.
+ * @param cim "tcp:<port>" vagy "unix:<utvonal>"
+ * @param fajl ha nem NULL, az induláskor betöltendő mentés
+ * @return 1 ha a leallit paranccsal állt le, 0 ha nem tudott elindulni
+ */
+int szerver_futtat(const char *cim, const char *fajl);
+
+/**
+ * @brief A tesztkliens: a be soronként egy-egy parancsát elküldi, a válaszokat kiírja a ki-re, és a feliratkozás után a kapott
+ * változásokból tükrözi a táblát, minden sorban összevetve a hash-ét a szerverével. Két parancsa helyi:
+ * "varj <generacio>" a tükrözött tábla generációjáig vár, "alszik <ms>" ennyi ideig nem olvas a socketről (a lemaradás
+ * kipróbálására). A be végén kilep-et küld, és a kapcsolat lezárásáig még feldolgozza a kapott sorokat.
+ * @param cim Mint a szerver_futtat-nál
+ * @param be
+ * @param ki ha NULL, nem ír ki semmit
+ * @param e ide írja az eredményt
+ * @return 1 ha sikerült kapcsolódni és a kapcsolat rendben zárult
+ */
+int kliens_futtat(const char *cim, FILE *be, FILE *ki, Kliens_eredmeny *e);
+
+#endif
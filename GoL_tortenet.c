@@ -0,0 +1,347 @@
+/**
+ * @file GoL_tortenet.c
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A visszajátszható történet megvalósítása.
+ * @version 0.1
+ * @date 2021-12-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include "GoL_logics.h"
+#include "GoL_tortenet.h"
+#ifdef GOL_DEBUG
+#include "src/debugmalloc.h"
+#endif
+
+/**
+ * @brief A szakasz a történet i. (0 a legrégebbi) szakasza.
+ */
+static Tortenet_szakasz* szakasz(Tortenet *tr, int i);
+
+/**
+ * @brief Új szakaszt kezd a történet végén, a tábla jelenlegi állapotával mint kulcsképpel.
+ * @return 1 ha sikeres, 0 ha elfogyott a memória (a történet ilyenkor nem változik)
+ */
+static int szakasz_uj(Tortenet *tr, Tabla *t);
+
+/**
+ * @brief Felszabadítja a szakasz memóriáját, és levonja a használt memóriából.
+ */
+static void szakasz_felszabadit(Tortenet *tr, Tortenet_szakasz *sz);
+
+/**
+ * @brief Amíg a történet túllépi a keretet, törli a legrégebbi szakaszt (a legutóbbit nem).
+ */
+static void keret_betart(Tortenet *tr);
+
+/**
+ * @brief Tömörítve a szakasz végére fűzi a változáslistát.
+ * @return 1 ha sikeres, 0 ha elfogyott a memória (a szakasz ilyenkor nem változik)
+ */
+static int delta_hozzaad(Tortenet *tr, Tortenet_szakasz *sz, OszlopSor_Lista_Elem *fej);
+
+/**
+ * @brief A szakasz i. deltájának celláit átbillenti a táblán (a hash-t is frissíti), és felveszi őket a listába.
+ */
+static OszlopSor_Lista_Elem* delta_alkalmaz(Tortenet *tr, Tortenet_szakasz *sz, int i, Tabla *t, OszlopSor_Lista_Elem *fej);
+
+/**
+ * @brief qsort-hoz összehasonlító függvény size_t-kre.
+ */
+static int index_hasonlit(const void *a, const void *b);
+
+/**
+ * @brief Egy előjel nélküli számot ír ki változó hosszú (7 bit / bájt) kódolással; legfeljebb 10 bájt.
+ * @return a kiírt bájtok száma
+ */
+static int varint_ir(unsigned char *hova, uint64_t ertek);
+
+/**
+ * @brief A varint_ir párja.
+ * @return a beolvasott szám
+ */
+static uint64_t varint_olvas(const unsigned char **p);
+
+Tortenet_szakasz* szakasz(Tortenet *tr, int i){
+    return &tr->szakaszok[(tr->elso + i) % tr->kapacitas];
+}
+
+int szakasz_uj(Tortenet *tr, Tabla *t){
+    size_t csomag = (size_t)(t->sz + 7) / 8;
+    unsigned char *racs = calloc((size_t)t->m * csomag, 1);
+    if(racs == NULL)
+        return 0;
+    if(tr->db == tr->kapacitas){
+        int uj_kapacitas = tr->kapacitas ? 2 * tr->kapacitas : 16;
+        Tortenet_szakasz *uj = malloc(uj_kapacitas * sizeof(Tortenet_szakasz));
+        if(uj == NULL){
+            free(racs);
+            return 0;
+        }
+        for(int i = 0; i < tr->db; i++)
+            uj[i] = *szakasz(tr, i);
+        free(tr->szakaszok);
+        tr->szakaszok = uj;
+        tr->kapacitas = uj_kapacitas;
+        tr->elso = 0;
+    }
+    Tortenet_szakasz *sz = &tr->szakaszok[(tr->elso + tr->db) % tr->kapacitas];
+    tr->db++;
+    sz->generacio = t->generacio;
+    sz->racs = racs;
+    for(int sor = 0; sor < t->m; sor++)
+        for(int oszlop = 0; oszlop < t->sz; oszlop++)
+            sz->racs[sor * csomag + (oszlop >> 3)] |= CELLA(t, sor, oszlop) << (oszlop & 7);
+    sz->deltak = NULL;
+    sz->deltak_meret = 0;
+    sz->deltak_kapacitas = 0;
+    sz->eltolasok = NULL;
+    sz->db = 0;
+    sz->kapacitas = 0;
+    tr->hasznalt += (size_t)t->m * csomag;
+    return 1;
+}
+
+void szakasz_felszabadit(Tortenet *tr, Tortenet_szakasz *sz){
+    tr->hasznalt -= (size_t)tr->m * ((tr->sz + 7) / 8) + sz->deltak_kapacitas + sz->kapacitas * sizeof(size_t);
+    free(sz->racs);
+    free(sz->deltak);
+    free(sz->eltolasok);
+}
+
+void keret_betart(Tortenet *tr){
+    while(tr->hasznalt > tr->keret && tr->db > 1){
+        szakasz_felszabadit(tr, szakasz(tr, 0));
+        tr->elso = (tr->elso + 1) % tr->kapacitas;
+        tr->db--;
+    }
+}
+
+int index_hasonlit(const void *a, const void *b){
+    size_t x = *(const size_t*)a, y = *(const size_t*)b;
+    return (x > y) - (x < y);
+}
+
+int varint_ir(unsigned char *hova, uint64_t ertek){
+    int n = 0;
+    while(ertek >= 0x80){
+        hova[n++] = (unsigned char)(ertek | 0x80);
+        ertek >>= 7;
+    }
+    hova[n++] = (unsigned char)ertek;
+    return n;
+}
+
+uint64_t varint_olvas(const unsigned char **p){
+    uint64_t ertek = 0;
+    int eltolas = 0;
+    const unsigned char *q = *p;
+    while(*q & 0x80){
+        ertek |= (uint64_t)(*q++ & 0x7F) << eltolas;
+        eltolas += 7;
+    }
+    ertek |= (uint64_t)(*q++) << eltolas;
+    *p = q;
+    return ertek;
+}
+
+int delta_hozzaad(Tortenet *tr, Tortenet_szakasz *sz, OszlopSor_Lista_Elem *fej){
+    size_t db = 0;
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next)
+        db++;
+    // Rendezve az egymás utáni indexek különbségei kicsik, többnyire 1-2 bájton elférnek
+    size_t *indexek = malloc((db ? db : 1) * sizeof(size_t));
+    if(indexek == NULL)
+        return 0;
+    size_t i = 0;
+    for(OszlopSor_Lista_Elem *iter = fej; iter != NULL; iter = iter->next)
+        indexek[i++] = (size_t)iter->sor * tr->sz + iter->oszlop;
+    qsort(indexek, db, sizeof(size_t), index_hasonlit);
+
+    unsigned char puffer[10];
+    size_t hossz = varint_ir(puffer, db);
+    for(i = 0; i < db; i++)
+        hossz += varint_ir(puffer, indexek[i] - (i ? indexek[i-1] : 0));
+    if(sz->deltak_meret + hossz > sz->deltak_kapacitas){
+        size_t uj = sz->deltak_kapacitas ? sz->deltak_kapacitas : 1024;
+        while(uj < sz->deltak_meret + hossz)
+            uj *= 2;
+        unsigned char *deltak = realloc(sz->deltak, uj);
+        if(deltak == NULL){
+            free(indexek);
+            return 0;
+        }
+        sz->deltak = deltak;
+        tr->hasznalt += uj - sz->deltak_kapacitas;
+        sz->deltak_kapacitas = uj;
+    }
+    if(sz->db == sz->kapacitas){
+        int uj = sz->kapacitas ? 2 * sz->kapacitas : 16;
+        size_t *eltolasok = realloc(sz->eltolasok, uj * sizeof(size_t));
+        if(eltolasok == NULL){
+            free(indexek);
+            return 0;
+        }
+        sz->eltolasok = eltolasok;
+        tr->hasznalt += (uj - sz->kapacitas) * sizeof(size_t);
+        sz->kapacitas = uj;
+    }
+    sz->eltolasok[sz->db++] = sz->deltak_meret;
+    unsigned char *p = sz->deltak + sz->deltak_meret;
+    p += varint_ir(p, db);
+    size_t elozo = 0;
+    for(i = 0; i < db; i++){
+        p += varint_ir(p, indexek[i] - elozo);
+        elozo = indexek[i];
+    }
+    sz->deltak_meret = p - sz->deltak;
+    free(indexek);
+    return 1;
+}
+
+OszlopSor_Lista_Elem* delta_alkalmaz(Tortenet *tr, Tortenet_szakasz *sz, int i, Tabla *t, OszlopSor_Lista_Elem *fej){
+    const unsigned char *p = sz->deltak + sz->eltolasok[i];
+    uint64_t db = varint_olvas(&p);
+    size_t index = 0;
+    for(uint64_t j = 0; j < db; j++){
+        index += varint_olvas(&p);
+        int sor = (int)(index / tr->sz), oszlop = (int)(index % tr->sz);
+        CELLA(t, sor, oszlop) ^= 1;
+        t->hash ^= cella_kulcs(sor + t->eltolas_sor, oszlop + t->eltolas_oszlop);
+        fej = valtozas_felvesz(fej, sor, oszlop);
+    }
+    return fej;
+}
+
+void tortenet_init(Tortenet *tr, Tabla *t, int kulcs_koz, size_t keret){
+    tr->szakaszok = NULL;
+    tr->elso = 0;
+    tr->db = 0;
+    tr->kapacitas = 0;
+    tr->kulcs_koz = kulcs_koz > 1 ? kulcs_koz : 2;
+    tr->keret = keret;
+    tr->hasznalt = 0;
+    tr->sz = t->sz;
+    tr->m = t->m;
+    // Ha már a kulcskép sem fér a keretbe (vagy nem foglalható le), a történet kikapcsolva marad
+    if(tortenet_memoria_becsles(t->sz - 2, t->m - 2) <= keret)
+        szakasz_uj(tr, t);
+}
+
+size_t tortenet_memoria_becsles(long long szelesseg, long long magassag){
+    if(szelesseg < 1 || magassag < 1)
+        return 0;
+    return (size_t)(magassag + 2) * (size_t)((szelesseg + 2 + 7) / 8);
+}
+
+int tortenet_aktiv(const Tortenet *tr){
+    return tr->db > 0;
+}
+
+void tortenet_torol(Tortenet *tr){
+    for(int i = 0; i < tr->db; i++)
+        szakasz_felszabadit(tr, szakasz(tr, i));
+    free(tr->szakaszok);
+    tr->szakaszok = NULL;
+    tr->db = 0;
+    tr->kapacitas = 0;
+}
+
+long long tortenet_elso(Tortenet *tr){
+    if(tr->db == 0)
+        return -1;
+    return szakasz(tr, 0)->generacio;
+}
+
+long long tortenet_utolso(Tortenet *tr){
+    if(tr->db == 0)
+        return -1;
+    Tortenet_szakasz *utolso = szakasz(tr, tr->db - 1);
+    return utolso->generacio + utolso->db;
+}
+
+void tortenet_rogzit(Tortenet *tr, Tabla *t, OszlopSor_Lista_Elem *fej){
+    if(tr->db == 0)
+        return;
+    long long utolso = tortenet_utolso(tr);
+    if(t->generacio >= tortenet_elso(tr) && t->generacio <= utolso)
+        return;
+    Tortenet_szakasz *sz = szakasz(tr, tr->db - 1);
+    // Ha nem fér a memóriába, a generáció kimarad; a következő lépés így nem folytatás, új kulcsképpel próbálkozik
+    if(t->generacio != utolso + 1 || sz->db + 1 >= tr->kulcs_koz || !delta_hozzaad(tr, sz, fej))
+        szakasz_uj(tr, t);
+    keret_betart(tr);
+}
+
+void tortenet_csonkit(Tortenet *tr, Tabla *t){
+    if(tr->db == 0)
+        return;
+    // A jelenlegi generációtól kezdve minden elavult; legalább egy szakasz kell, ezért az új előbb kerül be.
+    // Ha ez nem fér a memóriába, az elavult szakaszok sem maradhatnak: a történet kikapcsol
+    if(!szakasz_uj(tr, t)){
+        tortenet_torol(tr);
+        return;
+    }
+    while(tr->db > 1){
+        Tortenet_szakasz *sz = szakasz(tr, tr->db - 2);
+        if(sz->generacio < t->generacio)
+            break;
+        szakasz_felszabadit(tr, sz);
+        *sz = *szakasz(tr, tr->db - 1);
+        tr->db--;
+    }
+    if(tr->db > 1){
+        Tortenet_szakasz *sz = szakasz(tr, tr->db - 2);
+        if(sz->generacio + sz->db >= t->generacio){
+            sz->db = (int)(t->generacio - 1 - sz->generacio);
+            sz->deltak_meret = sz->db ? sz->eltolasok[sz->db] : 0;
+        }
+    }
+    keret_betart(tr);
+}
+
+OszlopSor_Lista_Elem* tortenet_ugras(Tortenet *tr, Tabla *t, long long cel, int *siker){
+    OszlopSor_Lista_Elem *fej = NULL;
+    Tortenet_szakasz *sz = NULL;
+    for(int i = tr->db - 1; i >= 0 && sz == NULL; i--){
+        Tortenet_szakasz *jelolt = szakasz(tr, i);
+        if(jelolt->generacio <= cel && cel <= jelolt->generacio + jelolt->db)
+            sz = jelolt;
+    }
+    *siker = sz != NULL;
+    if(sz == NULL)
+        return NULL;
+
+    long long most = t->generacio;
+    if(most >= sz->generacio && most <= sz->generacio + sz->db){
+        // Ugyanabban a szakaszban: a deltak a jelenlegi állapotból visszafelé vagy előre is alkalmazhatók
+        for(long long g = most; g > cel; g--)
+            fej = delta_alkalmaz(tr, sz, (int)(g - sz->generacio - 1), t, fej);
+        for(long long g = most + 1; g <= cel; g++)
+            fej = delta_alkalmaz(tr, sz, (int)(g - sz->generacio - 1), t, fej);
+    }
+    else{
+        size_t csomag = (size_t)(t->sz + 7) / 8;
+        for(int sor = 0; sor < t->m; sor++){
+            for(int oszlop = 0; oszlop < t->sz; oszlop++){
+                Cella c = (sz->racs[sor * csomag + (oszlop >> 3)] >> (oszlop & 7)) & 1;
+                if(CELLA(t, sor, oszlop) != c){
+                    CELLA(t, sor, oszlop) = c;
+                    t->hash ^= cella_kulcs(sor + t->eltolas_sor, oszlop + t->eltolas_oszlop);
+                    fej = valtozas_felvesz(fej, sor, oszlop);
+                }
+            }
+        }
+        for(long long g = sz->generacio + 1; g <= cel; g++)
+            fej = delta_alkalmaz(tr, sz, (int)(g - sz->generacio - 1), t, fej);
+    }
+    t->generacio = cel;
+    return fej;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file GoL_tortenet.h
+ * @author Nagy Ábel (CPD63P) (nagy.abel@edu.bme.hu)
+ * @brief A szimuláció visszajátszható története: visszaléptetés és tetszőleges korábbi generációra ugrás.
+ * A történet szakaszokból áll: minden szakasz egy kulcsképpel (a teljes tábla bitekbe csomagolva) kezdődik,
+ * utána generációnként a változáslista tömörítve (rendezett cellaindexek különbségei, változó hosszú kódolással).
+ * Mivel egy generáció változása mindkét irányban ugyanaz (a cellák átbillentése), visszafelé és előre is alkalmazható,
+ * így egy ugrás legfeljebb egy szakasznyi (kulcs_koz) változáslista alkalmazása.
+ * Ha a történet túllépi a memóriakeretet, a legrégebbi szakaszok törlődnek. Ha már egy kulcskép sem fér a keretbe,
+ * vagy elfogy a memória, a történet kikapcsol (üres marad), a tábla ettől még léptethető.
+ * @version 0.1
+ * @date 2021-12-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef GOL_TORTENET_H
+#define GOL_TORTENET_H
+
+#include <stddef.h>
+#include "GoL_logics.h"
+
+/**
+ * @brief Egy szakasz: a kulcskép és az utána következő generációk változásai.
+ * @param generacio A kulcskép generációja
+ * @param racs A kulcskép, soronként bitekbe csomagolva
+ * @param deltak A tömörített változáslisták egymás után
+ * @param deltak_meret
+ * @param deltak_kapacitas
+ * @param eltolasok Az i. delta (a generacio+i+1. generációba lépés) kezdete a deltak-ban
+ * @param db A deltak száma, a szakasz így a [generacio, generacio+db] generációkat fedi le
+ * @param kapacitas Az eltolasok tömb mérete
+ */
+typedef struct Tortenet_szakasz{
+    long long generacio;
+    unsigned char *racs;
+    unsigned char *deltak;
+    size_t deltak_meret, deltak_kapacitas;
+    size_t *eltolasok;
+    int db, kapacitas;
+}Tortenet_szakasz;
+
+/**
+ * @brief A történet.
+ * @param szakaszok Gyűrűs tömb, a legrégebbi szakasz az elso indexű
+ * @param elso
+ * @param db
+ * @param kapacitas
+ * @param kulcs_koz Ennyi generációnként kezd új szakaszt
+ * @param keret A memóriakeret bájtban
+ * @param hasznalt A szakaszok által foglalt memória bájtban
+ * @param sz A tábla szélessége
+ * @param m A tábla magassága
+ */
+typedef struct Tortenet{
+    Tortenet_szakasz *szakaszok;
+    int elso, db, kapacitas;
+    int kulcs_koz;
+    size_t keret, hasznalt;
+    int sz, m;
+}Tortenet;
+
+/**
+ * @brief Létrehozza a történetet, az első kulcskép a tábla jelenlegi állapota.
+ * @warning A tortenet_torol-lel felszabadítandó!!
+ * @param tr
+ * @param t
+ * @param kulcs_koz Ennyi generációnként készül kulcskép (egy ugrás legfeljebb ennyi delta alkalmazása)
+ * @param keret A memóriakeret bájtban; ha túllépi, a legrégebbi szakaszok törlődnek (a legutóbbi mindig megmarad).
+ * Ha már a kulcskép is nagyobb, vagy nem foglalható le, a történet kikapcsolva jön létre (lásd tortenet_aktiv).
+ */
+void tortenet_init(Tortenet *tr, Tabla *t, int kulcs_koz, size_t keret);
+
+/**
+ * @brief Egy szelesseg x magassag tábla kulcsképének mérete: a történet legalább ennyit foglal, legfeljebb a keretet
+ * (és egy kulcsképet). A tabla_meret_ellenoriz kísérő memóriájába számítandó.
+ * @param szelesseg szegély nélkül
+ * @param magassag
+ * @return bájtban, 0 ha a méret érvénytelen
+ */
+size_t tortenet_memoria_becsles(long long szelesseg, long long magassag);
+
+/**
+ * @brief Van-e a történetben rögzített generáció. A kikapcsolt történet nem rögzít, az ugrás mindig sikertelen,
+ * és egy új tortenet_init kapcsolja vissza.
+ * @param tr
+ * @return 1 ha igen
+ */
+int tortenet_aktiv(const Tortenet *tr);
+
+/**
+ * @brief Felszabadítja a történetet.
+ */
+void tortenet_torol(Tortenet *tr);
+
+/**
+ * @brief Minden lépés után hívandó, a lépés változáslistájával.
+ * Ha a generációt már tartalmazza a történet (visszalépés után újra előre), nem rögzít semmit.
+ * Ha a lépés nem a következő generáció (pl. ciklus miatti ugrás), új szakaszt kezd.
+ * @param tr
+ * @param t
+ * @param fej
+ */
+void tortenet_rogzit(Tortenet *tr, Tabla *t, OszlopSor_Lista_Elem *fej);
+
+/**
+ * @brief A tábla kézi megváltoztatása (flip, betöltés) után hívandó: a jelenlegi generációtól elvágja a történetet,
+ * és a tábla jelenlegi állapotával új szakaszt kezd.
+ * @param tr
+ * @param t
+ */
+void tortenet_csonkit(Tortenet *tr, Tabla *t);
+
+/**
+ * @brief A tábla a cel generáció állapotába kerül (hash és generáció számláló is).
+ * @warning A visszaadott linked list a valtozasok_felszabadit-tal felszabadítandó!!
+ * @param tr
+ * @param t
+ * @param cel
+ * @param siker ide írja, hogy a generáció benne van -e a történetben (ha nincs, a tábla nem változik)
+ * @return az átbillentett cellák (egy cella többször is szerepelhet, ha közben vissza is változott)
+ */
+OszlopSor_Lista_Elem* tortenet_ugras(Tortenet *tr, Tabla *t, long long cel, int *siker);
+
+/**
+ * @brief A történet legrégebbi generációja, -1 ha a történet ki van kapcsolva.
+ */
+long long tortenet_elso(Tortenet *tr);
+
+/**
+ * @brief A történet legújabb generációja, -1 ha a történet ki van kapcsolva.
+ */
+long long tortenet_utolso(Tortenet *tr);
+
+#endif
@@ -1,9 +1,36 @@
 cd .\NHF\
-gcc -c GoL_logics.c -o GoL_logics.o
-gcc -c GoL_graphics.c -o GoL_graphics.o
-gcc -c GoL_main.c -o  GoL_main.o
-gcc GoL_main.o GoL_graphics.o GoL_logics.o -lmingw32 -lSDL2main -lSDL2_gfx -lSDL2_ttf -lSDL2_image -lSDL2 -o GoL.exe
+:: Alapból release build; "make.bat debug" esetén debugmalloc-kal, optimalizálás nélkül
+set CFLAGS=-O2
+if "%1"=="debug" set CFLAGS=-g -O0 -DGOL_DEBUG
+gcc %CFLAGS% -c GoL_logics.c -o GoL_logics.o
+gcc %CFLAGS% -c GoL_graphics.c -o GoL_graphics.o
+gcc %CFLAGS% -c GoL_meres.c -o GoL_meres.o
+gcc %CFLAGS% -c GoL_ellenorzes.c -o GoL_ellenorzes.o
+gcc %CFLAGS% -c GoL_ciklus.c -o GoL_ciklus.o
+gcc %CFLAGS% -c GoL_statisztika.c -o GoL_statisztika.o
+gcc %CFLAGS% -c GoL_pool.c -o GoL_pool.o
+gcc %CFLAGS% -c GoL_parancssor.c -o GoL_parancssor.o
+gcc %CFLAGS% -c GoL_memoria.c -o GoL_memoria.o
+gcc %CFLAGS% -c GoL_idoblokk.c -o GoL_idoblokk.o
+gcc %CFLAGS% -c GoL_lut.c -o GoL_lut.o
+gcc %CFLAGS% -c GoL_motor.c -o GoL_motor.o
+gcc %CFLAGS% -c GoL_elosztott.c -o GoL_elosztott.o
+gcc %CFLAGS% -c GoL_mentespont.c -o GoL_mentespont.o
+gcc %CFLAGS% -c GoL_tortenet.c -o GoL_tortenet.o
+gcc %CFLAGS% -c GoL_felvetel.c -o GoL_felvetel.o
+gcc %CFLAGS% -c GoL_ltl.c -o GoL_ltl.o
+gcc %CFLAGS% -c GoL_kernel.c -o GoL_kernel.o
+gcc %CFLAGS% -c GoL_leves.c -o GoL_leves.o
+gcc %CFLAGS% -c GoL_nepszamlalas.c -o GoL_nepszamlalas.o
+gcc %CFLAGS% -c GoL_kozos.c -o GoL_kozos.o
+gcc %CFLAGS% -c GoL_szerver.c -o GoL_szerver.o
+gcc %CFLAGS% -c GoL_eroforras.c -o GoL_eroforras.o
+gcc %CFLAGS% -c GoL_novekvo.c -o GoL_novekvo.o
+gcc %CFLAGS% -c GoL_lemez.c -o GoL_lemez.o
+gcc %CFLAGS% -c GoL_ritka.c -o GoL_ritka.o
+gcc %CFLAGS% -c GoL_main.c -o  GoL_main.o
+gcc GoL_main.o GoL_graphics.o GoL_logics.o GoL_meres.o GoL_ellenorzes.o GoL_ciklus.o GoL_statisztika.o GoL_parancssor.o GoL_pool.o GoL_memoria.o GoL_idoblokk.o GoL_lut.o GoL_motor.o GoL_elosztott.o GoL_mentespont.o GoL_tortenet.o GoL_felvetel.o GoL_ltl.o GoL_kernel.o GoL_leves.o GoL_nepszamlalas.o GoL_kozos.o GoL_szerver.o GoL_eroforras.o GoL_novekvo.o GoL_lemez.o GoL_ritka.o -lmingw32 -lSDL2main -lSDL2_gfx -lSDL2_ttf -lSDL2_image -lSDL2 -o GoL.exe
 :: Hogy ne nyisson meg konzolt:
-:: gcc GoL_main.o GoL_graphics.o GoL_logics.o -lmingw32 -lSDL2main -lSDL2_gfx -lSDL2_ttf -lSDL2_image -lSDL2 -mwindows -o GoL.exe
+:: gcc GoL_main.o GoL_graphics.o GoL_logics.o GoL_meres.o GoL_ellenorzes.o GoL_ciklus.o GoL_statisztika.o GoL_parancssor.o GoL_pool.o GoL_memoria.o GoL_idoblokk.o GoL_lut.o GoL_motor.o GoL_elosztott.o GoL_mentespont.o GoL_tortenet.o GoL_felvetel.o GoL_ltl.o GoL_kernel.o GoL_leves.o GoL_nepszamlalas.o GoL_kozos.o GoL_szerver.o GoL_eroforras.o GoL_novekvo.o GoL_lemez.o GoL_ritka.o -lmingw32 -lSDL2main -lSDL2_gfx -lSDL2_ttf -lSDL2_image -lSDL2 -mwindows -o GoL.exe
 
 .\GoL.exe
\ No newline at end of file